@@ -101,6 +101,45 @@ int main()
     };
     build.Add(&model_viewer);
 
+    // The headless renderer only uses CPU rendering, so it doesn't need any GUI or GPU libraries.
+    // It still only builds for Windows since it links the Windows builds of the graphics library and uses Win32 APIs.
+    Project headless_renderer = 
+    {
+        .Type = ProjectType::PROGRAM,
+        .Name = "3DModelViewerHeadless",
+        .CodeFolderPath = workspace_folder_path / "code",
+        .UnityBuildFilepath = workspace_folder_path / "3DModelViewerHeadless.project",
+        .AdditionalIncludeFolderPaths = 
+        {
+            workspace_folder_path / "../../CppLibraries",
+            workspace_folder_path / "../../CppLibraries/ThirdParty",
+        },
+        .AdditionalLibraryFolderPaths = 
+        {
+#if DEBUG_BUILD
+            workspace_folder_path / "../../CppLibraries/build/debug",
+#endif
+#if RELEASE_BUILD
+            workspace_folder_path / "../../CppLibraries/build/release",
+#endif
+        },
+        .LinkerLibraryNames = 
+        {
+            "Filesystem.lib",
+            "Graphics.lib",
+            "Math.lib",
+            "String.lib",
+            "stb.lib",
+        },
+    };
+    build.Add(&headless_renderer);
+
+    // The benchmark uses the same libraries as the headless renderer.
+    Project benchmark = headless_renderer;
+    benchmark.Name = "3DModelViewerBenchmark";
+    benchmark.UnityBuildFilepath = workspace_folder_path / "3DModelViewerBenchmark.project";
+    build.Add(&benchmark);
+
     // BUILD DEBUG VERSIONS OF THE PROJECTS.
 #if DEBUG_BUILD
     int debug_build_exit_code = build.Run(workspace_folder_path, "debug");
@@ -0,0 +1,214 @@
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Assets/BinaryModelCache.h"
+#include "Benchmarking/BenchmarkOptions.h"
+#include "Benchmarking/BenchmarkResult.h"
+#include "Benchmarking/FrameTimeStatistics.h"
+#include "Benchmarking/RenderingSettingsMatrix.h"
+#include "Graphics/CpuRendering/CpuGraphicsDevice.h"
+#include "Graphics/Scene.h"
+#include "Headless/OffscreenWindow.h"
+#include "Rendering/CpuRenderingSettings.h"
+#include "Rendering/ObjectFrustumCuller.h"
+#include "Rendering/Rasterization/BinningRasterizer.h"
+#include "Rendering/RayTracing/TiledRayTracer.h"
+#include "Scenes/TestScenes.h"
+#include "Threading/WorkStealingThreadPool.h"
+
+/// A scene to benchmark along with a name to identify it in results.
+struct BenchmarkScene
+{
+    /// The name of the scene.
+    std::string Name = "";
+    /// The scene to render.
+    GRAPHICS::Scene Scene = {};
+};
+
+/// The entry point for benchmarking frame times of the CPU renderers.
+/// A fixed set of scenes is rendered with every relevant combination of rendering settings,
+/// and statistics are written to a machine-readable file for tracking regressions over time.
+/// @param[in]  argument_count - The number of command line arguments.
+/// @param[in]  arguments - The command line arguments.
+/// @return An exit code.  0 for success.
+int main(int argument_count, char* arguments[])
+{
+    // PARSE THE COMMAND LINE OPTIONS.
+    std::optional<BENCHMARKING::BenchmarkOptions> options = BENCHMARKING::BenchmarkOptions::Parse(argument_count, arguments);
+    if (!options)
+    {
+        BENCHMARKING::BenchmarkOptions::PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    // BUILD THE SCENES.
+    // These mirror the scenes that can be displayed in the interactive viewer.
+    // Space for all scenes is reserved upfront so that growing the vector never has to relocate loaded models.
+    constexpr std::size_t BUILT_IN_SCENE_COUNT = 2;
+    std::vector<BenchmarkScene> scenes;
+    scenes.reserve(BUILT_IN_SCENE_COUNT + options->ModelFilepaths.size());
+
+    BenchmarkScene& textured_quad_scene = scenes.emplace_back();
+    textured_quad_scene.Name = "textured_quad";
+    textured_quad_scene.Scene = SCENES::TestScenes::CreateLitScene();
+    textured_quad_scene.Scene.Objects.emplace_back(SCENES::TestScenes::CreateTexturedQuad(options->TextureFilepath));
+
+    BenchmarkScene& spheres_scene = scenes.emplace_back();
+    spheres_scene.Name = "spheres";
+    spheres_scene.Scene = SCENES::TestScenes::CreateLitScene();
+    spheres_scene.Scene.Objects.emplace_back(SCENES::TestScenes::CreateTexturedQuad(options->TextureFilepath));
+    spheres_scene.Scene.Objects.emplace_back(SCENES::TestScenes::CreateSpheres());
+
+    for (const std::filesystem::path& model_filepath : options->ModelFilepaths)
+    {
+        std::optional<GRAPHICS::MODELING::Model> model = ASSETS::BinaryModelCache::LoadModel(model_filepath);
+        if (!model)
+        {
+            std::cerr << "Failed to load model: " << model_filepath << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        BenchmarkScene& model_scene = scenes.emplace_back();
+        model_scene.Name = model_filepath.filename().string();
+        model_scene.Scene = SCENES::TestScenes::CreateLitScene();
+        GRAPHICS::Object3D& object = model_scene.Scene.Objects.emplace_back();
+        // The model is moved rather than copied to avoid temporarily needing twice its memory.
+        object.Model = std::move(*model);
+    }
+
+    // BENCHMARK EACH TYPE OF CPU RENDERER.
+    const GRAPHICS::VIEWING::Camera camera = SCENES::TestScenes::CreateDefaultCamera();
+    const std::size_t pixel_count_per_frame = static_cast<std::size_t>(options->WidthInPixels) * static_cast<std::size_t>(options->HeightInPixels);
+    HEADLESS::OffscreenWindow offscreen_window(options->WidthInPixels, options->HeightInPixels);
+    std::vector<BENCHMARKING::BenchmarkResult> results;
+
+    // Ray tracing and binning rasterization are split into screen tiles spread across threads, as in the interactive viewer.
+    // The pool is resized for each combination of settings.
+    THREADING::WorkStealingThreadPool thread_pool;
+    RENDERING::RAY_TRACING::TiledRayTracer ray_tracer;
+    RENDERING::RASTERIZATION::BinningRasterizer rasterizer;
+    RENDERING::ObjectFrustumCuller object_culler;
+
+    constexpr std::array<GRAPHICS::HARDWARE::GraphicsDeviceType, 2> GRAPHICS_DEVICE_TYPES =
+    {
+        GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RASTERIZER,
+        GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RAY_TRACER,
+    };
+    for (GRAPHICS::HARDWARE::GraphicsDeviceType graphics_device_type : GRAPHICS_DEVICE_TYPES)
+    {
+        // CREATE THE GRAPHICS DEVICE.
+        std::unique_ptr<GRAPHICS::HARDWARE::IGraphicsDevice> graphics_device = GRAPHICS::CPU_RENDERING::CpuGraphicsDevice::ConnectTo(
+            graphics_device_type,
+            offscreen_window);
+        if (!graphics_device)
+        {
+            std::cerr << "Failed to create graphics device." << std::endl;
+            return EXIT_FAILURE;
+        }
+        GRAPHICS::CPU_RENDERING::CpuGraphicsDevice& cpu_graphics_device = dynamic_cast<GRAPHICS::CPU_RENDERING::CpuGraphicsDevice&>(*graphics_device);
+        auto render_frame = [&](
+            GRAPHICS::Scene& scene,
+            const GRAPHICS::RenderingSettings& rendering_settings,
+            const RENDERING::CpuRenderingSettings& cpu_rendering_settings)
+        {
+            thread_pool.ResetWorkerArenas();
+            if (GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RAY_TRACER == graphics_device_type)
+            {
+                ray_tracer.Render(scene, camera, rendering_settings, cpu_rendering_settings, thread_pool, cpu_graphics_device.ColorBuffer);
+            }
+            else if (cpu_rendering_settings.BinningRasterization)
+            {
+                // Every frame is rendered in full so that each one is timed doing the same work.
+                constexpr bool ONLY_OBJECT_TRANSFORMS_CHANGED = false;
+                rasterizer.Render(scene, camera, rendering_settings, cpu_rendering_settings, ONLY_OBJECT_TRANSFORMS_CHANGED, thread_pool, cpu_graphics_device.ColorBuffer);
+            }
+            else
+            {
+                // Objects outside the view are hidden from the library's rasterizer, as in the interactive viewer.
+                object_culler.HideObjectsOutsideFrustum(
+                    scene,
+                    camera,
+                    cpu_graphics_device.ColorBuffer.GetWidthInPixels(),
+                    cpu_graphics_device.ColorBuffer.GetHeightInPixels(),
+                    cpu_rendering_settings.FrustumCulling);
+                graphics_device->Render(scene, camera, rendering_settings);
+                object_culler.ShowHiddenObjects();
+            }
+        };
+
+        // BENCHMARK EACH SCENE.
+        std::vector<BENCHMARKING::RenderingSettingsCombination> settings_combinations = BENCHMARKING::RenderingSettingsMatrix::Create(
+            graphics_device_type,
+            options->ThreadCounts);
+        for (BenchmarkScene& scene : scenes)
+        {
+            for (GRAPHICS::Object3D& object : scene.Scene.Objects)
+            {
+                graphics_device->Load(object);
+            }
+
+            // BENCHMARK EACH COMBINATION OF SETTINGS.
+            for (const BENCHMARKING::RenderingSettingsCombination& settings : settings_combinations)
+            {
+                thread_pool.Resize(settings.CpuRenderingSettings.ThreadCount);
+
+                // WARM UP.
+                for (unsigned int frame_index = 0; frame_index < options->WarmupFrameCount; ++frame_index)
+                {
+                    render_frame(scene.Scene, settings.RenderingSettings, settings.CpuRenderingSettings);
+                }
+
+                // MEASURE FRAME TIMES.
+                std::vector<double> frame_times_in_milliseconds;
+                frame_times_in_milliseconds.reserve(options->FrameCount);
+                for (unsigned int frame_index = 0; frame_index < options->FrameCount; ++frame_index)
+                {
+                    auto frame_start_time = std::chrono::high_resolution_clock::now();
+                    render_frame(scene.Scene, settings.RenderingSettings, settings.CpuRenderingSettings);
+                    auto frame_end_time = std::chrono::high_resolution_clock::now();
+
+                    std::chrono::duration<double, std::milli> frame_time_in_milliseconds = frame_end_time - frame_start_time;
+                    frame_times_in_milliseconds.push_back(frame_time_in_milliseconds.count());
+                }
+
+                // RECORD THE RESULTS.
+                BENCHMARKING::BenchmarkResult& result = results.emplace_back();
+                result.SceneName = scene.Name;
+                result.RenderingSettings = settings.RenderingSettings;
+                result.CpuRenderingSettings = settings.CpuRenderingSettings;
+                // The graphics library's rasterizer is single-threaded regardless of the pool.
+                bool multithreaded = (GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RAY_TRACER == graphics_device_type) || settings.CpuRenderingSettings.BinningRasterization;
+                result.CpuRenderingSettings.ThreadCount = multithreaded ? thread_pool.ThreadCount() : 1;
+                result.WidthInPixels = options->WidthInPixels;
+                result.HeightInPixels = options->HeightInPixels;
+                result.Statistics = BENCHMARKING::FrameTimeStatistics::Compute(frame_times_in_milliseconds, pixel_count_per_frame);
+
+                std::cout
+                    << scene.Name
+                    << (GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RAY_TRACER == graphics_device_type ? " ray tracer" : (settings.CpuRenderingSettings.BinningRasterization ? " binning rasterizer" : " library rasterizer"))
+                    << " (" << result.CpuRenderingSettings.ThreadCount << " threads)"
+                    << " #" << results.size()
+                    << ": median " << result.Statistics.MedianInMilliseconds << " ms"
+                    << ", p99 " << result.Statistics.P99InMilliseconds << " ms" << std::endl;
+            }
+        }
+
+        graphics_device->Shutdown();
+    }
+
+    // WRITE THE RESULTS.
+    bool results_written = BENCHMARKING::BenchmarkResult::WriteJson(results, options->OutputFilepath);
+    if (!results_written)
+    {
+        std::cerr << "Failed to write results: " << options->OutputFilepath << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,291 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Assets/BinaryModelCache.h"
+#include "Assets/WavefrontObjectParser.h"
+#include "Graphics/CpuRendering/CpuGraphicsDevice.h"
+#include "Graphics/Modeling/WavefrontObjectModel.h"
+#include "Graphics/RenderingSettings.h"
+#include "Graphics/Scene.h"
+#include "Headless/BmpFile.h"
+#include "Headless/CommandLineOptions.h"
+#include "Headless/ImageDifference.h"
+#include "Headless/OffscreenWindow.h"
+#include "Memory/HeapAllocationCounter.h"
+#include "Memory/ProcessMemoryUsage.h"
+#include "Rendering/CpuRenderingSettings.h"
+#include "Rendering/ObjectFrustumCuller.h"
+#include "Rendering/Rasterization/BinningRasterizer.h"
+#include "Rendering/RayTracing/TiledRayTracer.h"
+#include "Scenes/TestScenes.h"
+#include "Threading/WorkStealingThreadPool.h"
+
+/// The entry point for rendering the viewer's scenes without any window.
+/// This allows the CPU renderers to be run on machines without a desktop, such as for batch rendering
+/// or automated regression testing.
+/// @param[in]  argument_count - The number of command line arguments.
+/// @param[in]  arguments - The command line arguments.
+/// @return An exit code.  0 for success.
+int main(int argument_count, char* arguments[])
+{
+    // PARSE THE COMMAND LINE OPTIONS.
+    std::optional<HEADLESS::CommandLineOptions> options = HEADLESS::CommandLineOptions::Parse(argument_count, arguments);
+    if (!options)
+    {
+        HEADLESS::CommandLineOptions::PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    // VERIFY THE FAST MODEL PARSER IF REQUESTED.
+    // This checks that the parser used for loading models matches the graphics library's parser for a model,
+    // bypassing any cached copy of the model.
+    if (options->VerifyModelParser)
+    {
+        auto fast_parse_start_time = std::chrono::high_resolution_clock::now();
+        ASSETS::LoadProgress unused_progress;
+        std::optional<GRAPHICS::MODELING::Model> fast_parsed_model = ASSETS::WavefrontObjectParser::Load(options->ModelFilepath, unused_progress);
+        auto library_parse_start_time = std::chrono::high_resolution_clock::now();
+        std::optional<GRAPHICS::MODELING::Model> library_parsed_model = GRAPHICS::MODELING::WavefrontObjectModel::Load(options->ModelFilepath);
+        auto library_parse_end_time = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double, std::milli> fast_parse_time_in_milliseconds = library_parse_start_time - fast_parse_start_time;
+        std::chrono::duration<double, std::milli> library_parse_time_in_milliseconds = library_parse_end_time - library_parse_start_time;
+        std::cout
+            << "Fast parser: " << fast_parse_time_in_milliseconds.count() << " ms"
+            << ", library parser: " << library_parse_time_in_milliseconds.count() << " ms." << std::endl;
+
+        if (!library_parsed_model)
+        {
+            std::cerr << "Library parser failed to load model: " << options->ModelFilepath << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (!fast_parsed_model)
+        {
+            std::cout << "Model uses records the fast parser doesn't support, so the library parser is used for it." << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        std::string difference = ASSETS::WavefrontObjectParser::DescribeFirstDifference(*library_parsed_model, *fast_parsed_model);
+        if (!difference.empty())
+        {
+            std::cerr << "Parsed models differ: " << difference << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "Parsed models are identical." << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    // CREATE THE GRAPHICS DEVICE.
+    HEADLESS::OffscreenWindow offscreen_window(options->WidthInPixels, options->HeightInPixels);
+    std::unique_ptr<GRAPHICS::HARDWARE::IGraphicsDevice> graphics_device = GRAPHICS::CPU_RENDERING::CpuGraphicsDevice::ConnectTo(
+        options->GraphicsDeviceType,
+        offscreen_window);
+    if (!graphics_device)
+    {
+        std::cerr << "Failed to create graphics device." << std::endl;
+        return EXIT_FAILURE;
+    }
+    GRAPHICS::CPU_RENDERING::CpuGraphicsDevice& cpu_graphics_device = dynamic_cast<GRAPHICS::CPU_RENDERING::CpuGraphicsDevice&>(*graphics_device);
+
+    // BUILD THE SCENE.
+    GRAPHICS::Scene scene = SCENES::TestScenes::CreateLitScene();
+    if (options->ModelFilepath.empty())
+    {
+        scene.Objects.emplace_back(SCENES::TestScenes::CreateTexturedQuad(options->TextureFilepath));
+    }
+    else
+    {
+        MEMORY::ProcessMemoryUsage memory_usage_before_load = MEMORY::ProcessMemoryUsage::Get();
+        std::optional<GRAPHICS::MODELING::Model> model = ASSETS::BinaryModelCache::LoadModel(options->ModelFilepath);
+        if (!model)
+        {
+            std::cerr << "Failed to load model: " << options->ModelFilepath << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        GRAPHICS::Object3D& object = scene.Objects.emplace_back();
+        // The model is moved rather than copied to avoid temporarily needing twice its memory.
+        object.Model = std::move(*model);
+
+        // PRINT THE MEMORY NEEDED FOR LOADING THE MODEL.
+        // The peak during loading should be barely above what the loaded model finally needs;
+        // anything more indicates temporary copies.  Little else has been allocated yet, so the peak is from loading.
+        MEMORY::ProcessMemoryUsage memory_usage_after_load = MEMORY::ProcessMemoryUsage::Get();
+        double memory_before_load_in_mebibytes = static_cast<double>(memory_usage_before_load.CurrentBytes) / MEMORY::ProcessMemoryUsage::BYTES_PER_MEBIBYTE;
+        double model_size_in_mebibytes = static_cast<double>(memory_usage_after_load.CurrentBytes) / MEMORY::ProcessMemoryUsage::BYTES_PER_MEBIBYTE - memory_before_load_in_mebibytes;
+        double peak_load_size_in_mebibytes = static_cast<double>(memory_usage_after_load.PeakBytes) / MEMORY::ProcessMemoryUsage::BYTES_PER_MEBIBYTE - memory_before_load_in_mebibytes;
+        std::cout
+            << "Loaded model memory: " << model_size_in_mebibytes << " MiB"
+            << " (peak during load " << peak_load_size_in_mebibytes << " MiB)." << std::endl;
+    }
+
+    if (options->IncludeSpheres)
+    {
+        scene.Objects.emplace_back(SCENES::TestScenes::CreateSpheres());
+    }
+
+    for (GRAPHICS::Object3D& object : scene.Objects)
+    {
+        graphics_device->Load(object);
+    }
+
+    GRAPHICS::VIEWING::Camera camera = SCENES::TestScenes::CreateDefaultCamera();
+    GRAPHICS::RenderingSettings rendering_settings = {};
+    rendering_settings.GraphicsDeviceType = options->GraphicsDeviceType;
+    RENDERING::CpuRenderingSettings cpu_rendering_settings = {};
+    cpu_rendering_settings.ThreadCount = options->ThreadCount;
+    cpu_rendering_settings.BinningRasterization = options->BinningRasterization;
+
+    // Ray tracing and binning rasterization are split into screen tiles spread across all cores, as in the interactive viewer.
+    THREADING::WorkStealingThreadPool thread_pool(cpu_rendering_settings.ThreadCount);
+    RENDERING::RAY_TRACING::TiledRayTracer ray_tracer;
+    RENDERING::RASTERIZATION::BinningRasterizer rasterizer;
+    // Objects outside the view are hidden from the library's rasterizer, as in the interactive viewer.
+    RENDERING::ObjectFrustumCuller object_culler;
+    auto render_with_library = [&]()
+    {
+        object_culler.HideObjectsOutsideFrustum(
+            scene,
+            camera,
+            cpu_graphics_device.ColorBuffer.GetWidthInPixels(),
+            cpu_graphics_device.ColorBuffer.GetHeightInPixels(),
+            cpu_rendering_settings.FrustumCulling);
+        graphics_device->Render(scene, camera, rendering_settings);
+        object_culler.ShowHiddenObjects();
+    };
+
+    // COMPARE THE RASTERIZERS IF REQUESTED.
+    // The binning rasterizer replaces the library's rasterizer by default, so any pixels where they differ for the scene
+    // are reported as a regression check.
+    if (options->CompareRasterizers)
+    {
+        render_with_library();
+        const uint32_t* library_pixels = cpu_graphics_device.ColorBuffer.GetRawData();
+        std::size_t pixel_count = static_cast<std::size_t>(cpu_graphics_device.ColorBuffer.GetWidthInPixels()) * cpu_graphics_device.ColorBuffer.GetHeightInPixels();
+        std::vector<uint32_t> library_frame(library_pixels, library_pixels + pixel_count);
+
+        constexpr bool ONLY_OBJECT_TRANSFORMS_CHANGED = false;
+        rasterizer.Render(scene, camera, rendering_settings, cpu_rendering_settings, ONLY_OBJECT_TRANSFORMS_CHANGED, thread_pool, cpu_graphics_device.ColorBuffer);
+        HEADLESS::ImageDifference difference = HEADLESS::ImageDifference::Compute(
+            library_frame.data(),
+            cpu_graphics_device.ColorBuffer.GetRawData(),
+            pixel_count);
+
+        double different_pixel_percentage = (pixel_count > 0) ? 100.0 * static_cast<double>(difference.DifferentPixelCount) / static_cast<double>(pixel_count) : 0.0;
+        std::cout
+            << "Binning rasterizer differs from library rasterizer in " << difference.DifferentPixelCount << " of " << pixel_count << " pixels"
+            << " (" << different_pixel_percentage << "%), by up to " << difference.MaxChannelDifference << " per channel." << std::endl;
+
+        if (!options->OutputImageFilepath.empty())
+        {
+            bool image_written = HEADLESS::BmpFile::Write(
+                difference.DifferencePixels.data(),
+                cpu_graphics_device.ColorBuffer.GetWidthInPixels(),
+                cpu_graphics_device.ColorBuffer.GetHeightInPixels(),
+                options->OutputImageFilepath);
+            if (!image_written)
+            {
+                std::cerr << "Failed to write image: " << options->OutputImageFilepath << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+
+        graphics_device->Shutdown();
+        bool frames_identical = (0 == difference.DifferentPixelCount);
+        return frames_identical ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // RENDER ALL OF THE FRAMES.
+    // Heap allocations are counted for the last frame since earlier frames still build up reused memory.
+    std::vector<double> frame_times_in_milliseconds;
+    frame_times_in_milliseconds.reserve(options->FrameCount);
+    std::size_t last_frame_heap_allocation_count = 0;
+    for (unsigned int frame_index = 0; frame_index < options->FrameCount; ++frame_index)
+    {
+        thread_pool.ResetWorkerArenas();
+        std::size_t frame_start_heap_allocation_count = MEMORY::HeapAllocationCounter::AllocationCount();
+        auto frame_start_time = std::chrono::high_resolution_clock::now();
+        if (GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RAY_TRACER == options->GraphicsDeviceType)
+        {
+            ray_tracer.Render(scene, camera, rendering_settings, cpu_rendering_settings, thread_pool, cpu_graphics_device.ColorBuffer);
+        }
+        else if (GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RASTERIZER == options->GraphicsDeviceType && cpu_rendering_settings.BinningRasterization)
+        {
+            // Every frame is rendered in full so that each one is timed doing the same work.
+            constexpr bool ONLY_OBJECT_TRANSFORMS_CHANGED = false;
+            rasterizer.Render(scene, camera, rendering_settings, cpu_rendering_settings, ONLY_OBJECT_TRANSFORMS_CHANGED, thread_pool, cpu_graphics_device.ColorBuffer);
+        }
+        else if (GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RASTERIZER == options->GraphicsDeviceType)
+        {
+            render_with_library();
+        }
+        else
+        {
+            graphics_device->Render(scene, camera, rendering_settings);
+        }
+        auto frame_end_time = std::chrono::high_resolution_clock::now();
+        last_frame_heap_allocation_count = MEMORY::HeapAllocationCounter::AllocationCount() - frame_start_heap_allocation_count;
+
+        std::chrono::duration<double, std::milli> frame_time_in_milliseconds = frame_end_time - frame_start_time;
+        frame_times_in_milliseconds.push_back(frame_time_in_milliseconds.count());
+    }
+
+    // WRITE THE FINAL FRAME IF APPLICABLE.
+    if (!options->OutputImageFilepath.empty())
+    {
+        bool image_written = HEADLESS::BmpFile::Write(
+            cpu_graphics_device.ColorBuffer.GetRawData(),
+            cpu_graphics_device.ColorBuffer.GetWidthInPixels(),
+            cpu_graphics_device.ColorBuffer.GetHeightInPixels(),
+            options->OutputImageFilepath);
+        if (!image_written)
+        {
+            std::cerr << "Failed to write image: " << options->OutputImageFilepath << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // WRITE THE FRAME TIMINGS IF APPLICABLE.
+    if (!options->TimingsFilepath.empty())
+    {
+        std::ofstream timings_file(options->TimingsFilepath);
+        timings_file << "frame_index,render_time_in_milliseconds\n";
+        for (std::size_t frame_index = 0; frame_index < frame_times_in_milliseconds.size(); ++frame_index)
+        {
+            timings_file << frame_index << "," << frame_times_in_milliseconds[frame_index] << "\n";
+        }
+
+        if (!timings_file.good())
+        {
+            std::cerr << "Failed to write timings: " << options->TimingsFilepath << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // PRINT A SUMMARY.
+    double total_time_in_milliseconds = 0.0;
+    for (double frame_time_in_milliseconds : frame_times_in_milliseconds)
+    {
+        total_time_in_milliseconds += frame_time_in_milliseconds;
+    }
+    double average_time_in_milliseconds = frame_times_in_milliseconds.empty() ? 0.0 : total_time_in_milliseconds / static_cast<double>(frame_times_in_milliseconds.size());
+    std::cout
+        << "Rendered " << frame_times_in_milliseconds.size() << " frames"
+        << " (" << options->WidthInPixels << "x" << options->HeightInPixels << ")"
+        << " in " << total_time_in_milliseconds << " ms"
+        << " (average " << average_time_in_milliseconds << " ms/frame)." << std::endl;
+    std::cout << "Heap allocations in last frame: " << last_frame_heap_allocation_count << std::endl;
+    MEMORY::ProcessMemoryUsage memory_usage = MEMORY::ProcessMemoryUsage::Get();
+    std::cout
+        << "Memory: " << static_cast<double>(memory_usage.CurrentBytes) / MEMORY::ProcessMemoryUsage::BYTES_PER_MEBIBYTE << " MiB"
+        << " (peak " << static_cast<double>(memory_usage.PeakBytes) / MEMORY::ProcessMemoryUsage::BYTES_PER_MEBIBYTE << " MiB)." << std::endl;
+
+    graphics_device->Shutdown();
+    return EXIT_SUCCESS;
+}
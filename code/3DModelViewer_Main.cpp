@@ -1,17 +1,26 @@
 #include <cmath>
+#include <iomanip>
 #include <sstream>
 #include <Windows.h>
 #include <Windowsx.h>
 #include <imgui/backends/imgui_impl_win32.h>
-#include "Debugging/Timer.h"
+#include "Assets/AsyncModelLoader.h"
 #include "Graphics/CpuRendering/CpuGraphicsDevice.h"
 #include "Graphics/Geometry/Sphere.h"
-#include "Graphics/Modeling/WavefrontObjectModel.h"
 #include "Graphics/RenderingSettings.h"
 #include "Graphics/Scene.h"
 #include "Gui/Gui.h"
-#include "Math/Matrix4x4.h"
-#include "Math/Vector2.h"
+#include "Input/CameraInputQueue.h"
+#include "Memory/HeapAllocationCounter.h"
+#include "Profiling/Profiler.h"
+#include "Profiling/TraceRecorder.h"
+#include "Rendering/CpuRenderingSettings.h"
+#include "Rendering/DeviceResourceManager.h"
+#include "Rendering/ObjectFrustumCuller.h"
+#include "Rendering/Rasterization/BinningRasterizer.h"
+#include "Rendering/RayTracing/TiledRayTracer.h"
+#include "Scenes/TestScenes.h"
+#include "Threading/WorkStealingThreadPool.h"
 #include "Windowing/Win32Window.h"
 
 // GLOBALS.
@@ -20,9 +29,13 @@
 static std::unique_ptr<WINDOWING::Win32Window> g_window = nullptr;
 /// The rendering settings that can be displayed and updated via the GUI.
 static GRAPHICS::RenderingSettings g_rendering_settings = {};
+/// The settings for scheduling CPU rendering work that can be displayed and updated via the GUI.
+static RENDERING::CpuRenderingSettings g_cpu_rendering_settings = {};
 /// The camera that can be updated via the GUI.
 static GRAPHICS::VIEWING::Camera g_camera = {};
 
+/// Input for moving the camera, queued as it arrives and applied once per frame.
+static INPUT::CameraInputQueue g_camera_input_queue = {};
 /// True if a mouse button is down; false if not.
 static bool g_mouse_down = false;
 /// The previous mouse X position, if a mouse button was down, to help with detecting mouse drags.
@@ -30,8 +43,14 @@ static int g_previous_mouse_x = 0;
 /// The previous mouse Y position, if a mouse button was down, to help with detecting mouse drags.
 static int g_previous_mouse_y = 0;
 
-/// True if the scene has changed; used to allow only re-rendering scenes if a scene changes when ray tracing is used for a feasible frame rate.
-static bool g_scene_changed = false;
+/// True if the scene has changed; used to allow only re-rendering scenes if a scene changes, for a feasible frame rate
+/// when ray tracing and to avoid needlessly using the CPU when rasterizing.  Initially true so that the first frame is rendered.
+static bool g_scene_changed = true;
+/// True if object transforms are the only changes to the scene (including the camera and settings) since it was last rendered.
+/// The binning rasterizer then only re-renders where moved objects were and now are.
+static bool g_only_object_transforms_changed = false;
+/// True if the window must be redrawn even though nothing changed (such as after being uncovered).
+static bool g_window_needs_redraw = true;
 
 /// The main window callback procedure for processing messages sent to the main application window.
 /// @param[in]  window - Handle to the window.
@@ -58,10 +77,10 @@ LRESULT CALLBACK MainWindowCallback(
     if (im_gui_context)
     {
         ImGuiIO& io = ImGui::GetIO();
+        // Any changes made through the GUI are reported by the GUI itself.
         bool gui_capturing_input = (io.WantCaptureMouse || io.WantCaptureKeyboard);
         if (gui_capturing_input)
         {
-            g_scene_changed = true;
             return true;
         }
     }
@@ -73,7 +92,12 @@ LRESULT CALLBACK MainWindowCallback(
         case WM_CREATE:
             break;
         case WM_SIZE:
+        {
+            // The scene must be re-rendered to fit the new size.
+            g_scene_changed = true;
+            g_only_object_transforms_changed = false;
             break;
+        }
         case WM_DESTROY:
             break;
         case WM_CLOSE:
@@ -110,98 +134,20 @@ LRESULT CALLBACK MainWindowCallback(
         case WM_MOUSEMOVE:
         {
             // ROTATE THE CAMERA IN RESPONSE TO MOUSE DRAGS.
+            // Mice can send these messages far more often than frames are rendered, so drags are only
+            // queued here and the camera is rotated once per frame.
             if (g_mouse_down)
             {
-                // TRACK THE SCENE AS HAVING CHANGED BASED ON USER INPUT.
-                g_scene_changed = true;
-
                 /// @todo DragDetect? - https://docs.microsoft.com/en-us/windows/win32/learnwin32/other-mouse-operations
 
                 // GET THE CURRENT MOUSE COORDINATES.
                 int mouse_x_position_in_window_pixels = GET_X_LPARAM(l_param);
                 int mouse_y_position_in_window_pixels = GET_Y_LPARAM(l_param);
 
-                // COMPUTE THE DRAG DISTANCE.
+                // QUEUE THE DRAG.
                 int mouse_x_drag_distance_in_pixels = (mouse_x_position_in_window_pixels - g_previous_mouse_x);
                 int mouse_y_drag_distance_in_pixels = (mouse_y_position_in_window_pixels - g_previous_mouse_y);
-
-                int max_2d_drag_distance = std::max(mouse_x_drag_distance_in_pixels, mouse_y_drag_distance_in_pixels);
-
-                /// @todo   This z drag amount is somewhat arbitrary and could use more refinement.
-                int z_drag_amount = max_2d_drag_distance - (mouse_y_drag_distance_in_pixels - mouse_x_drag_distance_in_pixels);
-                MATH::Vector2i mouse_drag(mouse_x_drag_distance_in_pixels, mouse_y_drag_distance_in_pixels);
-                int mouse_drag_distance_in_pixels = mouse_drag.Length();
-                std::stringstream mouse_drag_debug_text;
-                mouse_drag_debug_text
-                    << "Mouse drag:"
-                    << "\tX =  " << mouse_x_drag_distance_in_pixels
-                    << "\tY = " << mouse_y_drag_distance_in_pixels
-                    << "\tZ = " << z_drag_amount
-                    << "\tDistance = " << mouse_drag_distance_in_pixels
-                    << std::endl;
-                OutputDebugString(mouse_drag_debug_text.str().c_str());
-
-                // COMPUTE THE CAMERA ROTATION AMOUNT.
-                constexpr float X_ROTATION_AMOUNT_IN_DEGREES_PER_PIXEL = 5.0f;
-                // Note - negation is important for intuitive behavior.
-                MATH::Angle<float>::Degrees x_rotation_amount_in_degrees(X_ROTATION_AMOUNT_IN_DEGREES_PER_PIXEL * -mouse_x_drag_distance_in_pixels);
-                constexpr float Y_ROTATION_AMOUNT_IN_DEGREES_PER_PIXEL = 2.0f;
-                MATH::Angle<float>::Degrees y_rotation_amount_in_degrees(Y_ROTATION_AMOUNT_IN_DEGREES_PER_PIXEL * -mouse_y_drag_distance_in_pixels);
-
-                constexpr float Z_ROTATION_AMOUNT_IN_DEGREES_PER_PIXEL = 2.0f;
-                /// @todo   Z-rotation could use more refinement.  Maybe just need coordinate system conversion first?
-                MATH::Angle<float>::Degrees z_rotation_amount_in_degrees(Z_ROTATION_AMOUNT_IN_DEGREES_PER_PIXEL * z_drag_amount);
-
-                MATH::Angle<float>::Radians x_rotation_amount_in_radians = MATH::Angle<float>::DegreesToRadians(x_rotation_amount_in_degrees);
-                MATH::Angle<float>::Radians y_rotation_amount_in_radians = MATH::Angle<float>::DegreesToRadians(y_rotation_amount_in_degrees);
-                MATH::Angle<float>::Radians z_rotation_amount_in_radians = MATH::Angle<float>::DegreesToRadians(z_rotation_amount_in_degrees);
-                MATH::Vector3<MATH::Angle<float>::Radians> rotation_angles_in_radians(
-                    x_rotation_amount_in_radians,
-                    y_rotation_amount_in_radians,
-                    z_rotation_amount_in_radians);
-                
-                MATH::Matrix4x4f camera_y_rotation_matrix = MATH::Matrix4x4f::Identity();
-                MATH::Matrix4x4f camera_x_rotation_matrix = MATH::Matrix4x4f::Identity();
-                MATH::Matrix4x4f camera_z_rotation_matrix = MATH::Matrix4x4f::Identity();
-
-                /// @todo   Z-rotation with too little dragging is distracting.  Probably a better way to dampen this.
-                constexpr int Z_THRESHOLD = 30;
-                if (std::abs(z_drag_amount) <= Z_THRESHOLD)
-                {
-                    camera_y_rotation_matrix = MATH::Matrix4x4f::RotateY(x_rotation_amount_in_radians);
-                    camera_x_rotation_matrix = MATH::Matrix4x4f::RotateX(y_rotation_amount_in_radians);
-                }
-                if (std::abs(z_drag_amount) > Z_THRESHOLD * 10)
-                {
-                    camera_z_rotation_matrix = MATH::Matrix4x4f::RotateZ(z_rotation_amount_in_radians);
-                }
-                /// @todo   Note - this is bogus, so separate rotation operations are needed.
-                //MATH::Matrix4x4f camera_rotation_matrix = MATH::Matrix4x4f::Rotation(rotation_angles_in_radians);
-
-                MATH::Matrix4x4f camera_rotation_matrix = camera_y_rotation_matrix * camera_x_rotation_matrix * camera_z_rotation_matrix;
-
-                // ROTATE THE CAMERA.
-                MATH::Vector4f original_camera_position = MATH::Vector4f::HomogeneousPositionVector(g_camera.WorldPosition);
-                MATH::Vector4f new_camera_position_homogeneous = camera_rotation_matrix * original_camera_position;
-                MATH::Vector3f new_camera_position(
-                    new_camera_position_homogeneous.X,
-                    new_camera_position_homogeneous.Y,
-                    new_camera_position_homogeneous.Z);
-
-                g_camera.WorldPosition = new_camera_position;
-                /// @todo   Cleaner way to preserve/recompute camera settings!
-                MATH::Vector3f camera_view_direction = MATH::Vector3f(0.0f, 0.0f, 0.0f) - g_camera.WorldPosition;
-                MATH::Vector3f normalized_camera_view_direction = MATH::Vector3f::Normalize(camera_view_direction);
-                MATH::Vector3f negative_camera_view_direction = MATH::Vector3f::Scale(-1.0f, normalized_camera_view_direction);
-                MATH::Vector4f homogeneous_up = MATH::Vector4f::HomogeneousPositionVector(g_camera.CoordinateFrame.Up);
-                MATH::Vector4f homogeneous_transformed_up = camera_rotation_matrix * homogeneous_up;
-                MATH::Vector3f transformed_up(homogeneous_transformed_up.X, homogeneous_transformed_up.Y, homogeneous_transformed_up.Z);
-                g_camera.CoordinateFrame = MATH::CoordinateFrame::FromUpAndForward(transformed_up, negative_camera_view_direction);
-
-                /// @todo   How to preserve prior settings?
-                g_camera.Projection = GRAPHICS::VIEWING::ProjectionType::PERSPECTIVE;
-                g_camera.NearClipPlaneViewDistance = 1.0f;
-                g_camera.FarClipPlaneViewDistance = 1000.0f;
+                g_camera_input_queue.AddMouseDrag(mouse_x_drag_distance_in_pixels, mouse_y_drag_distance_in_pixels);
 
                 // STORE THE PREVIOUS MOUSE COORDINATES THAT HAVE BEEN DRAGGED.
                 g_previous_mouse_x = mouse_x_position_in_window_pixels;
@@ -212,26 +158,16 @@ LRESULT CALLBACK MainWindowCallback(
         }
         case WM_MOUSEWHEEL:
         {
-            // TRACK THE SCENE AS HAVING CHANGED BASED ON USER INPUT.
-            g_scene_changed = true;
-
-            // COMPUTE HOW MUCH ZOOMING SHOULD OCCUR.
-            constexpr float WHEEL_ROTATIONS_PER_ACTION = 120.0f;
+            // QUEUE ZOOMING THE CAMERA.
             short wheel_rotations_delta = GET_WHEEL_DELTA_WPARAM(w_param);
-            float zoom_units = static_cast<float>(wheel_rotations_delta) / WHEEL_ROTATIONS_PER_ACTION;
-
-            // Rotating the mouse wheel forward results in a positive value, but that should be considered as "zooming in".
-            // Since the negative z-axis is "forward" (zooming in), the zoom distance must be negated.
-            constexpr float Z_AXIS_IN_OPPOSITE_DIRECTION_FROM_WHEEL_ROTATION = -1.0f;
-            constexpr float ZOOM_DISTANCE_PER_WHEEL_ROTATION = 1.0f;
-            float signed_zoom_distance = Z_AXIS_IN_OPPOSITE_DIRECTION_FROM_WHEEL_ROTATION * ZOOM_DISTANCE_PER_WHEEL_ROTATION * zoom_units;
-            MATH::Vector3f zoom_movement_vector = MATH::Vector3f::Scale(signed_zoom_distance, g_camera.CoordinateFrame.Forward);
-
-            // ZOOM IN THE CAMERA.
-            g_camera.WorldPosition += zoom_movement_vector;
+            g_camera_input_queue.AddMouseWheelRotation(wheel_rotations_delta);
+            break;
         }
         case WM_PAINT:
         {
+            // The window's contents may have been lost (such as by being covered), so it must be redrawn.
+            g_window_needs_redraw = true;
+
             PAINTSTRUCT paint;
             BeginPaint(window, &paint);
             EndPaint(window, &paint);
@@ -259,9 +195,30 @@ int CALLBACK WinMain(
 {
     // REFERENCE UNUSED PARAMETERS TO PREVENT COMPILER WARNINGS.
     previous_application_instance;
-    command_line_string;
     window_show_code;
 
+    // HANDLE COMMAND LINE OPTIONS.
+    // --trace [filepath] starts recording a trace immediately, which is written when the application exits.
+    std::istringstream command_line(command_line_string);
+    std::string command_line_argument;
+    while (command_line >> std::quoted(command_line_argument))
+    {
+        if ("--trace" == command_line_argument)
+        {
+            // USE ANY CUSTOM TRACE FILEPATH.
+            command_line >> std::ws;
+            bool trace_filepath_specified = !command_line.eof() && ('-' != command_line.peek());
+            if (trace_filepath_specified)
+            {
+                std::string trace_filepath;
+                command_line >> std::quoted(trace_filepath);
+                PROFILING::TraceRecorder::OutputFilepath = trace_filepath;
+            }
+
+            PROFILING::TraceRecorder::Start();
+        }
+    }
+
     // DEFINE PARAMETERS FOR THE WINDOW TO BE CREATED.
     // The structure is zeroed-out initially since it isn't necessary to set all fields.
     WNDCLASSEX window_class = {};
@@ -302,158 +259,73 @@ int CALLBACK WinMain(
     std::optional<GUI::Gui> gui = GUI::Gui::Create(*graphics_device, *g_window);
     assert(gui);
 
-    // CREATE A TEST MODEL.
-    std::optional<GRAPHICS::Object3D> current_object = GRAPHICS::Object3D();
-
-    std::shared_ptr<GRAPHICS::Material> test_material = std::make_shared<GRAPHICS::Material>();
-    test_material->Shading = GRAPHICS::SHADING::ShadingType::MATERIAL;
-    test_material->DiffuseProperties.Color = GRAPHICS::Color::WHITE;
-    test_material->DiffuseProperties.Texture = GRAPHICS::IMAGES::Bitmap::LoadPng("D:/temp/assets/test_texture.png", GRAPHICS::ColorFormat::RGBA);
-
-    GRAPHICS::Mesh test_mesh;
-    test_mesh.Name = "test_mesh";
-#if SINGLE_TRIANGLE
-    GRAPHICS::Triangle triangle;
-    triangle.Vertices =
-    {
-        GRAPHICS::VertexWithAttributes
-        {
-            .Position = MATH::Vector3f(0.0f, 1.0f, 0.0f),
-            .Color = GRAPHICS::Color::WHITE,
-            .TextureCoordinates = MATH::Vector2f(0.0f, 0.0f),
-        },
-        GRAPHICS::VertexWithAttributes
-        {
-            .Position = MATH::Vector3f(-1.0f, -1.0f, 0.0f) ,
-            .Color = GRAPHICS::Color::WHITE,
-            .TextureCoordinates = MATH::Vector2f(1.0f, 0.0f),
-        },
-        GRAPHICS::VertexWithAttributes
-        {
-            .Position = MATH::Vector3f(1.0f, -1.0f, 0.0f),
-            .Color = GRAPHICS::Color::WHITE,
-            .TextureCoordinates = MATH::Vector2f(0.0f, 1.0f),
-        },
-    };
-    triangle.Material = test_material;
-    test_mesh.Triangles.push_back(triangle);
-#else
-    GRAPHICS::GEOMETRY::Triangle triangle;
-#if 1
-    triangle.Vertices =
-    {
-        GRAPHICS::VertexWithAttributes
-        {
-            .Position = MATH::Vector3f(0.0f, 1.0f, 0.0f),
-            .Color = GRAPHICS::Color::WHITE,
-            //.Color = GRAPHICS::Color::RED,
-            .TextureCoordinates = MATH::Vector2f(0.0f, 0.0f), // red
-        },
-        GRAPHICS::VertexWithAttributes
-        {
-            .Position = MATH::Vector3f(0.0f, -1.0f, 0.0f),
-            .Color = GRAPHICS::Color::WHITE,
-            //.Color = GRAPHICS::Color(1.0f, 1.0f, 0.0f, 1.0f),
-            //.TextureCoordinates = MATH::Vector2f(1.0f, 1.0f), // this and one below are swapped; yellow
-            .TextureCoordinates = MATH::Vector2f(0.0f, 1.0f),
-        },
-        GRAPHICS::VertexWithAttributes
-        {
-            .Position = MATH::Vector3f(1.0f, -1.0f, 0.0f),
-            .Color = GRAPHICS::Color::WHITE,
-            //.Color = GRAPHICS::Color::BLUE,
-            //.TextureCoordinates = MATH::Vector2f(0.0f, 1.0f), // this and one above are swapped; blue
-            .TextureCoordinates = MATH::Vector2f(1.0f, 1.0f),
-        },
-    };
-    triangle.Material = test_material;
-    test_mesh.Triangles.push_back(triangle);
-#endif
-
-#if 1
-    triangle.Vertices =
-    {
-        GRAPHICS::VertexWithAttributes
-        {
-            .Position = MATH::Vector3f(1.0f, -1.0f, 0.0f),
-            .Color = GRAPHICS::Color::WHITE,
-            .TextureCoordinates = MATH::Vector2f(1.0f, 1.0f),
-        },
-        GRAPHICS::VertexWithAttributes
-        {
-            .Position = MATH::Vector3f(1.0f, 1.0f, 0.0f),
-            .Color = GRAPHICS::Color::WHITE,
-            .TextureCoordinates = MATH::Vector2f(1.0f, 0.0f),
-        },
-        GRAPHICS::VertexWithAttributes
-        {
-            .Position = MATH::Vector3f(0.0f, 1.0f, 0.0f),
-            .Color = GRAPHICS::Color::WHITE,
-            .TextureCoordinates = MATH::Vector2f(0.0f, 0.0f),
-        },
-    };
-    triangle.Material = test_material;
-    test_mesh.Triangles.push_back(triangle);
-#endif
-#endif
-
-    current_object->Model.MeshesByName["test_mesh"] = test_mesh;
-
-    graphics_device->Load(*current_object);
+    // Objects are loaded into the graphics device as they're added to the scene.
+    RENDERING::DeviceResourceManager device_resources;
 
     // INITIALIZE THE CAMERA.
-    g_camera = GRAPHICS::VIEWING::Camera::LookAtFrom(MATH::Vector3f(0.0f, 0.0f, 0.0f), MATH::Vector3f(0.0f, 5.0f, 20.0f));
-    g_camera.Projection = GRAPHICS::VIEWING::ProjectionType::PERSPECTIVE;
-    g_camera.NearClipPlaneViewDistance = 1.0f;
-    g_camera.FarClipPlaneViewDistance = 1000.0f;
-
-    // INITIALIZE THE SCENE.
-    GRAPHICS::Scene test_scene;
-    test_scene.BackgroundColor = GRAPHICS::Color::BLACK;
-    // Some lights are needed for most kinds of rendering.
-    test_scene.Lights = std::vector<GRAPHICS::SHADING::LIGHTING::Light>();
-    test_scene.Lights.emplace_back(
-        GRAPHICS::SHADING::LIGHTING::Light
-        {
-            .Type = GRAPHICS::SHADING::LIGHTING::LightType::POINT,
-            .Color = GRAPHICS::Color(1.0f, 1.0f, 1.0f, 1.0f),
-            .PointLightWorldPosition = MATH::Vector3f(0.0f, 0.0f, 5.0f)
-        });
+    g_camera = SCENES::TestScenes::CreateDefaultCamera();
 
-    test_scene.Objects.emplace_back(*current_object);
+    // INITIALIZE THE SCENE WITH A TEST MODEL.
+    // The scene owns all objects, so they're moved in rather than copied.
+    GRAPHICS::Scene test_scene = SCENES::TestScenes::CreateLitScene();
+    test_scene.Objects.emplace_back(SCENES::TestScenes::CreateTexturedQuad("D:/temp/assets/test_texture.png"));
 
     // ADD SOME SPHERES FOR RAY TRACING.
 #if SPHERES
-    GRAPHICS::Object3D spheres;
-    GRAPHICS::GEOMETRY::Sphere red_sphere;
-    red_sphere.CenterPosition = MATH::Vector3f(0.0f, -1.0f, -3.0f);
-    red_sphere.Radius = 1.0f;
-    red_sphere.Material = std::make_shared<GRAPHICS::Material>();
-    red_sphere.Material->DiffuseProperties.Color = GRAPHICS::Color::RED;
-    spheres.Spheres.emplace_back(red_sphere);
-
-    GRAPHICS::GEOMETRY::Sphere blue_sphere;
-    blue_sphere.CenterPosition = MATH::Vector3f(2.0f, 0.0f, -4.0f);
-    blue_sphere.Radius = 1.0f;
-    blue_sphere.Material = std::make_shared<GRAPHICS::Material>();
-    blue_sphere.Material->DiffuseProperties.Color = GRAPHICS::Color::BLUE;
-    spheres.Spheres.emplace_back(blue_sphere);
-
-    GRAPHICS::GEOMETRY::Sphere green_sphere;
-    green_sphere.CenterPosition = MATH::Vector3f(-2.0f, 0.0f, -4.0f);
-    green_sphere.Radius = 1.0f;
-    green_sphere.Material = std::make_shared<GRAPHICS::Material>();
-    green_sphere.Material->DiffuseProperties.Color = GRAPHICS::Color::GREEN;
-    spheres.Spheres.emplace_back(green_sphere);
-
-    test_scene.Objects.emplace_back(spheres);
+    test_scene.Objects.emplace_back(SCENES::TestScenes::CreateSpheres());
 #endif
 
+    // CREATE THE THREADS FOR CPU RENDERING.
+    THREADING::WorkStealingThreadPool thread_pool(g_cpu_rendering_settings.ThreadCount);
+    RENDERING::RAY_TRACING::TiledRayTracer ray_tracer;
+    RENDERING::RASTERIZATION::BinningRasterizer rasterizer;
+    // The graphics library's rasterizer doesn't cull objects itself, so objects outside the view are hidden from it.
+    RENDERING::ObjectFrustumCuller object_culler;
+
+    // PREPARE TO LOAD MODELS IN THE BACKGROUND.
+    // Loading large models can take a long time, so it is done without blocking rendering.
+    ASSETS::AsyncModelLoader model_loader;
+    // True if the model being loaded should replace the objects in the scene; false if it should be added to them.
+    bool loaded_model_replaces_scene = false;
+    // The indexed mesh prepared for CPU rendering while loading the most recent model, kept until the model
+    // is first rendered so that CPU renderers find it in the object mesh cache rather than building it again.
+    std::shared_ptr<const RENDERING::IndexedMesh> loaded_model_mesh = nullptr;
+
     // RUN A MESSAGE LOOP.
+    // To avoid using the CPU while nothing is happening, frames are only updated while there is activity
+    // (input, scene changes, loading, or progressive refinement) and for a few frames afterward,
+    // since the GUI can take a few frames to settle after input (such as for hover highlights to update).
+    constexpr unsigned int SETTLING_FRAME_COUNT = 3;
+    unsigned int frames_since_activity = 0;
+    std::size_t previous_frame_start_heap_allocation_count = MEMORY::HeapAllocationCounter::AllocationCount();
     bool running = true;
     while (running)
     {
+        // FREE TRANSIENT MEMORY FROM THE PREVIOUS FRAME.
+        thread_pool.ResetWorkerArenas();
+
+        // FREE ANY ABANDONED MODEL LOADS THAT HAVE FINISHED.
+        // This is done even while idle so that memory from a cancelled load is freed once its thread stops.
+        model_loader.Poll();
+
+        // WAIT FOR INPUT IF IDLE.
+        // The wait has a timeout just to be robust to any activity that doesn't arrive as window messages.
+        bool idle = (frames_since_activity > SETTLING_FRAME_COUNT);
+        if (idle)
+        {
+            constexpr DWORD NO_HANDLES_TO_WAIT_ON = 0;
+            constexpr BOOL WAIT_FOR_ANY = FALSE;
+            constexpr DWORD IDLE_TIMEOUT_IN_MILLISECONDS = 100;
+            MsgWaitForMultipleObjects(NO_HANDLES_TO_WAIT_ON, NULL, WAIT_FOR_ANY, IDLE_TIMEOUT_IN_MILLISECONDS, QS_ALLINPUT);
+        }
+
+        // START PROFILING THE FRAME.
+        // Idle iterations that end early are discarded since the next frame reuses the same slot.
+        PROFILING::Profiler::BeginFrame();
+
         // PROCESS ANY MESSAGES FOR THE APPLICATION WINDOW.
+        std::size_t message_processing_scope = PROFILING::Profiler::BeginScope("Process Messages");
+        bool any_messages_received = false;
         MSG message;
         auto message_received = [&]()
         {
@@ -470,6 +342,8 @@ int CALLBACK WinMain(
         };
         while (message_received())
         {
+            any_messages_received = true;
+
             // STOP RUNNING THE APPLICATION IF THE USER DECIDED TO QUIT.
             if (message.message == WM_QUIT)
             {
@@ -487,30 +361,231 @@ int CALLBACK WinMain(
             // Nothing value could be done with it besides logging, so it is ignored.
             DispatchMessage(&message);
         }
+        PROFILING::Profiler::EndScope(message_processing_scope);
+
+        // MOVE THE CAMERA BASED ON ALL INPUT SINCE THE PREVIOUS FRAME.
+        INPUT::CameraInput camera_input = g_camera_input_queue.TakeInput();
+        if (camera_input.MovesCamera())
+        {
+            camera_input.ApplyTo(g_camera);
+            g_scene_changed = true;
+            g_only_object_transforms_changed = false;
+        }
+
+        // SKIP UPDATING THE FRAME IF NOTHING IS HAPPENING.
+        bool progressive_render_ongoing = (
+            GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RAY_TRACER == graphics_device->Type() &&
+            g_cpu_rendering_settings.ProgressiveRayTracing &&
+            !ray_tracer.ProgressiveRenderComplete());
+        bool activity_occurred = (
+            any_messages_received ||
+            g_scene_changed ||
+            g_window_needs_redraw ||
+            model_loader.IsLoading() ||
+            progressive_render_ongoing);
+        frames_since_activity = activity_occurred ? 0 : frames_since_activity + 1;
+        idle = (frames_since_activity > SETTLING_FRAME_COUNT);
+        if (idle || !running)
+        {
+            continue;
+        }
+
+        // COUNT HEAP ALLOCATIONS FROM THE PREVIOUS FRAME.
+        // Allocations from any idle iterations in between are included since they're part of getting to this frame.
+        std::size_t frame_start_heap_allocation_count = MEMORY::HeapAllocationCounter::AllocationCount();
+        gui->HeapAllocationCountLastFrame = frame_start_heap_allocation_count - previous_frame_start_heap_allocation_count;
+        previous_frame_start_heap_allocation_count = frame_start_heap_allocation_count;
+
+        // UPDATE THE NUMBER OF RENDERING THREADS IF THE USER CHANGED IT.
+        thread_pool.Resize(g_cpu_rendering_settings.ThreadCount);
+
+        // LOAD ANY NEW OR CHANGED OBJECTS INTO THE GRAPHICS DEVICE.
+        std::size_t device_resources_scope = PROFILING::Profiler::BeginScope("Update Device Resources");
+        device_resources.Update(test_scene, *graphics_device);
+        PROFILING::Profiler::EndScope(device_resources_scope);
 
         // RENDER THE TEST SCENE.
-        // For a more reasonable frame rate when using ray tracing, re-rendering is only done if the scene has changed.
+        // For a more reasonable frame rate when using CPU rendering, re-rendering is only done if the scene has changed.
+        // Ray tracing and binning rasterization are split into screen tiles spread across all cores.
+        // Hardware graphics devices re-render everything each frame since they redraw the GUI along with the scene.
+        std::size_t render_scope = PROFILING::Profiler::BeginScope("Render Scene");
+        bool scene_rendered = false;
         if (graphics_device->Type() == GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RAY_TRACER)
+        {
+            GRAPHICS::CPU_RENDERING::CpuGraphicsDevice& cpu_graphics_device = dynamic_cast<GRAPHICS::CPU_RENDERING::CpuGraphicsDevice&>(*graphics_device);
+            if (g_cpu_rendering_settings.ProgressiveRayTracing)
+            {
+                // START A NEW PROGRESSIVE FRAME IF ANYTHING CHANGED.
+                // Any partially refined frame is thrown away so that the display keeps up with user input.
+                bool restart_progressive_render = g_scene_changed || ray_tracer.ProgressiveRenderNeedsRestart(cpu_graphics_device.ColorBuffer);
+                if (restart_progressive_render)
+                {
+                    ray_tracer.StartProgressiveRender(test_scene, g_camera, g_rendering_settings, g_cpu_rendering_settings, cpu_graphics_device.ColorBuffer);
+                }
+
+                // REFINE THE FRAME A BIT MORE IF IT ISN'T COMPLETE.
+                if (!ray_tracer.ProgressiveRenderComplete())
+                {
+                    ray_tracer.ContinueProgressiveRender(
+                        test_scene,
+                        g_rendering_settings,
+                        g_cpu_rendering_settings,
+                        thread_pool,
+                        cpu_graphics_device.ColorBuffer);
+                    scene_rendered = true;
+                }
+            }
+            else if (g_scene_changed)
+            {
+                ray_tracer.Render(
+                    test_scene,
+                    g_camera,
+                    g_rendering_settings,
+                    g_cpu_rendering_settings,
+                    thread_pool,
+                    cpu_graphics_device.ColorBuffer);
+                scene_rendered = true;
+            }
+        }
+        else if (g_cpu_rendering_settings.BinningRasterization && graphics_device->Type() == GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RASTERIZER)
+        {
+            if (g_scene_changed)
+            {
+                // ERASE THE GUI IF ONLY PART OF THE SCENE MAY BE RE-RENDERED.
+                // The rest of the color buffer is kept, so it must only hold the scene.
+                GRAPHICS::CPU_RENDERING::CpuGraphicsDevice& cpu_graphics_device = dynamic_cast<GRAPHICS::CPU_RENDERING::CpuGraphicsDevice&>(*graphics_device);
+                if (g_only_object_transforms_changed)
+                {
+                    gui->EraseSoftwareGui(cpu_graphics_device.ColorBuffer);
+                }
+
+                rasterizer.Render(
+                    test_scene,
+                    g_camera,
+                    g_rendering_settings,
+                    g_cpu_rendering_settings,
+                    g_only_object_transforms_changed,
+                    thread_pool,
+                    cpu_graphics_device.ColorBuffer);
+                scene_rendered = true;
+            }
+        }
+        else if (graphics_device->Type() == GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RASTERIZER)
         {
             if (g_scene_changed)
             {
+                GRAPHICS::CPU_RENDERING::CpuGraphicsDevice& cpu_graphics_device = dynamic_cast<GRAPHICS::CPU_RENDERING::CpuGraphicsDevice&>(*graphics_device);
+                object_culler.HideObjectsOutsideFrustum(
+                    test_scene,
+                    g_camera,
+                    cpu_graphics_device.ColorBuffer.GetWidthInPixels(),
+                    cpu_graphics_device.ColorBuffer.GetHeightInPixels(),
+                    g_cpu_rendering_settings.FrustumCulling);
                 graphics_device->Render(test_scene, g_camera, g_rendering_settings);
+                object_culler.ShowHiddenObjects();
+                scene_rendered = true;
             }
         }
         else
         {
             graphics_device->Render(test_scene, g_camera, g_rendering_settings);
+            scene_rendered = true;
         }
+        PROFILING::Profiler::EndScope(render_scope);
         // The scene has no longer changed since last beeing rendered.
         g_scene_changed = false;
+        g_only_object_transforms_changed = false;
+        // Any CPU renderer that needed the loaded model's mesh now holds its own reference to it.
+        loaded_model_mesh = nullptr;
+
+        // FREE GEOMETRY HELD BY CPU RENDERERS NOT IN USE.
+        // Their indexed meshes would otherwise stay in memory for as long as other renderers are used.
+        bool ray_tracer_in_use = (graphics_device->Type() == GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RAY_TRACER);
+        bool binning_rasterizer_in_use = g_cpu_rendering_settings.BinningRasterization && (graphics_device->Type() == GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RASTERIZER);
+        if (!ray_tracer_in_use)
+        {
+            ray_tracer.Scene.Release();
+        }
+        if (!binning_rasterizer_in_use)
+        {
+            rasterizer.Release();
+        }
+
+        // DISPLAY HOW MUCH GEOMETRY CPU RENDERING CULLED.
+        if (graphics_device->Type() == GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RAY_TRACER)
+        {
+            gui->RendererSettingsWindow.CullingStatistics = ray_tracer.Scene.Statistics;
+        }
+        else if (g_cpu_rendering_settings.BinningRasterization && graphics_device->Type() == GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RASTERIZER)
+        {
+            gui->RendererSettingsWindow.CullingStatistics = rasterizer.Statistics;
+        }
+        else if (graphics_device->Type() == GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RASTERIZER)
+        {
+            gui->RendererSettingsWindow.CullingStatistics = object_culler.Statistics;
+        }
+        else
+        {
+            gui->RendererSettingsWindow.CullingStatistics = {};
+        }
 
         // UPDATE AND RENDER THE GUI.
         GRAPHICS::HARDWARE::GraphicsDeviceType old_graphics_device_type = g_rendering_settings.GraphicsDeviceType;
-        gui->UpdateAndRender(*graphics_device, test_scene, g_camera, g_rendering_settings);
+        std::size_t gui_scope = PROFILING::Profiler::BeginScope("Update GUI");
+        gui->UpdateAndRender(*graphics_device, scene_rendered, test_scene, g_camera, g_rendering_settings, g_cpu_rendering_settings, model_loader);
+        PROFILING::Profiler::EndScope(gui_scope);
         GRAPHICS::HARDWARE::GraphicsDeviceType new_graphics_device_type = g_rendering_settings.GraphicsDeviceType;
 
+        // TRACK ANY CHANGES MADE THROUGH THE GUI.
+        // They are rendered in the next frame.  Moving objects is tracked separately since it only changes part of the screen.
+        g_only_object_transforms_changed =
+            !g_scene_changed &&
+            gui->SceneWindow.OnlyTransformsChanged &&
+            !gui->CameraWindow.CameraChanged &&
+            !gui->RendererSettingsWindow.SettingsChanged;
+        g_scene_changed |= (
+            gui->SceneWindow.SceneChanged ||
+            gui->CameraWindow.CameraChanged ||
+            gui->RendererSettingsWindow.SettingsChanged);
+
+        // START LOADING ANY NEWLY REQUESTED MODEL.
+        // Any model already being loaded is abandoned in favor of the newer request.
+        // The indexed mesh is only built along with the model for the CPU renderers that use it;
+        // they build it themselves if switched to later.
+        bool loaded_model_mesh_needed =
+            (GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RAY_TRACER == new_graphics_device_type) ||
+            (g_cpu_rendering_settings.BinningRasterization && GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RASTERIZER == new_graphics_device_type);
+        if (!gui->SelectedFilepath.empty())
+        {
+            model_loader.Start(gui->SelectedFilepath, loaded_model_mesh_needed);
+            loaded_model_replaces_scene = true;
+        }
+        else if (!gui->SceneWindow.ModelFilepathToLoad.empty())
+        {
+            model_loader.Start(gui->SceneWindow.ModelFilepathToLoad, loaded_model_mesh_needed);
+            loaded_model_replaces_scene = false;
+        }
+
+        // REBUILD RENDERING RESOURCES IF THE SCENE'S GEOMETRY WAS EDITED.
+        // Changes to object transforms are detected by the ray tracer itself and only need cheap refitting.
+        if (gui->SceneWindow.GeometryChanged)
+        {
+            ray_tracer.Scene.Invalidate();
+            rasterizer.Invalidate();
+            object_culler.Invalidate();
+            device_resources.Invalidate();
+        }
+
         // DISPLAY THE RENDERED FRAME IN THE WINDOW.
+        std::size_t display_scope = PROFILING::Profiler::BeginScope("Display Frame");
         graphics_device->DisplayRenderedImage(*g_window);
+        PROFILING::Profiler::EndScope(display_scope);
+        // Displaying the frame is as close as this can measure to when the user sees the response to their input.
+        if (camera_input.EarliestEventTime)
+        {
+            PROFILING::Profiler::RecordInputLatency(*camera_input.EarliestEventTime);
+        }
+        g_window_needs_redraw = false;
 
         // SWITCH TYPES OF GRAPHICS DEVICES IF APPLICABLE.
         bool graphics_device_type_changed = (old_graphics_device_type != new_graphics_device_type);
@@ -520,41 +595,57 @@ int CALLBACK WinMain(
             graphics_device->Shutdown();
 
             // CREATE THE NEW TYPE OF GRAPHICS DEVICE.
+            // Objects are loaded into it before the next frame is rendered.
             graphics_device = GRAPHICS::HARDWARE::IGraphicsDevice::Create(new_graphics_device_type, *g_window);
+            device_resources.DeviceReplaced();
 
-            // LOAD OBJECTS INTO THE NEW GRAPHICS DEVICE.
-            for (GRAPHICS::Object3D& object : test_scene.Objects)
-            {
-                graphics_device->Load(object);
-            }
-
-            // RE-INITIALIZE THE GUI.
-            gui = GUI::Gui::Create(*graphics_device, *g_window);
+            // SWITCH THE GUI TO THE NEW GRAPHICS DEVICE.
+            // GUI state and the camera are kept so that switching devices doesn't lose the user's view.
+            bool gui_device_changed = gui->ChangeGraphicsDevice(old_graphics_device_type, *graphics_device);
+            assert(gui_device_changed);
 
-            /// @todo   Better way to preserve camera settings!
-            g_camera = GRAPHICS::VIEWING::Camera::LookAtFrom(MATH::Vector3f(0.0f, 0.0f, 0.0f), MATH::Vector3f(0.0f, 5.0f, 20.0f));
-            g_camera.Projection = GRAPHICS::VIEWING::ProjectionType::PERSPECTIVE;
-            g_camera.NearClipPlaneViewDistance = 1.0f;
-            g_camera.FarClipPlaneViewDistance = 1000.0f;
+            // The new graphics device hasn't rendered anything yet.
+            g_scene_changed = true;
+            g_only_object_transforms_changed = false;
         }
 
-        // LOAD A NEW MODEL IF APPLICABLE.
-        if (!gui->SelectedFilepath.empty())
+        // ADD ANY NEWLY LOADED MODEL TO THE SCENE.
+        std::optional<ASSETS::LoadedModel> loaded_model = model_loader.TakeLoadedModel();
+        if (loaded_model && loaded_model->Model)
         {
-            std::optional<GRAPHICS::MODELING::Model> current_model = GRAPHICS::MODELING::WavefrontObjectModel::Load(gui->SelectedFilepath);
+            PROFILING::TraceScope add_model_scope("Add Loaded Model", "Model Loading");
 
-            if (current_model)
+            // Any old scene is cleared first so that its memory can be reused for the new model.
+            if (loaded_model_replaces_scene)
             {
-                current_object = GRAPHICS::Object3D();
-                current_object->Model = *current_model;
-                graphics_device->Load(*current_object);
-
                 test_scene.Objects.clear();
-                test_scene.Objects.emplace_back(*current_object);
-            }            
+            }
+
+            // The loaded model is moved directly into the scene since a copy of a large model could take
+            // seconds and temporarily need as much memory again.
+            GRAPHICS::Object3D& loaded_object = test_scene.Objects.emplace_back();
+            loaded_object.Model = std::move(*loaded_model->Model);
+            loaded_model_mesh = std::move(loaded_model->Mesh);
+
+            // The new model must be rendered, and any CPU rendering geometry for the old scene is no longer valid.
+            ray_tracer.Scene.Invalidate();
+            rasterizer.Invalidate();
+            object_culler.Invalidate();
+            g_scene_changed = true;
+            g_only_object_transforms_changed = false;
         }
+
+        // FINISH PROFILING THE FRAME.
+        PROFILING::Profiler::EndFrame();
     }
 
+    // ABANDON ANY MODEL STILL BEING LOADED.
+    // Cancelling asks the loading thread to stop early, and the loader waits for it to finish when destroyed.
+    model_loader.Cancel();
+
+    // FINISH ANY TRACE BEING RECORDED.
+    PROFILING::TraceRecorder::Stop();
+
     // SHUTDOWN SUBSYSTEMS.
     if (gui)
     {
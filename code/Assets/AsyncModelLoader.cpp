@@ -0,0 +1,189 @@
+#include <thread>
+#include "Assets/AsyncModelLoader.h"
+#include "Assets/BinaryModelCache.h"
+#include "Profiling/TraceRecorder.h"
+#include "Rendering/ObjectMeshCache.h"
+
+namespace ASSETS
+{
+    /// Constructor.
+    /// @param[in]  load_function - The function for loading models on the background thread.
+    AsyncModelLoader::AsyncModelLoader(LoadFunction load_function) :
+        Load(load_function)
+    {}
+
+    /// Destructor.  Cancels any load in progress and waits for all loading threads to finish.
+    /// Loaders poll for cancellation, so this usually only waits briefly, but loaders that can't be
+    /// interrupted (like the graphics library's parser) are waited on until they finish.
+    AsyncModelLoader::~AsyncModelLoader()
+    {
+        Cancel();
+        for (LoadThread& load_thread : LoadThreads)
+        {
+            load_thread.Thread.join();
+        }
+    }
+
+    /// Loads a model, the default way of loading models.
+    /// Models are loaded from their binary cache if possible, which also reports finer progress.
+    /// @param[in]  filepath - The path of the model to load.
+    /// @param[in,out]  progress - The progress to update.
+    /// @return The loaded model, if successful; null otherwise.
+    std::optional<GRAPHICS::MODELING::Model> AsyncModelLoader::LoadModel(const std::filesystem::path& filepath, LoadProgress& progress)
+    {
+        return BinaryModelCache::LoadModel(filepath, progress);
+    }
+
+    /// Starts loading a model in the background, abandoning any load already in progress.
+    /// @param[in]  filepath - The path of the model to load.
+    /// @param[in]  mesh_needed - True to also build the indexed mesh used by the CPU ray tracer and binning rasterizer;
+    ///     false if neither is in use, since the mesh would only take up memory.
+    void AsyncModelLoader::Start(const std::filesystem::path& filepath, const bool mesh_needed)
+    {
+        // ABANDON ANY PREVIOUS LOAD.
+        Cancel();
+        Poll();
+
+        // START THE NEW LOAD.
+        std::shared_ptr<PendingLoad> pending_load = std::make_shared<PendingLoad>();
+        pending_load->Filepath = filepath;
+        pending_load->StartTime = std::chrono::steady_clock::now();
+
+        // The thread holds its own reference to the shared state so that abandoning a load never has to wait for it.
+        // It's only joined once finished (or when the loader is destroyed).
+        std::promise<LoadedModel> result_promise;
+        pending_load->Result = result_promise.get_future();
+        LoadThread& load_thread = LoadThreads.emplace_back();
+        load_thread.Load = pending_load;
+        load_thread.Thread = std::thread(
+            [load = Load, pending_load, mesh_needed, result_promise = std::move(result_promise)]() mutable
+            {
+                {
+                    PROFILING::TraceScope load_scope("Load Model", "Model Loading");
+                    LoadedModel loaded_model;
+                    loaded_model.Filepath = pending_load->Filepath;
+                    try
+                    {
+                        loaded_model.Model = load(pending_load->Filepath, pending_load->Progress);
+
+                        // The indexed mesh for CPU rendering is prepared here too so that rendering doesn't have to.
+                        // It's shared by all CPU renderers through the cache.  Levels of detail aren't generated here
+                        // since only the binning rasterizer uses them, which generates them itself once it renders the model.
+                        bool mesh_built = mesh_needed && loaded_model.Model && !pending_load->Progress.CancelRequested;
+                        if (mesh_built)
+                        {
+                            loaded_model.Mesh = RENDERING::ObjectMeshCache::FindOrBuild(*loaded_model.Model);
+                        }
+                    }
+                    catch (...)
+                    {
+                        // Failures are reported like any other failed load.
+                        loaded_model.Model = std::nullopt;
+                        loaded_model.Mesh = nullptr;
+                    }
+                    result_promise.set_value(std::move(loaded_model));
+                }
+
+                // The thread is only marked finished after everything else it does, including ending the trace scope.
+                pending_load->ThreadFinished.store(true, std::memory_order_release);
+            });
+
+        CurrentLoad = pending_load;
+    }
+
+    /// Cancels any load in progress.  This returns immediately; the loading thread stops on its own.
+    void AsyncModelLoader::Cancel()
+    {
+        if (CurrentLoad)
+        {
+            CurrentLoad->Progress.CancelRequested = true;
+            CurrentLoad = nullptr;
+        }
+    }
+
+    /// Takes the result of the current load if it has finished.
+    /// @return The loaded model (which may indicate failure), if the load finished; null if no load finished.
+    std::optional<LoadedModel> AsyncModelLoader::TakeLoadedModel()
+    {
+        // CHECK IF THE LOAD HAS FINISHED.
+        if (!CurrentLoad)
+        {
+            return std::nullopt;
+        }
+        constexpr std::chrono::seconds NO_WAITING(0);
+        bool load_finished = (std::future_status::ready == CurrentLoad->Result.wait_for(NO_WAITING));
+        if (!load_finished)
+        {
+            return std::nullopt;
+        }
+
+        // HAND OFF THE LOADED MODEL.
+        LoadedModel loaded_model = CurrentLoad->Result.get();
+        CurrentLoad = nullptr;
+        Poll();
+        return loaded_model;
+    }
+
+    /// Joins any loading threads that have finished, without waiting for any still running.
+    /// The state of abandoned loads is freed along with their threads, including any model they finished loading,
+    /// so memory used by a cancelled load is released soon after its thread stops rather than at the next load.
+    void AsyncModelLoader::Poll()
+    {
+        for (auto load_thread = LoadThreads.begin(); load_thread != LoadThreads.end();)
+        {
+            bool thread_finished = load_thread->Load->ThreadFinished.load(std::memory_order_acquire);
+            if (thread_finished)
+            {
+                load_thread->Thread.join();
+                load_thread = LoadThreads.erase(load_thread);
+            }
+            else
+            {
+                ++load_thread;
+            }
+        }
+    }
+
+    /// Determines if a load is in progress (or finished but not yet taken).
+    /// @return True if a load is in progress; false if not.
+    bool AsyncModelLoader::IsLoading() const
+    {
+        return (nullptr != CurrentLoad);
+    }
+
+    /// Gets the path of the model currently being loaded.
+    /// @return The path being loaded; empty if no load is in progress.
+    std::filesystem::path AsyncModelLoader::CurrentFilepath() const
+    {
+        if (!CurrentLoad)
+        {
+            return "";
+        }
+
+        return CurrentLoad->Filepath;
+    }
+
+    /// Gets the proportion of the current load that has completed.
+    /// @return The completed proportion in [0, 1]; negative if unknown or if no load is in progress.
+    float AsyncModelLoader::CompletedProportion() const
+    {
+        if (!CurrentLoad)
+        {
+            return -1.0f;
+        }
+
+        return CurrentLoad->Progress.CompletedProportion;
+    }
+
+    /// Gets the time the current load has been running.
+    /// @return The elapsed time; zero if no load is in progress.
+    std::chrono::duration<float> AsyncModelLoader::ElapsedTime() const
+    {
+        if (!CurrentLoad)
+        {
+            return std::chrono::duration<float>::zero();
+        }
+
+        return std::chrono::steady_clock::now() - CurrentLoad->StartTime;
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "Assets/LoadProgress.h"
+#include "Graphics/Modeling/Model.h"
+#include "Rendering/IndexedMesh.h"
+
+/// Holds code for loading and managing assets used by the viewer.
+namespace ASSETS
+{
+    /// A model that finished loading in the background.
+    struct LoadedModel
+    {
+        /// The path the model was loaded from.
+        std::filesystem::path Filepath = "";
+        /// The model, if loading succeeded.
+        std::optional<GRAPHICS::MODELING::Model> Model = std::nullopt;
+        /// The indexed mesh of the model's visible triangles for CPU rendering, built while loading (see RENDERING::ObjectMeshCache).
+        /// It's only referenced from here, so it must be kept until the model is first rendered for CPU renderers to find it.
+        /// Null if no CPU renderer using it was in use when the load started.
+        std::shared_ptr<const RENDERING::IndexedMesh> Mesh = nullptr;
+    };
+
+    /// Loads models on a background thread so that the main thread can keep rendering and
+    /// responding to input while large files are parsed.
+    ///
+    /// Only a single load is tracked at a time.  Starting a new load or cancelling abandons any current one;
+    /// an abandoned load's thread is asked to stop and its result is simply discarded, which means
+    /// cancelling never blocks the main thread even if the loader can't be interrupted.
+    /// Abandoned threads are joined (and their results freed) by the first Poll() after they finish, so Poll() should
+    /// be called regularly, such as once per frame.  The destructor waits for any still running, so no loading thread
+    /// outlives the loader (and touches the program's statics as they're destroyed).
+    class AsyncModelLoader
+    {
+    public:
+        /// The type of function for loading a model on the background thread.
+        /// It should update the progress if it can and may stop early (returning null) if cancellation is requested.
+        using LoadFunction = std::function<std::optional<GRAPHICS::MODELING::Model>(const std::filesystem::path& filepath, LoadProgress& progress)>;
+
+        // CONSTRUCTION/DESTRUCTION.
+        explicit AsyncModelLoader(LoadFunction load_function = LoadModel);
+        ~AsyncModelLoader();
+        AsyncModelLoader(const AsyncModelLoader&) = delete;
+        AsyncModelLoader& operator=(const AsyncModelLoader&) = delete;
+
+        // LOADING.
+        static std::optional<GRAPHICS::MODELING::Model> LoadModel(const std::filesystem::path& filepath, LoadProgress& progress);
+        void Start(const std::filesystem::path& filepath, const bool mesh_needed);
+        void Cancel();
+        std::optional<LoadedModel> TakeLoadedModel();
+        void Poll();
+
+        // STATUS.
+        bool IsLoading() const;
+        std::filesystem::path CurrentFilepath() const;
+        float CompletedProportion() const;
+        std::chrono::duration<float> ElapsedTime() const;
+
+    private:
+        /// State for a single load, shared with its background thread so that it remains valid
+        /// even if the load is abandoned before the thread finishes.
+        struct PendingLoad
+        {
+            /// The path being loaded from.
+            std::filesystem::path Filepath = "";
+            /// The time the load started.
+            std::chrono::steady_clock::time_point StartTime = {};
+            /// The progress of the load.
+            LoadProgress Progress = {};
+            /// The result of the load, once finished.
+            std::future<LoadedModel> Result = {};
+            /// True once the loading thread has finished all of its work and is about to exit.
+            std::atomic<bool> ThreadFinished = false;
+        };
+
+        /// A thread running a load, which may have been abandoned.
+        struct LoadThread
+        {
+            /// The load the thread is running.
+            std::shared_ptr<PendingLoad> Load = nullptr;
+            /// The thread.
+            std::thread Thread = {};
+        };
+
+        // PRIVATE MEMBER VARIABLES.
+        /// The function for loading models.
+        LoadFunction Load = {};
+        /// The current load, if any.
+        std::shared_ptr<PendingLoad> CurrentLoad = nullptr;
+        /// The threads for the current load and any abandoned loads that haven't been joined yet.
+        /// Each keeps its load's state alive (including any result) until the thread is joined.
+        std::vector<LoadThread> LoadThreads = {};
+    };
+}
@@ -0,0 +1,941 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+#include "Assets/BinaryModelCache.h"
+#include "Assets/MemoryMappedFile.h"
+#include "Assets/TextureCache.h"
+#include "Assets/WavefrontObjectParser.h"
+#include "Graphics/Modeling/WavefrontObjectModel.h"
+#include "Profiling/TraceRecorder.h"
+#include "Rendering/IndexedMesh.h"
+#include "Rendering/UniqueVertexTable.h"
+
+namespace ASSETS
+{
+    /// The bytes at the start of every cache file, to quickly reject files that aren't caches.
+    constexpr std::array<char, 8> CACHE_FILE_MAGIC = { '3', 'D', 'M', 'V', 'M', 'O', 'D', 'L' };
+    /// The extension appended to model filepaths to get their cache filepaths.
+    constexpr char CACHE_FILE_EXTENSION[] = ".3dmvcache";
+    /// The index used to indicate that a material has no texture.
+    constexpr uint32_t NO_INDEX = UINT32_MAX;
+    /// The alignment of all data in cache files, allowing arrays to be used directly from mapped memory.
+    constexpr std::size_t CACHE_DATA_ALIGNMENT_IN_BYTES = 4;
+
+    /// The header at the start of each cache file.
+    struct CacheFileHeader
+    {
+        /// Always CACHE_FILE_MAGIC.
+        std::array<char, 8> Magic = {};
+        /// The version of the format the file was written in.
+        uint32_t FormatVersion = 0;
+        /// The size of the source model's filepath string following the header.
+        uint32_t SourceFilepathSizeInBytes = 0;
+        /// The size of the source model file when the cache was written.
+        uint64_t SourceFileSizeInBytes = 0;
+        /// The last write time of the source model file when the cache was written.
+        int64_t SourceLastWriteTime = 0;
+        /// The number of textures in the texture table.
+        uint32_t TextureCount = 0;
+        /// The number of materials in the material table.
+        uint32_t MaterialCount = 0;
+        /// The number of meshes.
+        uint32_t MeshCount = 0;
+        /// The number of files referenced by the source model (material libraries and textures) following the source filepath.
+        uint32_t ReferencedFileCount = 0;
+    };
+
+    /// The version of a file referenced by the source model when the cache was written, followed by the file's path.
+    struct CachedReferencedFile
+    {
+        /// The size of the file's path following this structure.
+        uint32_t FilepathSizeInBytes = 0;
+        /// 1 if the file existed; 0 if not, in which case its size and last write time are 0.
+        uint32_t Exists = 0;
+        /// The size of the file.
+        uint64_t FileSizeInBytes = 0;
+        /// The last write time of the file.
+        int64_t LastWriteTime = 0;
+    };
+
+    /// The header for each texture, followed by its pixels in row-major order as 8-bit RGBA values.
+    struct CachedTextureHeader
+    {
+        /// The width of the texture.
+        uint32_t WidthInPixels = 0;
+        /// The height of the texture.
+        uint32_t HeightInPixels = 0;
+    };
+
+    /// A material, followed by its name.
+    struct CachedMaterial
+    {
+        /// The size of the material's name following this structure.
+        uint32_t NameSizeInBytes = 0;
+        /// The type of shading for the material.
+        uint32_t Shading = 0;
+        /// The ambient color as RGBA components.
+        std::array<float, 4> AmbientColor = {};
+        /// The diffuse color as RGBA components.
+        std::array<float, 4> DiffuseColor = {};
+        /// The specular color as RGBA components.
+        std::array<float, 4> SpecularColor = {};
+        /// The specular power.
+        float SpecularPower = 0.0f;
+        /// The reflectivity proportion.
+        float ReflectivityProportion = 0.0f;
+        /// The emissive color as RGBA components.
+        std::array<float, 4> EmissiveColor = {};
+        /// The index of the diffuse texture; NO_INDEX if there is none.
+        uint32_t DiffuseTextureIndex = NO_INDEX;
+    };
+
+    /// The header for each mesh, followed by its key in the model, its name, an array for each vertex attribute,
+    /// triangle vertex indices, and material ranges (with IDs indexing the cache's material table).
+    struct CachedMeshHeader
+    {
+        /// The size of the key for the mesh in the model.
+        uint32_t KeySizeInBytes = 0;
+        /// The size of the mesh's name.
+        uint32_t NameSizeInBytes = 0;
+        /// 1 if the mesh is visible; 0 if not.
+        uint32_t Visible = 0;
+        /// The number of unique vertices in the mesh.
+        uint32_t VertexCount = 0;
+        /// The number of triangles in the mesh.
+        uint32_t TriangleCount = 0;
+        /// The number of material ranges in the mesh.
+        uint32_t MaterialRangeCount = 0;
+    };
+
+    // Vertex attribute arrays are written and read directly, which requires their types to be tightly packed.
+    static_assert(sizeof(MATH::Vector3f) == 3 * sizeof(float));
+    static_assert(sizeof(MATH::Vector2f) == 2 * sizeof(float));
+    static_assert(sizeof(GRAPHICS::Color) == 4 * sizeof(float));
+    static_assert(sizeof(RENDERING::MaterialRange) == 3 * sizeof(uint32_t));
+
+    /// Packs a color into an array of components.
+    /// @param[in]  color - The color to pack.
+    /// @return The RGBA components of the color.
+    static std::array<float, 4> PackColor(const GRAPHICS::Color& color)
+    {
+        return { color.Red, color.Green, color.Blue, color.Alpha };
+    }
+
+    /// Unpacks a color from an array of components.
+    /// @param[in]  components - The RGBA components of the color.
+    /// @return The color.
+    static GRAPHICS::Color UnpackColor(const std::array<float, 4>& components)
+    {
+        return GRAPHICS::Color(components[0], components[1], components[2], components[3]);
+    }
+
+    /// Converts a color component to 8 bits.
+    /// @param[in]  component - The component in [0, 1].
+    /// @return The component in [0, 255].
+    static uint32_t ComponentTo8Bits(const float component)
+    {
+        constexpr float MAX_8_BIT_COMPONENT = 255.0f;
+        float clamped_component = std::clamp(component, 0.0f, 1.0f);
+        return static_cast<uint32_t>(std::lround(clamped_component * MAX_8_BIT_COMPONENT));
+    }
+
+    /// Gets the identifying information about the current version of a source file, such as a model or a texture it references.
+    /// @param[in]  model_filepath - The path of the source file.
+    /// @param[out] file_size_in_bytes - The size of the file.
+    /// @param[out] last_write_time - The last write time of the file.
+    /// @return True if the information could be retrieved; false otherwise.
+    static bool GetSourceFileVersion(const std::filesystem::path& model_filepath, uint64_t& file_size_in_bytes, int64_t& last_write_time)
+    {
+        std::error_code error;
+        file_size_in_bytes = static_cast<uint64_t>(std::filesystem::file_size(model_filepath, error));
+        if (error)
+        {
+            return false;
+        }
+        last_write_time = static_cast<int64_t>(std::filesystem::last_write_time(model_filepath, error).time_since_epoch().count());
+        if (error)
+        {
+            return false;
+        }
+        return true;
+    }
+
+    /// Sequentially reads data from a memory-mapped cache file, ensuring nothing is read past the end.
+    class CacheFileReader
+    {
+    public:
+        /// Constructor.
+        /// @param[in]  file - The file to read.
+        explicit CacheFileReader(const MemoryMappedFile& file) :
+            File(file)
+        {}
+
+        /// Gets the proportion of the file that has been read.
+        /// @return The proportion of the file that has been read, in [0, 1].
+        float ReadProportion() const
+        {
+            return static_cast<float>(static_cast<double>(OffsetInBytes) / static_cast<double>(File.SizeInBytes));
+        }
+
+        /// Reads a single value.
+        /// @param[out] value - The value read.
+        /// @return True if the value was read; false if there was not enough data.
+        template <typename ValueType>
+        bool Read(ValueType& value)
+        {
+            // The value is copied out since it may be more strictly aligned than data in the file.
+            const uint8_t* data = ReadBytes(sizeof(ValueType));
+            if (!data)
+            {
+                return false;
+            }
+            std::memcpy(&value, data, sizeof(ValueType));
+            return true;
+        }
+
+        /// Reads an array of values without copying them.
+        /// @param[in]  count - The number of values to read.
+        /// @return The values within the mapped file; null if there was not enough data.
+        template <typename ValueType>
+        const ValueType* ReadArray(const std::size_t count)
+        {
+            static_assert(alignof(ValueType) <= CACHE_DATA_ALIGNMENT_IN_BYTES);
+            // Corrupt counts could otherwise overflow the size computation.
+            std::size_t max_count = File.SizeInBytes / sizeof(ValueType);
+            if (count > max_count)
+            {
+                return nullptr;
+            }
+            const uint8_t* data = ReadBytes(count * sizeof(ValueType));
+            return reinterpret_cast<const ValueType*>(data);
+        }
+
+        /// Reads a string.
+        /// @param[in]  size_in_bytes - The size of the string.
+        /// @return A view of the string within the mapped file; null if there was not enough data.
+        std::optional<std::string_view> ReadString(const std::size_t size_in_bytes)
+        {
+            const uint8_t* data = ReadBytes(size_in_bytes);
+            if (!data)
+            {
+                return std::nullopt;
+            }
+            return std::string_view(reinterpret_cast<const char*>(data), size_in_bytes);
+        }
+
+    private:
+        /// Reads bytes, advancing to the next aligned offset after them.
+        /// @param[in]  size_in_bytes - The number of bytes to read.
+        /// @return The bytes; null if there was not enough data.
+        const uint8_t* ReadBytes(const std::size_t size_in_bytes)
+        {
+            std::size_t remaining_size_in_bytes = File.SizeInBytes - OffsetInBytes;
+            if (size_in_bytes > remaining_size_in_bytes)
+            {
+                return nullptr;
+            }
+
+            const uint8_t* data = File.Data + OffsetInBytes;
+            std::size_t aligned_size_in_bytes = (size_in_bytes + CACHE_DATA_ALIGNMENT_IN_BYTES - 1) & ~(CACHE_DATA_ALIGNMENT_IN_BYTES - 1);
+            OffsetInBytes = std::min(OffsetInBytes + aligned_size_in_bytes, File.SizeInBytes);
+            return data;
+        }
+
+        /// The file being read.
+        const MemoryMappedFile& File;
+        /// The offset of the next data to read.
+        std::size_t OffsetInBytes = 0;
+    };
+
+    /// Sequentially writes data to a cache file, keeping it aligned.
+    class CacheFileWriter
+    {
+    public:
+        /// Constructor.
+        /// @param[in,out]  file - The file to write to.
+        explicit CacheFileWriter(std::ofstream& file) :
+            File(file)
+        {}
+
+        /// Writes a single value.
+        /// @param[in]  value - The value to write.
+        template <typename ValueType>
+        void Write(const ValueType& value)
+        {
+            WriteArray(&value, 1);
+        }
+
+        /// Writes an array of values.
+        /// @param[in]  values - The values to write.
+        /// @param[in]  count - The number of values to write.
+        template <typename ValueType>
+        void WriteArray(const ValueType* values, const std::size_t count)
+        {
+            WriteBytes(values, count * sizeof(ValueType));
+        }
+
+        /// Writes a string (without any null terminator).
+        /// @param[in]  string - The string to write.
+        void WriteString(const std::string& string)
+        {
+            WriteBytes(string.data(), string.size());
+        }
+
+    private:
+        /// Writes bytes, followed by padding up to the next aligned offset.
+        /// @param[in]  data - The bytes to write.
+        /// @param[in]  size_in_bytes - The number of bytes to write.
+        void WriteBytes(const void* data, const std::size_t size_in_bytes)
+        {
+            File.write(static_cast<const char*>(data), static_cast<std::streamsize>(size_in_bytes));
+
+            constexpr std::array<char, CACHE_DATA_ALIGNMENT_IN_BYTES> PADDING = {};
+            std::size_t padding_size_in_bytes = (CACHE_DATA_ALIGNMENT_IN_BYTES - (size_in_bytes % CACHE_DATA_ALIGNMENT_IN_BYTES)) % CACHE_DATA_ALIGNMENT_IN_BYTES;
+            File.write(PADDING.data(), static_cast<std::streamsize>(padding_size_in_bytes));
+        }
+
+        /// The file being written.
+        std::ofstream& File;
+    };
+
+    /// The number of values buffered at a time when writing arrays built on the fly.
+    constexpr std::size_t WRITE_BUFFER_VALUE_COUNT = 64 * 1024;
+
+    /// Writes an array of one attribute of each unique vertex.
+    /// Values are gathered into a small buffer at a time so that the whole array is never in memory at once.
+    /// Attribute sizes are multiples of the cache's alignment, so writing the array in pieces doesn't add any padding.
+    /// @param[in,out]  writer - The writer for the cache file.
+    /// @param[in]  unique_vertices - The unique vertices to write the attribute of.
+    /// @param[in]  attribute - The attribute of vertices to write.
+    template <typename AttributeType>
+    static void WriteVertexAttributes(
+        CacheFileWriter& writer,
+        const RENDERING::UniqueVertexTable& unique_vertices,
+        AttributeType GRAPHICS::VertexWithAttributes::* attribute)
+    {
+        static_assert(0 == sizeof(AttributeType) % CACHE_DATA_ALIGNMENT_IN_BYTES);
+
+        std::vector<AttributeType> attribute_values;
+        attribute_values.reserve(WRITE_BUFFER_VALUE_COUNT);
+        for (uint32_t vertex_index = 0; vertex_index < unique_vertices.VertexCount(); ++vertex_index)
+        {
+            attribute_values.emplace_back(unique_vertices.Vertex(vertex_index).*attribute);
+            if (attribute_values.size() >= WRITE_BUFFER_VALUE_COUNT)
+            {
+                writer.WriteArray(attribute_values.data(), attribute_values.size());
+                attribute_values.clear();
+            }
+        }
+        writer.WriteArray(attribute_values.data(), attribute_values.size());
+    }
+
+    /// Writes the unique vertex index of each triangle corner.
+    /// Indices are gathered into a small buffer at a time so that the whole array is never in memory at once.
+    /// @param[in,out]  writer - The writer for the cache file.
+    /// @param[in]  unique_vertices - The unique vertices, with all triangle corners already added.
+    /// @param[in]  corner_count - The number of triangle corners.
+    static void WriteVertexIndices(CacheFileWriter& writer, const RENDERING::UniqueVertexTable& unique_vertices, const uint32_t corner_count)
+    {
+        std::vector<uint32_t> vertex_indices;
+        vertex_indices.reserve(WRITE_BUFFER_VALUE_COUNT);
+        for (uint32_t corner_index = 0; corner_index < corner_count; ++corner_index)
+        {
+            vertex_indices.emplace_back(unique_vertices.Find(corner_index));
+            if (vertex_indices.size() >= WRITE_BUFFER_VALUE_COUNT)
+            {
+                writer.WriteArray(vertex_indices.data(), vertex_indices.size());
+                vertex_indices.clear();
+            }
+        }
+        writer.WriteArray(vertex_indices.data(), vertex_indices.size());
+    }
+
+    /// Copies an attribute of unique vertices from a cache file to each triangle corner referencing them.
+    /// Pages of the cache file are released once used, since keeping all of a huge cache file resident
+    /// alongside the model being built from it would otherwise set the peak memory of the load.
+    /// @param[in]  cache_file - The cache file being read.
+    /// @param[in]  vertex_indices - The unique vertex index of each triangle corner, in the cache file.
+    /// @param[in]  attribute_values - The attribute of each unique vertex, in the cache file.
+    /// @param[in]  vertex_count - The number of unique vertices.
+    /// @param[in]  attribute - The attribute of triangle vertices to copy to.
+    /// @param[in,out]  triangles - The triangles to copy the attribute to.
+    /// @return True if all vertex indices were valid; false otherwise.
+    template <typename AttributeType>
+    static bool ReadVertexAttributes(
+        const MemoryMappedFile& cache_file,
+        const uint32_t* vertex_indices,
+        const AttributeType* attribute_values,
+        const uint32_t vertex_count,
+        AttributeType GRAPHICS::VertexWithAttributes::* attribute,
+        std::vector<GRAPHICS::GEOMETRY::Triangle>& triangles)
+    {
+        // COPY THE ATTRIBUTE TO EACH TRIANGLE CORNER.
+        // Vertex indices are released in blocks as they're used.
+        constexpr std::size_t CORNERS_PER_RELEASE = std::size_t(1) << 20;
+        std::size_t corner_count = RENDERING::IndexedMesh::VERTICES_PER_TRIANGLE * triangles.size();
+        std::size_t vertex_indices_offset_in_bytes = static_cast<std::size_t>(reinterpret_cast<const uint8_t*>(vertex_indices) - cache_file.Data);
+        for (std::size_t first_corner_index = 0; first_corner_index < corner_count; first_corner_index += CORNERS_PER_RELEASE)
+        {
+            std::size_t end_corner_index = std::min(first_corner_index + CORNERS_PER_RELEASE, corner_count);
+            for (std::size_t corner_index = first_corner_index; corner_index < end_corner_index; ++corner_index)
+            {
+                uint32_t vertex_index = vertex_indices[corner_index];
+                if (vertex_index >= vertex_count)
+                {
+                    return false;
+                }
+
+                GRAPHICS::GEOMETRY::Triangle& triangle = triangles[corner_index / RENDERING::IndexedMesh::VERTICES_PER_TRIANGLE];
+                triangle.Vertices[corner_index % RENDERING::IndexedMesh::VERTICES_PER_TRIANGLE].*attribute = attribute_values[vertex_index];
+            }
+
+            cache_file.ReleasePages(
+                vertex_indices_offset_in_bytes + first_corner_index * sizeof(uint32_t),
+                (end_corner_index - first_corner_index) * sizeof(uint32_t));
+        }
+
+        // RELEASE THE ATTRIBUTE VALUES.
+        std::size_t attribute_values_offset_in_bytes = static_cast<std::size_t>(reinterpret_cast<const uint8_t*>(attribute_values) - cache_file.Data);
+        cache_file.ReleasePages(attribute_values_offset_in_bytes, vertex_count * sizeof(AttributeType));
+        return true;
+    }
+
+    /// Loads a model, using its cache if it is up-to-date and otherwise parsing the source file and updating the cache.
+    /// @param[in]  model_filepath - The path of the source model file.
+    /// @return The loaded model, if successful; null otherwise.
+    std::optional<GRAPHICS::MODELING::Model> BinaryModelCache::LoadModel(const std::filesystem::path& model_filepath)
+    {
+        LoadProgress unused_progress;
+        return LoadModel(model_filepath, unused_progress);
+    }
+
+    /// Loads a model, using its cache if it is up-to-date and otherwise parsing the source file and updating the cache.
+    /// @param[in]  model_filepath - The path of the source model file.
+    /// @param[in,out]  progress - The progress of the load.
+    /// @return The loaded model, if successful; null otherwise.
+    std::optional<GRAPHICS::MODELING::Model> BinaryModelCache::LoadModel(const std::filesystem::path& model_filepath, LoadProgress& progress)
+    {
+        // TRY LOADING FROM THE CACHE.
+        std::optional<GRAPHICS::MODELING::Model> model;
+        {
+            PROFILING::TraceScope read_cache_scope("Read Model Cache", "Model Loading");
+            model = Read(model_filepath, progress);
+        }
+        if (model || progress.CancelRequested)
+        {
+            return model;
+        }
+
+        // FALL BACK TO PARSING THE SOURCE FILE.
+        // The fast parser handles the common subset of the format, but the graphics library's parser
+        // is still needed for anything else.  That parser can't report its progress.
+        progress.CompletedProportion = 0.0f;
+        {
+            PROFILING::TraceScope parse_scope("Parse Model", "Model Loading");
+            model = WavefrontObjectParser::Load(model_filepath, progress);
+        }
+        if (progress.CancelRequested)
+        {
+            return std::nullopt;
+        }
+        if (!model)
+        {
+            progress.CompletedProportion = -1.0f;
+            PROFILING::TraceScope library_parse_scope("Parse Model With Library", "Model Loading");
+            model = GRAPHICS::MODELING::WavefrontObjectModel::Load(model_filepath);
+        }
+        if (!model)
+        {
+            return std::nullopt;
+        }
+
+        // SHARE TEXTURES WITH OTHER MATERIALS AND MODELS.
+        // The parser decodes a texture for each material referencing it, so duplicates are only freed here.
+        // This also keeps duplicates out of the model's cache file.
+        TextureCache::ShareTextures(*model);
+
+        // CACHE THE MODEL FOR NEXT TIME.
+        // Failing to write the cache (such as for read-only folders) isn't an error since the model was still loaded.
+        if (!progress.CancelRequested)
+        {
+            PROFILING::TraceScope write_cache_scope("Write Model Cache", "Model Loading");
+            Write(model_filepath, *model);
+        }
+
+        progress.CompletedProportion = 1.0f;
+        return model;
+    }
+
+    /// Gets the path of the cache file for a model.
+    /// @param[in]  model_filepath - The path of the source model file.
+    /// @return The path of the cache file, which is next to the source file.
+    std::filesystem::path BinaryModelCache::CacheFilepath(const std::filesystem::path& model_filepath)
+    {
+        std::filesystem::path cache_filepath = model_filepath;
+        cache_filepath += CACHE_FILE_EXTENSION;
+        return cache_filepath;
+    }
+
+    /// Reads a model from its cache file.
+    /// @param[in]  model_filepath - The path of the source model file.
+    /// @param[in,out]  progress - The progress of the load.  Reading stops early if cancellation is requested.
+    /// @return The cached model, if an up-to-date cache was read; null otherwise.
+    std::optional<GRAPHICS::MODELING::Model> BinaryModelCache::Read(const std::filesystem::path& model_filepath, LoadProgress& progress)
+    {
+        // MAP THE CACHE FILE.
+        std::filesystem::path cache_filepath = CacheFilepath(model_filepath);
+        std::unique_ptr<MemoryMappedFile> cache_file = MemoryMappedFile::Open(cache_filepath);
+        if (!cache_file)
+        {
+            return std::nullopt;
+        }
+        CacheFileReader reader(*cache_file);
+
+        // MAKE SURE THE CACHE IS FOR THE CURRENT VERSION OF THE SOURCE FILE.
+        CacheFileHeader header;
+        bool header_read = reader.Read(header);
+        if (!header_read)
+        {
+            return std::nullopt;
+        }
+        bool current_format = (CACHE_FILE_MAGIC == header.Magic) && (FORMAT_VERSION == header.FormatVersion);
+        if (!current_format)
+        {
+            return std::nullopt;
+        }
+
+        uint64_t source_file_size_in_bytes = 0;
+        int64_t source_last_write_time = 0;
+        bool source_file_version_retrieved = GetSourceFileVersion(model_filepath, source_file_size_in_bytes, source_last_write_time);
+        if (!source_file_version_retrieved)
+        {
+            return std::nullopt;
+        }
+        bool source_file_unchanged = (source_file_size_in_bytes == header.SourceFileSizeInBytes) && (source_last_write_time == header.SourceLastWriteTime);
+        if (!source_file_unchanged)
+        {
+            return std::nullopt;
+        }
+
+        // The cache may have been copied along with a different source file of the same size and time.
+        std::optional<std::string_view> cached_source_filepath = reader.ReadString(header.SourceFilepathSizeInBytes);
+        std::string source_filepath = std::filesystem::absolute(model_filepath).generic_string();
+        bool cache_for_source_file = cached_source_filepath && (*cached_source_filepath == source_filepath);
+        if (!cache_for_source_file)
+        {
+            return std::nullopt;
+        }
+
+        // MAKE SURE THE FILES REFERENCED BY THE SOURCE FILE ARE UNCHANGED.
+        // Edited material libraries or textures would otherwise keep being loaded from the stale cache.
+        for (uint32_t referenced_file_index = 0; referenced_file_index < header.ReferencedFileCount; ++referenced_file_index)
+        {
+            CachedReferencedFile cached_referenced_file;
+            if (!reader.Read(cached_referenced_file))
+            {
+                return std::nullopt;
+            }
+            std::optional<std::string_view> referenced_filepath = reader.ReadString(cached_referenced_file.FilepathSizeInBytes);
+            if (!referenced_filepath)
+            {
+                return std::nullopt;
+            }
+
+            uint64_t file_size_in_bytes = 0;
+            int64_t last_write_time = 0;
+            bool referenced_file_exists = GetSourceFileVersion(std::filesystem::path(*referenced_filepath), file_size_in_bytes, last_write_time);
+            bool referenced_file_unchanged =
+                (static_cast<uint32_t>(referenced_file_exists) == cached_referenced_file.Exists) &&
+                (file_size_in_bytes == cached_referenced_file.FileSizeInBytes) &&
+                (last_write_time == cached_referenced_file.LastWriteTime);
+            if (!referenced_file_unchanged)
+            {
+                return std::nullopt;
+            }
+        }
+
+        // READ THE TEXTURES.
+        std::vector<std::shared_ptr<GRAPHICS::IMAGES::Bitmap>> textures;
+        textures.reserve(header.TextureCount);
+        for (uint32_t texture_index = 0; texture_index < header.TextureCount; ++texture_index)
+        {
+            CachedTextureHeader texture_header;
+            if (!reader.Read(texture_header))
+            {
+                return std::nullopt;
+            }
+
+            std::size_t pixel_count = static_cast<std::size_t>(texture_header.WidthInPixels) * texture_header.HeightInPixels;
+            const uint32_t* pixels = reader.ReadArray<uint32_t>(pixel_count);
+            if (!pixels)
+            {
+                return std::nullopt;
+            }
+
+            // The texture is only unpacked if an identical one isn't already cached, such as from another model.
+            uint64_t packed_pixels_hash = TextureCache::ComputeContentHash(texture_header.WidthInPixels, texture_header.HeightInPixels, pixels);
+            std::string texture_source_key = "packed-rgba:" + std::to_string(packed_pixels_hash);
+            std::shared_ptr<GRAPHICS::IMAGES::Bitmap> texture = TextureCache::FindOrCreate(texture_source_key, [&texture_header, pixels]()
+            {
+                std::shared_ptr<GRAPHICS::IMAGES::Bitmap> unpacked_texture = std::make_shared<GRAPHICS::IMAGES::Bitmap>(
+                    texture_header.WidthInPixels,
+                    texture_header.HeightInPixels,
+                    GRAPHICS::ColorFormat::RGBA);
+                constexpr float MAX_8_BIT_COMPONENT = 255.0f;
+                for (uint32_t y = 0; y < texture_header.HeightInPixels; ++y)
+                {
+                    for (uint32_t x = 0; x < texture_header.WidthInPixels; ++x)
+                    {
+                        uint32_t rgba = pixels[static_cast<std::size_t>(y) * texture_header.WidthInPixels + x];
+                        GRAPHICS::Color color(
+                            static_cast<float>((rgba >> 24) & 0xFF) / MAX_8_BIT_COMPONENT,
+                            static_cast<float>((rgba >> 16) & 0xFF) / MAX_8_BIT_COMPONENT,
+                            static_cast<float>((rgba >> 8) & 0xFF) / MAX_8_BIT_COMPONENT,
+                            static_cast<float>(rgba & 0xFF) / MAX_8_BIT_COMPONENT);
+                        unpacked_texture->WritePixel(x, y, color);
+                    }
+                }
+                return unpacked_texture;
+            });
+            textures.emplace_back(texture);
+        }
+
+        // READ THE MATERIALS.
+        std::vector<std::shared_ptr<GRAPHICS::Material>> materials;
+        materials.reserve(header.MaterialCount);
+        for (uint32_t material_index = 0; material_index < header.MaterialCount; ++material_index)
+        {
+            CachedMaterial cached_material;
+            if (!reader.Read(cached_material))
+            {
+                return std::nullopt;
+            }
+            std::optional<std::string_view> material_name = reader.ReadString(cached_material.NameSizeInBytes);
+            if (!material_name)
+            {
+                return std::nullopt;
+            }
+
+            std::shared_ptr<GRAPHICS::Material> material = std::make_shared<GRAPHICS::Material>();
+            material->Name = *material_name;
+            material->Shading = static_cast<GRAPHICS::SHADING::ShadingType>(cached_material.Shading);
+            material->AmbientProperties.Color = UnpackColor(cached_material.AmbientColor);
+            material->DiffuseProperties.Color = UnpackColor(cached_material.DiffuseColor);
+            if (cached_material.DiffuseTextureIndex < textures.size())
+            {
+                material->DiffuseProperties.Texture = textures[cached_material.DiffuseTextureIndex];
+            }
+            material->SpecularProperties.Color = UnpackColor(cached_material.SpecularColor);
+            material->SpecularProperties.SpecularPower = cached_material.SpecularPower;
+            material->ReflectivityProportion = cached_material.ReflectivityProportion;
+            material->EmissiveColor = UnpackColor(cached_material.EmissiveColor);
+            materials.emplace_back(material);
+        }
+
+        // READ THE MESHES.
+        GRAPHICS::MODELING::Model model;
+        for (uint32_t mesh_index = 0; mesh_index < header.MeshCount; ++mesh_index)
+        {
+            // STOP EARLY IF THE LOAD WAS CANCELLED.
+            if (progress.CancelRequested)
+            {
+                return std::nullopt;
+            }
+            progress.CompletedProportion = reader.ReadProportion();
+
+            // READ THE RAW MESH DATA.
+            CachedMeshHeader mesh_header;
+            if (!reader.Read(mesh_header))
+            {
+                return std::nullopt;
+            }
+            std::optional<std::string_view> mesh_key = reader.ReadString(mesh_header.KeySizeInBytes);
+            std::optional<std::string_view> mesh_name = reader.ReadString(mesh_header.NameSizeInBytes);
+            const MATH::Vector3f* positions = reader.ReadArray<MATH::Vector3f>(mesh_header.VertexCount);
+            const MATH::Vector3f* normals = reader.ReadArray<MATH::Vector3f>(mesh_header.VertexCount);
+            const MATH::Vector2f* texture_coordinates = reader.ReadArray<MATH::Vector2f>(mesh_header.VertexCount);
+            const GRAPHICS::Color* colors = reader.ReadArray<GRAPHICS::Color>(mesh_header.VertexCount);
+            const uint32_t* vertex_indices = reader.ReadArray<uint32_t>(RENDERING::IndexedMesh::VERTICES_PER_TRIANGLE * mesh_header.TriangleCount);
+            const RENDERING::MaterialRange* material_ranges = reader.ReadArray<RENDERING::MaterialRange>(mesh_header.MaterialRangeCount);
+            bool mesh_read = mesh_key && mesh_name && positions && normals && texture_coordinates && colors && vertex_indices && material_ranges;
+            if (!mesh_read)
+            {
+                return std::nullopt;
+            }
+
+            // BUILD THE MESH.
+            // Each attribute is copied in a separate pass so that only one attribute array of the cache file
+            // needs to be resident alongside the model at a time.
+            GRAPHICS::Mesh mesh;
+            mesh.Name = *mesh_name;
+            mesh.Visible = (0 != mesh_header.Visible);
+            mesh.Triangles.resize(mesh_header.TriangleCount);
+            bool vertices_read =
+                ReadVertexAttributes(*cache_file, vertex_indices, positions, mesh_header.VertexCount, &GRAPHICS::VertexWithAttributes::Position, mesh.Triangles) &&
+                ReadVertexAttributes(*cache_file, vertex_indices, normals, mesh_header.VertexCount, &GRAPHICS::VertexWithAttributes::Normal, mesh.Triangles) &&
+                ReadVertexAttributes(*cache_file, vertex_indices, texture_coordinates, mesh_header.VertexCount, &GRAPHICS::VertexWithAttributes::TextureCoordinates, mesh.Triangles) &&
+                ReadVertexAttributes(*cache_file, vertex_indices, colors, mesh_header.VertexCount, &GRAPHICS::VertexWithAttributes::Color, mesh.Triangles);
+            if (!vertices_read)
+            {
+                return std::nullopt;
+            }
+
+            // ASSIGN MATERIALS.
+            for (uint32_t range_index = 0; range_index < mesh_header.MaterialRangeCount; ++range_index)
+            {
+                const RENDERING::MaterialRange& material_range = material_ranges[range_index];
+                bool range_valid =
+                    (material_range.FirstTriangleIndex <= mesh_header.TriangleCount) &&
+                    (material_range.TriangleCount <= mesh_header.TriangleCount - material_range.FirstTriangleIndex);
+                if (!range_valid)
+                {
+                    return std::nullopt;
+                }
+                if (material_range.MaterialId >= materials.size())
+                {
+                    continue;
+                }
+
+                const std::shared_ptr<GRAPHICS::Material>& material = materials[material_range.MaterialId];
+                for (uint32_t triangle_index = material_range.FirstTriangleIndex; triangle_index < material_range.FirstTriangleIndex + material_range.TriangleCount; ++triangle_index)
+                {
+                    mesh.Triangles[triangle_index].Material = material;
+                }
+            }
+
+            model.MeshesByName[std::string(*mesh_key)] = std::move(mesh);
+        }
+
+        progress.CompletedProportion = 1.0f;
+        return model;
+    }
+
+    /// Writes a model to its cache file, replacing any existing cache.
+    /// @param[in]  model_filepath - The path of the source model file the model was loaded from.
+    /// @param[in]  model - The model to write.
+    /// @return True if the cache was written; false otherwise.
+    bool BinaryModelCache::Write(const std::filesystem::path& model_filepath, const GRAPHICS::MODELING::Model& model)
+    {
+        // IDENTIFY THE SOURCE FILE VERSION.
+        CacheFileHeader header;
+        header.Magic = CACHE_FILE_MAGIC;
+        header.FormatVersion = FORMAT_VERSION;
+        bool source_file_version_retrieved = GetSourceFileVersion(model_filepath, header.SourceFileSizeInBytes, header.SourceLastWriteTime);
+        if (!source_file_version_retrieved)
+        {
+            return false;
+        }
+        std::string source_filepath = std::filesystem::absolute(model_filepath).generic_string();
+        header.SourceFilepathSizeInBytes = static_cast<uint32_t>(source_filepath.size());
+
+        // IDENTIFY THE VERSIONS OF REFERENCED FILES.
+        // Missing files are recorded too, so that the cache is regenerated if they're added later.
+        std::vector<std::filesystem::path> referenced_filepaths = WavefrontObjectParser::FindReferencedFiles(model_filepath);
+        std::vector<CachedReferencedFile> cached_referenced_files(referenced_filepaths.size());
+        std::vector<std::string> referenced_filepath_strings(referenced_filepaths.size());
+        for (std::size_t referenced_file_index = 0; referenced_file_index < referenced_filepaths.size(); ++referenced_file_index)
+        {
+            CachedReferencedFile& cached_referenced_file = cached_referenced_files[referenced_file_index];
+            bool referenced_file_exists = GetSourceFileVersion(
+                referenced_filepaths[referenced_file_index],
+                cached_referenced_file.FileSizeInBytes,
+                cached_referenced_file.LastWriteTime);
+            if (!referenced_file_exists)
+            {
+                cached_referenced_file.FileSizeInBytes = 0;
+                cached_referenced_file.LastWriteTime = 0;
+            }
+            cached_referenced_file.Exists = static_cast<uint32_t>(referenced_file_exists);
+
+            std::string& referenced_filepath_string = referenced_filepath_strings[referenced_file_index];
+            referenced_filepath_string = std::filesystem::absolute(referenced_filepaths[referenced_file_index]).generic_string();
+            cached_referenced_file.FilepathSizeInBytes = static_cast<uint32_t>(referenced_filepath_string.size());
+        }
+        header.ReferencedFileCount = static_cast<uint32_t>(cached_referenced_files.size());
+
+        // BUILD THE MATERIAL AND TEXTURE TABLES.
+        // Triangles typically share a small number of materials, so each unique one only needs to be stored once.
+        std::vector<const GRAPHICS::Material*> materials;
+        std::unordered_map<const GRAPHICS::Material*, uint32_t> material_indices_by_pointer;
+        std::vector<const GRAPHICS::IMAGES::Bitmap*> textures;
+        std::unordered_map<const GRAPHICS::IMAGES::Bitmap*, uint32_t> texture_indices_by_pointer;
+        for (const auto& [mesh_name, mesh] : model.MeshesByName)
+        {
+            for (const GRAPHICS::GEOMETRY::Triangle& triangle : mesh.Triangles)
+            {
+                const GRAPHICS::Material* material = triangle.Material.get();
+                if (!material || material_indices_by_pointer.contains(material))
+                {
+                    continue;
+                }
+                material_indices_by_pointer[material] = static_cast<uint32_t>(materials.size());
+                materials.emplace_back(material);
+
+                const GRAPHICS::IMAGES::Bitmap* texture = material->DiffuseProperties.Texture.get();
+                if (!texture || texture_indices_by_pointer.contains(texture))
+                {
+                    continue;
+                }
+                texture_indices_by_pointer[texture] = static_cast<uint32_t>(textures.size());
+                textures.emplace_back(texture);
+            }
+        }
+        header.TextureCount = static_cast<uint32_t>(textures.size());
+        header.MaterialCount = static_cast<uint32_t>(materials.size());
+        header.MeshCount = static_cast<uint32_t>(model.MeshesByName.size());
+
+        // OPEN A TEMPORARY FILE.
+        // The cache is written to a temporary file first so that an interrupted write never leaves a partial cache behind.
+        std::filesystem::path cache_filepath = CacheFilepath(model_filepath);
+        std::filesystem::path temporary_cache_filepath = cache_filepath;
+        temporary_cache_filepath += ".tmp";
+        std::ofstream cache_file(temporary_cache_filepath, std::ios::binary | std::ios::trunc);
+        if (!cache_file)
+        {
+            return false;
+        }
+        CacheFileWriter writer(cache_file);
+
+        // WRITE THE HEADER.
+        writer.Write(header);
+        writer.WriteString(source_filepath);
+        for (std::size_t referenced_file_index = 0; referenced_file_index < cached_referenced_files.size(); ++referenced_file_index)
+        {
+            writer.Write(cached_referenced_files[referenced_file_index]);
+            writer.WriteString(referenced_filepath_strings[referenced_file_index]);
+        }
+
+        // WRITE THE TEXTURES.
+        std::vector<uint32_t> texture_pixels;
+        for (const GRAPHICS::IMAGES::Bitmap* texture : textures)
+        {
+            CachedTextureHeader texture_header;
+            texture_header.WidthInPixels = texture->GetWidthInPixels();
+            texture_header.HeightInPixels = texture->GetHeightInPixels();
+            writer.Write(texture_header);
+
+            texture_pixels.clear();
+            texture_pixels.reserve(static_cast<std::size_t>(texture_header.WidthInPixels) * texture_header.HeightInPixels);
+            for (uint32_t y = 0; y < texture_header.HeightInPixels; ++y)
+            {
+                for (uint32_t x = 0; x < texture_header.WidthInPixels; ++x)
+                {
+                    GRAPHICS::Color color = texture->GetPixel(x, y);
+                    uint32_t rgba =
+                        (ComponentTo8Bits(color.Red) << 24) |
+                        (ComponentTo8Bits(color.Green) << 16) |
+                        (ComponentTo8Bits(color.Blue) << 8) |
+                        ComponentTo8Bits(color.Alpha);
+                    texture_pixels.emplace_back(rgba);
+                }
+            }
+            writer.WriteArray(texture_pixels.data(), texture_pixels.size());
+        }
+
+        // WRITE THE MATERIALS.
+        for (const GRAPHICS::Material* material : materials)
+        {
+            CachedMaterial cached_material;
+            cached_material.NameSizeInBytes = static_cast<uint32_t>(material->Name.size());
+            cached_material.Shading = static_cast<uint32_t>(material->Shading);
+            cached_material.AmbientColor = PackColor(material->AmbientProperties.Color);
+            cached_material.DiffuseColor = PackColor(material->DiffuseProperties.Color);
+            cached_material.SpecularColor = PackColor(material->SpecularProperties.Color);
+            cached_material.SpecularPower = material->SpecularProperties.SpecularPower;
+            cached_material.ReflectivityProportion = material->ReflectivityProportion;
+            cached_material.EmissiveColor = PackColor(material->EmissiveColor);
+            const GRAPHICS::IMAGES::Bitmap* texture = material->DiffuseProperties.Texture.get();
+            if (texture)
+            {
+                cached_material.DiffuseTextureIndex = texture_indices_by_pointer[texture];
+            }
+            writer.Write(cached_material);
+            writer.WriteString(material->Name);
+        }
+
+        // WRITE THE MESHES.
+        // Meshes are indexed so that vertices shared between triangles are only stored once.
+        // Each array is written straight from the triangles, since building a full indexed copy of a mesh
+        // (like an IndexedMesh) alongside the model would otherwise set the peak memory of loading huge models.
+        std::vector<RENDERING::MaterialRange> material_ranges;
+        for (const auto& [mesh_name, mesh] : model.MeshesByName)
+        {
+            // FIND THE MESH'S UNIQUE VERTICES.
+            RENDERING::UniqueVertexTable unique_vertices(mesh.Triangles);
+            uint32_t corner_count = static_cast<uint32_t>(RENDERING::IndexedMesh::VERTICES_PER_TRIANGLE * mesh.Triangles.size());
+            for (uint32_t corner_index = 0; corner_index < corner_count; ++corner_index)
+            {
+                unique_vertices.FindOrAdd(corner_index);
+            }
+
+            // GROUP TRIANGLES BY MATERIAL.
+            material_ranges.clear();
+            for (uint32_t triangle_index = 0; triangle_index < mesh.Triangles.size(); ++triangle_index)
+            {
+                uint32_t material_id = RENDERING::IndexedMesh::NO_MATERIAL;
+                const GRAPHICS::Material* material = mesh.Triangles[triangle_index].Material.get();
+                if (material)
+                {
+                    material_id = material_indices_by_pointer[material];
+                }
+
+                bool extends_previous_range = !material_ranges.empty() && (material_ranges.back().MaterialId == material_id);
+                if (extends_previous_range)
+                {
+                    ++material_ranges.back().TriangleCount;
+                }
+                else
+                {
+                    RENDERING::MaterialRange& material_range = material_ranges.emplace_back();
+                    material_range.FirstTriangleIndex = triangle_index;
+                    material_range.TriangleCount = 1;
+                    material_range.MaterialId = material_id;
+                }
+            }
+
+            // WRITE THE INDEXED MESH.
+            CachedMeshHeader mesh_header;
+            mesh_header.KeySizeInBytes = static_cast<uint32_t>(mesh_name.size());
+            mesh_header.NameSizeInBytes = static_cast<uint32_t>(mesh.Name.size());
+            mesh_header.Visible = mesh.Visible ? 1 : 0;
+            mesh_header.VertexCount = unique_vertices.VertexCount();
+            mesh_header.TriangleCount = static_cast<uint32_t>(mesh.Triangles.size());
+            mesh_header.MaterialRangeCount = static_cast<uint32_t>(material_ranges.size());
+            writer.Write(mesh_header);
+            writer.WriteString(mesh_name);
+            writer.WriteString(mesh.Name);
+            WriteVertexAttributes(writer, unique_vertices, &GRAPHICS::VertexWithAttributes::Position);
+            WriteVertexAttributes(writer, unique_vertices, &GRAPHICS::VertexWithAttributes::Normal);
+            WriteVertexAttributes(writer, unique_vertices, &GRAPHICS::VertexWithAttributes::TextureCoordinates);
+            WriteVertexAttributes(writer, unique_vertices, &GRAPHICS::VertexWithAttributes::Color);
+            WriteVertexIndices(writer, unique_vertices, corner_count);
+            writer.WriteArray(material_ranges.data(), material_ranges.size());
+        }
+
+        // REPLACE ANY OLD CACHE WITH THE NEW ONE.
+        cache_file.close();
+        if (!cache_file)
+        {
+            std::error_code ignored_error;
+            std::filesystem::remove(temporary_cache_filepath, ignored_error);
+            return false;
+        }
+        std::error_code rename_error;
+        std::filesystem::rename(temporary_cache_filepath, cache_filepath, rename_error);
+        if (rename_error)
+        {
+            std::error_code ignored_error;
+            std::filesystem::remove(temporary_cache_filepath, ignored_error);
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include "Assets/LoadProgress.h"
+#include "Graphics/Modeling/Model.h"
+
+namespace ASSETS
+{
+    /// A cache of models in a compact binary format stored next to their source files,
+    /// so that reopening a model avoids re-parsing its (potentially huge) text source.
+    ///
+    /// Each cache file holds:
+    /// - A header identifying the format version and the source file's path, size, and last write time.
+    ///   The cache is only used if all of these still match, so edited or replaced sources are re-parsed.
+    /// - The path, size, and last write time of each file the source references (material libraries and their textures),
+    ///   which must also still match so that edited materials or textures aren't hidden by the cache.
+    /// - A table of textures, stored as raw 8-bit RGBA pixels.
+    /// - A table of materials, referencing textures by index.
+    /// - For each mesh, its indexed form (see RENDERING::IndexedMesh): a packed array for each attribute of its unique vertices,
+    ///   triangle vertex indices, and ranges of triangles sharing materials.
+    ///
+    /// All data is 4-byte aligned so that arrays can be used directly from a memory mapping of the file.
+    class BinaryModelCache
+    {
+    public:
+        /// The version of the cache file format.  Must be incremented whenever the format changes
+        /// so that caches written in older formats get regenerated.
+        static constexpr uint32_t FORMAT_VERSION = 3;
+
+        // LOADING.
+        static std::optional<GRAPHICS::MODELING::Model> LoadModel(const std::filesystem::path& model_filepath);
+        static std::optional<GRAPHICS::MODELING::Model> LoadModel(const std::filesystem::path& model_filepath, LoadProgress& progress);
+
+        // CACHE FILE ACCESS.
+        static std::filesystem::path CacheFilepath(const std::filesystem::path& model_filepath);
+        static std::optional<GRAPHICS::MODELING::Model> Read(const std::filesystem::path& model_filepath, LoadProgress& progress);
+        static bool Write(const std::filesystem::path& model_filepath, const GRAPHICS::MODELING::Model& model);
+    };
+}
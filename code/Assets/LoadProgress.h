@@ -0,0 +1,17 @@
+#pragma once
+
+#include <atomic>
+
+namespace ASSETS
+{
+    /// Progress of a load that may be shared between a loading thread and the main thread.
+    struct LoadProgress
+    {
+        /// The proportion of the load that has completed, in [0, 1].
+        /// Negative if the loader can't currently estimate its progress.
+        std::atomic<float> CompletedProportion = -1.0f;
+        /// True if the main thread has requested that the load be cancelled.
+        /// Loaders that can check this periodically should stop early when it is set.
+        std::atomic<bool> CancelRequested = false;
+    };
+}
@@ -0,0 +1,172 @@
+#ifdef _WIN32
+// Windows min/max macros would otherwise break std::min/std::max in files following this one in unity builds.
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include "Assets/MemoryMappedFile.h"
+
+namespace ASSETS
+{
+    /// Maps an entire file into memory for reading.
+    /// @param[in]  filepath - The path of the file to map.
+    /// @return The mapped file, if successfully mapped; null otherwise (including for empty files, which can't be mapped).
+    std::unique_ptr<MemoryMappedFile> MemoryMappedFile::Open(const std::filesystem::path& filepath)
+    {
+        // OPEN THE FILE.
+        // The mapped file is owned by a smart pointer as early as possible so that any handles get closed if later steps fail.
+        std::unique_ptr<MemoryMappedFile> mapped_file(new MemoryMappedFile());
+#ifdef _WIN32
+        // Others are allowed to read the file at the same time, but the file shouldn't be modified while mapped.
+        const LPSECURITY_ATTRIBUTES DEFAULT_SECURITY = NULL;
+        const HANDLE NO_TEMPLATE_FILE = NULL;
+        HANDLE file_handle = CreateFileW(
+            filepath.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            DEFAULT_SECURITY,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+            NO_TEMPLATE_FILE);
+        if (INVALID_HANDLE_VALUE == file_handle)
+        {
+            return nullptr;
+        }
+        mapped_file->FileHandle = file_handle;
+
+        // GET THE SIZE OF THE FILE.
+        LARGE_INTEGER file_size_in_bytes = {};
+        BOOL file_size_retrieved = GetFileSizeEx(file_handle, &file_size_in_bytes);
+        bool file_mappable = file_size_retrieved && (file_size_in_bytes.QuadPart > 0);
+        if (!file_mappable)
+        {
+            return nullptr;
+        }
+        mapped_file->SizeInBytes = static_cast<std::size_t>(file_size_in_bytes.QuadPart);
+
+        // MAP THE ENTIRE FILE.
+        const DWORD ENTIRE_FILE_SIZE_HIGH = 0;
+        const DWORD ENTIRE_FILE_SIZE_LOW = 0;
+        const LPCWSTR NO_MAPPING_NAME = NULL;
+        HANDLE mapping_handle = CreateFileMappingW(file_handle, DEFAULT_SECURITY, PAGE_READONLY, ENTIRE_FILE_SIZE_HIGH, ENTIRE_FILE_SIZE_LOW, NO_MAPPING_NAME);
+        if (!mapping_handle)
+        {
+            return nullptr;
+        }
+        mapped_file->MappingHandle = mapping_handle;
+
+        const DWORD FILE_START_OFFSET_HIGH = 0;
+        const DWORD FILE_START_OFFSET_LOW = 0;
+        const SIZE_T ENTIRE_FILE = 0;
+        void* mapped_data = MapViewOfFile(mapping_handle, FILE_MAP_READ, FILE_START_OFFSET_HIGH, FILE_START_OFFSET_LOW, ENTIRE_FILE);
+        if (!mapped_data)
+        {
+            return nullptr;
+        }
+        mapped_file->Data = static_cast<const uint8_t*>(mapped_data);
+#else
+        int file_descriptor = open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file_descriptor < 0)
+        {
+            return nullptr;
+        }
+
+        // GET THE SIZE OF THE FILE.
+        struct stat file_status = {};
+        bool file_size_retrieved = (0 == fstat(file_descriptor, &file_status));
+        bool file_mappable = file_size_retrieved && (file_status.st_size > 0);
+        if (!file_mappable)
+        {
+            close(file_descriptor);
+            return nullptr;
+        }
+        mapped_file->SizeInBytes = static_cast<std::size_t>(file_status.st_size);
+
+        // MAP THE ENTIRE FILE.
+        // The mapping keeps its own reference to the file, so the file can be closed right away
+        // and there are no handles to keep like on Windows.
+        void* const ANY_ADDRESS = nullptr;
+        const off_t FILE_START_OFFSET = 0;
+        void* mapped_data = mmap(ANY_ADDRESS, mapped_file->SizeInBytes, PROT_READ, MAP_PRIVATE, file_descriptor, FILE_START_OFFSET);
+        close(file_descriptor);
+        if (MAP_FAILED == mapped_data)
+        {
+            return nullptr;
+        }
+        mapped_file->Data = static_cast<const uint8_t*>(mapped_data);
+
+        // The file is mostly read from start to end, so reading ahead makes page faults less frequent.
+        posix_madvise(mapped_data, mapped_file->SizeInBytes, POSIX_MADV_SEQUENTIAL);
+#endif
+
+        return mapped_file;
+    }
+
+    /// Releases the memory holding pages of the file that have already been read.
+    /// Pages of mapped files stay in memory until unmapped, so reading a huge file from start to end would otherwise
+    /// keep all of it resident at once.  Released pages stay mapped and are read from the file again if accessed.
+    /// Pages only partly in the range are released too, since any parts outside the range are simply read again if needed.
+    /// @param[in]  offset_in_bytes - The offset of the first byte to release.
+    /// @param[in]  size_in_bytes - The number of bytes to release.
+    void MemoryMappedFile::ReleasePages(const std::size_t offset_in_bytes, const std::size_t size_in_bytes) const
+    {
+        // FIND THE PAGES IN THE RANGE.
+        bool range_valid = (offset_in_bytes < SizeInBytes) && (size_in_bytes > 0);
+        if (!range_valid)
+        {
+            return;
+        }
+#ifdef _WIN32
+        SYSTEM_INFO system_info = {};
+        GetSystemInfo(&system_info);
+        std::size_t page_size_in_bytes = system_info.dwPageSize;
+#else
+        std::size_t page_size_in_bytes = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+        std::size_t first_page_offset_in_bytes = offset_in_bytes - (offset_in_bytes % page_size_in_bytes);
+        std::size_t end_offset_in_bytes = std::min(offset_in_bytes + size_in_bytes, SizeInBytes);
+        uint8_t* first_page = const_cast<uint8_t*>(Data) + first_page_offset_in_bytes;
+        std::size_t pages_size_in_bytes = end_offset_in_bytes - first_page_offset_in_bytes;
+
+        // RELEASE THE PAGES.
+#ifdef _WIN32
+        // Unlocking pages that aren't locked removes them from the process's working set, which is the documented way
+        // of trimming specific pages.  It always reports failure for such pages, so the result is ignored.
+        VirtualUnlock(first_page, pages_size_in_bytes);
+#else
+        // The mapping is read-only, so pages are never modified and can just be discarded.
+        madvise(first_page, pages_size_in_bytes, MADV_DONTNEED);
+#endif
+    }
+
+    /// Destructor that unmaps the file.
+    MemoryMappedFile::~MemoryMappedFile()
+    {
+#ifdef _WIN32
+        if (Data)
+        {
+            UnmapViewOfFile(Data);
+        }
+        if (MappingHandle)
+        {
+            CloseHandle(MappingHandle);
+        }
+        if (FileHandle)
+        {
+            CloseHandle(FileHandle);
+        }
+#else
+        if (Data)
+        {
+            munmap(const_cast<uint8_t*>(Data), SizeInBytes);
+        }
+#endif
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+namespace ASSETS
+{
+    /// A read-only view of an entire file mapped into memory.
+    /// Mapping lets the operating system page file contents in on demand directly from its file cache,
+    /// avoiding both the cost of copying large files into separate buffers and of reading parts that aren't used.
+    class MemoryMappedFile
+    {
+    public:
+        // CREATION.
+        static std::unique_ptr<MemoryMappedFile> Open(const std::filesystem::path& filepath);
+
+        // DESTRUCTION.
+        ~MemoryMappedFile();
+
+        // MEMORY MANAGEMENT.
+        void ReleasePages(const std::size_t offset_in_bytes, const std::size_t size_in_bytes) const;
+
+        // COPYING IS DISALLOWED SINCE THE FILE IS UNMAPPED ON DESTRUCTION.
+        MemoryMappedFile(const MemoryMappedFile&) = delete;
+        MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The contents of the file.
+        const uint8_t* Data = nullptr;
+        /// The size of the file.
+        std::size_t SizeInBytes = 0;
+
+    private:
+        // CONSTRUCTION.
+        MemoryMappedFile() = default;
+
+        // PRIVATE MEMBER VARIABLES.
+        /// The operating system handle to the open file.  Only used on Windows, since other systems
+        /// don't need the file kept open while it's mapped.
+        void* FileHandle = nullptr;
+        /// The operating system handle to the mapping of the file.  Only used on Windows.
+        void* MappingHandle = nullptr;
+    };
+}
@@ -0,0 +1,407 @@
+#include <cstring>
+#include <system_error>
+#include <unordered_set>
+#include "Assets/TextureCache.h"
+#include "Graphics/Material.h"
+#include "Profiling/TraceRecorder.h"
+
+namespace ASSETS
+{
+    /// Computes the memory used by a texture's pixels.
+    /// @param[in]  texture - The texture to measure.
+    /// @return The size of the texture's pixels.
+    static std::size_t TextureSizeInBytes(const GRAPHICS::IMAGES::Bitmap& texture)
+    {
+        return static_cast<std::size_t>(texture.GetWidthInPixels()) * texture.GetHeightInPixels() * sizeof(uint32_t);
+    }
+
+    /// Checks if two textures have identical pixels.
+    /// @param[in]  first_texture - The first texture to compare.
+    /// @param[in]  second_texture - The second texture to compare.
+    /// @return True if the textures are identical; false if not.
+    static bool TexturesIdentical(const GRAPHICS::IMAGES::Bitmap& first_texture, const GRAPHICS::IMAGES::Bitmap& second_texture)
+    {
+        bool same_dimensions =
+            (first_texture.GetWidthInPixels() == second_texture.GetWidthInPixels()) &&
+            (first_texture.GetHeightInPixels() == second_texture.GetHeightInPixels());
+        if (!same_dimensions)
+        {
+            return false;
+        }
+
+        std::size_t size_in_bytes = TextureSizeInBytes(first_texture);
+        bool same_pixels = (0 == std::memcmp(first_texture.GetRawData(), second_texture.GetRawData(), size_in_bytes));
+        return same_pixels;
+    }
+
+    /// Loads a PNG image file as an RGBA texture, reusing the cached texture if the file was already loaded.
+    /// @param[in]  filepath - The path of the image file.
+    /// @return The shared texture, if successfully loaded; null otherwise.
+    std::shared_ptr<GRAPHICS::IMAGES::Bitmap> TextureCache::LoadPng(const std::filesystem::path& filepath)
+    {
+        // IDENTIFY THE FILE.
+        // The canonical path lets the same file referenced through different relative paths be found,
+        // and the file's size and last write time make sure edited files are loaded again.
+        std::error_code error;
+        std::filesystem::path canonical_filepath = std::filesystem::weakly_canonical(filepath, error);
+        if (error)
+        {
+            canonical_filepath = std::filesystem::absolute(filepath, error);
+        }
+        std::string source_key = "file:" + canonical_filepath.generic_string();
+        std::uintmax_t file_size_in_bytes = std::filesystem::file_size(canonical_filepath, error);
+        if (!error)
+        {
+            source_key += "|" + std::to_string(file_size_in_bytes);
+        }
+        std::filesystem::file_time_type last_write_time = std::filesystem::last_write_time(canonical_filepath, error);
+        if (!error)
+        {
+            source_key += "|" + std::to_string(last_write_time.time_since_epoch().count());
+        }
+
+        // LOAD THE TEXTURE.
+        return FindOrCreate(source_key, [&canonical_filepath]()
+        {
+            PROFILING::TraceScope decode_scope("Decode Texture", "Textures");
+            return GRAPHICS::IMAGES::Bitmap::LoadPng(canonical_filepath.string(), GRAPHICS::ColorFormat::RGBA);
+        });
+    }
+
+    /// Gets the texture created from a source, creating it only if it isn't already cached.
+    /// @param[in]  source_key - Uniquely identifies the source of the texture, such that the same key always produces the same texture.
+    /// @param[in]  create_texture - Creates the texture if it isn't cached.  Called without holding the cache's lock,
+    ///     so textures may be created on multiple threads at once.  May return null if the texture couldn't be created.
+    /// @return The shared texture, if found or created; null otherwise.
+    std::shared_ptr<GRAPHICS::IMAGES::Bitmap> TextureCache::FindOrCreate(
+        const std::string& source_key,
+        const std::function<std::shared_ptr<GRAPHICS::IMAGES::Bitmap>()>& create_texture)
+    {
+        // CHECK IF THE TEXTURE IS ALREADY CACHED.
+        {
+            std::lock_guard<std::mutex> lock(CacheMutex);
+            auto content_hash = ContentHashesBySourceKey.find(source_key);
+            if (ContentHashesBySourceKey.end() != content_hash)
+            {
+                CachedTexture& cached_texture = TexturesByContentHash.at(content_hash->second);
+                MarkUsedLocked(cached_texture);
+                ++ActivityCounts.HitCount;
+                return cached_texture.Texture;
+            }
+        }
+
+        // CREATE THE TEXTURE.
+        std::shared_ptr<GRAPHICS::IMAGES::Bitmap> texture = create_texture();
+        if (!texture)
+        {
+            return nullptr;
+        }
+        uint64_t content_hash = ComputeContentHash(texture->GetWidthInPixels(), texture->GetHeightInPixels(), texture->GetRawData());
+
+        // CACHE THE TEXTURE.
+        std::shared_ptr<GRAPHICS::IMAGES::Bitmap> shared_texture = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(CacheMutex);
+            ++ActivityCounts.MissCount;
+            shared_texture = AddOrShareLocked(texture, content_hash, &source_key);
+        }
+        GenerateMipmaps(shared_texture, content_hash);
+        return shared_texture;
+    }
+
+    /// Gets a cached texture identical to the provided texture, caching the provided texture if there isn't one yet.
+    /// @param[in]  texture - The texture to share.  Must not be modified afterwards.
+    /// @return The shared texture, which may differ from the provided texture; null if the provided texture is null.
+    std::shared_ptr<GRAPHICS::IMAGES::Bitmap> TextureCache::Share(const std::shared_ptr<GRAPHICS::IMAGES::Bitmap>& texture)
+    {
+        if (!texture)
+        {
+            return nullptr;
+        }
+
+        uint64_t content_hash = ComputeContentHash(texture->GetWidthInPixels(), texture->GetHeightInPixels(), texture->GetRawData());
+        std::shared_ptr<GRAPHICS::IMAGES::Bitmap> shared_texture = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(CacheMutex);
+            const std::string* const NO_SOURCE_KEY = nullptr;
+            shared_texture = AddOrShareLocked(texture, content_hash, NO_SOURCE_KEY);
+        }
+        GenerateMipmaps(shared_texture, content_hash);
+        return shared_texture;
+    }
+
+    /// Replaces all textures in a model's materials with shared textures from the cache.
+    /// @param[in,out]  model - The model whose textures to share.
+    void TextureCache::ShareTextures(GRAPHICS::MODELING::Model& model)
+    {
+        PROFILING::TraceScope share_scope("Share Textures", "Textures");
+
+        // REPLACE EACH MATERIAL'S TEXTURE ONCE.
+        // Materials are shared by many triangles, and textures by many materials, so each is only visited once.
+        std::unordered_set<GRAPHICS::Material*> visited_materials;
+        std::unordered_map<const GRAPHICS::IMAGES::Bitmap*, std::shared_ptr<GRAPHICS::IMAGES::Bitmap>> shared_textures;
+        for (auto& [mesh_name, mesh] : model.MeshesByName)
+        {
+            for (GRAPHICS::GEOMETRY::Triangle& triangle : mesh.Triangles)
+            {
+                GRAPHICS::Material* material = triangle.Material.get();
+                if (!material || !material->DiffuseProperties.Texture)
+                {
+                    continue;
+                }
+                bool material_newly_visited = visited_materials.insert(material).second;
+                if (!material_newly_visited)
+                {
+                    continue;
+                }
+
+                std::shared_ptr<GRAPHICS::IMAGES::Bitmap>& texture = material->DiffuseProperties.Texture;
+                auto shared_texture = shared_textures.find(texture.get());
+                if (shared_textures.end() == shared_texture)
+                {
+                    shared_texture = shared_textures.emplace(texture.get(), Share(texture)).first;
+                }
+                texture = shared_texture->second;
+            }
+        }
+    }
+
+    /// Finds the mipmaps generated for a cached texture.
+    /// @param[in]  texture - The texture to find mipmaps for.
+    /// @return The texture's mipmaps; null if the texture isn't cached or its mipmaps aren't generated yet.
+    std::shared_ptr<const RENDERING::MipmappedTexture> TextureCache::FindMipmaps(const GRAPHICS::IMAGES::Bitmap* const texture)
+    {
+        if (!texture)
+        {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(CacheMutex);
+        auto content_hash = ContentHashesByTexture.find(texture);
+        if (ContentHashesByTexture.end() == content_hash)
+        {
+            return nullptr;
+        }
+        return TexturesByContentHash.at(content_hash->second).Mipmaps;
+    }
+
+    /// Computes a hash of a texture's pixels.
+    /// @param[in]  width_in_pixels - The width of the texture.
+    /// @param[in]  height_in_pixels - The height of the texture.
+    /// @param[in]  pixels - The texture's pixels, one 32-bit value per pixel.
+    /// @return The content hash.
+    uint64_t TextureCache::ComputeContentHash(
+        const unsigned int width_in_pixels,
+        const unsigned int height_in_pixels,
+        const uint32_t* const pixels)
+    {
+        // The multiplier is from the 64-bit FNV hash.  Pixels are mixed in pairs to halve the serial multiplies for large textures.
+        constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+        constexpr uint64_t PRIME = 0x100000001b3ull;
+        uint64_t hash = FNV_OFFSET_BASIS;
+        auto mix = [&hash](const uint64_t value)
+        {
+            hash = (hash ^ value) * PRIME;
+            hash ^= (hash >> 32);
+        };
+        mix((static_cast<uint64_t>(width_in_pixels) << 32) | height_in_pixels);
+
+        std::size_t pixel_count = static_cast<std::size_t>(width_in_pixels) * height_in_pixels;
+        std::size_t pixel_index = 0;
+        for (; pixel_index + 1 < pixel_count; pixel_index += 2)
+        {
+            mix((static_cast<uint64_t>(pixels[pixel_index]) << 32) | pixels[pixel_index + 1]);
+        }
+        if (pixel_index < pixel_count)
+        {
+            mix(pixels[pixel_index]);
+        }
+        return hash;
+    }
+
+    /// Sets the memory budget for cached textures, evicting idle textures if now over budget.
+    /// @param[in]  memory_budget_in_bytes - The memory budget.
+    void TextureCache::SetMemoryBudget(const std::size_t memory_budget_in_bytes)
+    {
+        std::lock_guard<std::mutex> lock(CacheMutex);
+        MemoryBudgetInBytes = memory_budget_in_bytes;
+        EvictToBudgetLocked();
+    }
+
+    /// Removes all textures from the cache.  Textures still in use remain valid but will no longer be shared.
+    void TextureCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(CacheMutex);
+        TexturesByContentHash.clear();
+        ContentHashesByTexture.clear();
+        ContentHashesBySourceKey.clear();
+        RecentUseOrder.clear();
+        SizeInBytes = 0;
+    }
+
+    /// Gets counts describing the current contents of the cache and its activity so far.
+    /// @return The cache statistics.
+    TextureCacheStatistics TextureCache::Statistics()
+    {
+        std::lock_guard<std::mutex> lock(CacheMutex);
+        TextureCacheStatistics statistics = ActivityCounts;
+        statistics.TextureCount = TexturesByContentHash.size();
+        statistics.SizeInBytes = SizeInBytes;
+        statistics.MemoryBudgetInBytes = MemoryBudgetInBytes;
+        for (const auto& [content_hash, cached_texture] : TexturesByContentHash)
+        {
+            if (cached_texture.Mipmaps)
+            {
+                statistics.MipmapSizeInBytes += cached_texture.Mipmaps->SizeInBytes();
+            }
+
+            bool in_use = (cached_texture.Texture.use_count() > 1);
+            if (in_use)
+            {
+                ++statistics.InUseTextureCount;
+                statistics.InUseSizeInBytes += cached_texture.SizeInBytes;
+            }
+        }
+        return statistics;
+    }
+
+    /// Adds a texture to the cache or gets an identical cached texture.  The cache's lock must be held.
+    /// @param[in]  texture - The texture to add.
+    /// @param[in]  content_hash - The hash of the texture's pixels.
+    /// @param[in]  source_key - The key of the source the texture was created from, if any.
+    /// @return The shared texture.
+    std::shared_ptr<GRAPHICS::IMAGES::Bitmap> TextureCache::AddOrShareLocked(
+        const std::shared_ptr<GRAPHICS::IMAGES::Bitmap>& texture,
+        const uint64_t content_hash,
+        const std::string* const source_key)
+    {
+        // CHECK FOR AN IDENTICAL CACHED TEXTURE.
+        auto existing_texture = TexturesByContentHash.find(content_hash);
+        if (TexturesByContentHash.end() != existing_texture)
+        {
+            CachedTexture& cached_texture = existing_texture->second;
+            if (cached_texture.Texture == texture)
+            {
+                MarkUsedLocked(cached_texture);
+                return cached_texture.Texture;
+            }
+
+            // Hashes can collide, so pixels are compared to be sure.  A colliding texture just isn't shared.
+            bool identical = TexturesIdentical(*cached_texture.Texture, *texture);
+            if (!identical)
+            {
+                return texture;
+            }
+
+            // The source may have been cached by another thread while this texture was being created.
+            if (source_key && !ContentHashesBySourceKey.contains(*source_key))
+            {
+                ContentHashesBySourceKey[*source_key] = content_hash;
+                cached_texture.SourceKeys.emplace_back(*source_key);
+            }
+            MarkUsedLocked(cached_texture);
+            ++ActivityCounts.DuplicateCount;
+            return cached_texture.Texture;
+        }
+
+        // ADD THE TEXTURE.
+        CachedTexture& cached_texture = TexturesByContentHash[content_hash];
+        cached_texture.Texture = texture;
+        cached_texture.SizeInBytes = TextureSizeInBytes(*texture);
+        ContentHashesByTexture[texture.get()] = content_hash;
+        if (source_key)
+        {
+            ContentHashesBySourceKey[*source_key] = content_hash;
+            cached_texture.SourceKeys.emplace_back(*source_key);
+        }
+        cached_texture.RecentUsePosition = RecentUseOrder.insert(RecentUseOrder.end(), content_hash);
+        SizeInBytes += cached_texture.SizeInBytes;
+
+        // The new texture is in use by the caller, so only older idle textures may be evicted.
+        std::shared_ptr<GRAPHICS::IMAGES::Bitmap> shared_texture = cached_texture.Texture;
+        EvictToBudgetLocked();
+        return shared_texture;
+    }
+
+    /// Generates mipmaps for a newly cached texture, if not already generated.
+    /// The cache's lock must not be held, since generating mipmaps for large textures takes a while.
+    /// @param[in]  texture - The texture returned from the cache.
+    /// @param[in]  content_hash - The hash of the texture's pixels.
+    void TextureCache::GenerateMipmaps(const std::shared_ptr<GRAPHICS::IMAGES::Bitmap>& texture, const uint64_t content_hash)
+    {
+        // CHECK IF MIPMAPS ARE NEEDED.
+        // Textures with colliding hashes aren't cached, so they just don't get mipmaps.
+        auto texture_needs_mipmaps = [&texture, content_hash]()
+        {
+            auto cached_texture = TexturesByContentHash.find(content_hash);
+            return (TexturesByContentHash.end() != cached_texture) &&
+                (cached_texture->second.Texture == texture) &&
+                !cached_texture->second.Mipmaps;
+        };
+        {
+            std::lock_guard<std::mutex> lock(CacheMutex);
+            if (!texture || !texture_needs_mipmaps())
+            {
+                return;
+            }
+        }
+
+        // GENERATE THE MIPMAPS.
+        PROFILING::TraceScope mipmap_scope("Generate Mipmaps", "Textures");
+        std::shared_ptr<const RENDERING::MipmappedTexture> mipmaps = std::make_shared<const RENDERING::MipmappedTexture>(
+            RENDERING::MipmappedTexture::Generate(*texture));
+
+        // STORE THE MIPMAPS WITH THE TEXTURE.
+        // Another thread may have generated identical mipmaps in the meantime, in which case those are kept.
+        std::lock_guard<std::mutex> lock(CacheMutex);
+        if (!texture_needs_mipmaps())
+        {
+            return;
+        }
+        CachedTexture& cached_texture = TexturesByContentHash.at(content_hash);
+        cached_texture.Mipmaps = mipmaps;
+        std::size_t mipmap_size_in_bytes = mipmaps->SizeInBytes();
+        cached_texture.SizeInBytes += mipmap_size_in_bytes;
+        SizeInBytes += mipmap_size_in_bytes;
+        EvictToBudgetLocked();
+    }
+
+    /// Moves a cached texture to the end of the least-recently-used order.  The cache's lock must be held.
+    /// @param[in,out]  cached_texture - The texture that was used.
+    void TextureCache::MarkUsedLocked(CachedTexture& cached_texture)
+    {
+        RecentUseOrder.splice(RecentUseOrder.end(), RecentUseOrder, cached_texture.RecentUsePosition);
+    }
+
+    /// Evicts idle textures in least-recently-used order until the cache is within its memory budget.
+    /// The cache's lock must be held.
+    void TextureCache::EvictToBudgetLocked()
+    {
+        auto content_hash = RecentUseOrder.begin();
+        while ((SizeInBytes > MemoryBudgetInBytes) && (RecentUseOrder.end() != content_hash))
+        {
+            // SKIP TEXTURES STILL IN USE.
+            // Only the cache referencing a texture means nothing else can get it without going through the cache,
+            // so the count can't increase while the lock is held.
+            CachedTexture& cached_texture = TexturesByContentHash.at(*content_hash);
+            bool in_use = (cached_texture.Texture.use_count() > 1);
+            if (in_use)
+            {
+                ++content_hash;
+                continue;
+            }
+
+            // EVICT THE TEXTURE.
+            for (const std::string& source_key : cached_texture.SourceKeys)
+            {
+                ContentHashesBySourceKey.erase(source_key);
+            }
+            ContentHashesByTexture.erase(cached_texture.Texture.get());
+            SizeInBytes -= cached_texture.SizeInBytes;
+            ++ActivityCounts.EvictionCount;
+            uint64_t evicted_content_hash = *content_hash;
+            content_hash = RecentUseOrder.erase(content_hash);
+            TexturesByContentHash.erase(evicted_content_hash);
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Graphics/Images/Bitmap.h"
+#include "Graphics/Modeling/Model.h"
+#include "Rendering/MipmappedTexture.h"
+
+namespace ASSETS
+{
+    /// Counts describing the contents and effectiveness of the texture cache.
+    struct TextureCacheStatistics
+    {
+        /// The number of distinct textures in the cache.
+        std::size_t TextureCount = 0;
+        /// The memory used by all textures in the cache, including their mipmaps.
+        std::size_t SizeInBytes = 0;
+        /// The memory used by mipmaps generated for textures in the cache.
+        std::size_t MipmapSizeInBytes = 0;
+        /// The number of cached textures still referenced outside the cache, which can't be evicted.
+        std::size_t InUseTextureCount = 0;
+        /// The memory used by cached textures still referenced outside the cache.
+        std::size_t InUseSizeInBytes = 0;
+        /// The memory budget that idle textures are evicted to stay within.
+        std::size_t MemoryBudgetInBytes = 0;
+        /// The number of requests for textures that were already cached.
+        std::size_t HitCount = 0;
+        /// The number of requests for textures that had to be created.
+        std::size_t MissCount = 0;
+        /// The number of created textures discarded in favor of cached textures with identical pixels.
+        std::size_t DuplicateCount = 0;
+        /// The number of textures evicted to stay within the memory budget.
+        std::size_t EvictionCount = 0;
+    };
+
+    /// A cache of textures shared by all materials and models, so that each distinct image is only kept in memory once.
+    ///
+    /// Textures are found by a source key identifying where they came from (like the canonical path of an image file),
+    /// so that repeatedly requested textures aren't decoded again.  Newly created textures are then deduplicated
+    /// by a hash of their pixels, so identical images from different sources (like copies of the same file
+    /// in different folders) also share memory.
+    ///
+    /// Textures handed out by the cache are shared and must not be modified.  Textures not used outside the cache
+    /// are evicted in least-recently-used order once the cache exceeds its memory budget.  Textures still in use
+    /// are never evicted, since doing so wouldn't free any memory.
+    ///
+    /// Mipmaps for filtered sampling in the CPU rendering paths are generated once when a texture is first cached,
+    /// so that this happens while models load rather than while rendering.
+    ///
+    /// The cache may be used from any thread, such as while models are loaded in the background.
+    class TextureCache
+    {
+    public:
+        /// The default memory budget for cached textures.
+        static constexpr std::size_t DEFAULT_MEMORY_BUDGET_IN_BYTES = std::size_t(1) << 30;
+
+        // TEXTURE ACCESS.
+        static std::shared_ptr<GRAPHICS::IMAGES::Bitmap> LoadPng(const std::filesystem::path& filepath);
+        static std::shared_ptr<GRAPHICS::IMAGES::Bitmap> FindOrCreate(
+            const std::string& source_key,
+            const std::function<std::shared_ptr<GRAPHICS::IMAGES::Bitmap>()>& create_texture);
+        static std::shared_ptr<GRAPHICS::IMAGES::Bitmap> Share(const std::shared_ptr<GRAPHICS::IMAGES::Bitmap>& texture);
+        static void ShareTextures(GRAPHICS::MODELING::Model& model);
+        static std::shared_ptr<const RENDERING::MipmappedTexture> FindMipmaps(const GRAPHICS::IMAGES::Bitmap* const texture);
+
+        // HASHING.
+        static uint64_t ComputeContentHash(
+            const unsigned int width_in_pixels,
+            const unsigned int height_in_pixels,
+            const uint32_t* const pixels);
+
+        // MEMORY MANAGEMENT.
+        static void SetMemoryBudget(const std::size_t memory_budget_in_bytes);
+        static void Clear();
+        static TextureCacheStatistics Statistics();
+
+    private:
+        /// A texture held by the cache.
+        struct CachedTexture
+        {
+            /// The texture.
+            std::shared_ptr<GRAPHICS::IMAGES::Bitmap> Texture = nullptr;
+            /// The texture's mipmaps, once generated.
+            std::shared_ptr<const RENDERING::MipmappedTexture> Mipmaps = nullptr;
+            /// The memory used by the texture's pixels and mipmaps.
+            std::size_t SizeInBytes = 0;
+            /// The source keys that refer to the texture, which must be forgotten if it's evicted.
+            std::vector<std::string> SourceKeys = {};
+            /// The texture's position in the least-recently-used order.
+            std::list<uint64_t>::iterator RecentUsePosition = {};
+        };
+
+        // HELPER METHODS.
+        static std::shared_ptr<GRAPHICS::IMAGES::Bitmap> AddOrShareLocked(
+            const std::shared_ptr<GRAPHICS::IMAGES::Bitmap>& texture,
+            const uint64_t content_hash,
+            const std::string* const source_key);
+        static void GenerateMipmaps(const std::shared_ptr<GRAPHICS::IMAGES::Bitmap>& texture, const uint64_t content_hash);
+        static void MarkUsedLocked(CachedTexture& cached_texture);
+        static void EvictToBudgetLocked();
+
+        // PRIVATE MEMBER VARIABLES.
+        /// Protects the variables below since textures may be requested from any thread.
+        static inline std::mutex CacheMutex = {};
+        /// The memory budget that idle textures are evicted to stay within.
+        static inline std::size_t MemoryBudgetInBytes = DEFAULT_MEMORY_BUDGET_IN_BYTES;
+        /// The memory used by all cached textures.
+        static inline std::size_t SizeInBytes = 0;
+        /// Cached textures by the hash of their contents.
+        static inline std::unordered_map<uint64_t, CachedTexture> TexturesByContentHash = {};
+        /// The content hashes of cached textures by the textures themselves, for finding their mipmaps.
+        static inline std::unordered_map<const GRAPHICS::IMAGES::Bitmap*, uint64_t> ContentHashesByTexture = {};
+        /// The content hashes of cached textures by the keys of sources they were created from.
+        static inline std::unordered_map<std::string, uint64_t> ContentHashesBySourceKey = {};
+        /// The content hashes of cached textures, from least to most recently used.
+        static inline std::list<uint64_t> RecentUseOrder = {};
+        /// Counts of cache activity, for reporting.
+        static inline TextureCacheStatistics ActivityCounts = {};
+    };
+}
@@ -0,0 +1,891 @@
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <map>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include "Assets/MemoryMappedFile.h"
+#include "Assets/TextureCache.h"
+#include "Assets/WavefrontObjectParser.h"
+#include "Profiling/TraceRecorder.h"
+#include "Rendering/IndexedMesh.h"
+
+namespace ASSETS
+{
+    /// Loads a model from a Wavefront .obj file, along with any material libraries it references.
+    /// @param[in]  filepath - The path of the .obj file.
+    /// @param[in,out]  progress - The progress of the load.  Parsing stops early if cancellation is requested.
+    /// @return The loaded model, if the file could be read and only used supported records; null otherwise.
+    std::optional<GRAPHICS::MODELING::Model> WavefrontObjectParser::Load(const std::filesystem::path& filepath, LoadProgress& progress)
+    {
+        // MAP THE FILE.
+        std::unique_ptr<MemoryMappedFile> file = MemoryMappedFile::Open(filepath);
+        if (!file)
+        {
+            return std::nullopt;
+        }
+        const char* file_begin = reinterpret_cast<const char*>(file->Data);
+        const char* file_end = file_begin + file->SizeInBytes;
+
+        // SPLIT THE FILE INTO CHUNKS ON LINE BOUNDARIES.
+        std::size_t max_chunk_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        std::size_t chunk_count = std::clamp<std::size_t>(file->SizeInBytes / MIN_CHUNK_SIZE_IN_BYTES, 1, max_chunk_count);
+        std::vector<const char*> chunk_boundaries;
+        chunk_boundaries.reserve(chunk_count + 1);
+        chunk_boundaries.push_back(file_begin);
+        for (std::size_t chunk_index = 1; chunk_index < chunk_count; ++chunk_index)
+        {
+            // Each chunk ends after the line containing its nominal end, so no line is split between chunks.
+            const char* nominal_chunk_end = std::max(file_begin + file->SizeInBytes * chunk_index / chunk_count, chunk_boundaries.back());
+            const char* line_end = FindLineEnd(nominal_chunk_end, file_end);
+            const char* chunk_end = (line_end < file_end) ? line_end + 1 : file_end;
+            chunk_boundaries.push_back(chunk_end);
+        }
+        chunk_boundaries.push_back(file_end);
+
+        // TOKENIZE ALL CHUNKS IN PARALLEL.
+        std::vector<ParsedChunk> chunks(chunk_count);
+        {
+            PROFILING::TraceScope tokenize_scope("Tokenize Model", "Model Loading");
+            std::atomic<std::size_t> parsed_size_in_bytes = 0;
+            RunInParallel(chunk_count, [&](const std::size_t chunk_index)
+            {
+                ParseChunk(
+                    chunk_boundaries[chunk_index],
+                    chunk_boundaries[chunk_index + 1],
+                    file->SizeInBytes,
+                    parsed_size_in_bytes,
+                    progress,
+                    chunks[chunk_index]);
+            });
+        }
+        if (progress.CancelRequested)
+        {
+            return std::nullopt;
+        }
+        for (const ParsedChunk& chunk : chunks)
+        {
+            if (!chunk.Valid)
+            {
+                return std::nullopt;
+            }
+        }
+
+        // COMBINE THE VERTEX ATTRIBUTES FROM ALL CHUNKS.
+        // Face indices refer to attributes anywhere in the file, so they must be in single arrays.
+        std::vector<MATH::Vector3f> positions;
+        std::vector<MATH::Vector2f> texture_coordinates;
+        std::vector<MATH::Vector3f> normals;
+        {
+            PROFILING::TraceScope combine_scope("Combine Vertex Attributes", "Model Loading");
+            std::size_t position_count = 0;
+            std::size_t texture_coordinate_count = 0;
+            std::size_t normal_count = 0;
+            for (const ParsedChunk& chunk : chunks)
+            {
+                position_count += chunk.Positions.size();
+                texture_coordinate_count += chunk.TextureCoordinates.size();
+                normal_count += chunk.Normals.size();
+            }
+            positions.reserve(position_count);
+            texture_coordinates.reserve(texture_coordinate_count);
+            normals.reserve(normal_count);
+            for (ParsedChunk& chunk : chunks)
+            {
+                positions.insert(positions.end(), chunk.Positions.begin(), chunk.Positions.end());
+                texture_coordinates.insert(texture_coordinates.end(), chunk.TextureCoordinates.begin(), chunk.TextureCoordinates.end());
+                normals.insert(normals.end(), chunk.Normals.begin(), chunk.Normals.end());
+                // Assigning new vectors frees their memory, unlike assigning {}, which only clears them.
+                chunk.Positions = std::vector<MATH::Vector3f>();
+                chunk.TextureCoordinates = std::vector<MATH::Vector2f>();
+                chunk.Normals = std::vector<MATH::Vector3f>();
+            }
+        }
+
+        // DETERMINE THE MESH AND MATERIAL FOR EACH FACE.
+        // State changes are applied in file order, splitting each chunk's faces into runs sharing a mesh and material.
+        // Runs are assigned consecutive triangles in their meshes so that each chunk's triangles can then be built in parallel.
+        GRAPHICS::MODELING::Model model;
+        std::vector<std::vector<FaceRun>> face_runs_by_chunk(chunk_count);
+        {
+            PROFILING::TraceScope assign_scope("Assign Meshes and Materials", "Model Loading");
+            MaterialsByName materials_by_name;
+            GRAPHICS::Mesh* current_mesh = nullptr;
+            std::shared_ptr<GRAPHICS::Material> current_material = nullptr;
+            std::unordered_map<GRAPHICS::Mesh*, std::size_t> triangle_counts_by_mesh;
+            for (std::size_t chunk_index = 0; chunk_index < chunk_count; ++chunk_index)
+            {
+                const ParsedChunk& chunk = chunks[chunk_index];
+                std::vector<FaceRun>& face_runs = face_runs_by_chunk[chunk_index];
+                std::size_t chunk_face_count = chunk.FaceCorners.size() / RENDERING::IndexedMesh::VERTICES_PER_TRIANGLE;
+                std::size_t run_first_face_index = 0;
+                for (std::size_t state_change_index = 0; state_change_index <= chunk.StateChanges.size(); ++state_change_index)
+                {
+                    // END THE CURRENT RUN OF FACES.
+                    // The final run in the chunk ends at the end of the chunk.
+                    bool state_changed = (state_change_index < chunk.StateChanges.size());
+                    std::size_t run_end_face_index = state_changed ? chunk.StateChanges[state_change_index].FaceIndex : chunk_face_count;
+                    if (run_end_face_index > run_first_face_index)
+                    {
+                        // Faces before any mesh is named go into a mesh with an empty name.
+                        if (!current_mesh)
+                        {
+                            current_mesh = &model.MeshesByName[""];
+                        }
+
+                        std::size_t& mesh_triangle_count = triangle_counts_by_mesh[current_mesh];
+                        FaceRun& face_run = face_runs.emplace_back();
+                        face_run.FirstFaceIndex = run_first_face_index;
+                        face_run.FaceCount = run_end_face_index - run_first_face_index;
+                        face_run.Mesh = current_mesh;
+                        face_run.FirstTriangleIndex = mesh_triangle_count;
+                        face_run.Material = current_material;
+                        mesh_triangle_count += face_run.FaceCount;
+                    }
+                    run_first_face_index = run_end_face_index;
+                    if (!state_changed)
+                    {
+                        break;
+                    }
+
+                    // APPLY THE STATE CHANGE.
+                    const StateChange& state_change = chunk.StateChanges[state_change_index];
+                    if (StateChangeType::MESH == state_change.Type)
+                    {
+                        std::string mesh_name(state_change.Argument);
+                        current_mesh = &model.MeshesByName[mesh_name];
+                        current_mesh->Name = mesh_name;
+                    }
+                    else if (StateChangeType::MATERIAL == state_change.Type)
+                    {
+                        auto material = materials_by_name.find(std::string(state_change.Argument));
+                        current_material = (materials_by_name.end() != material) ? material->second : nullptr;
+                    }
+                    else if (StateChangeType::MATERIAL_LIBRARY == state_change.Type)
+                    {
+                        std::filesystem::path material_filepath = filepath.parent_path() / std::filesystem::path(state_change.Argument);
+                        bool materials_loaded = LoadMaterials(material_filepath, materials_by_name);
+                        if (!materials_loaded)
+                        {
+                            return std::nullopt;
+                        }
+                    }
+                }
+            }
+
+            // RELEASE THE FILE BEFORE ALLOCATING TRIANGLES.
+            // Nothing refers to the file's contents anymore, and releasing it first keeps it from being resident
+            // alongside all of the model's triangles, which would otherwise set the peak memory of the load.
+            for (ParsedChunk& chunk : chunks)
+            {
+                chunk.StateChanges = std::vector<StateChange>();
+            }
+            file.reset();
+
+            // Triangles are only reserved here since they're added a chunk at a time below.
+            for (auto& [mesh, triangle_count] : triangle_counts_by_mesh)
+            {
+                mesh->Triangles.reserve(triangle_count);
+            }
+        }
+
+        // BUILD THE TRIANGLES A CHUNK AT A TIME.
+        // Each chunk's face corners are freed as soon as its triangles are built so that corners for the whole file
+        // are never resident alongside all of the model's triangles.  Runs are assigned consecutive triangles in
+        // file order, so each chunk only appends to its meshes' reserved triangles.
+        std::atomic<bool> indices_valid = true;
+        {
+            PROFILING::TraceScope build_scope("Build Triangles", "Model Loading");
+            for (std::size_t chunk_index = 0; indices_valid && chunk_index < chunk_count; ++chunk_index)
+            {
+                // ADD THE CHUNK'S TRIANGLES TO THEIR MESHES.
+                ParsedChunk& chunk = chunks[chunk_index];
+                const std::vector<FaceRun>& face_runs = face_runs_by_chunk[chunk_index];
+                for (const FaceRun& face_run : face_runs)
+                {
+                    face_run.Mesh->Triangles.resize(face_run.FirstTriangleIndex + face_run.FaceCount);
+                }
+
+                // BUILD THE CHUNK'S TRIANGLES IN PARALLEL.
+                // Each task builds its own range of the chunk's faces, so no synchronization is needed.
+                constexpr std::size_t MIN_FACE_COUNT_PER_TASK = 4096;
+                std::size_t chunk_face_count = chunk.FaceCorners.size() / RENDERING::IndexedMesh::VERTICES_PER_TRIANGLE;
+                std::size_t task_count = std::clamp<std::size_t>(chunk_face_count / MIN_FACE_COUNT_PER_TASK, 1, max_chunk_count);
+                RunInParallel(task_count, [&](const std::size_t task_index)
+                {
+                    std::size_t task_first_face_index = chunk_face_count * task_index / task_count;
+                    std::size_t task_end_face_index = chunk_face_count * (task_index + 1) / task_count;
+                    for (const FaceRun& face_run : face_runs)
+                    {
+                        // Only the part of the run within this task's range of faces is built.
+                        std::size_t first_face_index = std::max(face_run.FirstFaceIndex, task_first_face_index);
+                        std::size_t end_face_index = std::min(face_run.FirstFaceIndex + face_run.FaceCount, task_end_face_index);
+
+                        // Vertex colors aren't stored in .obj files, so the diffuse color of the material is used.
+                        GRAPHICS::Color vertex_color = face_run.Material ? face_run.Material->DiffuseProperties.Color : GRAPHICS::Color::WHITE;
+                        for (std::size_t face_index = first_face_index; face_index < end_face_index; ++face_index)
+                        {
+                            GRAPHICS::GEOMETRY::Triangle& triangle = face_run.Mesh->Triangles[face_run.FirstTriangleIndex + face_index - face_run.FirstFaceIndex];
+                            triangle.Material = face_run.Material;
+
+                            std::size_t first_corner_index = RENDERING::IndexedMesh::VERTICES_PER_TRIANGLE * face_index;
+                            for (std::size_t vertex_index = 0; vertex_index < RENDERING::IndexedMesh::VERTICES_PER_TRIANGLE; ++vertex_index)
+                            {
+                                // VALIDATE THE CORNER'S INDICES.
+                                const FaceCorner& corner = chunk.FaceCorners[first_corner_index + vertex_index];
+                                bool corner_valid =
+                                    (corner.PositionIndex <= positions.size()) &&
+                                    (corner.TextureCoordinateIndex <= texture_coordinates.size()) &&
+                                    (corner.NormalIndex <= normals.size());
+                                if (!corner_valid)
+                                {
+                                    indices_valid = false;
+                                    return;
+                                }
+
+                                // SET THE VERTEX'S ATTRIBUTES.
+                                // Attributes that weren't given keep their defaults.
+                                GRAPHICS::VertexWithAttributes& vertex = triangle.Vertices[vertex_index];
+                                vertex.Position = positions[corner.PositionIndex - 1];
+                                if (corner.TextureCoordinateIndex > 0)
+                                {
+                                    vertex.TextureCoordinates = texture_coordinates[corner.TextureCoordinateIndex - 1];
+                                }
+                                if (corner.NormalIndex > 0)
+                                {
+                                    vertex.Normal = normals[corner.NormalIndex - 1];
+                                }
+                                vertex.Color = vertex_color;
+                            }
+                        }
+                    }
+                });
+                chunk.FaceCorners = std::vector<FaceCorner>();
+            }
+        }
+        if (!indices_valid)
+        {
+            return std::nullopt;
+        }
+
+        return model;
+    }
+
+    /// Finds the files a model references: its material libraries and their textures.
+    /// Paths are resolved the same way as when loading, so that the files can be checked for changes.
+    /// Unlike loading, unsupported records are skipped, since the graphics library's parser may still load the model.
+    /// @param[in]  filepath - The path of the .obj file.
+    /// @return The paths of referenced files, in the order they're referenced, which may include files that don't exist.
+    std::vector<std::filesystem::path> WavefrontObjectParser::FindReferencedFiles(const std::filesystem::path& filepath)
+    {
+        // MAP THE FILE.
+        std::vector<std::filesystem::path> referenced_filepaths;
+        std::unique_ptr<MemoryMappedFile> file = MemoryMappedFile::Open(filepath);
+        if (!file)
+        {
+            return referenced_filepaths;
+        }
+        const char* file_end = reinterpret_cast<const char*>(file->Data) + file->SizeInBytes;
+
+        // FIND THE MATERIAL LIBRARIES.
+        // This runs while the parsed model is already in memory (such as when writing its cache), so pages of the file
+        // are released as they're scanned to avoid having all of a huge file resident at once alongside the model.
+        constexpr std::size_t RELEASE_INTERVAL_IN_BYTES = std::size_t(16) << 20;
+        std::vector<std::filesystem::path> material_filepaths;
+        const char* file_begin = reinterpret_cast<const char*>(file->Data);
+        const char* line_begin = file_begin;
+        std::size_t released_size_in_bytes = 0;
+        while (line_begin < file_end)
+        {
+            const char* line_end = FindLineEnd(line_begin, file_end);
+            const char* position = line_begin;
+            std::string_view record_type = ReadToken(position, line_end);
+            if ("mtllib" == record_type)
+            {
+                std::filesystem::path material_filepath = filepath.parent_path() / std::filesystem::path(ReadRestOfLine(position, line_end));
+                material_filepaths.emplace_back(material_filepath);
+            }
+            line_begin = (line_end < file_end) ? line_end + 1 : file_end;
+
+            std::size_t scanned_size_in_bytes = static_cast<std::size_t>(line_begin - file_begin);
+            if (scanned_size_in_bytes - released_size_in_bytes >= RELEASE_INTERVAL_IN_BYTES)
+            {
+                file->ReleasePages(released_size_in_bytes, scanned_size_in_bytes - released_size_in_bytes);
+                released_size_in_bytes = scanned_size_in_bytes;
+            }
+        }
+
+        // FIND THE TEXTURES IN EACH MATERIAL LIBRARY.
+        for (const std::filesystem::path& material_filepath : material_filepaths)
+        {
+            referenced_filepaths.emplace_back(material_filepath);
+
+            std::unique_ptr<MemoryMappedFile> material_file = MemoryMappedFile::Open(material_filepath);
+            if (!material_file)
+            {
+                continue;
+            }
+            const char* material_file_end = reinterpret_cast<const char*>(material_file->Data) + material_file->SizeInBytes;
+            const char* material_line_begin = reinterpret_cast<const char*>(material_file->Data);
+            while (material_line_begin < material_file_end)
+            {
+                const char* line_end = FindLineEnd(material_line_begin, material_file_end);
+                const char* position = material_line_begin;
+                std::string_view record_type = ReadToken(position, line_end);
+                if ("map_Kd" == record_type)
+                {
+                    std::string_view texture_filename = ReadRestOfLine(position, line_end);
+                    bool texture_options_given = !texture_filename.empty() && ('-' == texture_filename.front());
+                    if (!texture_options_given)
+                    {
+                        std::filesystem::path texture_filepath = material_filepath.parent_path() / std::filesystem::path(texture_filename);
+                        referenced_filepaths.emplace_back(texture_filepath);
+                    }
+                }
+                material_line_begin = (line_end < material_file_end) ? line_end + 1 : material_file_end;
+            }
+        }
+
+        return referenced_filepaths;
+    }
+
+    /// Compares two models, such as from different parsers, to find the first way they differ.
+    /// Materials and textures are compared by their contents rather than their addresses.
+    /// @param[in]  expected_model - The model to compare against.
+    /// @param[in]  actual_model - The model to compare.
+    /// @return A description of the first difference found; empty if the models are identical.
+    std::string WavefrontObjectParser::DescribeFirstDifference(
+        const GRAPHICS::MODELING::Model& expected_model,
+        const GRAPHICS::MODELING::Model& actual_model)
+    {
+        // COMPARE THE SET OF MESHES.
+        if (expected_model.MeshesByName.size() != actual_model.MeshesByName.size())
+        {
+            return "Mesh count " + std::to_string(actual_model.MeshesByName.size()) + " instead of " + std::to_string(expected_model.MeshesByName.size());
+        }
+
+        // COMPARE EACH MESH.
+        // The same pair of materials is typically shared by many triangles, so each pair is only compared once.
+        std::map<std::pair<const GRAPHICS::Material*, const GRAPHICS::Material*>, std::string> material_differences;
+        for (const auto& [mesh_key, expected_mesh] : expected_model.MeshesByName)
+        {
+            auto actual_mesh_entry = actual_model.MeshesByName.find(mesh_key);
+            if (actual_model.MeshesByName.end() == actual_mesh_entry)
+            {
+                return "Missing mesh '" + mesh_key + "'";
+            }
+            const GRAPHICS::Mesh& actual_mesh = actual_mesh_entry->second;
+            std::string mesh_description = "Mesh '" + mesh_key + "'";
+            if (expected_mesh.Name != actual_mesh.Name)
+            {
+                return mesh_description + " named '" + actual_mesh.Name + "' instead of '" + expected_mesh.Name + "'";
+            }
+            if (expected_mesh.Visible != actual_mesh.Visible)
+            {
+                return mesh_description + " has different visibility";
+            }
+            if (expected_mesh.Triangles.size() != actual_mesh.Triangles.size())
+            {
+                return mesh_description + " has " + std::to_string(actual_mesh.Triangles.size()) + " triangles instead of " + std::to_string(expected_mesh.Triangles.size());
+            }
+
+            // COMPARE EACH TRIANGLE.
+            for (std::size_t triangle_index = 0; triangle_index < expected_mesh.Triangles.size(); ++triangle_index)
+            {
+                const GRAPHICS::GEOMETRY::Triangle& expected_triangle = expected_mesh.Triangles[triangle_index];
+                const GRAPHICS::GEOMETRY::Triangle& actual_triangle = actual_mesh.Triangles[triangle_index];
+                std::string triangle_description = mesh_description + " triangle " + std::to_string(triangle_index);
+                for (std::size_t vertex_index = 0; vertex_index < RENDERING::IndexedMesh::VERTICES_PER_TRIANGLE; ++vertex_index)
+                {
+                    if (!VerticesEqual(expected_triangle.Vertices[vertex_index], actual_triangle.Vertices[vertex_index]))
+                    {
+                        return triangle_description + " vertex " + std::to_string(vertex_index) + " differs";
+                    }
+                }
+
+                std::pair<const GRAPHICS::Material*, const GRAPHICS::Material*> materials(expected_triangle.Material.get(), actual_triangle.Material.get());
+                auto material_difference = material_differences.find(materials);
+                if (material_differences.end() == material_difference)
+                {
+                    material_difference = material_differences.emplace(materials, DescribeMaterialDifference(materials.first, materials.second)).first;
+                }
+                if (!material_difference->second.empty())
+                {
+                    return triangle_description + " material " + material_difference->second;
+                }
+            }
+        }
+
+        return "";
+    }
+
+    /// Parses all records in a chunk of a file.
+    /// @param[in]  chunk_begin - The start of the chunk, at the start of a line.
+    /// @param[in]  chunk_end - The end of the chunk, at the end of the file or just after a line ends.
+    /// @param[in]  file_size_in_bytes - The size of the entire file, for reporting progress.
+    /// @param[in,out]  parsed_size_in_bytes - The amount of the file parsed by all chunks so far, for reporting progress.
+    /// @param[in,out]  progress - The progress of the load.  Parsing stops early if cancellation is requested.
+    /// @param[out] chunk - The parsed chunk.  Marked invalid if any records weren't supported or parsing was cancelled.
+    void WavefrontObjectParser::ParseChunk(
+        const char* const chunk_begin,
+        const char* const chunk_end,
+        const std::size_t file_size_in_bytes,
+        std::atomic<std::size_t>& parsed_size_in_bytes,
+        LoadProgress& progress,
+        ParsedChunk& chunk)
+    {
+        // Progress is only reported every so often to keep threads from contending over it.
+        constexpr std::size_t PROGRESS_INTERVAL_IN_BYTES = std::size_t(1) << 20;
+        const char* last_reported_position = chunk_begin;
+        const char* line_begin = chunk_begin;
+        while (line_begin < chunk_end)
+        {
+            // PARSE THE NEXT RECORD.
+            const char* line_end = FindLineEnd(line_begin, chunk_end);
+            const char* position = line_begin;
+            std::string_view record_type = ReadToken(position, line_end);
+            bool record_valid = true;
+            if (record_type.empty() || ('#' == record_type.front()))
+            {
+                // Blank lines and comments have no data.
+            }
+            else if ("v" == record_type)
+            {
+                float coordinates[3] = {};
+                record_valid = ReadFloats(position, line_end, 3, coordinates) && AtLineEnd(position, line_end);
+                chunk.Positions.emplace_back(coordinates[0], coordinates[1], coordinates[2]);
+            }
+            else if ("vt" == record_type)
+            {
+                float coordinates[2] = {};
+                record_valid = ReadFloats(position, line_end, 2, coordinates) && AtLineEnd(position, line_end);
+                chunk.TextureCoordinates.emplace_back(coordinates[0], coordinates[1]);
+            }
+            else if ("vn" == record_type)
+            {
+                float coordinates[3] = {};
+                record_valid = ReadFloats(position, line_end, 3, coordinates) && AtLineEnd(position, line_end);
+                chunk.Normals.emplace_back(coordinates[0], coordinates[1], coordinates[2]);
+            }
+            else if ("f" == record_type)
+            {
+                for (std::size_t vertex_index = 0; record_valid && vertex_index < RENDERING::IndexedMesh::VERTICES_PER_TRIANGLE; ++vertex_index)
+                {
+                    record_valid = ParseFaceCorner(position, line_end, chunk.FaceCorners.emplace_back());
+                }
+                record_valid = record_valid && AtLineEnd(position, line_end);
+            }
+            else if (("o" == record_type) || ("g" == record_type) || ("usemtl" == record_type) || ("mtllib" == record_type))
+            {
+                StateChange& state_change = chunk.StateChanges.emplace_back();
+                state_change.FaceIndex = chunk.FaceCorners.size() / RENDERING::IndexedMesh::VERTICES_PER_TRIANGLE;
+                state_change.Argument = ReadRestOfLine(position, line_end);
+                if ("usemtl" == record_type)
+                {
+                    state_change.Type = StateChangeType::MATERIAL;
+                }
+                else if ("mtllib" == record_type)
+                {
+                    state_change.Type = StateChangeType::MATERIAL_LIBRARY;
+                }
+                else
+                {
+                    state_change.Type = StateChangeType::MESH;
+                }
+            }
+            else if ("s" == record_type)
+            {
+                // Smoothing groups don't affect anything since normals are given explicitly.
+            }
+            else
+            {
+                record_valid = false;
+            }
+
+            // STOP IF THE RECORD WASN'T SUPPORTED.
+            if (!record_valid)
+            {
+                chunk.Valid = false;
+                return;
+            }
+            line_begin = (line_end < chunk_end) ? line_end + 1 : chunk_end;
+
+            // REPORT PROGRESS.
+            std::size_t unreported_size_in_bytes = static_cast<std::size_t>(line_begin - last_reported_position);
+            if (unreported_size_in_bytes >= PROGRESS_INTERVAL_IN_BYTES)
+            {
+                std::size_t total_parsed_size_in_bytes = (parsed_size_in_bytes += unreported_size_in_bytes);
+                last_reported_position = line_begin;
+                progress.CompletedProportion = static_cast<float>(static_cast<double>(total_parsed_size_in_bytes) / static_cast<double>(file_size_in_bytes));
+                if (progress.CancelRequested)
+                {
+                    chunk.Valid = false;
+                    return;
+                }
+            }
+        }
+    }
+
+    /// Loads the materials from a Wavefront .mtl material library.
+    /// @param[in]  filepath - The path of the material library.
+    /// @param[in,out]  materials_by_name - The materials to add to.  Materials with the same name as existing ones replace them.
+    /// @return True if the library was read and only used supported records; false otherwise.
+    bool WavefrontObjectParser::LoadMaterials(const std::filesystem::path& filepath, MaterialsByName& materials_by_name)
+    {
+        // MAP THE FILE.
+        std::unique_ptr<MemoryMappedFile> file = MemoryMappedFile::Open(filepath);
+        if (!file)
+        {
+            return false;
+        }
+        const char* file_end = reinterpret_cast<const char*>(file->Data) + file->SizeInBytes;
+
+        // PARSE EACH RECORD.
+        std::shared_ptr<GRAPHICS::Material> current_material = nullptr;
+        const char* line_begin = reinterpret_cast<const char*>(file->Data);
+        while (line_begin < file_end)
+        {
+            const char* line_end = FindLineEnd(line_begin, file_end);
+            const char* position = line_begin;
+            std::string_view record_type = ReadToken(position, line_end);
+            line_begin = (line_end < file_end) ? line_end + 1 : file_end;
+
+            // SKIP LINES WITHOUT MATERIAL PROPERTIES.
+            bool ignored_record =
+                record_type.empty() ||
+                ('#' == record_type.front()) ||
+                ("d" == record_type) ||
+                ("Tr" == record_type) ||
+                ("Ni" == record_type) ||
+                ("illum" == record_type) ||
+                ("Tf" == record_type);
+            if (ignored_record)
+            {
+                continue;
+            }
+
+            // START A NEW MATERIAL IF APPLICABLE.
+            if ("newmtl" == record_type)
+            {
+                current_material = std::make_shared<GRAPHICS::Material>();
+                current_material->Name = ReadRestOfLine(position, line_end);
+                current_material->Shading = GRAPHICS::SHADING::ShadingType::MATERIAL;
+                materials_by_name[current_material->Name] = current_material;
+                continue;
+            }
+
+            // READ THE CURRENT MATERIAL'S PROPERTY.
+            // Properties outside of any material aren't supported.
+            if (!current_material)
+            {
+                return false;
+            }
+            bool property_valid = false;
+            if (("Ka" == record_type) || ("Kd" == record_type) || ("Ks" == record_type) || ("Ke" == record_type))
+            {
+                float components[3] = {};
+                property_valid = ReadFloats(position, line_end, 3, components) && AtLineEnd(position, line_end);
+                GRAPHICS::Color color(components[0], components[1], components[2], 1.0f);
+                if ("Ka" == record_type)
+                {
+                    current_material->AmbientProperties.Color = color;
+                }
+                else if ("Kd" == record_type)
+                {
+                    current_material->DiffuseProperties.Color = color;
+                }
+                else if ("Ks" == record_type)
+                {
+                    current_material->SpecularProperties.Color = color;
+                }
+                else
+                {
+                    current_material->EmissiveColor = color;
+                }
+            }
+            else if ("Ns" == record_type)
+            {
+                property_valid = ReadFloats(position, line_end, 1, &current_material->SpecularProperties.SpecularPower) && AtLineEnd(position, line_end);
+            }
+            else if ("map_Kd" == record_type)
+            {
+                // Texture options (like scaling) aren't supported.
+                std::string_view texture_filename = ReadRestOfLine(position, line_end);
+                bool texture_options_given = !texture_filename.empty() && ('-' == texture_filename.front());
+                if (!texture_options_given)
+                {
+                    std::filesystem::path texture_filepath = filepath.parent_path() / std::filesystem::path(texture_filename);
+                    current_material->DiffuseProperties.Texture = TextureCache::LoadPng(texture_filepath);
+                    property_valid = (nullptr != current_material->DiffuseProperties.Texture);
+                }
+            }
+
+            if (!property_valid)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /// Parses a single corner of a face, in any of the v, v/vt, v//vn, or v/vt/vn forms.
+    /// @param[in,out]  position - The position to parse from.  Updated to just after the corner.
+    /// @param[in]  line_end - The end of the line.
+    /// @param[out] corner - The parsed corner.
+    /// @return True if a supported corner was parsed; false otherwise.
+    bool WavefrontObjectParser::ParseFaceCorner(const char*& position, const char* const line_end, FaceCorner& corner)
+    {
+        // READ THE POSITION INDEX.
+        SkipSpaces(position, line_end);
+        if (!ReadIndex(position, line_end, corner.PositionIndex))
+        {
+            return false;
+        }
+
+        // READ THE TEXTURE COORDINATE INDEX IF ONE EXISTS.
+        if ((position < line_end) && ('/' == *position))
+        {
+            ++position;
+            bool texture_coordinate_index_exists = (position < line_end) && ('/' != *position);
+            if (texture_coordinate_index_exists && !ReadIndex(position, line_end, corner.TextureCoordinateIndex))
+            {
+                return false;
+            }
+
+            // READ THE NORMAL INDEX IF ONE EXISTS.
+            if ((position < line_end) && ('/' == *position))
+            {
+                ++position;
+                if (!ReadIndex(position, line_end, corner.NormalIndex))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return AtTokenEnd(position, line_end);
+    }
+
+    /// Reads floating-point numbers separated by spaces.
+    /// Numbers are parsed with the same correct rounding as standard stream extraction, but without any allocations or locale lookups.
+    /// @param[in,out]  position - The position to read from.  Updated to just after the last number.
+    /// @param[in]  line_end - The end of the line.
+    /// @param[in]  count - The number of numbers to read.
+    /// @param[out] values - The numbers read.
+    /// @return True if all numbers were read; false otherwise.
+    bool WavefrontObjectParser::ReadFloats(const char*& position, const char* const line_end, const std::size_t count, float* values)
+    {
+        for (std::size_t value_index = 0; value_index < count; ++value_index)
+        {
+            SkipSpaces(position, line_end);
+            std::from_chars_result result = std::from_chars(position, line_end, values[value_index]);
+            bool value_read = (std::errc() == result.ec) && AtTokenEnd(result.ptr, line_end);
+            if (!value_read)
+            {
+                return false;
+            }
+            position = result.ptr;
+        }
+        return true;
+    }
+
+    /// Reads a positive 1-based index.
+    /// @param[in,out]  position - The position to read from.  Updated to just after the index.
+    /// @param[in]  line_end - The end of the line.
+    /// @param[out] index - The index read.
+    /// @return True if a positive index was read; false otherwise (including for relative negative indices, which aren't supported).
+    bool WavefrontObjectParser::ReadIndex(const char*& position, const char* const line_end, uint32_t& index)
+    {
+        std::from_chars_result result = std::from_chars(position, line_end, index);
+        bool index_read = (std::errc() == result.ec) && (index > 0);
+        position = result.ptr;
+        return index_read;
+    }
+
+    /// Reads the next token of non-space characters.
+    /// @param[in,out]  position - The position to read from.  Updated to just after the token.
+    /// @param[in]  line_end - The end of the line.
+    /// @return The token; empty if the line has no more tokens.
+    std::string_view WavefrontObjectParser::ReadToken(const char*& position, const char* const line_end)
+    {
+        SkipSpaces(position, line_end);
+        const char* token_begin = position;
+        while (!AtTokenEnd(position, line_end))
+        {
+            ++position;
+        }
+        return std::string_view(token_begin, static_cast<std::size_t>(position - token_begin));
+    }
+
+    /// Reads the rest of a line, such as a name that may contain spaces.
+    /// @param[in,out]  position - The position to read from.  Updated to the end of the line.
+    /// @param[in]  line_end - The end of the line.
+    /// @return The rest of the line without leading or trailing spaces.
+    std::string_view WavefrontObjectParser::ReadRestOfLine(const char*& position, const char* const line_end)
+    {
+        SkipSpaces(position, line_end);
+        const char* text_begin = position;
+        const char* text_end = line_end;
+        while ((text_end > text_begin) && AtTokenEnd(text_end - 1, line_end))
+        {
+            --text_end;
+        }
+        position = line_end;
+        return std::string_view(text_begin, static_cast<std::size_t>(text_end - text_begin));
+    }
+
+    /// Skips past any spaces.
+    /// @param[in,out]  position - The position to skip from.  Updated to the next non-space character or the end of the line.
+    /// @param[in]  line_end - The end of the line.
+    void WavefrontObjectParser::SkipSpaces(const char*& position, const char* const line_end)
+    {
+        while ((position < line_end) && AtTokenEnd(position, line_end))
+        {
+            ++position;
+        }
+    }
+
+    /// Determines if a position is at the end of a token.
+    /// Carriage returns count as spaces so that files with Windows line endings are handled.
+    /// @param[in]  position - The position to check.
+    /// @param[in]  line_end - The end of the line.
+    /// @return True if the position is at a space or the end of the line; false otherwise.
+    bool WavefrontObjectParser::AtTokenEnd(const char* const position, const char* const line_end)
+    {
+        if (position >= line_end)
+        {
+            return true;
+        }
+
+        char character = *position;
+        bool is_space = (' ' == character) || ('\t' == character) || ('\r' == character);
+        return is_space;
+    }
+
+    /// Determines if only spaces remain in a line.
+    /// @param[in]  position - The position to check from.
+    /// @param[in]  line_end - The end of the line.
+    /// @return True if nothing but spaces remain; false otherwise.
+    bool WavefrontObjectParser::AtLineEnd(const char* position, const char* const line_end)
+    {
+        SkipSpaces(position, line_end);
+        return (position == line_end);
+    }
+
+    /// Finds the end of the line containing a position.
+    /// @param[in]  position - The position within the line.
+    /// @param[in]  end - The end of the data containing the line.
+    /// @return The newline ending the line; the end of the data if there is no newline.
+    const char* WavefrontObjectParser::FindLineEnd(const char* const position, const char* const end)
+    {
+        const void* newline = std::memchr(position, '\n', static_cast<std::size_t>(end - position));
+        return newline ? static_cast<const char*>(newline) : end;
+    }
+
+    /// Runs tasks in parallel, each on its own thread.
+    /// Models are loaded on a background thread rather than the rendering thread pool, so threads are started for each load.
+    /// @param[in]  task_count - The number of tasks to run.
+    /// @param[in]  task - The function to run each task.  The calling thread runs the first task.
+    void WavefrontObjectParser::RunInParallel(const std::size_t task_count, const std::function<void(const std::size_t task_index)>& task)
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(task_count);
+        for (std::size_t task_index = 1; task_index < task_count; ++task_index)
+        {
+            threads.emplace_back(task, task_index);
+        }
+        if (task_count > 0)
+        {
+            task(0);
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    /// Compares the contents of two materials.
+    /// @param[in]  expected_material - The material to compare against.  May be null.
+    /// @param[in]  actual_material - The material to compare.  May be null.
+    /// @return A description of the first difference found; empty if the materials are identical.
+    std::string WavefrontObjectParser::DescribeMaterialDifference(const GRAPHICS::Material* const expected_material, const GRAPHICS::Material* const actual_material)
+    {
+        // COMPARE MISSING MATERIALS.
+        if (!expected_material || !actual_material)
+        {
+            bool both_missing = (!expected_material && !actual_material);
+            return both_missing ? "" : "is missing in only one model";
+        }
+
+        // COMPARE BASIC PROPERTIES.
+        std::string material_description = "'" + expected_material->Name + "'";
+        bool properties_equal =
+            (expected_material->Name == actual_material->Name) &&
+            (expected_material->Shading == actual_material->Shading) &&
+            ColorsEqual(expected_material->AmbientProperties.Color, actual_material->AmbientProperties.Color) &&
+            ColorsEqual(expected_material->DiffuseProperties.Color, actual_material->DiffuseProperties.Color) &&
+            ColorsEqual(expected_material->SpecularProperties.Color, actual_material->SpecularProperties.Color) &&
+            (expected_material->SpecularProperties.SpecularPower == actual_material->SpecularProperties.SpecularPower) &&
+            (expected_material->ReflectivityProportion == actual_material->ReflectivityProportion) &&
+            ColorsEqual(expected_material->EmissiveColor, actual_material->EmissiveColor);
+        if (!properties_equal)
+        {
+            return material_description + " has different properties";
+        }
+
+        // COMPARE TEXTURES.
+        const GRAPHICS::IMAGES::Bitmap* expected_texture = expected_material->DiffuseProperties.Texture.get();
+        const GRAPHICS::IMAGES::Bitmap* actual_texture = actual_material->DiffuseProperties.Texture.get();
+        if (!expected_texture || !actual_texture)
+        {
+            bool both_missing = (!expected_texture && !actual_texture);
+            return both_missing ? "" : material_description + " has a texture in only one model";
+        }
+        bool textures_equal =
+            (expected_texture->GetWidthInPixels() == actual_texture->GetWidthInPixels()) &&
+            (expected_texture->GetHeightInPixels() == actual_texture->GetHeightInPixels()) &&
+            (TextureCache::ComputeContentHash(expected_texture->GetWidthInPixels(), expected_texture->GetHeightInPixels(), expected_texture->GetRawData()) ==
+                TextureCache::ComputeContentHash(actual_texture->GetWidthInPixels(), actual_texture->GetHeightInPixels(), actual_texture->GetRawData()));
+        if (!textures_equal)
+        {
+            return material_description + " has a different texture";
+        }
+
+        return "";
+    }
+
+    /// Compares all attributes of two vertices.
+    /// @param[in]  expected_vertex - The vertex to compare against.
+    /// @param[in]  actual_vertex - The vertex to compare.
+    /// @return True if all attributes are exactly equal; false otherwise.
+    bool WavefrontObjectParser::VerticesEqual(const GRAPHICS::VertexWithAttributes& expected_vertex, const GRAPHICS::VertexWithAttributes& actual_vertex)
+    {
+        bool vertices_equal =
+            (expected_vertex.Position.X == actual_vertex.Position.X) &&
+            (expected_vertex.Position.Y == actual_vertex.Position.Y) &&
+            (expected_vertex.Position.Z == actual_vertex.Position.Z) &&
+            (expected_vertex.Normal.X == actual_vertex.Normal.X) &&
+            (expected_vertex.Normal.Y == actual_vertex.Normal.Y) &&
+            (expected_vertex.Normal.Z == actual_vertex.Normal.Z) &&
+            (expected_vertex.TextureCoordinates.X == actual_vertex.TextureCoordinates.X) &&
+            (expected_vertex.TextureCoordinates.Y == actual_vertex.TextureCoordinates.Y) &&
+            ColorsEqual(expected_vertex.Color, actual_vertex.Color);
+        return vertices_equal;
+    }
+
+    /// Compares all components of two colors.
+    /// @param[in]  expected_color - The color to compare against.
+    /// @param[in]  actual_color - The color to compare.
+    /// @return True if all components are exactly equal; false otherwise.
+    bool WavefrontObjectParser::ColorsEqual(const GRAPHICS::Color& expected_color, const GRAPHICS::Color& actual_color)
+    {
+        bool colors_equal =
+            (expected_color.Red == actual_color.Red) &&
+            (expected_color.Green == actual_color.Green) &&
+            (expected_color.Blue == actual_color.Blue) &&
+            (expected_color.Alpha == actual_color.Alpha);
+        return colors_equal;
+    }
+}
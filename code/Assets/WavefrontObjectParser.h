@@ -0,0 +1,150 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Assets/LoadProgress.h"
+#include "Graphics/Material.h"
+#include "Graphics/Modeling/Model.h"
+#include "Math/Vector2.h"
+#include "Math/Vector3.h"
+
+namespace ASSETS
+{
+    /// A parallel parser for Wavefront .obj models and their .mtl material libraries,
+    /// producing the same models as GRAPHICS::MODELING::WavefrontObjectModel::Load() much faster for large files.
+    ///
+    /// The file is memory-mapped and split into one chunk per core on line boundaries.  Chunks are tokenized in parallel
+    /// directly from the mapped memory (without building strings), each into its own arrays of vertex attributes and faces.
+    /// Since face indices refer to attributes across the entire file, triangles are only built once all chunks are parsed,
+    /// again in parallel, directly into their final places in the model's meshes.
+    ///
+    /// Only the commonly used subset of the format is supported:
+    /// - v, vt, and vn records with 3, 2, and 3 components.
+    /// - f records with exactly 3 corners using positive indices, in any of the v, v/vt, v//vn, or v/vt/vn forms.
+    /// - o and g records, which start (or continue) the mesh with the given name.
+    /// - usemtl and mtllib records.
+    /// - s records and comments, which are ignored.
+    /// Material libraries use newmtl, Ka, Kd, Ks, Ke, Ns, and map_Kd records; d, Tr, Ni, illum, and Tf records
+    /// don't map to any material properties and are ignored.
+    ///
+    /// Anything else makes parsing fail, so that the caller can fall back to the graphics library's parser
+    /// rather than risk loading a model differently.
+    class WavefrontObjectParser
+    {
+    public:
+        /// The minimum size of a chunk parsed by a single thread.  Smaller files are parsed by fewer threads
+        /// since the overhead of starting threads would outweigh the parallel speedup.
+        static constexpr std::size_t MIN_CHUNK_SIZE_IN_BYTES = std::size_t(1) << 20;
+
+        // LOADING.
+        static std::optional<GRAPHICS::MODELING::Model> Load(const std::filesystem::path& filepath, LoadProgress& progress);
+        static std::vector<std::filesystem::path> FindReferencedFiles(const std::filesystem::path& filepath);
+
+        // VERIFICATION.
+        static std::string DescribeFirstDifference(
+            const GRAPHICS::MODELING::Model& expected_model,
+            const GRAPHICS::MODELING::Model& actual_model);
+
+    private:
+        /// The attribute indices for a single corner of a face, as given in the file.
+        /// Indices in the file are 1-based, so 0 indicates that an attribute wasn't given.
+        struct FaceCorner
+        {
+            /// The 1-based index of the corner's position.
+            uint32_t PositionIndex = 0;
+            /// The 1-based index of the corner's texture coordinates; 0 if not given.
+            uint32_t TextureCoordinateIndex = 0;
+            /// The 1-based index of the corner's normal; 0 if not given.
+            uint32_t NormalIndex = 0;
+        };
+
+        /// The kinds of records that change which mesh or material later faces use.
+        enum class StateChangeType
+        {
+            /// An o or g record starting a mesh.
+            MESH,
+            /// A usemtl record.
+            MATERIAL,
+            /// A mtllib record.
+            MATERIAL_LIBRARY
+        };
+
+        /// A record changing the state for later faces.
+        struct StateChange
+        {
+            /// The index (within its chunk) of the first face following the record.
+            std::size_t FaceIndex = 0;
+            /// The kind of record.
+            StateChangeType Type = StateChangeType::MESH;
+            /// The record's argument, within the mapped file.
+            std::string_view Argument = {};
+        };
+
+        /// The results of parsing a single chunk of a file.
+        struct ParsedChunk
+        {
+            /// True if the chunk only contained supported records; false if not.
+            bool Valid = true;
+            /// The positions from v records.
+            std::vector<MATH::Vector3f> Positions = {};
+            /// The texture coordinates from vt records.
+            std::vector<MATH::Vector2f> TextureCoordinates = {};
+            /// The normals from vn records.
+            std::vector<MATH::Vector3f> Normals = {};
+            /// The corners of all faces, 3 per face.
+            std::vector<FaceCorner> FaceCorners = {};
+            /// The state changes, in the order they appeared.
+            std::vector<StateChange> StateChanges = {};
+        };
+
+        /// Consecutive faces in a chunk that go into the same mesh with the same material.
+        struct FaceRun
+        {
+            /// The index (within its chunk) of the first face.
+            std::size_t FirstFaceIndex = 0;
+            /// The number of faces.
+            std::size_t FaceCount = 0;
+            /// The mesh the faces' triangles go into.
+            GRAPHICS::Mesh* Mesh = nullptr;
+            /// The index in the mesh of the first face's triangle.
+            std::size_t FirstTriangleIndex = 0;
+            /// The material for the faces; null if none.
+            std::shared_ptr<GRAPHICS::Material> Material = nullptr;
+        };
+
+        /// Materials by name, as loaded from material libraries.
+        using MaterialsByName = std::unordered_map<std::string, std::shared_ptr<GRAPHICS::Material>>;
+
+        // HELPER METHODS.
+        static void ParseChunk(
+            const char* const chunk_begin,
+            const char* const chunk_end,
+            const std::size_t file_size_in_bytes,
+            std::atomic<std::size_t>& parsed_size_in_bytes,
+            LoadProgress& progress,
+            ParsedChunk& chunk);
+        static bool LoadMaterials(const std::filesystem::path& filepath, MaterialsByName& materials_by_name);
+        static bool ParseFaceCorner(const char*& position, const char* const line_end, FaceCorner& corner);
+        static bool ReadFloats(const char*& position, const char* const line_end, const std::size_t count, float* values);
+        static bool ReadIndex(const char*& position, const char* const line_end, uint32_t& index);
+        static std::string_view ReadToken(const char*& position, const char* const line_end);
+        static std::string_view ReadRestOfLine(const char*& position, const char* const line_end);
+        static void SkipSpaces(const char*& position, const char* const line_end);
+        static bool AtTokenEnd(const char* const position, const char* const line_end);
+        static bool AtLineEnd(const char* position, const char* const line_end);
+        static const char* FindLineEnd(const char* const position, const char* const end);
+        static void RunInParallel(const std::size_t task_count, const std::function<void(const std::size_t task_index)>& task);
+        static std::string DescribeMaterialDifference(const GRAPHICS::Material* const expected_material, const GRAPHICS::Material* const actual_material);
+        static bool VerticesEqual(const GRAPHICS::VertexWithAttributes& expected_vertex, const GRAPHICS::VertexWithAttributes& actual_vertex);
+        static bool ColorsEqual(const GRAPHICS::Color& expected_color, const GRAPHICS::Color& actual_color);
+    };
+}
@@ -0,0 +1,119 @@
+#include <iostream>
+#include <string>
+#include "Benchmarking/BenchmarkOptions.h"
+
+namespace BENCHMARKING
+{
+    /// Parses options from the command line.
+    /// @param[in]  argument_count - The number of command line arguments, including the program name.
+    /// @param[in]  arguments - The command line arguments, including the program name.
+    /// @return The parsed options, if valid; null otherwise.
+    std::optional<BenchmarkOptions> BenchmarkOptions::Parse(const int argument_count, char* arguments[])
+    {
+        BenchmarkOptions options;
+        // Any thread counts specified replace the defaults rather than adding to them.
+        bool thread_counts_specified = false;
+
+        // PARSE EACH ARGUMENT.
+        // The first argument is skipped since it is the program name.
+        // All options currently require values.
+        for (int argument_index = 1; argument_index < argument_count; ++argument_index)
+        {
+            std::string argument = arguments[argument_index];
+
+            // MAKE SURE A VALUE EXISTS.
+            int value_index = argument_index + 1;
+            bool value_exists = (value_index < argument_count);
+            if (!value_exists)
+            {
+                std::cerr << "Missing value for " << argument << std::endl;
+                return std::nullopt;
+            }
+            std::string value = arguments[value_index];
+            argument_index = value_index;
+
+            // HANDLE THE CURRENT OPTION.
+            try
+            {
+                if ("--frames" == argument)
+                {
+                    options.FrameCount = static_cast<unsigned int>(std::stoul(value));
+                }
+                else if ("--warmup-frames" == argument)
+                {
+                    options.WarmupFrameCount = static_cast<unsigned int>(std::stoul(value));
+                }
+                else if ("--width" == argument)
+                {
+                    options.WidthInPixels = static_cast<unsigned int>(std::stoul(value));
+                }
+                else if ("--height" == argument)
+                {
+                    options.HeightInPixels = static_cast<unsigned int>(std::stoul(value));
+                }
+                else if ("--threads" == argument)
+                {
+                    if (!thread_counts_specified)
+                    {
+                        options.ThreadCounts.clear();
+                        thread_counts_specified = true;
+                    }
+                    options.ThreadCounts.emplace_back(static_cast<unsigned int>(std::stoul(value)));
+                }
+                else if ("--texture" == argument)
+                {
+                    options.TextureFilepath = value;
+                }
+                else if ("--model" == argument)
+                {
+                    options.ModelFilepaths.emplace_back(value);
+                }
+                else if ("--output" == argument)
+                {
+                    options.OutputFilepath = value;
+                }
+                else
+                {
+                    std::cerr << "Unknown option: " << argument << std::endl;
+                    return std::nullopt;
+                }
+            }
+            catch (const std::exception&)
+            {
+                std::cerr << "Invalid value for " << argument << ": " << value << std::endl;
+                return std::nullopt;
+            }
+        }
+
+        // VALIDATE THE OPTIONS.
+        bool dimensions_valid = (options.WidthInPixels > 0) && (options.HeightInPixels > 0);
+        if (!dimensions_valid)
+        {
+            std::cerr << "Width and height must be greater than zero." << std::endl;
+            return std::nullopt;
+        }
+        if (0 == options.FrameCount)
+        {
+            std::cerr << "At least one frame must be measured." << std::endl;
+            return std::nullopt;
+        }
+
+        return options;
+    }
+
+    /// Prints usage information about the command line options.
+    void BenchmarkOptions::PrintUsage()
+    {
+        std::cout
+            << "Usage: 3DModelViewerBenchmark [options]\n"
+            << "  --frames <count>          Measured frames per scene and settings combination (default 30).\n"
+            << "  --warmup-frames <count>   Unmeasured frames rendered first (default 2).\n"
+            << "  --width <pixels>          Frame width (default 900).\n"
+            << "  --height <pixels>         Frame height (default 700).\n"
+            << "  --threads <count>         Threads for multithreaded renderers; 0 for all cores.  May be repeated (default 1 and 0).\n"
+            << "  --texture <path.png>      Texture for the textured quad scene.\n"
+            << "  --model <path.obj>        Additional model to benchmark.  May be repeated.\n"
+            << "  --output <path.json>      Results file (default benchmark_results.json).\n"
+            << std::flush;
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace BENCHMARKING
+{
+    /// The options for a benchmark run, as specified on the command line.
+    struct BenchmarkOptions
+    {
+        // PARSING.
+        static std::optional<BenchmarkOptions> Parse(const int argument_count, char* arguments[]);
+        static void PrintUsage();
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The number of measured frames for each scene and settings combination.
+        unsigned int FrameCount = 30;
+        /// The number of unmeasured frames to render first to warm up caches.
+        unsigned int WarmupFrameCount = 2;
+        /// The width of rendered frames.
+        unsigned int WidthInPixels = 900;
+        /// The height of rendered frames.
+        unsigned int HeightInPixels = 700;
+        /// The path to the texture for the textured quad scene.
+        std::filesystem::path TextureFilepath = "D:/temp/assets/test_texture.png";
+        /// The numbers of threads to benchmark multithreaded renderers with.  0 uses one thread per hardware core.
+        /// Comparing a single thread with all cores shows how well rendering scales.
+        std::vector<unsigned int> ThreadCounts = { 1, 0 };
+        /// Paths to additional (typically large) Wavefront .obj models to benchmark.
+        std::vector<std::filesystem::path> ModelFilepaths = {};
+        /// The path of the machine-readable results file.
+        std::filesystem::path OutputFilepath = "benchmark_results.json";
+    };
+}
@@ -0,0 +1,119 @@
+#include <fstream>
+#include "Benchmarking/BenchmarkResult.h"
+
+namespace BENCHMARKING
+{
+    /// Writes benchmark results to a JSON file for tracking performance over time.
+    /// @param[in]  results - The results to write.
+    /// @param[in]  filepath - The path of the file to write.
+    /// @return True if the file was written; false otherwise.
+    bool BenchmarkResult::WriteJson(const std::vector<BenchmarkResult>& results, const std::filesystem::path& filepath)
+    {
+        // OPEN THE FILE.
+        std::ofstream json_file(filepath);
+        if (!json_file)
+        {
+            return false;
+        }
+
+        // DEFINE HELPERS FOR WRITING VALUES.
+        auto write_string = [&](const std::string& text)
+        {
+            json_file << '"';
+            for (char character : text)
+            {
+                // ESCAPE CHARACTERS THAT ARE SPECIAL IN JSON.
+                // Other control characters aren't expected in scene names.
+                switch (character)
+                {
+                    case '"':
+                        json_file << "\\\"";
+                        break;
+                    case '\\':
+                        json_file << "\\\\";
+                        break;
+                    case '\n':
+                        json_file << "\\n";
+                        break;
+                    default:
+                        json_file << character;
+                        break;
+                }
+            }
+            json_file << '"';
+        };
+        auto write_bool = [&](const bool value)
+        {
+            json_file << (value ? "true" : "false");
+        };
+
+        // WRITE EACH RESULT.
+        json_file << "{\n  \"results\": [\n";
+        for (std::size_t result_index = 0; result_index < results.size(); ++result_index)
+        {
+            const BenchmarkResult& result = results[result_index];
+
+            json_file << "    {\n";
+
+            json_file << "      \"scene\": ";
+            write_string(result.SceneName);
+            json_file << ",\n";
+
+            bool is_ray_tracer = (GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RAY_TRACER == result.RenderingSettings.GraphicsDeviceType);
+            json_file << "      \"renderer\": ";
+            write_string(is_ray_tracer ? "cpu_ray_tracer" : "cpu_rasterizer");
+            json_file << ",\n";
+
+            json_file << "      \"width\": " << result.WidthInPixels << ",\n";
+            json_file << "      \"height\": " << result.HeightInPixels << ",\n";
+
+            json_file << "      \"settings\": {";
+            json_file << " \"cull_backfaces\": ";
+            write_bool(result.RenderingSettings.CullBackfaces);
+            json_file << ", \"depth_buffering\": ";
+            write_bool(result.RenderingSettings.DepthBuffering);
+            json_file << ", \"shadows_enabled\": ";
+            write_bool(result.RenderingSettings.Shading.Lighting.ShadowsEnabled);
+            json_file << ", \"reflections\": ";
+            write_bool(result.RenderingSettings.Reflections);
+            json_file << ", \"max_reflection_count\": " << result.RenderingSettings.MaxReflectionCount;
+            json_file << " },\n";
+
+            const RENDERING::CpuRenderingSettings& cpu_rendering_settings = result.CpuRenderingSettings;
+            json_file << "      \"cpu_settings\": {";
+            json_file << " \"thread_count\": " << cpu_rendering_settings.ThreadCount;
+            json_file << ", \"tile_size_in_pixels\": " << cpu_rendering_settings.TileSizeInPixels;
+            json_file << ", \"binning_rasterization\": ";
+            write_bool(cpu_rendering_settings.BinningRasterization);
+            // The SIMD setting is part of the graphics library's settings, but it only changes how CPU rendering work is done.
+            json_file << ", \"use_cpu_simd\": ";
+            write_bool(result.RenderingSettings.UseCpuSimd);
+            json_file << ", \"progressive_ray_tracing\": ";
+            write_bool(cpu_rendering_settings.ProgressiveRayTracing);
+            json_file << ", \"mipmapped_texture_sampling\": ";
+            write_bool(cpu_rendering_settings.MipmappedTextureSampling);
+            json_file << ", \"levels_of_detail\": ";
+            write_bool(cpu_rendering_settings.LevelsOfDetail);
+            json_file << ", \"level_of_detail_pixels_per_triangle\": " << cpu_rendering_settings.LevelOfDetailPixelsPerTriangle;
+            json_file << ", \"frustum_culling\": ";
+            write_bool(cpu_rendering_settings.FrustumCulling);
+            json_file << ", \"hierarchical_depth_culling\": ";
+            write_bool(cpu_rendering_settings.HierarchicalDepthCulling);
+            json_file << " },\n";
+
+            json_file << "      \"frame_count\": " << result.Statistics.FrameCount << ",\n";
+            json_file << "      \"min_ms\": " << result.Statistics.MinInMilliseconds << ",\n";
+            json_file << "      \"median_ms\": " << result.Statistics.MedianInMilliseconds << ",\n";
+            json_file << "      \"p99_ms\": " << result.Statistics.P99InMilliseconds << ",\n";
+            json_file << "      \"mean_ms\": " << result.Statistics.MeanInMilliseconds << ",\n";
+            json_file << "      \"pixels_per_second\": " << result.Statistics.PixelsPerSecond << "\n";
+
+            bool is_last_result = (result_index + 1 == results.size());
+            json_file << (is_last_result ? "    }\n" : "    },\n");
+        }
+        json_file << "  ]\n}\n";
+
+        bool file_written = json_file.good();
+        return file_written;
+    }
+}
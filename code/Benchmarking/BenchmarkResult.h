@@ -0,0 +1,33 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "Benchmarking/FrameTimeStatistics.h"
+#include "Graphics/RenderingSettings.h"
+#include "Rendering/CpuRenderingSettings.h"
+
+namespace BENCHMARKING
+{
+    /// The measured performance for rendering a single scene with a single combination of settings.
+    struct BenchmarkResult
+    {
+        // WRITING.
+        static bool WriteJson(const std::vector<BenchmarkResult>& results, const std::filesystem::path& filepath);
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The name of the scene that was rendered.
+        std::string SceneName = "";
+        /// The settings the scene was rendered with.
+        GRAPHICS::RenderingSettings RenderingSettings = {};
+        /// The CPU rendering settings the scene was rendered with.
+        /// The thread count is the number of threads actually used rather than 0 for all cores.
+        RENDERING::CpuRenderingSettings CpuRenderingSettings = {};
+        /// The width of rendered frames.
+        unsigned int WidthInPixels = 0;
+        /// The height of rendered frames.
+        unsigned int HeightInPixels = 0;
+        /// The frame time statistics.
+        FrameTimeStatistics Statistics = {};
+    };
+}
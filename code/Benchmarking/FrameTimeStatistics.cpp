@@ -0,0 +1,52 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include "Benchmarking/FrameTimeStatistics.h"
+
+namespace BENCHMARKING
+{
+    /// Computes statistics for the frame times.
+    /// @param[in]  frame_times_in_milliseconds - The frame times to summarize.  Taken by value since they need to be sorted.
+    /// @param[in]  pixel_count_per_frame - The number of pixels rendered in each frame.
+    /// @return The statistics for the frame times.
+    FrameTimeStatistics FrameTimeStatistics::Compute(std::vector<double> frame_times_in_milliseconds, const std::size_t pixel_count_per_frame)
+    {
+        // HANDLE THE CASE OF NO FRAMES.
+        FrameTimeStatistics statistics;
+        if (frame_times_in_milliseconds.empty())
+        {
+            return statistics;
+        }
+
+        // SORT THE FRAME TIMES TO ALLOW COMPUTING PERCENTILES.
+        std::sort(frame_times_in_milliseconds.begin(), frame_times_in_milliseconds.end());
+        statistics.FrameCount = frame_times_in_milliseconds.size();
+
+        // COMPUTE PERCENTILES.
+        // The nearest-rank method is used so that each percentile is an actual measured frame time.
+        auto percentile = [&](const double percent) -> double
+        {
+            double rank = std::ceil((percent / 100.0) * static_cast<double>(statistics.FrameCount));
+            std::size_t index = static_cast<std::size_t>(std::max(rank, 1.0)) - 1;
+            index = std::min(index, statistics.FrameCount - 1);
+            return frame_times_in_milliseconds[index];
+        };
+        statistics.MinInMilliseconds = frame_times_in_milliseconds.front();
+        statistics.MedianInMilliseconds = percentile(50.0);
+        statistics.P99InMilliseconds = percentile(99.0);
+
+        // COMPUTE AVERAGES.
+        double total_time_in_milliseconds = std::accumulate(frame_times_in_milliseconds.cbegin(), frame_times_in_milliseconds.cend(), 0.0);
+        statistics.MeanInMilliseconds = total_time_in_milliseconds / static_cast<double>(statistics.FrameCount);
+
+        constexpr double MILLISECONDS_PER_SECOND = 1000.0;
+        double total_time_in_seconds = total_time_in_milliseconds / MILLISECONDS_PER_SECOND;
+        if (total_time_in_seconds > 0.0)
+        {
+            double total_pixel_count = static_cast<double>(pixel_count_per_frame) * static_cast<double>(statistics.FrameCount);
+            statistics.PixelsPerSecond = total_pixel_count / total_time_in_seconds;
+        }
+
+        return statistics;
+    }
+}
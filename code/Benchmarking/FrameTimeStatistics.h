@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/// Holds code for measuring rendering performance.
+namespace BENCHMARKING
+{
+    /// Summary statistics for a series of frame times.
+    struct FrameTimeStatistics
+    {
+        // COMPUTATION.
+        static FrameTimeStatistics Compute(std::vector<double> frame_times_in_milliseconds, const std::size_t pixel_count_per_frame);
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The number of frames the statistics were computed from.
+        std::size_t FrameCount = 0;
+        /// The fastest frame time.
+        double MinInMilliseconds = 0.0;
+        /// The median (50th percentile) frame time.
+        double MedianInMilliseconds = 0.0;
+        /// The 99th percentile frame time.
+        double P99InMilliseconds = 0.0;
+        /// The average frame time.
+        double MeanInMilliseconds = 0.0;
+        /// The average rendering throughput in pixels per second.
+        double PixelsPerSecond = 0.0;
+    };
+}
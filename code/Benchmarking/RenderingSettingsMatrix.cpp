@@ -0,0 +1,91 @@
+#include <array>
+#include "Benchmarking/RenderingSettingsMatrix.h"
+
+namespace BENCHMARKING
+{
+    /// Creates all combinations of rendering settings to benchmark for the specified type of graphics device.
+    /// @param[in]  graphics_device_type - The type of graphics device to create settings for.
+    /// @param[in]  thread_counts - The numbers of threads to benchmark multithreaded renderers with.
+    /// @return The combinations of rendering settings, in a stable order across runs.
+    std::vector<RenderingSettingsCombination> RenderingSettingsMatrix::Create(
+        const GRAPHICS::HARDWARE::GraphicsDeviceType graphics_device_type,
+        const std::vector<unsigned int>& thread_counts)
+    {
+        constexpr std::array<bool, 2> BOOLEAN_VALUES = { false, true };
+        /// The reflection counts to benchmark when reflections are enabled.
+        /// These cover a cheap single bounce and a more expensive number of bounces.
+        constexpr std::array<unsigned int, 2> MAX_REFLECTION_COUNTS = { 1, 5 };
+
+        std::vector<RenderingSettingsCombination> settings_combinations;
+        RenderingSettingsCombination base_settings = {};
+        base_settings.RenderingSettings.GraphicsDeviceType = graphics_device_type;
+        // Each benchmarked frame is rendered fully rather than being refined over later frames.
+        base_settings.CpuRenderingSettings.ProgressiveRayTracing = false;
+
+        switch (graphics_device_type)
+        {
+            case GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RASTERIZER:
+            {
+                // VARY SETTINGS THAT AFFECT RASTERIZATION.
+                for (bool binning_rasterization : BOOLEAN_VALUES)
+                {
+                    // The graphics library's rasterizer only ever uses a single thread.
+                    const std::vector<unsigned int> SINGLE_THREAD_COUNT = { 1 };
+                    const std::vector<unsigned int>& rasterizer_thread_counts = binning_rasterization ? thread_counts : SINGLE_THREAD_COUNT;
+                    for (unsigned int thread_count : rasterizer_thread_counts)
+                    {
+                        for (bool use_cpu_simd : BOOLEAN_VALUES)
+                        {
+                            for (bool cull_backfaces : BOOLEAN_VALUES)
+                            {
+                                for (bool depth_buffering : BOOLEAN_VALUES)
+                                {
+                                    RenderingSettingsCombination settings = base_settings;
+                                    settings.CpuRenderingSettings.BinningRasterization = binning_rasterization;
+                                    settings.CpuRenderingSettings.ThreadCount = thread_count;
+                                    settings.RenderingSettings.UseCpuSimd = use_cpu_simd;
+                                    settings.RenderingSettings.CullBackfaces = cull_backfaces;
+                                    settings.RenderingSettings.DepthBuffering = depth_buffering;
+                                    settings_combinations.emplace_back(settings);
+                                }
+                            }
+                        }
+                    }
+                }
+                break;
+            }
+            case GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RAY_TRACER:
+            {
+                // VARY SETTINGS THAT AFFECT RAY TRACING.
+                for (unsigned int thread_count : thread_counts)
+                {
+                    for (bool shadows_enabled : BOOLEAN_VALUES)
+                    {
+                        RenderingSettingsCombination settings = base_settings;
+                        settings.CpuRenderingSettings.ThreadCount = thread_count;
+                        settings.RenderingSettings.Shading.Lighting.ShadowsEnabled = shadows_enabled;
+
+                        settings.RenderingSettings.Reflections = false;
+                        settings_combinations.emplace_back(settings);
+
+                        // The reflection count only matters if reflections are enabled.
+                        settings.RenderingSettings.Reflections = true;
+                        for (unsigned int max_reflection_count : MAX_REFLECTION_COUNTS)
+                        {
+                            settings.RenderingSettings.MaxReflectionCount = max_reflection_count;
+                            settings_combinations.emplace_back(settings);
+                        }
+                    }
+                }
+                break;
+            }
+            default:
+            {
+                // Other types of graphics devices are not benchmarked since they require a window.
+                break;
+            }
+        }
+
+        return settings_combinations;
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <vector>
+#include "Graphics/Hardware/GraphicsDeviceType.h"
+#include "Graphics/RenderingSettings.h"
+#include "Rendering/CpuRenderingSettings.h"
+
+namespace BENCHMARKING
+{
+    /// A single combination of settings to benchmark.
+    struct RenderingSettingsCombination
+    {
+        /// The settings for what is rendered.
+        GRAPHICS::RenderingSettings RenderingSettings = {};
+        /// The settings for how CPU rendering work is done.
+        RENDERING::CpuRenderingSettings CpuRenderingSettings = {};
+    };
+
+    /// The combinations of rendering settings to benchmark for a type of graphics device.
+    /// Only settings that affect a given renderer are varied for it so that time isn't wasted
+    /// measuring combinations that produce identical work (like shadows in the rasterizer).
+    class RenderingSettingsMatrix
+    {
+    public:
+        static std::vector<RenderingSettingsCombination> Create(
+            const GRAPHICS::HARDWARE::GraphicsDeviceType graphics_device_type,
+            const std::vector<unsigned int>& thread_counts);
+    };
+}
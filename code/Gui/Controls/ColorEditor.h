@@ -9,6 +9,6 @@ namespace GUI::CONTROLS
     class ColorEditor
     {
     public:
-        static void DisplayAndAllowEditing(const char* const color_label, GRAPHICS::Color& color);
+        static bool DisplayAndAllowEditing(const char* const color_label, GRAPHICS::Color& color);
     };
 }
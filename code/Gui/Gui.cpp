@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <commdlg.h>
 #include <imgui/backends/imgui_impl_dx11.h>
 #include <imgui/backends/imgui_impl_opengl3.h>
@@ -8,6 +9,9 @@
 #include "Graphics/CpuRendering/CpuGraphicsDevice.h"
 #include "Graphics/DirectX/Direct3DGraphicsDevice.h"
 #include "Gui/Gui.h"
+#include "Memory/ProcessMemoryUsage.h"
+#include "Profiling/Profiler.h"
+#include "Profiling/TraceRecorder.h"
 #include "Windowing/Win32Window.h"
 
 namespace GUI
@@ -29,36 +33,12 @@ namespace GUI
         ASSERT_THEN_IF(imgui_initialized)
         {
             // INITIALIZE PARTS OF THE IMGUI LIBRARY BASED ON THE TYPE OF GRAPHICS DEVICE.
-            GRAPHICS::HARDWARE::GraphicsDeviceType current_graphics_device_type = graphics_device.Type();
-            switch (current_graphics_device_type)
+            bool graphics_device_backend_initialized = InitializeGraphicsDeviceBackend(graphics_device);
+            if (!graphics_device_backend_initialized)
             {
-                case GRAPHICS::HARDWARE::CPU_RASTERIZER:
-                case GRAPHICS::HARDWARE::CPU_RAY_TRACER:
-                {
-                    imgui_sw::bind_imgui_painting();
-                    break;
-                }
-                case GRAPHICS::HARDWARE::OPEN_GL:
-                {
-                    bool imgui_open_gl_initializated = ImGui_ImplOpenGL3_Init();
-                    ASSERT_THEN_IF_NOT(imgui_open_gl_initializated)
-                    {
-                        return std::nullopt;
-                    }
-                    break;
-                }
-                case GRAPHICS::HARDWARE::DIRECT_3D:
-                {
-                    const GRAPHICS::DIRECT_X::Direct3DGraphicsDevice& direct_x_graphics_device = dynamic_cast<const GRAPHICS::DIRECT_X::Direct3DGraphicsDevice&>(graphics_device);
-                    bool imgui_direct_x_initialized = ImGui_ImplDX11_Init(direct_x_graphics_device.Device, direct_x_graphics_device.DeviceContext);
-                    ASSERT_THEN_IF_NOT(imgui_direct_x_initialized)
-                    {
-                        return std::nullopt;
-                    }
-                    break;
-                }
+                return std::nullopt;
             }
-            
+
             Gui gui;
             return gui;
         }
@@ -70,14 +50,21 @@ namespace GUI
 
     /// Updates and renders the GUI.
     /// @param[in,out]  graphics_device - The graphics device to use for rendering the GUI.
+    /// @param[in]  scene_rendered - True if the graphics device rendered a new image of the scene this frame;
+    ///     false if its rendered image is unchanged since the last frame.
     /// @param[in,out]  scene - The scene being controlled by the GUI.
     /// @param[in,out]  camera - The camera through which the scene is being viewed.
     /// @param[in,out]  rendering_settings - The settings for rendering to potentially update.
+    /// @param[in,out]  cpu_rendering_settings - The settings for scheduling CPU rendering work to potentially update.
+    /// @param[in,out]  model_loader - The loader of any models being loaded in the background.
     void Gui::UpdateAndRender(
         GRAPHICS::HARDWARE::IGraphicsDevice& graphics_device, 
+        const bool scene_rendered,
         GRAPHICS::Scene& scene,
         GRAPHICS::VIEWING::Camera& camera,
-        GRAPHICS::RenderingSettings& rendering_settings)
+        GRAPHICS::RenderingSettings& rendering_settings,
+        RENDERING::CpuRenderingSettings& cpu_rendering_settings,
+        ASSETS::AsyncModelLoader& model_loader)
     {
         // START THE NEW FRAME.
         ImGui_ImplWin32_NewFrame();
@@ -193,6 +180,37 @@ namespace GUI
                 {
                     ImGuiDemoWindowOpen = true;
                 }
+                if (ImGui::MenuItem("Profiler"))
+                {
+                    ProfilerWindow.IsOpen = true;
+                }
+                if (ImGui::MenuItem("Texture Cache"))
+                {
+                    TextureCacheWindow.IsOpen = true;
+                }
+                // The reference painter only applies to CPU graphics devices, where it allows checking the faster GUI painter's output.
+                ImGui::MenuItem("Reference GUI Painter", nullptr, &GuiLayer.UseReferencePainter);
+                // The trace is only written to its file once recording is stopped.
+                bool trace_recording = PROFILING::TraceRecorder::IsRecording();
+                if (ImGui::MenuItem("Record Trace", nullptr, trace_recording))
+                {
+                    if (trace_recording)
+                    {
+                        PROFILING::TraceRecorder::Stop();
+                    }
+                    else
+                    {
+                        PROFILING::TraceRecorder::Start();
+                    }
+                }
+                ImGui::Separator();
+                ImGui::Text("Heap Allocations Last Frame: %zu", HeapAllocationCountLastFrame);
+                // The peak shows memory needed only temporarily, such as for loading models.
+                MEMORY::ProcessMemoryUsage memory_usage = MEMORY::ProcessMemoryUsage::Get();
+                ImGui::Text(
+                    "Memory: %.1f MiB (Peak %.1f MiB)",
+                    static_cast<double>(memory_usage.CurrentBytes) / MEMORY::ProcessMemoryUsage::BYTES_PER_MEBIBYTE,
+                    static_cast<double>(memory_usage.PeakBytes) / MEMORY::ProcessMemoryUsage::BYTES_PER_MEBIBYTE);
                 ImGui::EndMenu();
             }
 
@@ -202,10 +220,13 @@ namespace GUI
         // RENDER THE VARIOUS WINDOWS IF APPLICABLE.
         GRAPHICS::HARDWARE::GraphicsDeviceType old_renderer_type = rendering_settings.GraphicsDeviceType;
 
-        RendererSettingsWindow.UpdateAndRender(rendering_settings, graphics_device);
+        RendererSettingsWindow.UpdateAndRender(rendering_settings, cpu_rendering_settings, graphics_device);
         CameraWindow.UpdateAndRender(camera);
 
         SceneWindow.UpdateAndRender(scene);
+        ModelLoadingWindow.UpdateAndRender(model_loader);
+        ProfilerWindow.UpdateAndRender();
+        TextureCacheWindow.UpdateAndRender();
 
         if (ImGuiDemoWindowOpen)
         {
@@ -226,10 +247,7 @@ namespace GUI
             case GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RAY_TRACER:
             {
                 GRAPHICS::CPU_RENDERING::CpuGraphicsDevice& cpu_graphics_device = dynamic_cast<GRAPHICS::CPU_RENDERING::CpuGraphicsDevice&>(graphics_device);
-                uint32_t* pixel_buffer = cpu_graphics_device.ColorBuffer.GetRawData();
-                int pixel_buffer_width_in_pixels = static_cast<int>(cpu_graphics_device.ColorBuffer.GetWidthInPixels());
-                int pixel_buffer_height_in_pixels = static_cast<int>(cpu_graphics_device.ColorBuffer.GetHeightInPixels());
-                imgui_sw::paint_imgui(pixel_buffer, pixel_buffer_width_in_pixels, pixel_buffer_height_in_pixels);
+                PaintSoftwareGui(cpu_graphics_device.ColorBuffer, scene_rendered);
                 break;
             }
             case GRAPHICS::HARDWARE::GraphicsDeviceType::OPEN_GL:
@@ -245,39 +263,188 @@ namespace GUI
                 break;
             }
         }
+    }
+
+    /// Erases the GUI composited onto a color buffer by a CPU graphics device, so that the color buffer holds just the scene.
+    /// This must be done before only part of the scene is re-rendered, since the rest of the color buffer is kept.
+    /// The scene must then be re-rendered before the GUI is next rendered, so that the GUI is composited again.
+    /// @param[in,out]  color_buffer - The color buffer the GUI was last composited onto.
+    void Gui::EraseSoftwareGui(GRAPHICS::IMAGES::Bitmap& color_buffer) const
+    {
+        // CHECK IF THE SAVED SCENE IS FOR THE COLOR BUFFER.
+        // If its size changed, the whole scene is re-rendered anyway.
+        bool scene_pixels_current = (ScenePixelsWidth == color_buffer.GetWidthInPixels()) && (ScenePixelsHeight == color_buffer.GetHeightInPixels());
+        if (!scene_pixels_current)
+        {
+            return;
+        }
+
+        // RESTORE THE SCENE UNDER THE GUI.
+        // The GUI was only composited within the saved area, so nothing outside of it needs to be restored.
+        RENDERING::ScreenRectangle erased_area = GuiLayer.Bounds.Intersection(SavedSceneArea);
+        RestoreScenePixels(color_buffer.GetRawData(), erased_area);
+    }
+
+    /// Switches the GUI to rendering with a different graphics device.
+    /// Only the parts of ImGui specific to the type of graphics device are re-initialized,
+    /// so GUI state (like open windows and their positions) is kept across the switch.
+    /// @param[in]  old_graphics_device_type - The type of graphics device the GUI was rendering with.
+    /// @param[in]  new_graphics_device - The graphics device to render the GUI with from now on.
+    /// @return True if the GUI can render with the new graphics device; false otherwise.
+    bool Gui::ChangeGraphicsDevice(
+        const GRAPHICS::HARDWARE::GraphicsDeviceType old_graphics_device_type,
+        const GRAPHICS::HARDWARE::IGraphicsDevice& new_graphics_device)
+    {
+        ShutdownGraphicsDeviceBackend(old_graphics_device_type);
+        bool graphics_device_backend_initialized = InitializeGraphicsDeviceBackend(new_graphics_device);
+        return graphics_device_backend_initialized;
+    }
+
+    /// Shuts down the GUI.
+    /// @param[in]  graphics_device_type - The type of graphics device the GUI is rendering to.
+    void Gui::Shutdown(const GRAPHICS::HARDWARE::GraphicsDeviceType graphics_device_type)
+    {
+        ShutdownGraphicsDeviceBackend(graphics_device_type);
+        ImGui_ImplWin32_Shutdown();
+        ImGui::DestroyContext();
+    }
+
+    /// Composites the GUI painted in software over the scene rendered into a color buffer.
+    /// @param[in,out]  color_buffer - The color buffer holding the rendered scene, to composite the GUI onto.
+    /// @param[in]  scene_rendered - True if a new image of the scene was rendered into the color buffer this frame;
+    ///     false if the color buffer still holds the scene and GUI from the last frame.
+    void Gui::PaintSoftwareGui(GRAPHICS::IMAGES::Bitmap& color_buffer, const bool scene_rendered)
+    {
+        uint32_t* pixels = color_buffer.GetRawData();
+        unsigned int width_in_pixels = color_buffer.GetWidthInPixels();
+        unsigned int height_in_pixels = color_buffer.GetHeightInPixels();
+
+        // UPDATE THE GUI LAYER.
+        RENDERING::ScreenRectangle previous_gui_bounds = GuiLayer.Bounds;
+        bool gui_changed = GuiLayer.Update(*ImGui::GetDrawData(), width_in_pixels, height_in_pixels);
+
+        bool scene_pixels_current = (ScenePixelsWidth == width_in_pixels) && (ScenePixelsHeight == height_in_pixels);
+        if (scene_rendered || !scene_pixels_current)
+        {
+            // FORGET THE PREVIOUSLY SAVED SCENE.
+            // The color buffer now holds just the scene everywhere, so parts of it are only saved below as the GUI covers them.
+            // The buffer for saved pixels is only reallocated if the size of the color buffer changed.
+            std::size_t pixel_count = static_cast<std::size_t>(width_in_pixels) * static_cast<std::size_t>(height_in_pixels);
+            ScenePixels.resize(pixel_count);
+            ScenePixelsWidth = width_in_pixels;
+            ScenePixelsHeight = height_in_pixels;
+            SavedSceneArea = {};
+        }
+        else
+        {
+            // CHECK IF THE COLOR BUFFER ALREADY HOLDS THE CURRENT GUI.
+            // If neither the scene nor the GUI changed, the last frame can be displayed as-is.
+            if (!gui_changed)
+            {
+                return;
+            }
+
+            // ERASE THE PREVIOUSLY COMPOSITED GUI.
+            // The scene under the previous GUI was saved before compositing it, so only that area needs to be restored.
+            // Without this, translucent parts of the GUI would accumulate over frames.
+            RENDERING::ScreenRectangle erased_area = previous_gui_bounds.Intersection(SavedSceneArea);
+            RestoreScenePixels(pixels, erased_area);
+        }
+
+        // SAVE THE SCENE UNDER THE CURRENT GUI.
+        RENDERING::ScreenRectangle gui_area = GuiLayer.Bounds.ClampedTo(static_cast<int>(width_in_pixels), static_cast<int>(height_in_pixels));
+        SaveScenePixels(pixels, gui_area);
+
+        // COMPOSITE THE GUI OVER THE SCENE.
+        GuiLayer.CompositeOnto(pixels);
+    }
+
+    /// Saves the scene in an area of the color buffer, so that the GUI can later be erased from that area.
+    /// The saved area is kept as a single rectangle, so it grows to contain both the previously saved area and the new area.
+    /// Only pixels not already saved are copied; they still hold just the scene since the GUI is only ever composited
+    /// within the saved area.
+    /// @param[in]  pixels - The pixels of the color buffer, which must be the size of the saved scene.
+    /// @param[in]  area - The area to save, within the color buffer.
+    void Gui::SaveScenePixels(const uint32_t* const pixels, const RENDERING::ScreenRectangle& area)
+    {
+        RENDERING::ScreenRectangle expanded_area = SavedSceneArea;
+        expanded_area.Expand(area);
+        for (int y = expanded_area.TopY; y < expanded_area.BottomY; ++y)
+        {
+            // SAVE ANY PARTS OF THE ROW NOT ALREADY SAVED.
+            // If part of the row was already saved, only the spans to its left and right are new.
+            std::size_t row_start_pixel_index = static_cast<std::size_t>(y) * ScenePixelsWidth;
+            bool row_partly_saved = !SavedSceneArea.IsEmpty() && (SavedSceneArea.TopY <= y) && (y < SavedSceneArea.BottomY);
+            int left_span_end_x = row_partly_saved ? SavedSceneArea.LeftX : expanded_area.RightX;
+            int right_span_start_x = row_partly_saved ? SavedSceneArea.RightX : expanded_area.RightX;
+            std::copy(
+                pixels + row_start_pixel_index + expanded_area.LeftX,
+                pixels + row_start_pixel_index + left_span_end_x,
+                ScenePixels.data() + row_start_pixel_index + expanded_area.LeftX);
+            std::copy(
+                pixels + row_start_pixel_index + right_span_start_x,
+                pixels + row_start_pixel_index + expanded_area.RightX,
+                ScenePixels.data() + row_start_pixel_index + right_span_start_x);
+        }
+        SavedSceneArea = expanded_area;
+    }
+
+    /// Restores the saved scene in an area of the color buffer, erasing any GUI composited there.
+    /// @param[out] pixels - The pixels of the color buffer, which must be the size of the saved scene.
+    /// @param[in]  area - The area to restore, within the saved area.
+    void Gui::RestoreScenePixels(uint32_t* const pixels, const RENDERING::ScreenRectangle& area) const
+    {
+        for (int y = area.TopY; y < area.BottomY; ++y)
+        {
+            std::size_t row_start_pixel_index = static_cast<std::size_t>(y) * ScenePixelsWidth + static_cast<std::size_t>(area.LeftX);
+            std::copy_n(
+                ScenePixels.data() + row_start_pixel_index,
+                area.WidthInPixels(),
+                pixels + row_start_pixel_index);
+        }
+    }
 
-        // SHUTDOWN IMGUI COMPONENTS IF THE TYPE OF GRAPHICS DEVICE IS CHANGING.
-        bool graphics_device_type_changed = (old_renderer_type != rendering_settings.GraphicsDeviceType);
-        if (graphics_device_type_changed)
+    /// Initializes the parts of ImGui specific to the type of graphics device.
+    /// @param[in]  graphics_device - The graphics device to use for rendering the GUI.
+    /// @return True if initialization succeeded; false otherwise.
+    bool Gui::InitializeGraphicsDeviceBackend(const GRAPHICS::HARDWARE::IGraphicsDevice& graphics_device)
+    {
+        GRAPHICS::HARDWARE::GraphicsDeviceType current_graphics_device_type = graphics_device.Type();
+        switch (current_graphics_device_type)
         {
-            switch (old_renderer_type)
+            case GRAPHICS::HARDWARE::CPU_RASTERIZER:
+            case GRAPHICS::HARDWARE::CPU_RAY_TRACER:
             {
-                case GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RASTERIZER:
-                case GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RAY_TRACER:
-                {
-                    imgui_sw::unbind_imgui_painting();
-                    break;
-                }
-                case GRAPHICS::HARDWARE::GraphicsDeviceType::OPEN_GL:
+                imgui_sw::bind_imgui_painting();
+                break;
+            }
+            case GRAPHICS::HARDWARE::OPEN_GL:
+            {
+                bool imgui_open_gl_initializated = ImGui_ImplOpenGL3_Init();
+                ASSERT_THEN_IF_NOT(imgui_open_gl_initializated)
                 {
-                    ImGui_ImplOpenGL3_Shutdown();
-                    break;
+                    return false;
                 }
-                case GRAPHICS::HARDWARE::GraphicsDeviceType::DIRECT_3D:
+                break;
+            }
+            case GRAPHICS::HARDWARE::DIRECT_3D:
+            {
+                const GRAPHICS::DIRECT_X::Direct3DGraphicsDevice& direct_x_graphics_device = dynamic_cast<const GRAPHICS::DIRECT_X::Direct3DGraphicsDevice&>(graphics_device);
+                bool imgui_direct_x_initialized = ImGui_ImplDX11_Init(direct_x_graphics_device.Device, direct_x_graphics_device.DeviceContext);
+                ASSERT_THEN_IF_NOT(imgui_direct_x_initialized)
                 {
-                    ImGui_ImplDX11_Shutdown();
-                    break;
+                    return false;
                 }
+                break;
             }
-
-            ImGui_ImplWin32_Shutdown();
-            ImGui::DestroyContext();
         }
+
+        return true;
     }
 
-    /// Shuts down the GUI.
+    /// Shuts down the parts of ImGui specific to the type of graphics device.
     /// @param[in]  graphics_device_type - The type of graphics device the GUI is rendering to.
-    void Gui::Shutdown(const GRAPHICS::HARDWARE::GraphicsDeviceType graphics_device_type)
+    void Gui::ShutdownGraphicsDeviceBackend(const GRAPHICS::HARDWARE::GraphicsDeviceType graphics_device_type)
     {
         switch (graphics_device_type)
         {
@@ -298,8 +465,5 @@ namespace GUI
                 break;
             }
         }
-
-        ImGui_ImplWin32_Shutdown();
-        ImGui::DestroyContext();
     }
 }
@@ -1,16 +1,27 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
+#include "Assets/AsyncModelLoader.h"
 #include "Graphics/Hardware/IGraphicsDevice.h"
+#include "Graphics/Images/Bitmap.h"
 #include "Graphics/Object3D.h"
 #include "Graphics/RenderingSettings.h"
 #include "Graphics/Scene.h"
+#include "Gui/SoftwareGuiLayer.h"
 #include "Gui/Windows/CameraWindow.h"
+#include "Gui/Windows/ModelLoadingWindow.h"
+#include "Gui/Windows/ProfilerWindow.h"
 #include "Gui/Windows/RendererSettingsWindow.h"
 #include "Gui/Windows/SceneWindow.h"
+#include "Gui/Windows/TextureCacheWindow.h"
+#include "Rendering/CpuRenderingSettings.h"
+#include "Rendering/ScreenRectangle.h"
 #include "Windowing/IWindow.h"
 
 /// Holds code related to traditional Windows-Icons-Menus-Pointers (WIMP) style graphical user interfaces (GUIs).
@@ -29,15 +40,24 @@ namespace GUI
         // UPDATING METHODS.
         void UpdateAndRender(
             GRAPHICS::HARDWARE::IGraphicsDevice& graphics_device, 
+            const bool scene_rendered,
             GRAPHICS::Scene& scene,
             GRAPHICS::VIEWING::Camera& camera,
-            GRAPHICS::RenderingSettings& rendering_settings);
+            GRAPHICS::RenderingSettings& rendering_settings,
+            RENDERING::CpuRenderingSettings& cpu_rendering_settings,
+            ASSETS::AsyncModelLoader& model_loader);
+        void EraseSoftwareGui(GRAPHICS::IMAGES::Bitmap& color_buffer) const;
+
+        // GRAPHICS DEVICE METHODS.
+        bool ChangeGraphicsDevice(
+            const GRAPHICS::HARDWARE::GraphicsDeviceType old_graphics_device_type,
+            const GRAPHICS::HARDWARE::IGraphicsDevice& new_graphics_device);
 
         // SHUTDOWN METHODS.
         void Shutdown(const GRAPHICS::HARDWARE::GraphicsDeviceType graphics_device_type);
 
         // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
-        /// Selected model filepath.
+        /// Selected model filepath.  The model should replace the objects currently in the scene.
         std::filesystem::path SelectedFilepath = "";
 
         /// The window letting a user change rendering settings.
@@ -46,10 +66,44 @@ namespace GUI
         WINDOWS::CameraWindow CameraWindow = {};
         /// The window letting a user view/edit scene information.
         WINDOWS::SceneWindow SceneWindow = {};
+        /// The window showing progress of models being loaded.
+        WINDOWS::ModelLoadingWindow ModelLoadingWindow = {};
+        /// The window showing where time is spent in recent frames.
+        WINDOWS::ProfilerWindow ProfilerWindow = {};
+        /// The window showing memory used by shared textures.
+        WINDOWS::TextureCacheWindow TextureCacheWindow = {};
 
         /// True if the ImGui metrics window is open; false if not.
         bool ImGuiMetricsWindowOpen = false;
         /// True if the ImGui demo window is open; false if not.
         bool ImGuiDemoWindowOpen = false;
+        /// The number of heap allocations made during the previous frame, shown in the debug menu.
+        /// Steady-state frames should ideally not allocate at all.
+        std::size_t HeapAllocationCountLastFrame = 0;
+
+    private:
+        // HELPER METHODS.
+        static bool InitializeGraphicsDeviceBackend(const GRAPHICS::HARDWARE::IGraphicsDevice& graphics_device);
+        static void ShutdownGraphicsDeviceBackend(const GRAPHICS::HARDWARE::GraphicsDeviceType graphics_device_type);
+        void PaintSoftwareGui(GRAPHICS::IMAGES::Bitmap& color_buffer, const bool scene_rendered);
+        void SaveScenePixels(const uint32_t* const pixels, const RENDERING::ScreenRectangle& area);
+        void RestoreScenePixels(uint32_t* const pixels, const RENDERING::ScreenRectangle& area) const;
+
+        // PRIVATE MEMBER VARIABLES.
+        /// A copy of parts of the most recently rendered scene (without the GUI) for CPU graphics devices,
+        /// the same size as the color buffer.  The GUI is composited directly over the scene, so this allows erasing
+        /// the previously composited GUI on frames where the scene isn't re-rendered.  Only pixels within the saved area are valid.
+        std::vector<uint32_t> ScenePixels = {};
+        /// The width of the scene copy.
+        unsigned int ScenePixelsWidth = 0;
+        /// The height of the scene copy.
+        unsigned int ScenePixelsHeight = 0;
+        /// The area of the scene saved since it was last rendered, which contains everywhere the GUI has since been composited.
+        /// Only this area is copied rather than the whole scene, since the GUI usually covers a small part of the screen.
+        /// It's also restored before the scene is only partly re-rendered (such as after objects move), so that the
+        /// parts of the scene that aren't re-rendered don't keep the old GUI.
+        RENDERING::ScreenRectangle SavedSceneArea = {};
+        /// The GUI painted in software for CPU graphics devices, cached until the GUI changes.
+        SoftwareGuiLayer GuiLayer = {};
     };
 }
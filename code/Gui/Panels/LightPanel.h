@@ -8,6 +8,6 @@ namespace GUI::PANELS
     class LightPanel
     {
     public:
-        static void UpdateAndRender(GRAPHICS::SHADING::LIGHTING::Light& light);
+        static bool UpdateAndRender(GRAPHICS::SHADING::LIGHTING::Light& light);
     };
 }
\ No newline at end of file
@@ -8,6 +8,6 @@ namespace GUI::PANELS
     class MaterialPanel
     {
     public:
-        static void UpdateAndRender(GRAPHICS::Material& material);
+        static bool UpdateAndRender(GRAPHICS::Material& material);
     };
 }
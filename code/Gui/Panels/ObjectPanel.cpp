@@ -1,4 +1,7 @@
-#include <string>
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <utility>
 #include <imgui/imgui.h>
 #include "Gui/Controls/ColorEditor.h"
 #include "Gui/Panels/MaterialPanel.h"
@@ -6,18 +9,31 @@
 
 namespace GUI::PANELS
 {
+    /// The maximum length of labels for items in the panel.  Longer labels (such as for long mesh names) are truncated.
+    constexpr std::size_t MAX_LABEL_LENGTH_IN_CHARACTERS = 128;
+
     /// Updates and renders the panel.
     /// @param[in,out]  object - The object to display and potentially update in the panel.
-    void ObjectPanel::UpdateAndRender(GRAPHICS::Object3D& object)
+    /// @param[out] only_transform_changed - True if the object's transform was changed but nothing else about it was;
+    ///     false if not.  Renderers then only need to redraw where the object was and now is.
+    /// @param[out] geometry_changed - True if the geometry of the object (rather than just its transform or materials)
+    ///     was changed; false if not.
+    /// @return True if anything about the object was changed; false if not.
+    bool ObjectPanel::UpdateAndRender(GRAPHICS::Object3D& object, bool& only_transform_changed, bool& geometry_changed)
     {
+        only_transform_changed = false;
+        geometry_changed = false;
+        bool transform_changed = false;
+        bool object_changed = false;
+
         // ALLOW THE USER TO EDIT THE WORLD POSITION.
-        ImGui::SliderFloat3("Position", (float*)&object.WorldPosition, -50.0f, 50.0f);
+        transform_changed |= ImGui::SliderFloat3("Position", (float*)&object.WorldPosition, -50.0f, 50.0f);
 
         // ALLOW THE USER TO EDIT THE ROTATION.
-        ImGui::SliderFloat3("Rotation (radians)", (float*)&object.RotationInRadians, -50.0f, 50.0f);
+        transform_changed |= ImGui::SliderFloat3("Rotation (radians)", (float*)&object.RotationInRadians, -50.0f, 50.0f);
 
         // ALLOW THE USER TO EDIT THE SCALE.
-        ImGui::SliderFloat3("Scale", (float*)&object.Scale, -50.0f, 50.0f);
+        transform_changed |= ImGui::SliderFloat3("Scale", (float*)&object.Scale, -50.0f, 50.0f);
 
         // DISPLAY INFORMATION ABOUT THE MODEL.
         if (ImGui::TreeNode("Model"))
@@ -26,50 +42,86 @@ namespace GUI::PANELS
             for (auto& [mesh_name, mesh] : object.Model.MeshesByName)
             {
                 // RENDER A TREE FOR THE CURRENT MESH.
+                // Labels are formatted into stack buffers to avoid allocating strings every frame.
+                // The mesh's tree node has a fixed ID so that it stays open as its triangle count changes.
                 std::size_t triangle_count = mesh.Triangles.size();
-                std::string mesh_display_text = mesh_name + " (" + std::to_string(triangle_count) + " triangles)";
-                if (ImGui::TreeNode(mesh_display_text.c_str()))
+                char mesh_display_text[MAX_LABEL_LENGTH_IN_CHARACTERS] = {};
+                std::snprintf(mesh_display_text, sizeof(mesh_display_text), "%s (%zu triangles)###Mesh", mesh_name.c_str(), triangle_count);
+                ImGui::PushID(&mesh);
+                if (ImGui::TreeNode(mesh_display_text))
                 {
                     // ALLOW THE USER TO CHANGE THE VISIBILITY OF THE MESH.
-                    ImGui::Checkbox("Visible?", &mesh.Visible);
-
-                    // RENDER INFORMATION ABOUT ALL TRIANGLES.
-                    for (std::size_t triangle_index = 0; triangle_index < mesh.Triangles.size(); ++triangle_index)
+                    geometry_changed |= ImGui::Checkbox("Visible?", &mesh.Visible);
+
+                    // RENDER A LIST OF ALL TRIANGLES.
+                    // Meshes may have millions of triangles, so the list is a fixed-height scrolling region
+                    // where only the visible rows are submitted.  The selected triangle is shown in detail below the list.
+                    // The selection is kept in ImGui's state storage since this panel has no state of its own.
+                    ImGuiStorage* gui_state = ImGui::GetStateStorage();
+                    ImGuiID selected_triangle_index_id = ImGui::GetID("SelectedTriangleIndex");
+                    constexpr int NO_SELECTED_TRIANGLE = -1;
+                    int selected_triangle_index = gui_state->GetInt(selected_triangle_index_id, NO_SELECTED_TRIANGLE);
+
+                    constexpr float MAX_VISIBLE_TRIANGLE_ROW_COUNT = 8.0f;
+                    float visible_triangle_row_count = std::min(static_cast<float>(triangle_count), MAX_VISIBLE_TRIANGLE_ROW_COUNT);
+                    ImVec2 triangle_list_size(0.0f, ImGui::GetTextLineHeightWithSpacing() * (visible_triangle_row_count + 0.5f));
+                    constexpr bool TRIANGLE_LIST_BORDER = true;
+                    if (ImGui::BeginChild("Triangles", triangle_list_size, TRIANGLE_LIST_BORDER))
                     {
-                        // RENDER INFORMATION ABOUT THE CURRENT TRIANGLE.
-                        std::string triangle_tree_label = "Triangle " + std::to_string(triangle_index);
-                        if (ImGui::TreeNode(triangle_tree_label.c_str()))
+                        // The clipper works with ints, so extremely large meshes only list the triangles that fit.
+                        int listed_triangle_count = static_cast<int>(std::min<std::size_t>(triangle_count, INT_MAX));
+                        ImGuiListClipper triangle_list_clipper;
+                        triangle_list_clipper.Begin(listed_triangle_count);
+                        while (triangle_list_clipper.Step())
                         {
-                            GRAPHICS::GEOMETRY::Triangle& triangle = mesh.Triangles.at(triangle_index);
-
-                            // ALLOW VIEWING/EDITING THE MATERIAL.
-                            if (triangle.Material)
+                            for (int triangle_index = triangle_list_clipper.DisplayStart; triangle_index < triangle_list_clipper.DisplayEnd; ++triangle_index)
                             {
-                                MaterialPanel::UpdateAndRender(*triangle.Material);
+                                char triangle_label[MAX_LABEL_LENGTH_IN_CHARACTERS] = {};
+                                std::snprintf(triangle_label, sizeof(triangle_label), "Triangle %d", triangle_index);
+                                bool triangle_selected = (selected_triangle_index == triangle_index);
+                                if (ImGui::Selectable(triangle_label, triangle_selected))
+                                {
+                                    selected_triangle_index = triangle_selected ? NO_SELECTED_TRIANGLE : triangle_index;
+                                    gui_state->SetInt(selected_triangle_index_id, selected_triangle_index);
+                                }
                             }
+                        }
+                        triangle_list_clipper.End();
+                    }
+                    ImGui::EndChild();
+
+                    // RENDER INFORMATION ABOUT THE SELECTED TRIANGLE.
+                    bool triangle_selected = (0 <= selected_triangle_index) && (static_cast<std::size_t>(selected_triangle_index) < triangle_count);
+                    if (triangle_selected)
+                    {
+                        GRAPHICS::GEOMETRY::Triangle& triangle = mesh.Triangles[static_cast<std::size_t>(selected_triangle_index)];
+                        ImGui::Text("Triangle %d", selected_triangle_index);
 
-                            // RENDER INFORMATION ABOUT ALL VERTICES.
-                            for (std::size_t vertex_index = 0; vertex_index < triangle.Vertices.size(); ++vertex_index)
+                        // ALLOW VIEWING/EDITING THE MATERIAL.
+                        if (triangle.Material)
+                        {
+                            object_changed |= MaterialPanel::UpdateAndRender(*triangle.Material);
+                        }
+
+                        // RENDER INFORMATION ABOUT ALL VERTICES.
+                        for (std::size_t vertex_index = 0; vertex_index < triangle.Vertices.size(); ++vertex_index)
+                        {
+                            char vertex_tree_label[MAX_LABEL_LENGTH_IN_CHARACTERS] = {};
+                            std::snprintf(vertex_tree_label, sizeof(vertex_tree_label), "Vertex %zu", vertex_index);
+                            if (ImGui::TreeNode(vertex_tree_label))
                             {
-                                std::string vertex_tree_label = "Vertex " + std::to_string(vertex_index);
-                                if (ImGui::TreeNode(vertex_tree_label.c_str()))
-                                {
-                                    // ALLOW EDITING KEY PROPERTIES OF THE VERTEX.
-                                    GRAPHICS::VertexWithAttributes& vertex = triangle.Vertices.at(vertex_index);
+                                // ALLOW EDITING KEY PROPERTIES OF THE VERTEX.
+                                GRAPHICS::VertexWithAttributes& vertex = triangle.Vertices.at(vertex_index);
 
-                                    CONTROLS::ColorEditor::DisplayAndAllowEditing("Color", vertex.Color);
+                                geometry_changed |= CONTROLS::ColorEditor::DisplayAndAllowEditing("Color", vertex.Color);
 
-                                    ImGui::InputFloat3("Position", (float*)&vertex.Position);
-                                    ImGui::InputFloat2("TextureCoordinates", (float*)&vertex.TextureCoordinates);
-                                    ImGui::InputFloat2("Normal", (float*)&vertex.Normal);
+                                geometry_changed |= ImGui::InputFloat3("Position", (float*)&vertex.Position);
+                                geometry_changed |= ImGui::InputFloat2("TextureCoordinates", (float*)&vertex.TextureCoordinates);
+                                geometry_changed |= ImGui::InputFloat2("Normal", (float*)&vertex.Normal);
 
-                                    // END RENDERING THE TREE FOR THE CURRENT VERTEX.
-                                    ImGui::TreePop();
-                                }
+                                // END RENDERING THE TREE FOR THE CURRENT VERTEX.
+                                ImGui::TreePop();
                             }
-
-                            // END RENDERING THE TREE FOR THE CURRENT TRIANGLE.
-                            ImGui::TreePop();
                         }
                     }
 
@@ -78,12 +130,14 @@ namespace GUI::PANELS
                     {
                         GRAPHICS::GEOMETRY::Triangle new_triangle;
                         new_triangle.Material = std::make_shared<GRAPHICS::Material>();
-                        mesh.Triangles.emplace_back(new_triangle);
+                        mesh.Triangles.emplace_back(std::move(new_triangle));
+                        geometry_changed = true;
                     }
 
                     // END RENDERING THE TREE FOR THE CURRENT MESH.
                     ImGui::TreePop();
                 }
+                ImGui::PopID();
             }
 
             // ALLOW ADDING NEW MESHES.
@@ -99,6 +153,7 @@ namespace GUI::PANELS
             {
                 GRAPHICS::Mesh new_mesh = { .Name = new_mesh_name };
                 object.Model.MeshesByName[new_mesh.Name] = new_mesh;
+                geometry_changed = true;
             }
 
             // END RENDERING THE TREE FOR THE CURRENT MODEL.
@@ -106,26 +161,28 @@ namespace GUI::PANELS
         }
 
         // DISPLAY INFORMATION ABOUT SPHERES.
-        std::string sphere_root_tree_label = "Spheres (" + std::to_string(object.Spheres.size()) + ")";
-        if (ImGui::TreeNode(sphere_root_tree_label.c_str()))
+        char sphere_root_tree_label[MAX_LABEL_LENGTH_IN_CHARACTERS] = {};
+        std::snprintf(sphere_root_tree_label, sizeof(sphere_root_tree_label), "Spheres (%zu)", object.Spheres.size());
+        if (ImGui::TreeNode(sphere_root_tree_label))
         {
             // RENDER INFORMATION ABOUT ALL SPHERES.
             for (std::size_t sphere_index = 0; sphere_index < object.Spheres.size(); ++sphere_index)
             {
                 // RENDER A TREE FOR THE CURRENT SPHERE.
-                std::string sphere_tree_label = "Sphere " + std::to_string(sphere_index);
-                if (ImGui::TreeNode(sphere_tree_label.c_str()))
+                char sphere_tree_label[MAX_LABEL_LENGTH_IN_CHARACTERS] = {};
+                std::snprintf(sphere_tree_label, sizeof(sphere_tree_label), "Sphere %zu", sphere_index);
+                if (ImGui::TreeNode(sphere_tree_label))
                 {
                     // ALLOW EDITING KEY PROPERTIES OF THE SPHERE.
                     GRAPHICS::GEOMETRY::Sphere& sphere = object.Spheres.at(sphere_index);
 
                     if (sphere.Material)
                     {
-                        MaterialPanel::UpdateAndRender(*sphere.Material);
+                        object_changed |= MaterialPanel::UpdateAndRender(*sphere.Material);
                     }
 
-                    ImGui::InputFloat3("Position", (float*)&sphere.CenterPosition);
-                    ImGui::InputFloat("Radius", (float*)&sphere.Radius);
+                    geometry_changed |= ImGui::InputFloat3("Position", (float*)&sphere.CenterPosition);
+                    geometry_changed |= ImGui::InputFloat("Radius", (float*)&sphere.Radius);
 
                     // END RENDERING THE TREE FOR THE CURRENT SPHERE.
                     ImGui::TreePop();
@@ -137,11 +194,17 @@ namespace GUI::PANELS
             {
                 GRAPHICS::GEOMETRY::Sphere new_sphere;
                 new_sphere.Material = std::make_shared<GRAPHICS::Material>();
-                object.Spheres.emplace_back(new_sphere);
+                object.Spheres.emplace_back(std::move(new_sphere));
+                geometry_changed = true;
             }
 
             // END RENDERING THE TREE FOR ALL SPHERES IN THE OBJECT.
             ImGui::TreePop();
         }
+
+        // Material edits may also affect other objects sharing the materials, so they aren't transform-only changes.
+        only_transform_changed = transform_changed && !object_changed && !geometry_changed;
+        object_changed |= transform_changed || geometry_changed;
+        return object_changed;
     }
 }
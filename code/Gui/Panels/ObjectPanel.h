@@ -8,6 +8,6 @@ namespace GUI::PANELS
     class ObjectPanel
     {
     public:
-        static void UpdateAndRender(GRAPHICS::Object3D& object);
+        static bool UpdateAndRender(GRAPHICS::Object3D& object, bool& only_transform_changed, bool& geometry_changed);
     };
 }
@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <imgui/backends/imgui_sw.hpp>
+#include "Gui/SoftwareGuiLayer.h"
+#include "Profiling/Profiler.h"
+#include "Rendering/PremultipliedAlpha.h"
+
+namespace GUI
+{
+    /// Combines bytes into a hash.  Bytes are mixed 8 at a time since draw data can be large.
+    /// @param[in]  hash - The hash to combine the bytes into.
+    /// @param[in]  data - The bytes to hash.
+    /// @param[in]  size_in_bytes - The number of bytes to hash.
+    /// @return The combined hash.
+    static uint64_t HashBytes(uint64_t hash, const void* const data, const std::size_t size_in_bytes)
+    {
+        // The multiplier is from the 64-bit FNV hash, whose multiply-xor mixing is sufficient for detecting changes.
+        constexpr uint64_t PRIME = 0x100000001b3ull;
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        std::size_t byte_index = 0;
+        for (; byte_index + sizeof(uint64_t) <= size_in_bytes; byte_index += sizeof(uint64_t))
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, bytes + byte_index, sizeof(word));
+            hash = (hash ^ word) * PRIME;
+            hash ^= (hash >> 32);
+        }
+        for (; byte_index < size_in_bytes; ++byte_index)
+        {
+            hash = (hash ^ bytes[byte_index]) * PRIME;
+        }
+        return hash;
+    }
+
+    /// Updates the layer to match the current GUI, repainting it only if the GUI changed.
+    /// @param[in]  draw_data - The draw data for the current GUI.
+    /// @param[in]  width_in_pixels - The width of the screen.
+    /// @param[in]  height_in_pixels - The height of the screen.
+    /// @return True if the layer changed; false if it's the same as the last update.
+    bool SoftwareGuiLayer::Update(const ImDrawData& draw_data, const unsigned int width_in_pixels, const unsigned int height_in_pixels)
+    {
+        // CHECK IF THE LAYER NEEDS TO CHANGE.
+        uint64_t draw_data_hash = HashDrawData(draw_data);
+        bool size_changed = (WidthInPixels != width_in_pixels) || (HeightInPixels != height_in_pixels);
+        bool painter_changed = (PaintedWithReferencePainter != UseReferencePainter);
+        bool layer_changed = size_changed || painter_changed || (DrawDataHash != draw_data_hash);
+        if (!layer_changed)
+        {
+            return false;
+        }
+
+        // RESIZE THE LAYER IF NEEDED.
+        if (size_changed)
+        {
+            WidthInPixels = width_in_pixels;
+            HeightInPixels = height_in_pixels;
+            std::size_t pixel_count = static_cast<std::size_t>(width_in_pixels) * static_cast<std::size_t>(height_in_pixels);
+            Pixels.assign(pixel_count, 0);
+            WhiteBackgroundPixels.assign(pixel_count, 0);
+        }
+
+        // REPAINT THE LAYER.
+        DrawDataHash = draw_data_hash;
+        PaintedWithReferencePainter = UseReferencePainter;
+        Bounds = ComputeBounds(draw_data).ClampedTo(static_cast<int>(width_in_pixels), static_cast<int>(height_in_pixels));
+        Repaint(draw_data);
+        return true;
+    }
+
+    /// Blends the layer over pixels, using premultiplied alpha.
+    /// Only pixels within the layer's bounds are touched.
+    /// @param[in,out]  pixels - The pixels to composite onto, with the same dimensions as the layer.
+    void SoftwareGuiLayer::CompositeOnto(uint32_t* pixels) const
+    {
+        PROFILING::ProfileScope composite_scope("Composite GUI");
+
+        for (int y = Bounds.TopY; y < Bounds.BottomY; ++y)
+        {
+            std::size_t row_start_pixel_index = static_cast<std::size_t>(y) * WidthInPixels + static_cast<std::size_t>(Bounds.LeftX);
+            const uint32_t* layer_row = Pixels.data() + row_start_pixel_index;
+            uint32_t* destination_row = pixels + row_start_pixel_index;
+            int row_pixel_count = Bounds.WidthInPixels();
+            int pixel_index = 0;
+
+#if PREMULTIPLIED_ALPHA_SSE2
+            // BLEND 4 PIXELS AT A TIME.
+            const __m128i ZERO = _mm_setzero_si128();
+            constexpr int PIXELS_PER_BATCH = 4;
+            for (; pixel_index + PIXELS_PER_BATCH <= row_pixel_count; pixel_index += PIXELS_PER_BATCH)
+            {
+                // SKIP FULLY TRANSPARENT PIXELS.
+                // Much of the GUI's bounds can be empty space between windows.
+                __m128i layer_pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(layer_row + pixel_index));
+                bool all_transparent = (0xFFFF == _mm_movemask_epi8(_mm_cmpeq_epi32(layer_pixels, ZERO)));
+                if (all_transparent)
+                {
+                    continue;
+                }
+
+                __m128i* destination_pixels = reinterpret_cast<__m128i*>(destination_row + pixel_index);
+                __m128i blended_pixels = RENDERING::PremultipliedAlpha::BlendOver(layer_pixels, _mm_loadu_si128(destination_pixels));
+                _mm_storeu_si128(destination_pixels, blended_pixels);
+            }
+#endif
+
+            // BLEND ANY REMAINING PIXELS INDIVIDUALLY.
+            for (; pixel_index < row_pixel_count; ++pixel_index)
+            {
+                uint32_t layer_pixel = layer_row[pixel_index];
+                if (0 != layer_pixel)
+                {
+                    destination_row[pixel_index] = RENDERING::PremultipliedAlpha::BlendOver(layer_pixel, destination_row[pixel_index]);
+                }
+            }
+        }
+    }
+
+    /// Hashes draw data to detect changes to the GUI.
+    /// @param[in]  draw_data - The draw data to hash.
+    /// @return The hash of the draw data.
+    uint64_t SoftwareGuiLayer::HashDrawData(const ImDrawData& draw_data)
+    {
+        constexpr uint64_t INITIAL_HASH = 0xcbf29ce484222325ull;
+        uint64_t hash = INITIAL_HASH;
+        hash = HashBytes(hash, &draw_data.DisplayPos, sizeof(draw_data.DisplayPos));
+        hash = HashBytes(hash, &draw_data.DisplaySize, sizeof(draw_data.DisplaySize));
+        for (int draw_list_index = 0; draw_list_index < draw_data.CmdListsCount; ++draw_list_index)
+        {
+            const ImDrawList* draw_list = draw_data.CmdLists[draw_list_index];
+            hash = HashBytes(hash, draw_list->VtxBuffer.Data, static_cast<std::size_t>(draw_list->VtxBuffer.Size) * sizeof(ImDrawVert));
+            hash = HashBytes(hash, draw_list->IdxBuffer.Data, static_cast<std::size_t>(draw_list->IdxBuffer.Size) * sizeof(ImDrawIdx));
+
+            // Only the parts of draw commands affecting what's painted are hashed, since the rest may include pointers
+            // (like callbacks) that don't affect the output.
+            for (const ImDrawCmd& draw_command : draw_list->CmdBuffer)
+            {
+                hash = HashBytes(hash, &draw_command.ClipRect, sizeof(draw_command.ClipRect));
+                hash = HashBytes(hash, &draw_command.TextureId, sizeof(draw_command.TextureId));
+                hash = HashBytes(hash, &draw_command.VtxOffset, sizeof(draw_command.VtxOffset));
+                hash = HashBytes(hash, &draw_command.IdxOffset, sizeof(draw_command.IdxOffset));
+                hash = HashBytes(hash, &draw_command.ElemCount, sizeof(draw_command.ElemCount));
+            }
+        }
+        return hash;
+    }
+
+    /// Computes the area of the screen covered by GUI draw data.
+    /// @param[in]  draw_data - The draw data.
+    /// @return The area covered by all vertices in the draw data.  This may be slightly larger than
+    ///     the area actually painted since vertices outside of clipping rectangles are included.
+    RENDERING::ScreenRectangle SoftwareGuiLayer::ComputeBounds(const ImDrawData& draw_data)
+    {
+        float min_x = std::numeric_limits<float>::max();
+        float min_y = std::numeric_limits<float>::max();
+        float max_x = std::numeric_limits<float>::lowest();
+        float max_y = std::numeric_limits<float>::lowest();
+        for (int draw_list_index = 0; draw_list_index < draw_data.CmdListsCount; ++draw_list_index)
+        {
+            const ImDrawList* draw_list = draw_data.CmdLists[draw_list_index];
+            for (const ImDrawVert& vertex : draw_list->VtxBuffer)
+            {
+                min_x = std::min(min_x, vertex.pos.x);
+                min_y = std::min(min_y, vertex.pos.y);
+                max_x = std::max(max_x, vertex.pos.x);
+                max_y = std::max(max_y, vertex.pos.y);
+            }
+        }
+
+        // CONVERT TO WHOLE PIXELS.
+        // The bounds are expanded outward so that partially covered pixels are included.
+        RENDERING::ScreenRectangle bounds;
+        bool any_vertices = (min_x <= max_x) && (min_y <= max_y);
+        if (any_vertices)
+        {
+            bounds.LeftX = static_cast<int>(std::floor(min_x - draw_data.DisplayPos.x));
+            bounds.TopY = static_cast<int>(std::floor(min_y - draw_data.DisplayPos.y));
+            bounds.RightX = static_cast<int>(std::ceil(max_x - draw_data.DisplayPos.x)) + 1;
+            bounds.BottomY = static_cast<int>(std::ceil(max_y - draw_data.DisplayPos.y)) + 1;
+        }
+        return bounds;
+    }
+
+    /// Repaints the layer.
+    /// @param[in]  draw_data - The draw data for the current GUI.
+    void SoftwareGuiLayer::Repaint(const ImDrawData& draw_data)
+    {
+        PROFILING::ProfileScope paint_gui_scope("Paint GUI");
+
+        if (UseReferencePainter)
+        {
+            RepaintWithReferencePainter();
+            return;
+        }
+
+        // CLEAR THE AREA TO PAINT INTO.
+        // Pixels outside of the bounds are never read, so they don't need to be cleared.
+        constexpr uint32_t TRANSPARENT_BLACK = 0x00000000;
+        int bounds_width_in_pixels = Bounds.WidthInPixels();
+        for (int y = Bounds.TopY; y < Bounds.BottomY; ++y)
+        {
+            std::size_t row_start_pixel_index = static_cast<std::size_t>(y) * WidthInPixels + static_cast<std::size_t>(Bounds.LeftX);
+            std::fill_n(Pixels.data() + row_start_pixel_index, bounds_width_in_pixels, TRANSPARENT_BLACK);
+        }
+
+        // PAINT THE GUI.
+        Painter.Paint(draw_data, Pixels.data(), WidthInPixels, HeightInPixels);
+    }
+
+    /// Repaints the layer from ImGui's current draw data using imgui_sw.
+    /// imgui_sw always paints ImGui's current draw data, so it isn't passed in.
+    void SoftwareGuiLayer::RepaintWithReferencePainter()
+    {
+        // CLEAR THE AREAS TO PAINT INTO TO BLACK AND WHITE.
+        // Pixels outside of the bounds are never read, so they don't need to be cleared.
+        constexpr uint32_t OPAQUE_BLACK = 0xFF000000;
+        constexpr uint32_t OPAQUE_WHITE = 0xFFFFFFFF;
+        int bounds_width_in_pixels = Bounds.WidthInPixels();
+        for (int y = Bounds.TopY; y < Bounds.BottomY; ++y)
+        {
+            std::size_t row_start_pixel_index = static_cast<std::size_t>(y) * WidthInPixels + static_cast<std::size_t>(Bounds.LeftX);
+            std::fill_n(Pixels.data() + row_start_pixel_index, bounds_width_in_pixels, OPAQUE_BLACK);
+            std::fill_n(WhiteBackgroundPixels.data() + row_start_pixel_index, bounds_width_in_pixels, OPAQUE_WHITE);
+        }
+
+        // PAINT THE GUI OVER BOTH BACKGROUNDS.
+        int width_in_pixels = static_cast<int>(WidthInPixels);
+        int height_in_pixels = static_cast<int>(HeightInPixels);
+        imgui_sw::paint_imgui(Pixels.data(), width_in_pixels, height_in_pixels);
+        imgui_sw::paint_imgui(WhiteBackgroundPixels.data(), width_in_pixels, height_in_pixels);
+
+        // CONVERT TO PREMULTIPLIED ALPHA.
+        // Over black, each component is the GUI's component times its alpha, which is exactly the premultiplied color.
+        // The amount the white background shows through is the GUI's transparency.  The green component is used for this
+        // since all components are blended the same way.
+        for (int y = Bounds.TopY; y < Bounds.BottomY; ++y)
+        {
+            std::size_t row_start_pixel_index = static_cast<std::size_t>(y) * WidthInPixels + static_cast<std::size_t>(Bounds.LeftX);
+            uint32_t* black_background_row = Pixels.data() + row_start_pixel_index;
+            const uint32_t* white_background_row = WhiteBackgroundPixels.data() + row_start_pixel_index;
+            for (int pixel_index = 0; pixel_index < bounds_width_in_pixels; ++pixel_index)
+            {
+                uint32_t over_black = black_background_row[pixel_index];
+                uint32_t over_white = white_background_row[pixel_index];
+                int green_over_black = static_cast<int>((over_black >> 8) & 0xFF);
+                int green_over_white = static_cast<int>((over_white >> 8) & 0xFF);
+                int transparency = std::clamp(green_over_white - green_over_black, 0, 255);
+                uint32_t alpha = static_cast<uint32_t>(255 - transparency);
+                black_background_row[pixel_index] = (alpha << 24) | (over_black & 0x00FFFFFF);
+            }
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <imgui/imgui.h>
+#include "Gui/SoftwareGuiPainter.h"
+#include "Rendering/ScreenRectangle.h"
+
+namespace GUI
+{
+    /// The GUI painted in software into its own premultiplied-alpha layer, so that it can be composited over
+    /// the rendered scene each frame without being repainted unless the GUI actually changes.
+    ///
+    /// Changes are detected by hashing ImGui's draw data (vertices, indices, and draw commands),
+    /// which is much cheaper than painting.  The GUI is normally painted directly into the layer by a SoftwareGuiPainter.
+    /// imgui_sw can instead be used as a reference for checking the painter's output.  It blends directly onto opaque pixels,
+    /// so the layer is then derived by painting the GUI over both black and white:  Over black, each pixel
+    /// is exactly the premultiplied GUI color, and the difference from white gives its transparency.
+    class SoftwareGuiLayer
+    {
+    public:
+        // OPERATIONS.
+        bool Update(const ImDrawData& draw_data, const unsigned int width_in_pixels, const unsigned int height_in_pixels);
+        void CompositeOnto(uint32_t* pixels) const;
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The area of the screen covered by the layer.  Pixels outside of this are fully transparent.
+        RENDERING::ScreenRectangle Bounds = {};
+        /// True to paint the GUI with imgui_sw rather than the faster painter; false otherwise.
+        bool UseReferencePainter = false;
+
+    private:
+        // HELPER METHODS.
+        static uint64_t HashDrawData(const ImDrawData& draw_data);
+        static RENDERING::ScreenRectangle ComputeBounds(const ImDrawData& draw_data);
+        void Repaint(const ImDrawData& draw_data);
+        void RepaintWithReferencePainter();
+
+        // PRIVATE MEMBER VARIABLES.
+        /// The width of the layer.
+        unsigned int WidthInPixels = 0;
+        /// The height of the layer.
+        unsigned int HeightInPixels = 0;
+        /// The hash of the draw data the layer was last painted from.
+        uint64_t DrawDataHash = 0;
+        /// True if the layer was last painted with imgui_sw; false if with the faster painter.
+        bool PaintedWithReferencePainter = false;
+        /// The painter for painting the GUI into the layer.
+        SoftwareGuiPainter Painter = {};
+        /// The premultiplied-alpha pixels of the layer, in the 0xAARRGGBB format of color buffers.
+        /// This is also where imgui_sw paints the GUI over black.
+        std::vector<uint32_t> Pixels = {};
+        /// Pixels imgui_sw paints the GUI over white into, to determine its transparency.
+        std::vector<uint32_t> WhiteBackgroundPixels = {};
+    };
+}
@@ -0,0 +1,552 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+#include "Gui/SoftwareGuiPainter.h"
+#include "Rendering/PremultipliedAlpha.h"
+
+namespace GUI
+{
+    /// Paints draw data, blending over existing pixels.
+    /// @param[in]  draw_data - The draw data to paint.
+    /// @param[in,out]  pixels - The premultiplied-alpha pixels to paint into, in the 0xAARRGGBB format of color buffers.
+    /// @param[in]  width_in_pixels - The width of the pixels.
+    /// @param[in]  height_in_pixels - The height of the pixels.
+    void SoftwareGuiPainter::Paint(const ImDrawData& draw_data, uint32_t* pixels, const unsigned int width_in_pixels, const unsigned int height_in_pixels)
+    {
+        // GET THE FONT ATLAS.
+        // The atlas has already been built by the time anything is drawn, so this just retrieves it.
+        FontTexture font_texture;
+        unsigned char* font_texels = nullptr;
+        ImGui::GetIO().Fonts->GetTexDataAsAlpha8(&font_texels, &font_texture.WidthInTexels, &font_texture.HeightInTexels);
+        font_texture.Texels = font_texels;
+
+        PaintTarget target;
+        target.Pixels = pixels;
+        target.WidthInPixels = static_cast<int>(width_in_pixels);
+
+        for (int draw_list_index = 0; draw_list_index < draw_data.CmdListsCount; ++draw_list_index)
+        {
+            const ImDrawList* draw_list = draw_data.CmdLists[draw_list_index];
+            for (const ImDrawCmd& draw_command : draw_list->CmdBuffer)
+            {
+                // SKIP CALLBACKS.
+                // The GUI doesn't use any that affect painting.
+                if (draw_command.UserCallback)
+                {
+                    continue;
+                }
+
+                // DETERMINE WHERE THE COMMAND CAN PAINT.
+                // Pixels are covered if their centers are inside.
+                RENDERING::ScreenRectangle clip_rectangle;
+                clip_rectangle.LeftX = static_cast<int>(std::floor(draw_command.ClipRect.x - draw_data.DisplayPos.x + 0.5f));
+                clip_rectangle.TopY = static_cast<int>(std::floor(draw_command.ClipRect.y - draw_data.DisplayPos.y + 0.5f));
+                clip_rectangle.RightX = static_cast<int>(std::floor(draw_command.ClipRect.z - draw_data.DisplayPos.x + 0.5f));
+                clip_rectangle.BottomY = static_cast<int>(std::floor(draw_command.ClipRect.w - draw_data.DisplayPos.y + 0.5f));
+                clip_rectangle = clip_rectangle.ClampedTo(static_cast<int>(width_in_pixels), static_cast<int>(height_in_pixels));
+                if (clip_rectangle.IsEmpty())
+                {
+                    continue;
+                }
+
+                // PAINT EACH PRIMITIVE.
+                const ImDrawVert* vertices = draw_list->VtxBuffer.Data + draw_command.VtxOffset;
+                const ImDrawIdx* indices = draw_list->IdxBuffer.Data + draw_command.IdxOffset;
+                unsigned int index = 0;
+                while (index + 3 <= draw_command.ElemCount)
+                {
+                    // PAINT UNIFORMLY COLORED AXIS-ALIGNED RECTANGLES.
+                    // ImGui adds rectangles as two triangles sharing their first and third vertices (see ImDrawList::PrimRect()),
+                    // which covers solid rectangles and glyphs.
+                    bool possible_rectangle = (
+                        (index + 6 <= draw_command.ElemCount) &&
+                        (indices[index + 3] == indices[index]) &&
+                        (indices[index + 4] == indices[index + 2]));
+                    if (possible_rectangle)
+                    {
+                        const ImDrawVert& top_left = vertices[indices[index]];
+                        const ImDrawVert& top_right = vertices[indices[index + 1]];
+                        const ImDrawVert& bottom_right = vertices[indices[index + 2]];
+                        const ImDrawVert& bottom_left = vertices[indices[index + 5]];
+                        bool axis_aligned = (
+                            (top_left.pos.x == bottom_left.pos.x) && (top_right.pos.x == bottom_right.pos.x) &&
+                            (top_left.pos.y == top_right.pos.y) && (bottom_left.pos.y == bottom_right.pos.y) &&
+                            (top_left.uv.x == bottom_left.uv.x) && (top_right.uv.x == bottom_right.uv.x) &&
+                            (top_left.uv.y == top_right.uv.y) && (bottom_left.uv.y == bottom_right.uv.y));
+                        bool uniform_color = (
+                            (top_left.col == top_right.col) &&
+                            (top_left.col == bottom_right.col) &&
+                            (top_left.col == bottom_left.col));
+                        if (axis_aligned && uniform_color)
+                        {
+                            PaintRectangle(top_left, bottom_right, draw_data.DisplayPos, clip_rectangle, font_texture, target);
+                            index += 6;
+                            continue;
+                        }
+                    }
+
+                    // PAINT ANY OTHER TRIANGLES.
+                    PaintTriangle(
+                        vertices[indices[index]],
+                        vertices[indices[index + 1]],
+                        vertices[indices[index + 2]],
+                        draw_data.DisplayPos,
+                        clip_rectangle,
+                        font_texture,
+                        target);
+                    index += 3;
+                }
+            }
+        }
+    }
+
+    /// Samples the coverage of the font texture at texture coordinates, using the nearest texel.
+    /// @param[in]  u - The horizontal texture coordinate.
+    /// @param[in]  v - The vertical texture coordinate.
+    /// @return The coverage in [0, 255].  Fully covered if there's no texture.
+    uint32_t SoftwareGuiPainter::FontTexture::SampleCoverage(const float u, const float v) const
+    {
+        if (!Texels)
+        {
+            return 255;
+        }
+
+        std::size_t texel_index = static_cast<std::size_t>(TexelY(v)) * static_cast<std::size_t>(WidthInTexels) + static_cast<std::size_t>(TexelX(u));
+        return Texels[texel_index];
+    }
+
+    /// Gets the column of the texel nearest a horizontal texture coordinate.
+    /// @param[in]  u - The horizontal texture coordinate.
+    /// @return The column of the texel, clamped to the texture.
+    int SoftwareGuiPainter::FontTexture::TexelX(const float u) const
+    {
+        int texel_x = static_cast<int>(std::floor(u * static_cast<float>(WidthInTexels)));
+        return std::clamp(texel_x, 0, std::max(WidthInTexels - 1, 0));
+    }
+
+    /// Gets the row of the texel nearest a vertical texture coordinate.
+    /// @param[in]  v - The vertical texture coordinate.
+    /// @return The row of the texel, clamped to the texture.
+    int SoftwareGuiPainter::FontTexture::TexelY(const float v) const
+    {
+        int texel_y = static_cast<int>(std::floor(v * static_cast<float>(HeightInTexels)));
+        return std::clamp(texel_y, 0, std::max(HeightInTexels - 1, 0));
+    }
+
+    /// Paints a uniformly colored axis-aligned rectangle, which may be textured.
+    /// @param[in]  corner - One corner of the rectangle.
+    /// @param[in]  opposite_corner - The diagonally opposite corner of the rectangle.
+    /// @param[in]  display_origin - The position of the top-left of the screen in draw data coordinates.
+    /// @param[in]  clip_rectangle - The area of the screen that may be painted.
+    /// @param[in]  font_texture - The texture to sample.
+    /// @param[in,out]  target - The pixels to paint into.
+    void SoftwareGuiPainter::PaintRectangle(
+        const ImDrawVert& corner,
+        const ImDrawVert& opposite_corner,
+        const ImVec2& display_origin,
+        const RENDERING::ScreenRectangle& clip_rectangle,
+        const FontTexture& font_texture,
+        PaintTarget& target)
+    {
+        // DETERMINE THE EDGES OF THE RECTANGLE.
+        // Corners may be in any order, so they're sorted along with their texture coordinates.
+        float left_x = corner.pos.x - display_origin.x;
+        float right_x = opposite_corner.pos.x - display_origin.x;
+        float left_u = corner.uv.x;
+        float right_u = opposite_corner.uv.x;
+        if (right_x < left_x)
+        {
+            std::swap(left_x, right_x);
+            std::swap(left_u, right_u);
+        }
+        float top_y = corner.pos.y - display_origin.y;
+        float bottom_y = opposite_corner.pos.y - display_origin.y;
+        float top_v = corner.uv.y;
+        float bottom_v = opposite_corner.uv.y;
+        if (bottom_y < top_y)
+        {
+            std::swap(top_y, bottom_y);
+            std::swap(top_v, bottom_v);
+        }
+
+        // DETERMINE THE PIXELS TO PAINT.
+        RENDERING::ScreenRectangle rectangle;
+        rectangle.LeftX = static_cast<int>(std::floor(left_x + 0.5f));
+        rectangle.TopY = static_cast<int>(std::floor(top_y + 0.5f));
+        rectangle.RightX = static_cast<int>(std::floor(right_x + 0.5f));
+        rectangle.BottomY = static_cast<int>(std::floor(bottom_y + 0.5f));
+        rectangle = rectangle.Intersection(clip_rectangle);
+        if (rectangle.IsEmpty())
+        {
+            return;
+        }
+
+        // PAINT SOLID RECTANGLES.
+        // These sample a single texel (normally ImGui's white pixel) for their whole area.
+        uint32_t color = corner.col;
+        bool textured = (left_u != right_u) || (top_v != bottom_v);
+        if (!textured)
+        {
+            uint32_t coverage = font_texture.SampleCoverage(left_u, top_v);
+            PaintSolidRectangle(rectangle, RENDERING::PremultipliedAlpha::Premultiply(color, coverage), target);
+            return;
+        }
+
+        // DETERMINE THE TEXEL COLUMN FOR EACH PIXEL COLUMN.
+        // Texture coordinates are sampled at pixel centers.  Since the rectangle is axis-aligned,
+        // every row samples the same columns, so they only need to be computed once.
+        float u_per_pixel = (right_u - left_u) / (right_x - left_x);
+        float v_per_pixel = (bottom_v - top_v) / (bottom_y - top_y);
+        int width_in_pixels = rectangle.WidthInPixels();
+        ColumnTexelXs.resize(static_cast<std::size_t>(width_in_pixels));
+        for (int column_index = 0; column_index < width_in_pixels; ++column_index)
+        {
+            float pixel_center_x = static_cast<float>(rectangle.LeftX + column_index) + 0.5f;
+            float u = left_u + (pixel_center_x - left_x) * u_per_pixel;
+            ColumnTexelXs[column_index] = font_texture.TexelX(u);
+        }
+
+        // PAINT EACH ROW.
+        for (int y = rectangle.TopY; y < rectangle.BottomY; ++y)
+        {
+            float pixel_center_y = static_cast<float>(y) + 0.5f;
+            float v = top_v + (pixel_center_y - top_y) * v_per_pixel;
+            const unsigned char* texel_row = font_texture.Texels + static_cast<std::size_t>(font_texture.TexelY(v)) * static_cast<std::size_t>(font_texture.WidthInTexels);
+            uint32_t* pixel_row = target.Pixels + static_cast<std::size_t>(y) * static_cast<std::size_t>(target.WidthInPixels) + static_cast<std::size_t>(rectangle.LeftX);
+            int column_index = 0;
+
+#if PREMULTIPLIED_ALPHA_SSE2
+            // PAINT 4 PIXELS AT A TIME.
+            const __m128i COLORS = _mm_set1_epi32(static_cast<int>(color));
+            constexpr int PIXELS_PER_BATCH = 4;
+            for (; column_index + PIXELS_PER_BATCH <= width_in_pixels; column_index += PIXELS_PER_BATCH)
+            {
+                // SKIP UNCOVERED PIXELS.
+                // Much of a glyph's area is empty.
+                const int* texel_xs = ColumnTexelXs.data() + column_index;
+                int coverage_0 = texel_row[texel_xs[0]];
+                int coverage_1 = texel_row[texel_xs[1]];
+                int coverage_2 = texel_row[texel_xs[2]];
+                int coverage_3 = texel_row[texel_xs[3]];
+                bool any_coverage = (0 != (coverage_0 | coverage_1 | coverage_2 | coverage_3));
+                if (!any_coverage)
+                {
+                    continue;
+                }
+
+                __m128i coverages = _mm_setr_epi32(coverage_0, coverage_1, coverage_2, coverage_3);
+                __m128i source_pixels = RENDERING::PremultipliedAlpha::Premultiply(COLORS, coverages);
+                __m128i* destination_pixels = reinterpret_cast<__m128i*>(pixel_row + column_index);
+                _mm_storeu_si128(destination_pixels, RENDERING::PremultipliedAlpha::BlendOver(source_pixels, _mm_loadu_si128(destination_pixels)));
+            }
+#endif
+
+            // PAINT ANY REMAINING PIXELS INDIVIDUALLY.
+            for (; column_index < width_in_pixels; ++column_index)
+            {
+                uint32_t coverage = texel_row[ColumnTexelXs[column_index]];
+                if (0 == coverage)
+                {
+                    continue;
+                }
+
+                uint32_t source_pixel = RENDERING::PremultipliedAlpha::Premultiply(color, coverage);
+                pixel_row[column_index] = RENDERING::PremultipliedAlpha::BlendOver(source_pixel, pixel_row[column_index]);
+            }
+        }
+    }
+
+    /// Paints a rectangle with a single color.
+    /// @param[in]  rectangle - The pixels to paint.  Must be within the target.
+    /// @param[in]  premultiplied_color - The color to blend over the pixels.
+    /// @param[in,out]  target - The pixels to paint into.
+    void SoftwareGuiPainter::PaintSolidRectangle(const RENDERING::ScreenRectangle& rectangle, const uint32_t premultiplied_color, PaintTarget& target)
+    {
+        // SKIP INVISIBLE RECTANGLES.
+        bool fully_transparent = (0 == premultiplied_color);
+        if (fully_transparent)
+        {
+            return;
+        }
+
+        int width_in_pixels = rectangle.WidthInPixels();
+        bool opaque = ((premultiplied_color >> 24) == 0xFF);
+        for (int y = rectangle.TopY; y < rectangle.BottomY; ++y)
+        {
+            uint32_t* pixel_row = target.Pixels + static_cast<std::size_t>(y) * static_cast<std::size_t>(target.WidthInPixels) + static_cast<std::size_t>(rectangle.LeftX);
+
+            // OVERWRITE PIXELS COVERED BY OPAQUE RECTANGLES.
+            if (opaque)
+            {
+                std::fill_n(pixel_row, width_in_pixels, premultiplied_color);
+                continue;
+            }
+
+            int column_index = 0;
+
+#if PREMULTIPLIED_ALPHA_SSE2
+            // BLEND 4 PIXELS AT A TIME.
+            const __m128i SOURCE_PIXELS = _mm_set1_epi32(static_cast<int>(premultiplied_color));
+            constexpr int PIXELS_PER_BATCH = 4;
+            for (; column_index + PIXELS_PER_BATCH <= width_in_pixels; column_index += PIXELS_PER_BATCH)
+            {
+                __m128i* destination_pixels = reinterpret_cast<__m128i*>(pixel_row + column_index);
+                _mm_storeu_si128(destination_pixels, RENDERING::PremultipliedAlpha::BlendOver(SOURCE_PIXELS, _mm_loadu_si128(destination_pixels)));
+            }
+#endif
+
+            // BLEND ANY REMAINING PIXELS INDIVIDUALLY.
+            for (; column_index < width_in_pixels; ++column_index)
+            {
+                pixel_row[column_index] = RENDERING::PremultipliedAlpha::BlendOver(premultiplied_color, pixel_row[column_index]);
+            }
+        }
+    }
+
+    /// Paints a triangle, interpolating its vertices' colors and texture coordinates across it.
+    /// @param[in]  first_vertex - The first vertex of the triangle.
+    /// @param[in]  second_vertex - The second vertex of the triangle.
+    /// @param[in]  third_vertex - The third vertex of the triangle.
+    /// @param[in]  display_origin - The position of the top-left of the screen in draw data coordinates.
+    /// @param[in]  clip_rectangle - The area of the screen that may be painted.
+    /// @param[in]  font_texture - The texture to sample.
+    /// @param[in,out]  target - The pixels to paint into.
+    void SoftwareGuiPainter::PaintTriangle(
+        const ImDrawVert& first_vertex,
+        const ImDrawVert& second_vertex,
+        const ImDrawVert& third_vertex,
+        const ImVec2& display_origin,
+        const RENDERING::ScreenRectangle& clip_rectangle,
+        const FontTexture& font_texture,
+        PaintTarget& target)
+    {
+        // GET THE VERTICES IN A CONSISTENT WINDING ORDER.
+        // Edge functions are positive inside triangles with a positive area, so triangles with a negative area are flipped.
+        constexpr std::size_t VERTEX_COUNT = 3;
+        std::array<const ImDrawVert*, VERTEX_COUNT> vertices = { &first_vertex, &second_vertex, &third_vertex };
+        std::array<ImVec2, VERTEX_COUNT> positions;
+        for (std::size_t vertex_index = 0; vertex_index < VERTEX_COUNT; ++vertex_index)
+        {
+            positions[vertex_index] = ImVec2(vertices[vertex_index]->pos.x - display_origin.x, vertices[vertex_index]->pos.y - display_origin.y);
+        }
+        float area = (
+            (positions[1].x - positions[0].x) * (positions[2].y - positions[0].y) -
+            (positions[1].y - positions[0].y) * (positions[2].x - positions[0].x));
+        if (0.0f == area)
+        {
+            return;
+        }
+        if (area < 0.0f)
+        {
+            std::swap(vertices[1], vertices[2]);
+            std::swap(positions[1], positions[2]);
+            area = -area;
+        }
+
+        // DETERMINE THE PIXELS THAT MIGHT BE COVERED.
+        float min_x = std::min({ positions[0].x, positions[1].x, positions[2].x });
+        float min_y = std::min({ positions[0].y, positions[1].y, positions[2].y });
+        float max_x = std::max({ positions[0].x, positions[1].x, positions[2].x });
+        float max_y = std::max({ positions[0].y, positions[1].y, positions[2].y });
+        RENDERING::ScreenRectangle bounds;
+        bounds.LeftX = static_cast<int>(std::ceil(min_x - 0.5f));
+        bounds.TopY = static_cast<int>(std::ceil(min_y - 0.5f));
+        bounds.RightX = static_cast<int>(std::floor(max_x - 0.5f)) + 1;
+        bounds.BottomY = static_cast<int>(std::floor(max_y - 0.5f)) + 1;
+        bounds = bounds.Intersection(clip_rectangle);
+        if (bounds.IsEmpty())
+        {
+            return;
+        }
+
+        // COMPUTE THE EDGE FUNCTIONS.
+        // The edge function for each vertex is zero on the opposite edge and equals the area at the vertex.
+        // To avoid blending pixels on a shared edge twice, each edge only includes pixels exactly on it
+        // if it's a top or left edge.  A shared edge goes in opposite directions in its two triangles,
+        // so it's a top or left edge in exactly one of them.
+        std::array<PlaneEquation, VERTEX_COUNT> edge_functions;
+        std::array<bool, VERTEX_COUNT> edges_inclusive;
+        for (std::size_t vertex_index = 0; vertex_index < VERTEX_COUNT; ++vertex_index)
+        {
+            const ImVec2& edge_start = positions[(vertex_index + 1) % VERTEX_COUNT];
+            const ImVec2& edge_end = positions[(vertex_index + 2) % VERTEX_COUNT];
+            float edge_x = edge_end.x - edge_start.x;
+            float edge_y = edge_end.y - edge_start.y;
+            edge_functions[vertex_index].A = -edge_y;
+            edge_functions[vertex_index].B = edge_x;
+            edge_functions[vertex_index].C = edge_y * edge_start.x - edge_x * edge_start.y;
+            edges_inclusive[vertex_index] = (edge_y > 0.0f) || ((0.0f == edge_y) && (edge_x < 0.0f));
+        }
+
+        // COMPUTE HOW ATTRIBUTES VARY ACROSS THE TRIANGLE.
+        // Each attribute is interpolated from the first vertex using the edge functions of the other vertices as weights.
+        auto interpolate = [&](const float first_value, const float second_value, const float third_value)
+        {
+            float second_difference = (second_value - first_value) / area;
+            float third_difference = (third_value - first_value) / area;
+            PlaneEquation plane;
+            plane.A = edge_functions[1].A * second_difference + edge_functions[2].A * third_difference;
+            plane.B = edge_functions[1].B * second_difference + edge_functions[2].B * third_difference;
+            plane.C = first_value + edge_functions[1].C * second_difference + edge_functions[2].C * third_difference;
+            return plane;
+        };
+        constexpr std::size_t COMPONENT_COUNT = 4;
+        std::array<PlaneEquation, COMPONENT_COUNT> color_components;
+        for (std::size_t component_index = 0; component_index < COMPONENT_COUNT; ++component_index)
+        {
+            uint32_t shift = static_cast<uint32_t>(component_index * 8);
+            color_components[component_index] = interpolate(
+                static_cast<float>((vertices[0]->col >> shift) & 0xFF),
+                static_cast<float>((vertices[1]->col >> shift) & 0xFF),
+                static_cast<float>((vertices[2]->col >> shift) & 0xFF));
+        }
+        PlaneEquation u_plane = interpolate(vertices[0]->uv.x, vertices[1]->uv.x, vertices[2]->uv.x);
+        PlaneEquation v_plane = interpolate(vertices[0]->uv.y, vertices[1]->uv.y, vertices[2]->uv.y);
+
+        // CHECK IF THE TRIANGLE HAS A CONSTANT COLOR.
+        // This is true for most non-rectangular shapes, which then only need their coverage computed per pixel.
+        bool uniform_color = (vertices[0]->col == vertices[1]->col) && (vertices[0]->col == vertices[2]->col);
+        bool textured = (vertices[0]->uv.x != vertices[1]->uv.x) || (vertices[0]->uv.x != vertices[2]->uv.x) ||
+            (vertices[0]->uv.y != vertices[1]->uv.y) || (vertices[0]->uv.y != vertices[2]->uv.y);
+        uint32_t uniform_source_pixel = RENDERING::PremultipliedAlpha::Premultiply(
+            vertices[0]->col,
+            font_texture.SampleCoverage(vertices[0]->uv.x, vertices[0]->uv.y));
+        bool uniform_source = uniform_color && !textured;
+        if (uniform_source && (0 == uniform_source_pixel))
+        {
+            return;
+        }
+
+        // Colors are computed the same way for single pixels and batches of pixels so that both give identical results.
+        constexpr float MAX_COMPONENT_VALUE = 255.0f;
+        auto compute_source_pixel = [&](const float pixel_center_x, const float pixel_center_y)
+        {
+            if (uniform_source)
+            {
+                return uniform_source_pixel;
+            }
+
+            uint32_t color = vertices[0]->col;
+            if (!uniform_color)
+            {
+                color = 0;
+                for (std::size_t component_index = 0; component_index < COMPONENT_COUNT; ++component_index)
+                {
+                    const PlaneEquation& component = color_components[component_index];
+                    float component_value = component.A * pixel_center_x + (component.B * pixel_center_y + component.C);
+                    component_value = std::min(std::max(component_value, 0.0f), MAX_COMPONENT_VALUE);
+                    // Adding 0.5 rounds to the nearest integer.
+                    color |= (static_cast<uint32_t>(component_value + 0.5f) << (component_index * 8));
+                }
+            }
+
+            float u = u_plane.A * pixel_center_x + (u_plane.B * pixel_center_y + u_plane.C);
+            float v = v_plane.A * pixel_center_x + (v_plane.B * pixel_center_y + v_plane.C);
+            return RENDERING::PremultipliedAlpha::Premultiply(color, font_texture.SampleCoverage(u, v));
+        };
+
+        // PAINT EACH ROW.
+        for (int y = bounds.TopY; y < bounds.BottomY; ++y)
+        {
+            float pixel_center_y = static_cast<float>(y) + 0.5f;
+            std::array<float, VERTEX_COUNT> edge_row_values;
+            for (std::size_t vertex_index = 0; vertex_index < VERTEX_COUNT; ++vertex_index)
+            {
+                edge_row_values[vertex_index] = edge_functions[vertex_index].B * pixel_center_y + edge_functions[vertex_index].C;
+            }
+
+            uint32_t* pixel_row = target.Pixels + static_cast<std::size_t>(y) * static_cast<std::size_t>(target.WidthInPixels);
+            int x = bounds.LeftX;
+
+#if PREMULTIPLIED_ALPHA_SSE2
+            // PAINT 4 PIXELS AT A TIME.
+            const __m128 PIXEL_CENTER_OFFSETS = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+            const __m128 ZERO = _mm_setzero_ps();
+            const __m128 MAX_COMPONENT_VALUES = _mm_set1_ps(MAX_COMPONENT_VALUE);
+            const __m128 ROUNDING = _mm_set1_ps(0.5f);
+            const __m128 PIXEL_CENTER_Y = _mm_set1_ps(pixel_center_y);
+            constexpr int PIXELS_PER_BATCH = 4;
+            for (; x + PIXELS_PER_BATCH <= bounds.RightX; x += PIXELS_PER_BATCH)
+            {
+                // DETERMINE WHICH PIXELS ARE INSIDE THE TRIANGLE.
+                __m128 pixel_center_xs = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), PIXEL_CENTER_OFFSETS);
+                __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                for (std::size_t vertex_index = 0; vertex_index < VERTEX_COUNT; ++vertex_index)
+                {
+                    __m128 edge_values = _mm_add_ps(
+                        _mm_mul_ps(_mm_set1_ps(edge_functions[vertex_index].A), pixel_center_xs),
+                        _mm_set1_ps(edge_row_values[vertex_index]));
+                    __m128 inside_edge = edges_inclusive[vertex_index] ? _mm_cmpge_ps(edge_values, ZERO) : _mm_cmpgt_ps(edge_values, ZERO);
+                    inside = _mm_and_ps(inside, inside_edge);
+                }
+                int inside_mask = _mm_movemask_ps(inside);
+                if (0 == inside_mask)
+                {
+                    continue;
+                }
+
+                // COMPUTE THE COLORS TO BLEND.
+                __m128i source_pixels = _mm_set1_epi32(static_cast<int>(uniform_source_pixel));
+                if (!uniform_source)
+                {
+                    __m128i colors = _mm_set1_epi32(static_cast<int>(vertices[0]->col));
+                    if (!uniform_color)
+                    {
+                        colors = _mm_setzero_si128();
+                        for (std::size_t component_index = 0; component_index < COMPONENT_COUNT; ++component_index)
+                        {
+                            const PlaneEquation& component = color_components[component_index];
+                            __m128 component_values = _mm_add_ps(
+                                _mm_mul_ps(_mm_set1_ps(component.A), pixel_center_xs),
+                                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(component.B), PIXEL_CENTER_Y), _mm_set1_ps(component.C)));
+                            component_values = _mm_min_ps(_mm_max_ps(component_values, ZERO), MAX_COMPONENT_VALUES);
+                            __m128i integer_components = _mm_cvttps_epi32(_mm_add_ps(component_values, ROUNDING));
+                            colors = _mm_or_si128(colors, _mm_slli_epi32(integer_components, static_cast<int>(component_index * 8)));
+                        }
+                    }
+
+                    // Texels are looked up individually since SSE2 can't gather them.
+                    alignas(16) std::array<int, PIXELS_PER_BATCH> coverages = {};
+                    for (int lane_index = 0; lane_index < PIXELS_PER_BATCH; ++lane_index)
+                    {
+                        float lane_center_x = static_cast<float>(x + lane_index) + 0.5f;
+                        float u = u_plane.A * lane_center_x + (u_plane.B * pixel_center_y + u_plane.C);
+                        float v = v_plane.A * lane_center_x + (v_plane.B * pixel_center_y + v_plane.C);
+                        coverages[lane_index] = static_cast<int>(font_texture.SampleCoverage(u, v));
+                    }
+                    source_pixels = RENDERING::PremultipliedAlpha::Premultiply(colors, _mm_load_si128(reinterpret_cast<const __m128i*>(coverages.data())));
+                }
+
+                // BLEND THE PIXELS INSIDE THE TRIANGLE.
+                __m128i* destination_pixels = reinterpret_cast<__m128i*>(pixel_row + x);
+                __m128i old_pixels = _mm_loadu_si128(destination_pixels);
+                __m128i blended_pixels = RENDERING::PremultipliedAlpha::BlendOver(source_pixels, old_pixels);
+                __m128i inside_lanes = _mm_castps_si128(inside);
+                __m128i new_pixels = _mm_or_si128(_mm_and_si128(inside_lanes, blended_pixels), _mm_andnot_si128(inside_lanes, old_pixels));
+                _mm_storeu_si128(destination_pixels, new_pixels);
+            }
+#endif
+
+            // PAINT ANY REMAINING PIXELS INDIVIDUALLY.
+            for (; x < bounds.RightX; ++x)
+            {
+                float pixel_center_x = static_cast<float>(x) + 0.5f;
+                bool inside = true;
+                for (std::size_t vertex_index = 0; vertex_index < VERTEX_COUNT; ++vertex_index)
+                {
+                    float edge_value = edge_functions[vertex_index].A * pixel_center_x + edge_row_values[vertex_index];
+                    bool inside_edge = edges_inclusive[vertex_index] ? (edge_value >= 0.0f) : (edge_value > 0.0f);
+                    inside = inside && inside_edge;
+                }
+                if (!inside)
+                {
+                    continue;
+                }
+
+                uint32_t source_pixel = compute_source_pixel(pixel_center_x, pixel_center_y);
+                pixel_row[x] = RENDERING::PremultipliedAlpha::BlendOver(source_pixel, pixel_row[x]);
+            }
+        }
+    }
+}
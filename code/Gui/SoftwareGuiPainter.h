@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <imgui/imgui.h>
+#include "Rendering/ScreenRectangle.h"
+
+namespace GUI
+{
+    /// Paints ImGui draw data in software into premultiplied-alpha pixels, as a faster alternative to imgui_sw.
+    ///
+    /// Almost all of the GUI is made of a few kinds of primitives, each of which has a path blending 4 pixels at a time:
+    /// - Solid rectangles (window backgrounds, frames, buttons), which are axis-aligned quads with a single color.
+    /// - Glyphs, which are axis-aligned quads with a single color textured by the font atlas.
+    /// - Other triangles (rounded corners, anti-aliased edges), which may have colors interpolated across them.
+    ///
+    /// Pixels are covered if their centers are inside primitives, with ties on shared triangle edges going to only
+    /// one of the triangles so that translucent shapes aren't blended twice along their internal edges.
+    ///
+    /// The only texture used by the GUI is ImGui's font atlas, so texture IDs are ignored and the atlas's alpha is sampled directly.
+    class SoftwareGuiPainter
+    {
+    public:
+        // PAINTING.
+        void Paint(const ImDrawData& draw_data, uint32_t* pixels, const unsigned int width_in_pixels, const unsigned int height_in_pixels);
+
+    private:
+        /// The font atlas primitives are textured with.
+        struct FontTexture
+        {
+            uint32_t SampleCoverage(const float u, const float v) const;
+            int TexelX(const float u) const;
+            int TexelY(const float v) const;
+
+            /// The alpha of each texel, row by row.
+            const unsigned char* Texels = nullptr;
+            /// The width of the texture.
+            int WidthInTexels = 0;
+            /// The height of the texture.
+            int HeightInTexels = 0;
+        };
+
+        /// The pixels being painted into.
+        struct PaintTarget
+        {
+            /// The pixels, row by row.
+            uint32_t* Pixels = nullptr;
+            /// The width of the pixels.
+            int WidthInPixels = 0;
+        };
+
+        /// A value varying linearly across the screen, in the form A * x + B * y + C.
+        struct PlaneEquation
+        {
+            /// The change in value per pixel in the x direction.
+            float A = 0.0f;
+            /// The change in value per pixel in the y direction.
+            float B = 0.0f;
+            /// The value at the screen's origin.
+            float C = 0.0f;
+        };
+
+        // HELPER METHODS.
+        void PaintRectangle(
+            const ImDrawVert& corner,
+            const ImDrawVert& opposite_corner,
+            const ImVec2& display_origin,
+            const RENDERING::ScreenRectangle& clip_rectangle,
+            const FontTexture& font_texture,
+            PaintTarget& target);
+        static void PaintSolidRectangle(const RENDERING::ScreenRectangle& rectangle, const uint32_t premultiplied_color, PaintTarget& target);
+        static void PaintTriangle(
+            const ImDrawVert& first_vertex,
+            const ImDrawVert& second_vertex,
+            const ImDrawVert& third_vertex,
+            const ImVec2& display_origin,
+            const RENDERING::ScreenRectangle& clip_rectangle,
+            const FontTexture& font_texture,
+            PaintTarget& target);
+
+        // PRIVATE MEMBER VARIABLES.
+        /// The texel column sampled for each column of pixels in the glyph currently being painted.
+        /// Kept between glyphs to avoid reallocating.
+        std::vector<int> ColumnTexelXs = {};
+    };
+}
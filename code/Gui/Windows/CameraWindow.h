@@ -14,5 +14,7 @@ namespace GUI::WINDOWS
         // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
         /// True if the window is open; false if not.
         bool IsOpen = false;
+        /// True if the camera was changed during the last update; false if not.
+        bool CameraChanged = false;
     };
 }
@@ -0,0 +1,59 @@
+#include <cmath>
+#include <string>
+#include <imgui/imgui.h>
+#include "Gui/Windows/ModelLoadingWindow.h"
+
+namespace GUI::WINDOWS
+{
+    /// Updates and renders the window, if a model is being loaded.
+    /// @param[in,out]  model_loader - The loader whose progress to display (and possibly cancel).
+    void ModelLoadingWindow::UpdateAndRender(ASSETS::AsyncModelLoader& model_loader)
+    {
+        // DON'T RENDER THE WINDOW IF NOTHING IS BEING LOADED.
+        if (!model_loader.IsLoading())
+        {
+            return;
+        }
+
+        // RENDER THE WINDOW.
+        // It is placed near the bottom of the screen so that it doesn't block the view of the scene being rendered.
+        ImGuiViewport* viewport = ImGui::GetMainViewport();
+        ImVec2 window_position(viewport->WorkPos.x + viewport->WorkSize.x * 0.5f, viewport->WorkPos.y + viewport->WorkSize.y * 0.9f);
+        ImVec2 window_pivot(0.5f, 1.0f);
+        ImGui::SetNextWindowPos(window_position, ImGuiCond_Always, window_pivot);
+        ImGuiWindowFlags window_flags = ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoSavedSettings;
+        if (ImGui::Begin("Loading Model", nullptr, window_flags))
+        {
+            // DISPLAY WHAT IS BEING LOADED.
+            std::string filepath = model_loader.CurrentFilepath().string();
+            ImGui::Text("%s", filepath.c_str());
+
+            // DISPLAY THE PROGRESS.
+            // If the loader can't estimate its progress, the elapsed time is shown instead so that users can still tell it is working.
+            float elapsed_time_in_seconds = model_loader.ElapsedTime().count();
+            float completed_proportion = model_loader.CompletedProportion();
+            bool progress_known = (completed_proportion >= 0.0f);
+            constexpr float PROGRESS_BAR_WIDTH_IN_PIXELS = 300.0f;
+            ImVec2 progress_bar_size(PROGRESS_BAR_WIDTH_IN_PIXELS, 0.0f);
+            if (progress_known)
+            {
+                std::string progress_text = std::to_string(static_cast<int>(completed_proportion * 100.0f)) + "% (" + std::to_string(static_cast<int>(elapsed_time_in_seconds)) + " s)";
+                ImGui::ProgressBar(completed_proportion, progress_bar_size, progress_text.c_str());
+            }
+            else
+            {
+                // The bar repeatedly fills up to indicate that work is still being done.
+                std::string progress_text = std::to_string(static_cast<int>(elapsed_time_in_seconds)) + " s";
+                float animation_fraction = std::fmod(elapsed_time_in_seconds, 1.0f);
+                ImGui::ProgressBar(animation_fraction, progress_bar_size, progress_text.c_str());
+            }
+
+            // ALLOW THE USER TO CANCEL LOADING.
+            if (ImGui::Button("Cancel"))
+            {
+                model_loader.Cancel();
+            }
+        }
+        ImGui::End();
+    }
+}
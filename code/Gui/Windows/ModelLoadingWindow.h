@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Assets/AsyncModelLoader.h"
+
+namespace GUI::WINDOWS
+{
+    /// A window showing the progress of a model being loaded in the background and letting users cancel it.
+    /// The window is only shown while a load is in progress.
+    class ModelLoadingWindow
+    {
+    public:
+        // PUBLIC METHODS.
+        void UpdateAndRender(ASSETS::AsyncModelLoader& model_loader);
+    };
+}
@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <imgui/imgui.h>
+#include "Gui/Windows/ProfilerWindow.h"
+
+namespace GUI::WINDOWS
+{
+    /// Updates and renders the window, if open.
+    void ProfilerWindow::UpdateAndRender()
+    {
+        // DON'T RENDER THE WINDOW IF IT IS CLOSED.
+        if (!IsOpen)
+        {
+            return;
+        }
+
+        // RENDER THE WINDOW.
+        if (ImGui::Begin("Profiler", &IsOpen))
+        {
+            // ALLOW PAUSING SO THAT SPECIFIC FRAMES CAN BE INSPECTED.
+            ImGui::Checkbox("Pause", &PROFILING::Profiler::Paused);
+
+            // DON'T DISPLAY ANYTHING ELSE IF NO FRAMES HAVE BEEN RECORDED.
+            std::size_t frame_count = PROFILING::Profiler::CompletedFrameCount();
+            if (frame_count <= 0)
+            {
+                ImGui::Text("No frames recorded.");
+                ImGui::End();
+                return;
+            }
+
+            // GATHER FRAME TIMES.
+            float total_frame_time_in_milliseconds = 0.0f;
+            float max_frame_time_in_milliseconds = 0.0f;
+            for (std::size_t frames_ago = 0; frames_ago < frame_count; ++frames_ago)
+            {
+                float frame_time_in_milliseconds = PROFILING::Profiler::GetCompletedFrame(frames_ago).DurationInMilliseconds;
+                FrameTimesInMilliseconds[frame_count - 1 - frames_ago] = frame_time_in_milliseconds;
+                total_frame_time_in_milliseconds += frame_time_in_milliseconds;
+                max_frame_time_in_milliseconds = std::max(max_frame_time_in_milliseconds, frame_time_in_milliseconds);
+            }
+            float average_frame_time_in_milliseconds = total_frame_time_in_milliseconds / static_cast<float>(frame_count);
+            constexpr float MILLISECONDS_PER_SECOND = 1000.0f;
+            float average_frames_per_second = (average_frame_time_in_milliseconds > 0.0f) ? MILLISECONDS_PER_SECOND / average_frame_time_in_milliseconds : 0.0f;
+
+            // GRAPH FRAME TIMES.
+            ImGui::Text(
+                "Average: %.2f ms (%.1f FPS)  Max: %.2f ms  (%zu frames)",
+                average_frame_time_in_milliseconds,
+                average_frames_per_second,
+                max_frame_time_in_milliseconds,
+                frame_count);
+            constexpr float GRAPH_HEIGHT_IN_PIXELS = 80.0f;
+            const char* const NO_OVERLAY_TEXT = nullptr;
+            constexpr float GRAPH_MIN_TIME_IN_MILLISECONDS = 0.0f;
+            ImGui::PlotHistogram(
+                "##FrameTimes",
+                FrameTimesInMilliseconds.data(),
+                static_cast<int>(frame_count),
+                0,
+                NO_OVERLAY_TEXT,
+                GRAPH_MIN_TIME_IN_MILLISECONDS,
+                max_frame_time_in_milliseconds,
+                ImVec2(ImGui::GetContentRegionAvail().x, GRAPH_HEIGHT_IN_PIXELS));
+
+            // SUMMARIZE INPUT LATENCY.
+            // Only frames that handled input have a latency, measured from the input until the frame was displayed.
+            std::size_t input_frame_count = 0;
+            float latest_input_latency_in_milliseconds = -1.0f;
+            float total_input_latency_in_milliseconds = 0.0f;
+            float max_input_latency_in_milliseconds = 0.0f;
+            for (std::size_t frames_ago = 0; frames_ago < frame_count; ++frames_ago)
+            {
+                float input_latency_in_milliseconds = PROFILING::Profiler::GetCompletedFrame(frames_ago).InputLatencyInMilliseconds;
+                if (input_latency_in_milliseconds < 0.0f)
+                {
+                    continue;
+                }
+
+                if (0 == input_frame_count)
+                {
+                    latest_input_latency_in_milliseconds = input_latency_in_milliseconds;
+                }
+                ++input_frame_count;
+                total_input_latency_in_milliseconds += input_latency_in_milliseconds;
+                max_input_latency_in_milliseconds = std::max(max_input_latency_in_milliseconds, input_latency_in_milliseconds);
+            }
+            if (input_frame_count > 0)
+            {
+                float average_input_latency_in_milliseconds = total_input_latency_in_milliseconds / static_cast<float>(input_frame_count);
+                ImGui::Text(
+                    "Input Latency: latest %.2f ms  avg %.2f ms  max %.2f ms  (%zu frames with input)",
+                    latest_input_latency_in_milliseconds,
+                    average_input_latency_in_milliseconds,
+                    max_input_latency_in_milliseconds,
+                    input_frame_count);
+            }
+            else
+            {
+                ImGui::Text("Input Latency: no input recorded.");
+            }
+
+            // ALLOW SELECTING A FRAME TO VIEW IN DETAIL.
+            int max_frames_ago = static_cast<int>(frame_count) - 1;
+            ImGui::SliderInt("Frames Ago", &SelectedFramesAgo, 0, max_frames_ago);
+            SelectedFramesAgo = std::clamp(SelectedFramesAgo, 0, max_frames_ago);
+            const PROFILING::ProfiledFrame& selected_frame = PROFILING::Profiler::GetCompletedFrame(static_cast<std::size_t>(SelectedFramesAgo));
+            ImGui::Text("Frame %llu: %.2f ms", static_cast<unsigned long long>(selected_frame.FrameIndex), selected_frame.DurationInMilliseconds);
+
+            // DRAW FLAME BARS FOR THE SELECTED FRAME.
+            // Each scope is a bar spanning its portion of the frame, with nested scopes in rows below their parents.
+            uint32_t max_depth = 0;
+            for (const PROFILING::ProfiledScope& scope : selected_frame.Scopes)
+            {
+                max_depth = std::max(max_depth, scope.Depth);
+            }
+            float row_height_in_pixels = ImGui::GetTextLineHeightWithSpacing();
+            ImVec2 flame_graph_position = ImGui::GetCursorScreenPos();
+            ImVec2 flame_graph_size(ImGui::GetContentRegionAvail().x, row_height_in_pixels * static_cast<float>(max_depth + 1));
+            ImGui::Dummy(flame_graph_size);
+
+            ImDrawList* draw_list = ImGui::GetWindowDrawList();
+            float pixels_per_millisecond = (selected_frame.DurationInMilliseconds > 0.0f) ? flame_graph_size.x / selected_frame.DurationInMilliseconds : 0.0f;
+            for (const PROFILING::ProfiledScope& scope : selected_frame.Scopes)
+            {
+                // COMPUTE THE BAR'S RECTANGLE.
+                // Bars are kept at least a pixel wide so that very short scopes remain visible.
+                constexpr float MIN_BAR_WIDTH_IN_PIXELS = 1.0f;
+                ImVec2 bar_min(
+                    flame_graph_position.x + scope.StartTimeInMilliseconds * pixels_per_millisecond,
+                    flame_graph_position.y + static_cast<float>(scope.Depth) * row_height_in_pixels);
+                ImVec2 bar_max(
+                    bar_min.x + std::max(scope.DurationInMilliseconds * pixels_per_millisecond, MIN_BAR_WIDTH_IN_PIXELS),
+                    bar_min.y + row_height_in_pixels - 1.0f);
+
+                // PICK A COLOR CONSISTENT FOR THE SCOPE'S NAME.
+                // The golden ratio spreads hues for consecutive hash values far apart.
+                std::size_t name_hash = std::hash<std::string_view>()(scope.Name);
+                constexpr float GOLDEN_RATIO_CONJUGATE = 0.618034f;
+                float hue = static_cast<float>(name_hash % 1024) * GOLDEN_RATIO_CONJUGATE;
+                hue -= static_cast<float>(static_cast<int>(hue));
+                constexpr float SATURATION = 0.5f;
+                constexpr float VALUE = 0.7f;
+                ImU32 bar_color = ImColor::HSV(hue, SATURATION, VALUE);
+                draw_list->AddRectFilled(bar_min, bar_max, bar_color);
+
+                // LABEL THE BAR IF IT IS WIDE ENOUGH.
+                char bar_label[128] = {};
+                std::snprintf(bar_label, sizeof(bar_label), "%s %.2f ms", scope.Name, scope.DurationInMilliseconds);
+                ImVec2 bar_label_size = ImGui::CalcTextSize(bar_label);
+                float bar_width_in_pixels = bar_max.x - bar_min.x;
+                if (bar_label_size.x < bar_width_in_pixels)
+                {
+                    draw_list->AddText(bar_min, ImGui::GetColorU32(ImGuiCol_Text), bar_label);
+                }
+
+                // SHOW DETAILS WHEN HOVERING OVER THE BAR.
+                if (ImGui::IsMouseHoveringRect(bar_min, bar_max))
+                {
+                    ImGui::SetTooltip("%s\nStart: %.3f ms\nDuration: %.3f ms", scope.Name, scope.StartTimeInMilliseconds, scope.DurationInMilliseconds);
+                }
+            }
+
+            // SUMMARIZE TOP-LEVEL SCOPES ACROSS ALL FRAMES.
+            // Scopes are matched by name, and there are few enough distinct top-level scopes that a linear search is fine.
+            struct ScopeSummary
+            {
+                const char* Name = "";
+                float LatestDurationInMilliseconds = 0.0f;
+                float TotalDurationInMilliseconds = 0.0f;
+                float MaxDurationInMilliseconds = 0.0f;
+            };
+            constexpr std::size_t MAX_SUMMARIZED_SCOPE_COUNT = 32;
+            std::array<ScopeSummary, MAX_SUMMARIZED_SCOPE_COUNT> scope_summaries = {};
+            std::size_t scope_summary_count = 0;
+            for (std::size_t frames_ago = 0; frames_ago < frame_count; ++frames_ago)
+            {
+                const PROFILING::ProfiledFrame& frame = PROFILING::Profiler::GetCompletedFrame(frames_ago);
+                for (const PROFILING::ProfiledScope& scope : frame.Scopes)
+                {
+                    if (scope.Depth > 0)
+                    {
+                        continue;
+                    }
+
+                    ScopeSummary* scope_summary = std::find_if(
+                        scope_summaries.data(),
+                        scope_summaries.data() + scope_summary_count,
+                        [&](const ScopeSummary& summary) { return 0 == std::strcmp(summary.Name, scope.Name); });
+                    bool new_scope = (scope_summaries.data() + scope_summary_count == scope_summary);
+                    if (new_scope)
+                    {
+                        if (scope_summary_count >= MAX_SUMMARIZED_SCOPE_COUNT)
+                        {
+                            continue;
+                        }
+                        ++scope_summary_count;
+                        scope_summary->Name = scope.Name;
+                        scope_summary->LatestDurationInMilliseconds = scope.DurationInMilliseconds;
+                    }
+                    scope_summary->TotalDurationInMilliseconds += scope.DurationInMilliseconds;
+                    scope_summary->MaxDurationInMilliseconds = std::max(scope_summary->MaxDurationInMilliseconds, scope.DurationInMilliseconds);
+                }
+            }
+
+            ImGui::Separator();
+            ImGui::Text("Phase averages over %zu frames:", frame_count);
+            for (std::size_t scope_summary_index = 0; scope_summary_index < scope_summary_count; ++scope_summary_index)
+            {
+                const ScopeSummary& scope_summary = scope_summaries[scope_summary_index];
+                float average_duration_in_milliseconds = scope_summary.TotalDurationInMilliseconds / static_cast<float>(frame_count);
+                ImGui::Text(
+                    "%-24s latest %7.3f ms  avg %7.3f ms  max %7.3f ms",
+                    scope_summary.Name,
+                    scope_summary.LatestDurationInMilliseconds,
+                    average_duration_in_milliseconds,
+                    scope_summary.MaxDurationInMilliseconds);
+            }
+        }
+        ImGui::End();
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include "Profiling/Profiler.h"
+
+namespace GUI::WINDOWS
+{
+    /// A window showing where time is spent in recent frames, based on the profiler's recorded scopes.
+    class ProfilerWindow
+    {
+    public:
+        // PUBLIC METHODS.
+        void UpdateAndRender();
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// True if the window is open; false if not.
+        bool IsOpen = false;
+        /// How many frames before the most recent frame the frame shown in detail is.
+        int SelectedFramesAgo = 0;
+
+    private:
+        // PRIVATE MEMBER VARIABLES.
+        /// Frame times for graphing, ordered from oldest to newest.  Kept to avoid reallocating each frame.
+        std::array<float, PROFILING::Profiler::FRAME_HISTORY_COUNT> FrameTimesInMilliseconds = {};
+    };
+}
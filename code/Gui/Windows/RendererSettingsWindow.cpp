@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <thread>
 #include <imgui/imgui.h>
 #include "Gui/Windows/RendererSettingsWindow.h"
 
@@ -5,9 +7,16 @@ namespace GUI::WINDOWS
 {
     /// Updates and renders the window, if open.
     /// @param[in,out]  rendering_settings - The rendering settings to update/display in the window.
+    /// @param[in,out]  cpu_rendering_settings - The settings for scheduling CPU rendering work to update/display in the window.
     /// @param[in,out]  graphics_device - The graphics device for which the rendering settings apply.
-    void RendererSettingsWindow::UpdateAndRender(GRAPHICS::RenderingSettings& rendering_settings, GRAPHICS::HARDWARE::IGraphicsDevice& graphics_device)
+    void RendererSettingsWindow::UpdateAndRender(
+        GRAPHICS::RenderingSettings& rendering_settings,
+        RENDERING::CpuRenderingSettings& cpu_rendering_settings,
+        GRAPHICS::HARDWARE::IGraphicsDevice& graphics_device)
     {
+        // RESET CHANGE TRACKING FOR THE NEW FRAME.
+        SettingsChanged = false;
+
         // DON'T RENDER THE WINDOW IF IT IS CLOSED.
         if (!IsOpen)
         {
@@ -23,57 +32,95 @@ namespace GUI::WINDOWS
             if (ImGui::RadioButton("CPU RASTERIZER", rasterization_configured))
             {
                 rendering_settings.GraphicsDeviceType = GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RASTERIZER;
+                SettingsChanged = true;
             }
 
             bool ray_tracing_configured = (GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RAY_TRACER == current_graphics_device_type);
             if (ImGui::RadioButton("CPU RAY TRACER", ray_tracing_configured))
             {
                 rendering_settings.GraphicsDeviceType = GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RAY_TRACER;
+                SettingsChanged = true;
             }
 
             bool open_gl_configured = (GRAPHICS::HARDWARE::GraphicsDeviceType::OPEN_GL == current_graphics_device_type);
             if (ImGui::RadioButton("OPEN GL", open_gl_configured))
             {
                 rendering_settings.GraphicsDeviceType = GRAPHICS::HARDWARE::GraphicsDeviceType::OPEN_GL;
+                SettingsChanged = true;
             }
 
             bool direct_3d_configured = (GRAPHICS::HARDWARE::GraphicsDeviceType::DIRECT_3D == current_graphics_device_type);
             if (ImGui::RadioButton("DIRECT 3D", direct_3d_configured))
             {
                 rendering_settings.GraphicsDeviceType = GRAPHICS::HARDWARE::GraphicsDeviceType::DIRECT_3D;
+                SettingsChanged = true;
             }
 
             // ALLOW EDITING OTHER KINDS OF RENDERING SETTINGS.
             /// @todo   Figure out how to communicate that all settings are not applicable to all renderers.
-            ImGui::Checkbox("CPU SIMD?", &rendering_settings.UseCpuSimd);
-            ImGui::Checkbox("Cull Backfaces?", &rendering_settings.CullBackfaces);
-            ImGui::Checkbox("Depth Buffering?", &rendering_settings.DepthBuffering);
-            ImGui::Checkbox("Lighting?", &rendering_settings.Shading.Lighting.Enabled);
-            ImGui::Checkbox("Render point lights?", &rendering_settings.Shading.Lighting.RenderPointLights);
-            ImGui::Checkbox("Ambient Lighting?", &rendering_settings.Shading.Lighting.AmbientLightingEnabled);
-            ImGui::Checkbox("Shadows?", &rendering_settings.Shading.Lighting.ShadowsEnabled);
-            ImGui::Checkbox("Diffuse Shading?", &rendering_settings.Shading.Lighting.DiffuseLightingEnabled);
-            ImGui::Checkbox("Specular Shading?", &rendering_settings.Shading.Lighting.SpecularLightingEnabled);
-            ImGui::Checkbox("Reflections?", &rendering_settings.Reflections);
-            ImGui::SliderInt("Max Reflection Count:", reinterpret_cast<int*>(&rendering_settings.MaxReflectionCount), 0, 30);
-            ImGui::Checkbox("Texture Mapping?", &rendering_settings.Shading.TextureMappingEnabled);
+            // Only the rasterizers have separate SIMD code paths, so the setting is hidden when it would do nothing
+            // (the ray tracer has a single code path).
+            if (rasterization_configured)
+            {
+                SettingsChanged |= ImGui::Checkbox("CPU SIMD?", &rendering_settings.UseCpuSimd);
+            }
+            SettingsChanged |= ImGui::Checkbox("Cull Backfaces?", &rendering_settings.CullBackfaces);
+            SettingsChanged |= ImGui::Checkbox("Depth Buffering?", &rendering_settings.DepthBuffering);
+            SettingsChanged |= ImGui::Checkbox("Lighting?", &rendering_settings.Shading.Lighting.Enabled);
+            SettingsChanged |= ImGui::Checkbox("Render point lights?", &rendering_settings.Shading.Lighting.RenderPointLights);
+            SettingsChanged |= ImGui::Checkbox("Ambient Lighting?", &rendering_settings.Shading.Lighting.AmbientLightingEnabled);
+            SettingsChanged |= ImGui::Checkbox("Shadows?", &rendering_settings.Shading.Lighting.ShadowsEnabled);
+            SettingsChanged |= ImGui::Checkbox("Diffuse Shading?", &rendering_settings.Shading.Lighting.DiffuseLightingEnabled);
+            SettingsChanged |= ImGui::Checkbox("Specular Shading?", &rendering_settings.Shading.Lighting.SpecularLightingEnabled);
+            SettingsChanged |= ImGui::Checkbox("Reflections?", &rendering_settings.Reflections);
+            SettingsChanged |= ImGui::SliderInt("Max Reflection Count:", reinterpret_cast<int*>(&rendering_settings.MaxReflectionCount), 0, 30);
+            SettingsChanged |= ImGui::Checkbox("Texture Mapping?", &rendering_settings.Shading.TextureMappingEnabled);
 
             // ALLOW THE USER TO CHANGE THE SHADING TYPE.
             bool wireframe_configured = (GRAPHICS::SHADING::ShadingType::WIREFRAME == rendering_settings.Shading.ShadingType);
             if (ImGui::RadioButton("WIREFRAME", wireframe_configured))
             {
                 rendering_settings.Shading.ShadingType = GRAPHICS::SHADING::ShadingType::WIREFRAME;
+                SettingsChanged = true;
             }
             bool flat_configured = (GRAPHICS::SHADING::ShadingType::FLAT == rendering_settings.Shading.ShadingType);
             if (ImGui::RadioButton("FLAT", flat_configured))
             {
                 rendering_settings.Shading.ShadingType = GRAPHICS::SHADING::ShadingType::FLAT;
+                SettingsChanged = true;
             }
             bool material_configured = (GRAPHICS::SHADING::ShadingType::MATERIAL == rendering_settings.Shading.ShadingType);
             if (ImGui::RadioButton("MATERIAL", material_configured))
             {
                 rendering_settings.Shading.ShadingType = GRAPHICS::SHADING::ShadingType::MATERIAL;
+                SettingsChanged = true;
             }
+
+            // ALLOW THE USER TO CHANGE HOW CPU RENDERING WORK IS SPLIT ACROSS CORES.
+            // A thread count of 0 uses all hardware threads.
+            int hardware_thread_count = static_cast<int>(std::thread::hardware_concurrency());
+            ImGui::Text("Hardware Threads: %d", hardware_thread_count);
+            SettingsChanged |= ImGui::SliderInt("Thread Count (0 = all):", reinterpret_cast<int*>(&cpu_rendering_settings.ThreadCount), 0, std::max(hardware_thread_count, 1));
+            SettingsChanged |= ImGui::SliderInt("Tile Size:", reinterpret_cast<int*>(&cpu_rendering_settings.TileSizeInPixels), 8, 128);
+            SettingsChanged |= ImGui::Checkbox("Binning Rasterizer?", &cpu_rendering_settings.BinningRasterization);
+            SettingsChanged |= ImGui::Checkbox("Progressive Ray Tracing?", &cpu_rendering_settings.ProgressiveRayTracing);
+            SettingsChanged |= ImGui::SliderFloat("Refinement Time Budget (ms):", &cpu_rendering_settings.ProgressiveTimeBudgetInMilliseconds, 1.0f, 100.0f);
+            SettingsChanged |= ImGui::Checkbox("Mipmapped Textures?", &cpu_rendering_settings.MipmappedTextureSampling);
+            SettingsChanged |= ImGui::Checkbox("Levels of Detail?", &cpu_rendering_settings.LevelsOfDetail);
+            SettingsChanged |= ImGui::SliderFloat("Pixels Per Triangle:", &cpu_rendering_settings.LevelOfDetailPixelsPerTriangle, 0.25f, 16.0f);
+            SettingsChanged |= ImGui::Checkbox("Frustum Culling?", &cpu_rendering_settings.FrustumCulling);
+            SettingsChanged |= ImGui::Checkbox("Hierarchical Depth Culling?", &cpu_rendering_settings.HierarchicalDepthCulling);
+
+            // DISPLAY HOW MUCH GEOMETRY WAS CULLED.
+            ImGui::Text(
+                "Objects Outside Frustum: %zu / %zu",
+                CullingStatistics.ObjectsOutsideFrustum,
+                CullingStatistics.ObjectCount);
+            ImGui::Text(
+                "Clusters Outside Frustum: %zu / %zu",
+                CullingStatistics.ClustersOutsideFrustum,
+                CullingStatistics.ClusterCount);
+            ImGui::Text("Occluded Triangles: %zu", CullingStatistics.OccludedTriangleCount);
         }
         ImGui::End();
     }
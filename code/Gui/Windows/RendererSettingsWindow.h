@@ -2,6 +2,8 @@
 
 #include "Graphics/Hardware/IGraphicsDevice.h"
 #include "Graphics/RenderingSettings.h"
+#include "Rendering/CpuRenderingSettings.h"
+#include "Rendering/ViewFrustum.h"
 
 namespace GUI::WINDOWS
 {
@@ -10,10 +12,17 @@ namespace GUI::WINDOWS
     {
     public:
         // PUBLIC METHODS.
-        void UpdateAndRender(GRAPHICS::RenderingSettings& rendering_settings, GRAPHICS::HARDWARE::IGraphicsDevice& graphics_device);
+        void UpdateAndRender(
+            GRAPHICS::RenderingSettings& rendering_settings,
+            RENDERING::CpuRenderingSettings& cpu_rendering_settings,
+            GRAPHICS::HARDWARE::IGraphicsDevice& graphics_device);
 
         // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
         /// True if the window is open; false if not.
         bool IsOpen = false;
+        /// True if any settings were changed during the last update; false if not.
+        bool SettingsChanged = false;
+        /// Counts of geometry culled by CPU rendering in the most recent frame, for display.
+        RENDERING::CullingStatistics CullingStatistics = {};
     };
 }
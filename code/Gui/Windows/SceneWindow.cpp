@@ -1,9 +1,7 @@
 #include <string>
-#include <optional>
 #include <vector>
 #include <commdlg.h>
 #include <imgui/imgui.h>
-#include "Graphics/Modeling/WavefrontObjectModel.h"
 #include "Gui/Controls/ColorEditor.h"
 #include "Gui/Panels/LightPanel.h"
 #include "Gui/Panels/ObjectPanel.h"
@@ -66,6 +64,12 @@ namespace GUI::WINDOWS
     /// @param[in,out]  scene - The scene whose information to display (and possibly update).
     void SceneWindow::UpdateAndRender(GRAPHICS::Scene& scene)
     {
+        // RESET CHANGE TRACKING FOR THE NEW FRAME.
+        GeometryChanged = false;
+        SceneChanged = false;
+        OnlyTransformsChanged = false;
+        ModelFilepathToLoad.clear();
+
         // DON'T RENDER THE WINDOW IF IT IS CLOSED.
         if (!IsOpen)
         {
@@ -73,10 +77,12 @@ namespace GUI::WINDOWS
         }
 
         // RENDER THE WINDOW.
+        // Transform changes are tracked separately until the end so that it's known if they were the only changes.
+        bool transforms_changed = false;
         if (ImGui::Begin("Scene", &IsOpen))
         {
             // ALLOW THE USER TO EDIT THE BACKGROUND COLOR.
-            CONTROLS::ColorEditor::DisplayAndAllowEditing("Background Color", scene.BackgroundColor);
+            SceneChanged |= CONTROLS::ColorEditor::DisplayAndAllowEditing("Background Color", scene.BackgroundColor);
 
             // ALLOW THE USER TO VIEW/EDIT LIGHTS.
             /// @todo   Allow rendering of lights in scene!
@@ -89,14 +95,14 @@ namespace GUI::WINDOWS
                 {
                     // DISPLAY INFORMATION FOR THE CURRENT LIGHT.
                     bool light_removed = false;
-                    std::string light_tree_label = "Light " + std::to_string(light_index);
-                    if (ImGui::TreeNode(light_tree_label.c_str()))
+                    // The label is formatted by ImGui to avoid building a string every frame.
+                    if (ImGui::TreeNode(reinterpret_cast<void*>(light_index), "Light %zu", light_index))
                     {
                         // ALLOW THE USER TO REMOVE THE CURRENT LIGHT.
                         light_removed = ImGui::Button("Remove");
 
                         // ALLOW VIEWING/EDITING OF THE LIGHT.
-                        PANELS::LightPanel::UpdateAndRender(*light);
+                        SceneChanged |= PANELS::LightPanel::UpdateAndRender(*light);
 
                         ImGui::TreePop();
                     }
@@ -111,6 +117,7 @@ namespace GUI::WINDOWS
                     if (light_removed)
                     {
                         light = scene.Lights.erase(light);
+                        SceneChanged = true;
                     }
                     else
                     {
@@ -122,6 +129,7 @@ namespace GUI::WINDOWS
                 if (ImGui::Button("Add"))
                 {
                     scene.Lights.emplace_back(GRAPHICS::SHADING::LIGHTING::Light{});
+                    SceneChanged = true;
                 }
 
                 ImGui::TreePop();
@@ -137,14 +145,18 @@ namespace GUI::WINDOWS
                 {
                     // DISPLAY INFORMATION FOR THE CURRENT OBJECT.
                     bool object_removed = false;
-                    std::string object_tree_label = "Object " + std::to_string(object_index);
-                    if (ImGui::TreeNode(object_tree_label.c_str()))
+                    if (ImGui::TreeNode(reinterpret_cast<void*>(object_index), "Object %zu", object_index))
                     {
                         // ALLOW THE USER TO REMOVE THE CURRENT OBJECT.
                         object_removed = ImGui::Button("Remove");
 
                         // ALLOW VIEWING/EDITING OF THE OBJECT.
-                        PANELS::ObjectPanel::UpdateAndRender(*object);
+                        bool object_only_transform_changed = false;
+                        bool object_geometry_changed = false;
+                        bool object_changed = PANELS::ObjectPanel::UpdateAndRender(*object, object_only_transform_changed, object_geometry_changed);
+                        transforms_changed |= object_only_transform_changed;
+                        SceneChanged |= (object_changed && !object_only_transform_changed);
+                        GeometryChanged |= object_geometry_changed;
 
                         ImGui::TreePop();
                     }
@@ -159,6 +171,7 @@ namespace GUI::WINDOWS
                     if (object_removed)
                     {
                         object = scene.Objects.erase(object);
+                        GeometryChanged = true;
                     }
                     else
                     {
@@ -169,18 +182,7 @@ namespace GUI::WINDOWS
                 // ALLOW THE USER TO LOAD OBJECTS FROM FILE.
                 if (ImGui::Button("Load"))
                 {
-                    std::string model_filepath = GetFilepathToOpenFromUser();
-                    if (!model_filepath.empty())
-                    {
-                        std::optional<GRAPHICS::MODELING::Model> current_model = GRAPHICS::MODELING::WavefrontObjectModel::Load(model_filepath);
-                        if (current_model)
-                        {
-                            GRAPHICS::Object3D new_object = GRAPHICS::Object3D();
-                            new_object.Model = *current_model;
-                            scene.Objects.emplace_back(new_object);
-                            /// @todo   Will need to find way to load into graphics device.
-                        }
-                    }
+                    ModelFilepathToLoad = GetFilepathToOpenFromUser();
                 }
 
                 // ALLOW THE USER TO ADD ARBITRARY NEW OBJECTS.
@@ -189,11 +191,17 @@ namespace GUI::WINDOWS
                 if (ImGui::Button("Add"))
                 {
                     scene.Objects.emplace_back(GRAPHICS::Object3D{});
+                    GeometryChanged = true;
                 }
 
                 ImGui::TreePop();
             }
         }
         ImGui::End();
+
+        // Geometry and transform changes are also changes to the scene.
+        SceneChanged |= GeometryChanged;
+        OnlyTransformsChanged = transforms_changed && !SceneChanged;
+        SceneChanged |= transforms_changed;
     }
 }
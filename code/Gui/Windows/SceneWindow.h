@@ -1,5 +1,6 @@
 #pragma once
 
+#include <filesystem>
 #include "Graphics/Scene.h"
 
 namespace GUI::WINDOWS
@@ -14,5 +15,17 @@ namespace GUI::WINDOWS
         // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
         /// True if the window is open; false if not.
         bool IsOpen = false;
+        /// True if object geometry was changed (including objects being added or removed) during the last update;
+        /// false if not.  This lets renderers know when cached geometry must be rebuilt.
+        bool GeometryChanged = false;
+        /// True if anything about the scene was changed (including geometry) during the last update; false if not.
+        /// This lets renderers know when the scene must be re-rendered.
+        bool SceneChanged = false;
+        /// True if object transforms were the only changes to the scene during the last update; false if not.
+        /// Moved objects only change the parts of the screen they covered before and after, so renderers may just redraw those.
+        bool OnlyTransformsChanged = false;
+        /// The filepath of a model the user requested to be added to the scene during the last update; empty if none.
+        /// Models can take a long time to load, so loading them is left to the caller.
+        std::filesystem::path ModelFilepathToLoad = "";
     };
 }
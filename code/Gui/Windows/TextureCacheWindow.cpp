@@ -0,0 +1,49 @@
+#include <imgui/imgui.h>
+#include "Assets/TextureCache.h"
+#include "Gui/Windows/TextureCacheWindow.h"
+
+namespace GUI::WINDOWS
+{
+    /// Updates and renders the window, if open.
+    void TextureCacheWindow::UpdateAndRender()
+    {
+        // DON'T RENDER THE WINDOW IF IT IS CLOSED.
+        if (!IsOpen)
+        {
+            return;
+        }
+
+        // RENDER THE WINDOW.
+        if (ImGui::Begin("Texture Cache", &IsOpen))
+        {
+            ASSETS::TextureCacheStatistics statistics = ASSETS::TextureCache::Statistics();
+            constexpr float BYTES_PER_MEGABYTE = 1024.0f * 1024.0f;
+
+            // DISPLAY MEMORY USAGE.
+            float size_in_megabytes = static_cast<float>(statistics.SizeInBytes) / BYTES_PER_MEGABYTE;
+            float in_use_size_in_megabytes = static_cast<float>(statistics.InUseSizeInBytes) / BYTES_PER_MEGABYTE;
+            ImGui::Text("Textures: %zu (%.1f MB)", statistics.TextureCount, size_in_megabytes);
+            ImGui::Text("In Use: %zu (%.1f MB)", statistics.InUseTextureCount, in_use_size_in_megabytes);
+            float mipmap_size_in_megabytes = static_cast<float>(statistics.MipmapSizeInBytes) / BYTES_PER_MEGABYTE;
+            ImGui::Text("Mipmaps: %.1f MB", mipmap_size_in_megabytes);
+
+            // ALLOW CHANGING THE MEMORY BUDGET.
+            // Textures in use can't be evicted, so the cache may exceed its budget while they are.
+            int memory_budget_in_megabytes = static_cast<int>(static_cast<float>(statistics.MemoryBudgetInBytes) / BYTES_PER_MEGABYTE);
+            constexpr int MIN_MEMORY_BUDGET_IN_MEGABYTES = 0;
+            constexpr int MAX_MEMORY_BUDGET_IN_MEGABYTES = 16 * 1024;
+            if (ImGui::SliderInt("Budget (MB)", &memory_budget_in_megabytes, MIN_MEMORY_BUDGET_IN_MEGABYTES, MAX_MEMORY_BUDGET_IN_MEGABYTES))
+            {
+                std::size_t memory_budget_in_bytes = static_cast<std::size_t>(memory_budget_in_megabytes) * 1024 * 1024;
+                ASSETS::TextureCache::SetMemoryBudget(memory_budget_in_bytes);
+            }
+
+            // DISPLAY CACHE ACTIVITY.
+            ImGui::Separator();
+            ImGui::Text("Hits: %zu  Misses: %zu", statistics.HitCount, statistics.MissCount);
+            ImGui::Text("Duplicates Shared: %zu", statistics.DuplicateCount);
+            ImGui::Text("Evictions: %zu", statistics.EvictionCount);
+        }
+        ImGui::End();
+    }
+}
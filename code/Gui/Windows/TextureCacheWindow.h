@@ -0,0 +1,16 @@
+#pragma once
+
+namespace GUI::WINDOWS
+{
+    /// A window showing how much memory shared textures use and letting users change the texture cache's memory budget.
+    class TextureCacheWindow
+    {
+    public:
+        // PUBLIC METHODS.
+        void UpdateAndRender();
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// True if the window is open; false if not.
+        bool IsOpen = false;
+    };
+}
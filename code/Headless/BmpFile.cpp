@@ -0,0 +1,86 @@
+#include <fstream>
+#include "Headless/BmpFile.h"
+
+namespace HEADLESS
+{
+    /// Writes the pixels to a .bmp file.
+    /// @param[in]  pixels - The pixels to write, in top-down row order, packed as 0xAARRGGBB.
+    /// @param[in]  width_in_pixels - The width of the image.
+    /// @param[in]  height_in_pixels - The height of the image.
+    /// @param[in]  filepath - The path of the file to write.
+    /// @return True if the file was written; false otherwise.
+    bool BmpFile::Write(
+        const uint32_t* const pixels,
+        const unsigned int width_in_pixels,
+        const unsigned int height_in_pixels,
+        const std::filesystem::path& filepath)
+    {
+        // MAKE SURE THERE ARE PIXELS TO WRITE.
+        if (!pixels)
+        {
+            return false;
+        }
+
+        // OPEN THE FILE.
+        std::ofstream bmp_file(filepath, std::ios::binary);
+        if (!bmp_file)
+        {
+            return false;
+        }
+
+        // COMPUTE SIZES FOR THE HEADERS.
+        // See https://docs.microsoft.com/en-us/windows/win32/gdi/bitmap-storage for the layout.
+        constexpr uint32_t FILE_HEADER_SIZE_IN_BYTES = 14;
+        constexpr uint32_t INFO_HEADER_SIZE_IN_BYTES = 40;
+        constexpr uint32_t PIXEL_DATA_OFFSET_IN_BYTES = FILE_HEADER_SIZE_IN_BYTES + INFO_HEADER_SIZE_IN_BYTES;
+        constexpr uint32_t BYTES_PER_PIXEL = sizeof(uint32_t);
+        uint32_t pixel_data_size_in_bytes = width_in_pixels * height_in_pixels * BYTES_PER_PIXEL;
+        uint32_t file_size_in_bytes = PIXEL_DATA_OFFSET_IN_BYTES + pixel_data_size_in_bytes;
+
+        // WRITE THE HEADERS.
+        // All values in the file are little-endian.
+        auto write_16_bits = [&](const uint16_t value)
+        {
+            const char bytes[] = { static_cast<char>(value & 0xFF), static_cast<char>((value >> 8) & 0xFF) };
+            bmp_file.write(bytes, sizeof(bytes));
+        };
+        auto write_32_bits = [&](const uint32_t value)
+        {
+            write_16_bits(static_cast<uint16_t>(value & 0xFFFF));
+            write_16_bits(static_cast<uint16_t>((value >> 16) & 0xFFFF));
+        };
+
+        bmp_file.write("BM", 2);
+        write_32_bits(file_size_in_bytes);
+        constexpr uint32_t RESERVED = 0;
+        write_32_bits(RESERVED);
+        write_32_bits(PIXEL_DATA_OFFSET_IN_BYTES);
+
+        write_32_bits(INFO_HEADER_SIZE_IN_BYTES);
+        write_32_bits(width_in_pixels);
+        // A negative height indicates that rows are stored top-down, which matches the color buffer.
+        int32_t top_down_height_in_pixels = -static_cast<int32_t>(height_in_pixels);
+        write_32_bits(static_cast<uint32_t>(top_down_height_in_pixels));
+        constexpr uint16_t PLANE_COUNT = 1;
+        write_16_bits(PLANE_COUNT);
+        constexpr uint16_t BITS_PER_PIXEL = 32;
+        write_16_bits(BITS_PER_PIXEL);
+        constexpr uint32_t BI_RGB_UNCOMPRESSED = 0;
+        write_32_bits(BI_RGB_UNCOMPRESSED);
+        write_32_bits(pixel_data_size_in_bytes);
+        constexpr uint32_t UNSPECIFIED_RESOLUTION = 0;
+        write_32_bits(UNSPECIFIED_RESOLUTION);
+        write_32_bits(UNSPECIFIED_RESOLUTION);
+        constexpr uint32_t NO_PALETTE = 0;
+        write_32_bits(NO_PALETTE);
+        write_32_bits(NO_PALETTE);
+
+        // WRITE THE PIXELS.
+        // Each 0xAARRGGBB value is stored in memory as B, G, R, A bytes on little-endian machines,
+        // which is exactly the 32-bit .bmp pixel layout.
+        bmp_file.write(reinterpret_cast<const char*>(pixels), pixel_data_size_in_bytes);
+
+        bool file_written = bmp_file.good();
+        return file_written;
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+namespace HEADLESS
+{
+    /// Writes rendered images to uncompressed .bmp files.
+    /// The .bmp format was chosen since it can be written without any additional libraries
+    /// and since its 32-bit layout matches the BGRA pixel layout of CPU color buffers,
+    /// allowing pixels to be written directly without any conversion.
+    class BmpFile
+    {
+    public:
+        static bool Write(
+            const uint32_t* const pixels,
+            const unsigned int width_in_pixels,
+            const unsigned int height_in_pixels,
+            const std::filesystem::path& filepath);
+    };
+}
@@ -0,0 +1,163 @@
+#include <iostream>
+#include <string>
+#include "Headless/CommandLineOptions.h"
+
+namespace HEADLESS
+{
+    /// Parses options from the command line.
+    /// @param[in]  argument_count - The number of command line arguments, including the program name.
+    /// @param[in]  arguments - The command line arguments, including the program name.
+    /// @return The parsed options, if valid; null otherwise.
+    std::optional<CommandLineOptions> CommandLineOptions::Parse(const int argument_count, char* arguments[])
+    {
+        CommandLineOptions options;
+
+        // PARSE EACH ARGUMENT.
+        // The first argument is skipped since it is the program name.
+        for (int argument_index = 1; argument_index < argument_count; ++argument_index)
+        {
+            std::string argument = arguments[argument_index];
+
+            // HANDLE FLAGS WITHOUT VALUES.
+            if ("--spheres" == argument)
+            {
+                options.IncludeSpheres = true;
+                continue;
+            }
+            if ("--verify-parser" == argument)
+            {
+                options.VerifyModelParser = true;
+                continue;
+            }
+            if ("--library-rasterizer" == argument)
+            {
+                options.BinningRasterization = false;
+                continue;
+            }
+            if ("--compare-rasterizers" == argument)
+            {
+                options.CompareRasterizers = true;
+                continue;
+            }
+
+            // MAKE SURE A VALUE EXISTS FOR THE REMAINING OPTIONS.
+            int value_index = argument_index + 1;
+            bool value_exists = (value_index < argument_count);
+            if (!value_exists)
+            {
+                std::cerr << "Missing value for " << argument << std::endl;
+                return std::nullopt;
+            }
+            std::string value = arguments[value_index];
+            argument_index = value_index;
+
+            // HANDLE OPTIONS WITH VALUES.
+            try
+            {
+                if ("--renderer" == argument)
+                {
+                    if ("rasterizer" == value)
+                    {
+                        options.GraphicsDeviceType = GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RASTERIZER;
+                    }
+                    else if ("raytracer" == value)
+                    {
+                        options.GraphicsDeviceType = GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RAY_TRACER;
+                    }
+                    else
+                    {
+                        std::cerr << "Unknown renderer: " << value << std::endl;
+                        return std::nullopt;
+                    }
+                }
+                else if ("--threads" == argument)
+                {
+                    options.ThreadCount = static_cast<unsigned int>(std::stoul(value));
+                }
+                else if ("--frames" == argument)
+                {
+                    options.FrameCount = static_cast<unsigned int>(std::stoul(value));
+                }
+                else if ("--width" == argument)
+                {
+                    options.WidthInPixels = static_cast<unsigned int>(std::stoul(value));
+                }
+                else if ("--height" == argument)
+                {
+                    options.HeightInPixels = static_cast<unsigned int>(std::stoul(value));
+                }
+                else if ("--model" == argument)
+                {
+                    options.ModelFilepath = value;
+                }
+                else if ("--texture" == argument)
+                {
+                    options.TextureFilepath = value;
+                }
+                else if ("--image" == argument)
+                {
+                    options.OutputImageFilepath = value;
+                }
+                else if ("--timings" == argument)
+                {
+                    options.TimingsFilepath = value;
+                }
+                else
+                {
+                    std::cerr << "Unknown option: " << argument << std::endl;
+                    return std::nullopt;
+                }
+            }
+            catch (const std::exception&)
+            {
+                std::cerr << "Invalid value for " << argument << ": " << value << std::endl;
+                return std::nullopt;
+            }
+        }
+
+        // VALIDATE THE OPTIONS.
+        bool dimensions_valid = (options.WidthInPixels > 0) && (options.HeightInPixels > 0);
+        if (!dimensions_valid)
+        {
+            std::cerr << "Width and height must be greater than zero." << std::endl;
+            return std::nullopt;
+        }
+
+        bool model_given_for_verification = !options.VerifyModelParser || !options.ModelFilepath.empty();
+        if (!model_given_for_verification)
+        {
+            std::cerr << "A model must be given to verify the parser." << std::endl;
+            return std::nullopt;
+        }
+
+        // Only rasterizers can be compared, so the rasterizer device is always used for comparing them.
+        if (options.CompareRasterizers)
+        {
+            options.GraphicsDeviceType = GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RASTERIZER;
+        }
+
+        return options;
+    }
+
+    /// Prints usage information about the command line options.
+    void CommandLineOptions::PrintUsage()
+    {
+        std::cout
+            << "Usage: 3DModelViewerHeadless [options]\n"
+            << "  --renderer <rasterizer|raytracer>  CPU renderer to use (default rasterizer).\n"
+            << "  --threads <count>                  Ray tracing or binning threads, 0 for all cores (default 0).\n"
+            << "  --frames <count>                   Number of frames to render (default 1).\n"
+            << "  --width <pixels>                   Frame width (default 900).\n"
+            << "  --height <pixels>                  Frame height (default 700).\n"
+            << "  --model <path.obj>                 Wavefront model to render instead of the textured quad.\n"
+            << "  --texture <path.png>               Texture for the textured quad.\n"
+            << "  --spheres                          Add the test spheres to the scene.\n"
+            << "  --verify-parser                    Check that the fast parser loads the model identically instead of rendering.\n"
+            << "  --library-rasterizer               Rasterize with the library's rasterizer instead of the viewer's binning rasterizer.\n"
+            << "  --compare-rasterizers              Report how the binning rasterizer's frame differs from the library rasterizer's.\n"
+            << "                                     With --image, writes the per-channel difference instead of the frame.\n"
+            << "  --image <path.bmp>                 Write the final frame to a .bmp file.\n"
+            << "  --timings <path.csv>               Write per-frame render times to a .csv file.\n"
+            << std::flush;
+    }
+}
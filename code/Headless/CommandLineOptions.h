@@ -0,0 +1,46 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include "Graphics/Hardware/IGraphicsDevice.h"
+
+namespace HEADLESS
+{
+    /// The options for a headless rendering run, as specified on the command line.
+    struct CommandLineOptions
+    {
+        // PARSING.
+        static std::optional<CommandLineOptions> Parse(const int argument_count, char* arguments[]);
+        static void PrintUsage();
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The type of CPU graphics device to render with.
+        GRAPHICS::HARDWARE::GraphicsDeviceType GraphicsDeviceType = GRAPHICS::HARDWARE::GraphicsDeviceType::CPU_RASTERIZER;
+        /// The number of threads to render with.  0 uses one thread per hardware core.
+        unsigned int ThreadCount = 0;
+        /// The number of frames to render.
+        unsigned int FrameCount = 1;
+        /// The width of rendered frames.
+        unsigned int WidthInPixels = 900;
+        /// The height of rendered frames.
+        unsigned int HeightInPixels = 700;
+        /// The path to a Wavefront .obj model to render.  If empty, the textured quad test scene is rendered.
+        std::filesystem::path ModelFilepath = "";
+        /// The path to the texture for the textured quad test scene.
+        std::filesystem::path TextureFilepath = "D:/temp/assets/test_texture.png";
+        /// True if the test spheres should be added to the scene; false if not.
+        bool IncludeSpheres = false;
+        /// True if the model should be parsed by both the fast parser and the graphics library's parser
+        /// and checked for differences instead of being rendered; false if not.
+        bool VerifyModelParser = false;
+        /// True if the rasterizer should be the viewer's own binning rasterizer; false for the graphics library's rasterizer.
+        bool BinningRasterization = true;
+        /// True if a single frame should be rendered by both the graphics library's rasterizer and the binning rasterizer
+        /// and checked for differences instead of rendering normally; false if not.
+        bool CompareRasterizers = false;
+        /// The path to write the final rendered frame to.  If empty, no image is written.
+        std::filesystem::path OutputImageFilepath = "";
+        /// The path to write per-frame timings to.  If empty, no timings are written.
+        std::filesystem::path TimingsFilepath = "";
+    };
+}
@@ -0,0 +1,45 @@
+#include <algorithm>
+#include <cstdlib>
+#include "Headless/ImageDifference.h"
+
+namespace HEADLESS
+{
+    /// Compares two images pixel by pixel.
+    /// @param[in]  expected_pixels - The pixels of the reference image, packed as 0xAARRGGBB.
+    /// @param[in]  actual_pixels - The pixels of the image to check, packed as 0xAARRGGBB.
+    /// @param[in]  pixel_count - The number of pixels in each image.
+    /// @return How the images differ.
+    ImageDifference ImageDifference::Compute(const uint32_t* const expected_pixels, const uint32_t* const actual_pixels, const std::size_t pixel_count)
+    {
+        constexpr uint32_t OPAQUE_ALPHA = 0xFF000000u;
+        constexpr uint32_t BITS_PER_CHANNEL = 8;
+        constexpr uint32_t CHANNEL_MASK = 0xFFu;
+        constexpr uint32_t COLOR_CHANNEL_COUNT = 3;
+
+        ImageDifference difference;
+        difference.DifferencePixels.resize(pixel_count);
+        for (std::size_t pixel_index = 0; pixel_index < pixel_count; ++pixel_index)
+        {
+            // COMPUTE THE DIFFERENCE OF EACH COLOR CHANNEL.
+            uint32_t difference_pixel = OPAQUE_ALPHA;
+            for (uint32_t channel_index = 0; channel_index < COLOR_CHANNEL_COUNT; ++channel_index)
+            {
+                uint32_t shift = channel_index * BITS_PER_CHANNEL;
+                int expected_value = static_cast<int>((expected_pixels[pixel_index] >> shift) & CHANNEL_MASK);
+                int actual_value = static_cast<int>((actual_pixels[pixel_index] >> shift) & CHANNEL_MASK);
+                uint32_t channel_difference = static_cast<uint32_t>(std::abs(expected_value - actual_value));
+                difference_pixel |= (channel_difference << shift);
+                difference.MaxChannelDifference = std::max(difference.MaxChannelDifference, channel_difference);
+            }
+
+            // RECORD THE PIXEL'S DIFFERENCE.
+            bool pixel_differs = (OPAQUE_ALPHA != difference_pixel);
+            if (pixel_differs)
+            {
+                ++difference.DifferentPixelCount;
+            }
+            difference.DifferencePixels[pixel_index] = difference_pixel;
+        }
+        return difference;
+    }
+}
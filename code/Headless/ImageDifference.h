@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace HEADLESS
+{
+    /// How two rendered images of the same size differ, for checking renderers against each other.
+    struct ImageDifference
+    {
+        // COMPARISON.
+        static ImageDifference Compute(const uint32_t* const expected_pixels, const uint32_t* const actual_pixels, const std::size_t pixel_count);
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The number of pixels whose red, green, or blue values differ.  Alpha is ignored since it isn't displayed.
+        std::size_t DifferentPixelCount = 0;
+        /// The largest difference in any red, green, or blue value, from 0 to 255.
+        uint32_t MaxChannelDifference = 0;
+        /// The absolute difference of each channel for each pixel, packed as opaque 0xAARRGGBB pixels for writing as an image.
+        std::vector<uint32_t> DifferencePixels = {};
+    };
+}
@@ -0,0 +1,26 @@
+#include "Headless/OffscreenWindow.h"
+
+namespace HEADLESS
+{
+    /// Constructor.
+    /// @param[in]  width_in_pixels - The width of the offscreen area to render to.
+    /// @param[in]  height_in_pixels - The height of the offscreen area to render to.
+    OffscreenWindow::OffscreenWindow(const unsigned int width_in_pixels, const unsigned int height_in_pixels) :
+        WidthInPixels(width_in_pixels),
+        HeightInPixels(height_in_pixels)
+    {}
+
+    /// Gets the width of the offscreen area.
+    /// @return The width in pixels.
+    unsigned int OffscreenWindow::GetWidthInPixels() const
+    {
+        return WidthInPixels;
+    }
+
+    /// Gets the height of the offscreen area.
+    /// @return The height in pixels.
+    unsigned int OffscreenWindow::GetHeightInPixels() const
+    {
+        return HeightInPixels;
+    }
+}
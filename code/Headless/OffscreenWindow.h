@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Windowing/IWindow.h"
+
+/// Holds code for rendering without any on-screen window, such as for batch rendering or automated testing.
+namespace HEADLESS
+{
+    /// A stand-in for a window that only has dimensions and never appears on screen.
+    /// This allows graphics devices that size their buffers based on a window to be created
+    /// without depending on any particular windowing system.
+    class OffscreenWindow : public WINDOWING::IWindow
+    {
+    public:
+        // CONSTRUCTION.
+        explicit OffscreenWindow(const unsigned int width_in_pixels, const unsigned int height_in_pixels);
+
+        // DIMENSIONS.
+        unsigned int GetWidthInPixels() const override;
+        unsigned int GetHeightInPixels() const override;
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The width of the "window" in pixels.
+        unsigned int WidthInPixels = 0;
+        /// The height of the "window" in pixels.
+        unsigned int HeightInPixels = 0;
+    };
+}
@@ -0,0 +1,100 @@
+#if CAMERA_INPUT_DEBUG_OUTPUT
+#include <sstream>
+#include <Windows.h>
+#endif
+#include "Input/CameraInput.h"
+#include "Math/Matrix4x4.h"
+
+namespace INPUT
+{
+    /// Determines if the input moves the camera at all.
+    /// @return True if the camera should be moved; false if not.
+    bool CameraInput::MovesCamera() const
+    {
+        return (0 != YawDragInPixels) || (0 != PitchDragInPixels) || (0 != RollDragAmount) || (0 != MouseWheelDelta);
+    }
+
+    /// Moves the camera based on the input.
+    /// @param[in,out]  camera - The camera to move.
+    void CameraInput::ApplyTo(GRAPHICS::VIEWING::Camera& camera) const
+    {
+        // ROTATE THE CAMERA IN RESPONSE TO MOUSE DRAGS.
+        bool mouse_dragged = (0 != YawDragInPixels) || (0 != PitchDragInPixels) || (0 != RollDragAmount);
+        if (mouse_dragged)
+        {
+            // Formatting debug text is slow enough to matter for frequent input, so it's only compiled in when needed.
+#if CAMERA_INPUT_DEBUG_OUTPUT
+            std::stringstream mouse_drag_debug_text;
+            mouse_drag_debug_text
+                << "Mouse drag:"
+                << "\tYaw = " << YawDragInPixels
+                << "\tPitch = " << PitchDragInPixels
+                << "\tRoll = " << RollDragAmount
+                << std::endl;
+            OutputDebugString(mouse_drag_debug_text.str().c_str());
+#endif
+
+            // COMPUTE THE CAMERA ROTATION AMOUNT.
+            constexpr float X_ROTATION_AMOUNT_IN_DEGREES_PER_PIXEL = 5.0f;
+            // Note - negation is important for intuitive behavior.
+            MATH::Angle<float>::Degrees x_rotation_amount_in_degrees(X_ROTATION_AMOUNT_IN_DEGREES_PER_PIXEL * -YawDragInPixels);
+            constexpr float Y_ROTATION_AMOUNT_IN_DEGREES_PER_PIXEL = 2.0f;
+            MATH::Angle<float>::Degrees y_rotation_amount_in_degrees(Y_ROTATION_AMOUNT_IN_DEGREES_PER_PIXEL * -PitchDragInPixels);
+
+            constexpr float Z_ROTATION_AMOUNT_IN_DEGREES_PER_PIXEL = 2.0f;
+            /// @todo   Z-rotation could use more refinement.  Maybe just need coordinate system conversion first?
+            MATH::Angle<float>::Degrees z_rotation_amount_in_degrees(Z_ROTATION_AMOUNT_IN_DEGREES_PER_PIXEL * RollDragAmount);
+
+            MATH::Angle<float>::Radians x_rotation_amount_in_radians = MATH::Angle<float>::DegreesToRadians(x_rotation_amount_in_degrees);
+            MATH::Angle<float>::Radians y_rotation_amount_in_radians = MATH::Angle<float>::DegreesToRadians(y_rotation_amount_in_degrees);
+            MATH::Angle<float>::Radians z_rotation_amount_in_radians = MATH::Angle<float>::DegreesToRadians(z_rotation_amount_in_degrees);
+
+            /// @todo   Note - a single combined rotation matrix is bogus, so separate rotation operations are needed.
+            MATH::Matrix4x4f camera_y_rotation_matrix = MATH::Matrix4x4f::RotateY(x_rotation_amount_in_radians);
+            MATH::Matrix4x4f camera_x_rotation_matrix = MATH::Matrix4x4f::RotateX(y_rotation_amount_in_radians);
+            MATH::Matrix4x4f camera_z_rotation_matrix = MATH::Matrix4x4f::RotateZ(z_rotation_amount_in_radians);
+            MATH::Matrix4x4f camera_rotation_matrix = camera_y_rotation_matrix * camera_x_rotation_matrix * camera_z_rotation_matrix;
+
+            // ROTATE THE CAMERA.
+            MATH::Vector4f original_camera_position = MATH::Vector4f::HomogeneousPositionVector(camera.WorldPosition);
+            MATH::Vector4f new_camera_position_homogeneous = camera_rotation_matrix * original_camera_position;
+            MATH::Vector3f new_camera_position(
+                new_camera_position_homogeneous.X,
+                new_camera_position_homogeneous.Y,
+                new_camera_position_homogeneous.Z);
+
+            camera.WorldPosition = new_camera_position;
+            /// @todo   Cleaner way to preserve/recompute camera settings!
+            MATH::Vector3f camera_view_direction = MATH::Vector3f(0.0f, 0.0f, 0.0f) - camera.WorldPosition;
+            MATH::Vector3f normalized_camera_view_direction = MATH::Vector3f::Normalize(camera_view_direction);
+            MATH::Vector3f negative_camera_view_direction = MATH::Vector3f::Scale(-1.0f, normalized_camera_view_direction);
+            MATH::Vector4f homogeneous_up = MATH::Vector4f::HomogeneousPositionVector(camera.CoordinateFrame.Up);
+            MATH::Vector4f homogeneous_transformed_up = camera_rotation_matrix * homogeneous_up;
+            MATH::Vector3f transformed_up(homogeneous_transformed_up.X, homogeneous_transformed_up.Y, homogeneous_transformed_up.Z);
+            camera.CoordinateFrame = MATH::CoordinateFrame::FromUpAndForward(transformed_up, negative_camera_view_direction);
+
+            /// @todo   How to preserve prior settings?
+            camera.Projection = GRAPHICS::VIEWING::ProjectionType::PERSPECTIVE;
+            camera.NearClipPlaneViewDistance = 1.0f;
+            camera.FarClipPlaneViewDistance = 1000.0f;
+        }
+
+        // ZOOM THE CAMERA IN RESPONSE TO MOUSE WHEEL ROTATION.
+        if (0 != MouseWheelDelta)
+        {
+            // COMPUTE HOW MUCH ZOOMING SHOULD OCCUR.
+            constexpr float WHEEL_ROTATIONS_PER_ACTION = 120.0f;
+            float zoom_units = static_cast<float>(MouseWheelDelta) / WHEEL_ROTATIONS_PER_ACTION;
+
+            // Rotating the mouse wheel forward results in a positive value, but that should be considered as "zooming in".
+            // Since the negative z-axis is "forward" (zooming in), the zoom distance must be negated.
+            constexpr float Z_AXIS_IN_OPPOSITE_DIRECTION_FROM_WHEEL_ROTATION = -1.0f;
+            constexpr float ZOOM_DISTANCE_PER_WHEEL_ROTATION = 1.0f;
+            float signed_zoom_distance = Z_AXIS_IN_OPPOSITE_DIRECTION_FROM_WHEEL_ROTATION * ZOOM_DISTANCE_PER_WHEEL_ROTATION * zoom_units;
+            MATH::Vector3f zoom_movement_vector = MATH::Vector3f::Scale(signed_zoom_distance, camera.CoordinateFrame.Forward);
+
+            // ZOOM IN THE CAMERA.
+            camera.WorldPosition += zoom_movement_vector;
+        }
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include "Graphics/Viewing/Camera.h"
+
+/// Holds code for handling user input.
+namespace INPUT
+{
+    /// Input for moving the camera, combined from all input events since the camera was last updated.
+    ///
+    /// Mice can report movement hundreds or thousands of times per second, so rather than moving the
+    /// camera for each input event, events are added up and the camera is moved once per frame.
+    struct CameraInput
+    {
+        // QUERIES.
+        bool MovesCamera() const;
+
+        // UPDATING.
+        void ApplyTo(GRAPHICS::VIEWING::Camera& camera) const;
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The horizontal mouse drag distance for rotating the camera around the vertical axis.
+        int YawDragInPixels = 0;
+        /// The vertical mouse drag distance for rotating the camera around the horizontal axis.
+        int PitchDragInPixels = 0;
+        /// The amount of mouse dragging for rotating the camera around its viewing axis.
+        int RollDragAmount = 0;
+        /// The amount the mouse wheel was rotated for zooming, in the units reported by Windows.
+        int MouseWheelDelta = 0;
+        /// The time the earliest of the input events was received, for measuring input latency.
+        /// Null if there were no input events.
+        std::optional<std::chrono::steady_clock::time_point> EarliestEventTime = std::nullopt;
+    };
+}
@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <cstdlib>
+#include "Input/CameraInputQueue.h"
+
+namespace INPUT
+{
+    /// Adds a mouse drag for rotating the camera.
+    /// @param[in]  x_drag_distance_in_pixels - The horizontal distance the mouse was dragged.
+    /// @param[in]  y_drag_distance_in_pixels - The vertical distance the mouse was dragged.
+    void CameraInputQueue::AddMouseDrag(const int x_drag_distance_in_pixels, const int y_drag_distance_in_pixels)
+    {
+        // COMPUTE THE AMOUNT OF DRAGGING FOR ROTATING AROUND THE VIEWING AXIS.
+        // Which rotations a drag causes depends on each individual drag, so this is determined as input arrives.
+        int max_2d_drag_distance = std::max(x_drag_distance_in_pixels, y_drag_distance_in_pixels);
+        /// @todo   This z drag amount is somewhat arbitrary and could use more refinement.
+        int z_drag_amount = max_2d_drag_distance - (y_drag_distance_in_pixels - x_drag_distance_in_pixels);
+
+        // ADD THE DRAG TO THE APPROPRIATE ROTATIONS.
+        // Only relative amounts matter rather than ordering with other memory, so relaxed atomic operations are enough.
+        /// @todo   Z-rotation with too little dragging is distracting.  Probably a better way to dampen this.
+        constexpr int Z_THRESHOLD = 30;
+        if (std::abs(z_drag_amount) <= Z_THRESHOLD)
+        {
+            YawDragInPixels.fetch_add(x_drag_distance_in_pixels, std::memory_order_relaxed);
+            PitchDragInPixels.fetch_add(y_drag_distance_in_pixels, std::memory_order_relaxed);
+        }
+        if (std::abs(z_drag_amount) > Z_THRESHOLD * 10)
+        {
+            RollDragAmount.fetch_add(z_drag_amount, std::memory_order_relaxed);
+        }
+
+        RecordEventTime();
+    }
+
+    /// Adds mouse wheel rotation for zooming the camera.
+    /// @param[in]  mouse_wheel_delta - The amount the mouse wheel was rotated, in the units reported by Windows.
+    void CameraInputQueue::AddMouseWheelRotation(const int mouse_wheel_delta)
+    {
+        MouseWheelDelta.fetch_add(mouse_wheel_delta, std::memory_order_relaxed);
+        RecordEventTime();
+    }
+
+    /// Takes all input added since input was last taken.
+    /// @return The combined input.
+    CameraInput CameraInputQueue::TakeInput()
+    {
+        CameraInput input;
+        input.YawDragInPixels = YawDragInPixels.exchange(0, std::memory_order_relaxed);
+        input.PitchDragInPixels = PitchDragInPixels.exchange(0, std::memory_order_relaxed);
+        input.RollDragAmount = RollDragAmount.exchange(0, std::memory_order_relaxed);
+        input.MouseWheelDelta = MouseWheelDelta.exchange(0, std::memory_order_relaxed);
+
+        int64_t earliest_event_time_in_ticks = EarliestEventTimeInTicks.exchange(NO_EVENT_TIME, std::memory_order_relaxed);
+        if (NO_EVENT_TIME != earliest_event_time_in_ticks)
+        {
+            std::chrono::steady_clock::duration earliest_event_time_since_epoch(earliest_event_time_in_ticks);
+            input.EarliestEventTime = std::chrono::steady_clock::time_point(earliest_event_time_since_epoch);
+        }
+
+        return input;
+    }
+
+    /// Records the time of an input event if it's the earliest since input was last taken.
+    void CameraInputQueue::RecordEventTime()
+    {
+        // Later events leave the time unchanged since latency is measured from the earliest event.
+        int64_t event_time_in_ticks = static_cast<int64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        int64_t no_event_time = NO_EVENT_TIME;
+        EarliestEventTimeInTicks.compare_exchange_strong(no_event_time, event_time_in_ticks, std::memory_order_relaxed);
+    }
+}
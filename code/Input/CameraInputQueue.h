@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "Input/CameraInput.h"
+
+namespace INPUT
+{
+    /// Collects input for moving the camera as it arrives so that it can be applied once per frame.
+    ///
+    /// Input is only added up rather than stored as separate events, which keeps adding input cheap
+    /// and means the queue can never fill up however fast input arrives.  All state is atomic so that
+    /// input can be added from any thread (such as the window procedure) without locking.
+    /// Input arriving while it's being taken may be split across consecutive frames, but none is lost.
+    class CameraInputQueue
+    {
+    public:
+        // ADDING INPUT.
+        void AddMouseDrag(const int x_drag_distance_in_pixels, const int y_drag_distance_in_pixels);
+        void AddMouseWheelRotation(const int mouse_wheel_delta);
+
+        // TAKING INPUT.
+        CameraInput TakeInput();
+
+    private:
+        /// The value of the earliest event time when there have been no events.
+        static constexpr int64_t NO_EVENT_TIME = INT64_MIN;
+        static_assert(std::atomic<int64_t>::is_always_lock_free, "Input must be added without locking.");
+
+        // HELPER METHODS.
+        void RecordEventTime();
+
+        // PRIVATE MEMBER VARIABLES.
+        /// The mouse drag distance for rotating the camera around the vertical axis.
+        std::atomic<int> YawDragInPixels = 0;
+        /// The mouse drag distance for rotating the camera around the horizontal axis.
+        std::atomic<int> PitchDragInPixels = 0;
+        /// The amount of mouse dragging for rotating the camera around its viewing axis.
+        std::atomic<int> RollDragAmount = 0;
+        /// The amount the mouse wheel was rotated.
+        std::atomic<int> MouseWheelDelta = 0;
+        /// The time the earliest event was received since input was last taken, as steady clock ticks.
+        /// NO_EVENT_TIME if there have been no events.
+        std::atomic<int64_t> EarliestEventTimeInTicks = NO_EVENT_TIME;
+    };
+}
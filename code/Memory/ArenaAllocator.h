@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "Memory/LinearArena.h"
+
+namespace MEMORY
+{
+    /// A standard library allocator that allocates from a linear arena, so that containers for transient data
+    /// (like those rebuilt every frame) can grow without touching the heap.
+    ///
+    /// Freeing memory does nothing since arena memory is only freed by resetting the arena.  Containers using
+    /// an arena must therefore be destroyed or emptied before the arena is reset.  Allocators without an arena
+    /// (such as default-constructed ones) use the heap instead, so that containers can be created before
+    /// knowing which arena they should use.
+    template <typename ValueType>
+    class ArenaAllocator
+    {
+    public:
+        /// The type of values allocated.
+        using value_type = ValueType;
+        // The arena moves along with a container's contents so that memory is always freed to where it came from.
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        /// Constructor.
+        /// @param[in]  arena - The arena to allocate from; null to allocate from the heap.
+        explicit ArenaAllocator(LinearArena* const arena = nullptr) :
+            Arena(arena)
+        {}
+
+        /// Constructor for an allocator for a different type of value, as needed by the standard library.
+        /// @param[in]  other_allocator - The allocator to use the same arena as.
+        template <typename OtherValueType>
+        ArenaAllocator(const ArenaAllocator<OtherValueType>& other_allocator) :
+            Arena(other_allocator.Arena)
+        {}
+
+        /// Allocates memory for values.
+        /// @param[in]  count - The number of values to allocate memory for.
+        /// @return The allocated memory.
+        ValueType* allocate(const std::size_t count)
+        {
+            if (!Arena)
+            {
+                return std::allocator<ValueType>().allocate(count);
+            }
+
+            void* memory = Arena->Allocate(count * sizeof(ValueType), alignof(ValueType));
+            return static_cast<ValueType*>(memory);
+        }
+
+        /// Frees memory for values.  Only memory from the heap is actually freed.
+        /// @param[in]  values - The memory to free.
+        /// @param[in]  count - The number of values the memory was allocated for.
+        void deallocate(ValueType* const values, const std::size_t count)
+        {
+            if (!Arena)
+            {
+                std::allocator<ValueType>().deallocate(values, count);
+            }
+        }
+
+        /// Determines if two allocators can free each other's memory.
+        /// @param[in]  lhs - The allocator on the left of the operator.
+        /// @param[in]  rhs - The allocator on the right of the operator.
+        /// @return True if both allocators use the same arena (or both use the heap); false otherwise.
+        friend bool operator==(const ArenaAllocator& lhs, const ArenaAllocator& rhs)
+        {
+            return lhs.Arena == rhs.Arena;
+        }
+
+        /// Determines if two allocators can't free each other's memory.
+        /// @param[in]  lhs - The allocator on the left of the operator.
+        /// @param[in]  rhs - The allocator on the right of the operator.
+        /// @return True if the allocators use different arenas; false otherwise.
+        friend bool operator!=(const ArenaAllocator& lhs, const ArenaAllocator& rhs)
+        {
+            return lhs.Arena != rhs.Arena;
+        }
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The arena memory is allocated from; null for the heap.
+        LinearArena* Arena = nullptr;
+    };
+
+    /// A vector whose memory comes from an arena.
+    template <typename ValueType>
+    using ArenaVector = std::vector<ValueType, ArenaAllocator<ValueType>>;
+}
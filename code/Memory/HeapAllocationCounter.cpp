@@ -0,0 +1,53 @@
+#include <cstdlib>
+#include <new>
+#include "Memory/HeapAllocationCounter.h"
+
+namespace MEMORY
+{
+    /// Counts a single allocation.  Called for every allocation through the global operator new.
+    void HeapAllocationCounter::CountAllocation()
+    {
+        TotalAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Gets the total number of heap allocations so far.  The difference between two calls is the number
+    /// of allocations made in between them.
+    /// @return The total number of allocations since the program started.
+    std::size_t HeapAllocationCounter::AllocationCount()
+    {
+        return TotalAllocationCount.load(std::memory_order_relaxed);
+    }
+}
+
+/// Replaces the global allocation function to count allocations.
+/// The standard library's other forms (for arrays and non-throwing allocation) all use this one,
+/// as do its other deallocation functions with the ones below.
+/// @param[in]  size_in_bytes - The size of the memory to allocate.
+/// @return The allocated memory.
+/// @throws std::bad_alloc - Thrown if the memory couldn't be allocated.
+void* operator new(const std::size_t size_in_bytes)
+{
+    MEMORY::HeapAllocationCounter::CountAllocation();
+
+    // At least 1 byte is allocated since each allocation must have a unique address.
+    void* memory = std::malloc(size_in_bytes > 0 ? size_in_bytes : 1);
+    if (!memory)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+/// Replaces the global deallocation function to match the allocation function above.
+/// @param[in]  memory - The memory to free.
+void operator delete(void* const memory) noexcept
+{
+    std::free(memory);
+}
+
+/// Replaces the global sized deallocation function to match the allocation function above.
+/// @param[in]  memory - The memory to free.
+void operator delete(void* const memory, const std::size_t) noexcept
+{
+    std::free(memory);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace MEMORY
+{
+    /// Counts heap allocations made by the whole program, for finding code that allocates every frame.
+    ///
+    /// Allocations are counted by replacing the global operator new, so everything allocated through the
+    /// C++ standard library or new expressions is included.  Memory allocated directly with malloc()
+    /// (such as by ImGui or the operating system) or for over-aligned types isn't counted.
+    class HeapAllocationCounter
+    {
+    public:
+        // COUNTING.
+        static void CountAllocation();
+        static std::size_t AllocationCount();
+
+    private:
+        // PRIVATE MEMBER VARIABLES.
+        /// The total number of allocations made since the program started.
+        /// Only the count matters, not ordering with other memory, so relaxed atomic operations are enough.
+        static inline std::atomic<std::size_t> TotalAllocationCount = 0;
+    };
+}
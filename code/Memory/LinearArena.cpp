@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <cstdint>
+#include "Memory/LinearArena.h"
+
+namespace MEMORY
+{
+    /// Constructor.
+    /// @param[in]  initial_size_in_bytes - The size of the first block of memory.
+    LinearArena::LinearArena(const std::size_t initial_size_in_bytes)
+    {
+        AddBlock(initial_size_in_bytes);
+    }
+
+    /// Allocates memory that remains valid until the arena is reset.
+    /// @param[in]  size_in_bytes - The size of the memory to allocate.
+    /// @param[in]  alignment - The alignment of the memory.  Must be a power of 2.
+    /// @return The allocated memory.
+    void* LinearArena::Allocate(const std::size_t size_in_bytes, const std::size_t alignment)
+    {
+        // ALIGN THE NEXT FREE ADDRESS IN THE CURRENT BLOCK.
+        Block* current_block = &Blocks.back();
+        std::uintptr_t block_address = reinterpret_cast<std::uintptr_t>(current_block->Memory.get());
+        std::uintptr_t next_free_address = block_address + UsedSizeInCurrentBlockInBytes;
+        std::uintptr_t aligned_address = (next_free_address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+        std::size_t aligned_offset = static_cast<std::size_t>(aligned_address - block_address);
+
+        // MOVE ONTO A NEW BLOCK IF THE CURRENT ONE IS FULL.
+        bool memory_fits_in_current_block = (aligned_offset + size_in_bytes <= current_block->SizeInBytes);
+        if (!memory_fits_in_current_block)
+        {
+            // Enough extra space is requested that the memory fits no matter how the new block is aligned.
+            AddBlock(size_in_bytes + alignment);
+            current_block = &Blocks.back();
+            block_address = reinterpret_cast<std::uintptr_t>(current_block->Memory.get());
+            aligned_address = (block_address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+            aligned_offset = static_cast<std::size_t>(aligned_address - block_address);
+        }
+
+        // ALLOCATE THE MEMORY.
+        UsedSizeInCurrentBlockInBytes = aligned_offset + size_in_bytes;
+        return current_block->Memory.get() + aligned_offset;
+    }
+
+    /// Frees all memory allocated from the arena, invalidating it.
+    /// If more than one block was needed since the previous reset, all blocks are replaced with a single block
+    /// as large as all of them so that the same allocations won't need another block in the future.
+    void LinearArena::Reset()
+    {
+        if (Blocks.size() > 1)
+        {
+            std::size_t total_size_in_bytes = CapacityInBytes();
+            Blocks.clear();
+            AddBlock(total_size_in_bytes);
+        }
+        UsedSizeInCurrentBlockInBytes = 0;
+    }
+
+    /// Gets the total size of all blocks of memory in the arena.
+    /// @return The capacity of the arena.
+    std::size_t LinearArena::CapacityInBytes() const
+    {
+        std::size_t capacity_in_bytes = 0;
+        for (const Block& block : Blocks)
+        {
+            capacity_in_bytes += block.SizeInBytes;
+        }
+        return capacity_in_bytes;
+    }
+
+    /// Adds a new block to allocate from.
+    /// Blocks at least double in size so that a frame needing much more memory than usual only adds a few blocks.
+    /// @param[in]  min_size_in_bytes - The minimum size of the block.
+    void LinearArena::AddBlock(const std::size_t min_size_in_bytes)
+    {
+        std::size_t size_in_bytes = std::max(min_size_in_bytes, CapacityInBytes());
+        size_in_bytes = std::max<std::size_t>(size_in_bytes, 1);
+
+        Block& block = Blocks.emplace_back();
+        // The memory is left uninitialized since everything allocated from it is initialized by its user.
+        block.Memory = std::unique_ptr<std::byte[]>(new std::byte[size_in_bytes]);
+        block.SizeInBytes = size_in_bytes;
+        UsedSizeInCurrentBlockInBytes = 0;
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/// Holds code for managing memory.
+namespace MEMORY
+{
+    /// A linear (bump) allocator for transient data that all lives for the same span of time, like a single frame.
+    ///
+    /// Allocating just advances an offset within a block of memory, and individual allocations are never freed.
+    /// Instead, everything is freed at once by resetting the arena.  If a block runs out of space, a larger block
+    /// is added, and the next reset replaces all blocks with a single block large enough to hold all of them.
+    /// The arena therefore stops allocating from the heap once it has been through its most demanding frame.
+    ///
+    /// An arena isn't synchronized, so each thread needs its own (see WorkStealingThreadPool::WorkerArena()).
+    class LinearArena
+    {
+    public:
+        /// The size of the first block allocated by an arena.
+        static constexpr std::size_t DEFAULT_BLOCK_SIZE_IN_BYTES = std::size_t(64) * 1024;
+
+        // CONSTRUCTION.
+        explicit LinearArena(const std::size_t initial_size_in_bytes = DEFAULT_BLOCK_SIZE_IN_BYTES);
+        LinearArena(const LinearArena&) = delete;
+        LinearArena& operator=(const LinearArena&) = delete;
+
+        // ALLOCATION.
+        void* Allocate(const std::size_t size_in_bytes, const std::size_t alignment);
+        void Reset();
+
+        // STATISTICS.
+        std::size_t CapacityInBytes() const;
+
+    private:
+        /// A single contiguous block of memory that allocations are carved out of.
+        struct Block
+        {
+            /// The memory of the block.
+            std::unique_ptr<std::byte[]> Memory = nullptr;
+            /// The size of the block's memory.
+            std::size_t SizeInBytes = 0;
+        };
+
+        // HELPER METHODS.
+        void AddBlock(const std::size_t min_size_in_bytes);
+
+        // PRIVATE MEMBER VARIABLES.
+        /// The blocks of memory, with the one currently being allocated from last.
+        std::vector<Block> Blocks = {};
+        /// The number of bytes already allocated from the last block.
+        std::size_t UsedSizeInCurrentBlockInBytes = 0;
+    };
+}
@@ -0,0 +1,73 @@
+#ifdef _WIN32
+// Windows min/max macros would otherwise break std::min/std::max in files following this one in unity builds.
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#include <Psapi.h>
+#else
+#include <cstdio>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+#include "Memory/ProcessMemoryUsage.h"
+
+namespace MEMORY
+{
+    /// Gets the current memory usage of this process.
+    /// @return The memory usage; zero if it couldn't be retrieved.
+    ProcessMemoryUsage ProcessMemoryUsage::Get()
+    {
+        ProcessMemoryUsage usage;
+
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS memory_counters = {};
+        BOOL memory_counters_retrieved = GetProcessMemoryInfo(GetCurrentProcess(), &memory_counters, sizeof(memory_counters));
+        if (!memory_counters_retrieved)
+        {
+            return usage;
+        }
+
+        usage.CurrentBytes = memory_counters.WorkingSetSize;
+        usage.PeakBytes = memory_counters.PeakWorkingSetSize;
+#else
+        // GET THE PEAK RESIDENT MEMORY.
+        struct rusage resource_usage = {};
+        bool resource_usage_retrieved = (0 == getrusage(RUSAGE_SELF, &resource_usage));
+        if (!resource_usage_retrieved)
+        {
+            return usage;
+        }
+#ifdef __APPLE__
+        // macOS reports the peak in bytes.
+        usage.PeakBytes = static_cast<std::size_t>(resource_usage.ru_maxrss);
+#else
+        // Linux reports the peak in kibibytes.
+        constexpr std::size_t BYTES_PER_KIBIBYTE = 1024;
+        usage.PeakBytes = static_cast<std::size_t>(resource_usage.ru_maxrss) * BYTES_PER_KIBIBYTE;
+#endif
+
+        // GET THE CURRENT RESIDENT MEMORY.
+        // The second field of this file is the number of resident pages.  Where it doesn't exist (such as on macOS),
+        // the peak is the closest available measure.
+        usage.CurrentBytes = usage.PeakBytes;
+        std::FILE* memory_status_file = std::fopen("/proc/self/statm", "r");
+        if (memory_status_file)
+        {
+            unsigned long total_page_count = 0;
+            unsigned long resident_page_count = 0;
+            int read_field_count = std::fscanf(memory_status_file, "%lu %lu", &total_page_count, &resident_page_count);
+            std::fclose(memory_status_file);
+
+            constexpr int EXPECTED_FIELD_COUNT = 2;
+            if (EXPECTED_FIELD_COUNT == read_field_count)
+            {
+                std::size_t page_size_in_bytes = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+                usage.CurrentBytes = static_cast<std::size_t>(resident_page_count) * page_size_in_bytes;
+            }
+        }
+#endif
+
+        return usage;
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+
+namespace MEMORY
+{
+    /// The physical memory used by this process, as seen by the operating system.
+    ///
+    /// Unlike counting allocations, this includes everything resident in memory (such as memory-mapped files,
+    /// textures decoded by other libraries, and allocator overhead), so it shows the true cost of operations
+    /// like loading models.  The peak is especially useful for catching temporary copies that are freed
+    /// again before they'd otherwise be noticed.
+    struct ProcessMemoryUsage
+    {
+        // CONSTANTS.
+        /// The number of bytes in a mebibyte, for displaying memory usage.
+        static constexpr double BYTES_PER_MEBIBYTE = 1024.0 * 1024.0;
+
+        // QUERYING.
+        static ProcessMemoryUsage Get();
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The memory currently resident for the process (its working set).
+        std::size_t CurrentBytes = 0;
+        /// The most memory that has ever been resident for the process (its peak working set).
+        std::size_t PeakBytes = 0;
+    };
+}
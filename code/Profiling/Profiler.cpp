@@ -0,0 +1,179 @@
+#include <algorithm>
+#include "Profiling/Profiler.h"
+#include "Profiling/TraceRecorder.h"
+
+namespace PROFILING
+{
+    /// The scope index used for scopes that aren't being recorded.
+    constexpr std::size_t UNRECORDED_SCOPE_INDEX = SIZE_MAX;
+
+    /// Gets the time elapsed since a start time.
+    /// @param[in]  start_time - The start time.
+    /// @return The elapsed time in milliseconds.
+    static float MillisecondsSince(const std::chrono::steady_clock::time_point& start_time)
+    {
+        std::chrono::duration<float, std::milli> elapsed_time = std::chrono::steady_clock::now() - start_time;
+        return elapsed_time.count();
+    }
+
+    /// Begins recording a new frame on the calling thread.
+    void Profiler::BeginFrame()
+    {
+        // DON'T RECORD ANYTHING IF PAUSED AND NOT TRACING.
+        RecordingHistory = !Paused;
+        Tracing = TraceRecorder::IsRecording();
+        Recording = RecordingHistory || Tracing;
+        if (!Recording)
+        {
+            return;
+        }
+
+        // REUSE THE OLDEST FRAME'S MEMORY FOR THE NEW FRAME.
+        ProfiledFrame& frame = CurrentFrame();
+        frame.FrameIndex = TotalCompletedFrameCount;
+        frame.DurationInMilliseconds = 0.0f;
+        frame.InputLatencyInMilliseconds = -1.0f;
+        frame.Scopes.clear();
+
+        RecordingThreadId = std::this_thread::get_id();
+        CurrentDepth = 0;
+        FrameStartTime = std::chrono::steady_clock::now();
+    }
+
+    /// Finishes recording the current frame, making it available in the history.
+    void Profiler::EndFrame()
+    {
+        if (!Recording)
+        {
+            return;
+        }
+
+        std::chrono::steady_clock::time_point frame_end_time = std::chrono::steady_clock::now();
+        ProfiledFrame& frame = CurrentFrame();
+        std::chrono::duration<float, std::milli> frame_duration = frame_end_time - FrameStartTime;
+        frame.DurationInMilliseconds = frame_duration.count();
+        if (Tracing)
+        {
+            TraceRecorder::RecordEvent("Frame", "Frame", FrameStartTime, frame_end_time);
+        }
+
+        if (RecordingHistory)
+        {
+            ++TotalCompletedFrameCount;
+        }
+        Recording = false;
+    }
+
+    /// Begins a scope.  ProfileScope should typically be used instead to ensure the scope is ended.
+    /// @param[in]  name - The name of the scope.  Must live for the duration of the program (like a string literal).
+    /// @return The index of the scope, for ending it.
+    std::size_t Profiler::BeginScope(const char* const name)
+    {
+        // ONLY RECORD SCOPES ON THE THREAD RECORDING THE FRAME.
+        bool scope_recorded = Recording && (std::this_thread::get_id() == RecordingThreadId);
+        if (!scope_recorded)
+        {
+            return UNRECORDED_SCOPE_INDEX;
+        }
+
+        // RECORD THE START OF THE SCOPE.
+        ProfiledFrame& frame = CurrentFrame();
+        std::size_t scope_index = frame.Scopes.size();
+        ProfiledScope& scope = frame.Scopes.emplace_back();
+        scope.Name = name;
+        scope.Depth = CurrentDepth;
+        scope.StartTimeInMilliseconds = MillisecondsSince(FrameStartTime);
+        ++CurrentDepth;
+        return scope_index;
+    }
+
+    /// Ends a scope.
+    /// @param[in]  scope_index - The index of the scope returned when it began.
+    void Profiler::EndScope(const std::size_t scope_index)
+    {
+        // IGNORE SCOPES THAT WEREN'T RECORDED.
+        // Scopes may also outlive the frame they started in, in which case they are invalid for the current frame.
+        if (UNRECORDED_SCOPE_INDEX == scope_index || !Recording || std::this_thread::get_id() != RecordingThreadId)
+        {
+            return;
+        }
+        ProfiledFrame& frame = CurrentFrame();
+        if (scope_index >= frame.Scopes.size())
+        {
+            return;
+        }
+
+        // RECORD THE END OF THE SCOPE.
+        std::chrono::steady_clock::time_point scope_end_time = std::chrono::steady_clock::now();
+        ProfiledScope& scope = frame.Scopes[scope_index];
+        std::chrono::duration<float, std::milli> scope_end_time_in_frame = scope_end_time - FrameStartTime;
+        scope.DurationInMilliseconds = scope_end_time_in_frame.count() - scope.StartTimeInMilliseconds;
+        if (Tracing)
+        {
+            std::chrono::duration<float, std::milli> scope_start_time_in_frame(scope.StartTimeInMilliseconds);
+            std::chrono::steady_clock::time_point scope_start_time = FrameStartTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(scope_start_time_in_frame);
+            TraceRecorder::RecordEvent(scope.Name, "Frame Phase", scope_start_time, scope_end_time);
+        }
+        if (CurrentDepth > 0)
+        {
+            --CurrentDepth;
+        }
+    }
+
+    /// Records the latency from input until the current frame responding to it was displayed.
+    /// Should be called just after displaying the frame.
+    /// @param[in]  input_time - The time the earliest input handled in the frame was received.
+    void Profiler::RecordInputLatency(const std::chrono::steady_clock::time_point& input_time)
+    {
+        // ONLY RECORD LATENCY ON THE THREAD RECORDING THE FRAME.
+        bool latency_recorded = Recording && (std::this_thread::get_id() == RecordingThreadId);
+        if (!latency_recorded)
+        {
+            return;
+        }
+
+        // RECORD THE LATENCY.
+        // Input may have arrived before the frame started, so the latency may be longer than the frame.
+        std::chrono::steady_clock::time_point display_time = std::chrono::steady_clock::now();
+        ProfiledFrame& frame = CurrentFrame();
+        std::chrono::duration<float, std::milli> input_latency = display_time - input_time;
+        frame.InputLatencyInMilliseconds = input_latency.count();
+        if (Tracing)
+        {
+            TraceRecorder::RecordEvent("Input Latency", "Input", input_time, display_time);
+        }
+    }
+
+    /// Gets the number of completed frames available in the history.
+    /// @return The number of completed frames available.
+    std::size_t Profiler::CompletedFrameCount()
+    {
+        // The oldest frame's memory may currently be reused for recording a new frame, so it isn't available.
+        constexpr uint64_t MAX_AVAILABLE_FRAME_COUNT = FRAME_HISTORY_COUNT - 1;
+        return static_cast<std::size_t>(std::min(TotalCompletedFrameCount, MAX_AVAILABLE_FRAME_COUNT));
+    }
+
+    /// Gets a completed frame from the history.
+    /// @param[in]  frames_ago - How many frames before the most recently completed frame to get.
+    ///     Must be less than CompletedFrameCount().
+    /// @return The completed frame.
+    const ProfiledFrame& Profiler::GetCompletedFrame(const std::size_t frames_ago)
+    {
+        uint64_t frame_index = TotalCompletedFrameCount - 1 - frames_ago;
+        return Frames[frame_index % FRAME_HISTORY_COUNT];
+    }
+
+    /// Gets the frame currently being recorded.
+    /// @return The frame currently being recorded.
+    ProfiledFrame& Profiler::CurrentFrame()
+    {
+        if (RecordingHistory)
+        {
+            return Frames[TotalCompletedFrameCount % FRAME_HISTORY_COUNT];
+        }
+        else
+        {
+            return TraceOnlyFrame;
+        }
+    }
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/// Holds code for measuring where time is spent within the application.
+namespace PROFILING
+{
+    /// Timing for a single named scope within a frame.
+    struct ProfiledScope
+    {
+        /// The name of the scope.  Must point to a string that lives for the duration of the program (like a string literal).
+        const char* Name = "";
+        /// How deeply the scope is nested within other scopes.  0 for top-level scopes.
+        uint32_t Depth = 0;
+        /// The time the scope started, relative to the start of the frame.
+        float StartTimeInMilliseconds = 0.0f;
+        /// How long the scope lasted.
+        float DurationInMilliseconds = 0.0f;
+    };
+
+    /// Timing for all scopes within a single frame.
+    struct ProfiledFrame
+    {
+        /// The index of the frame since the program started.
+        uint64_t FrameIndex = 0;
+        /// How long the entire frame lasted.
+        float DurationInMilliseconds = 0.0f;
+        /// The time from the earliest input handled in the frame until the frame was displayed.
+        /// Negative if no input was handled in the frame.
+        float InputLatencyInMilliseconds = -1.0f;
+        /// All scopes within the frame, ordered by start time.
+        std::vector<ProfiledScope> Scopes = {};
+    };
+
+    /// A lightweight profiler for measuring how long named scopes take within each frame on the main thread.
+    /// Only a fixed number of recent frames are kept, and memory for them is reused, so profiling can always stay on.
+    ///
+    /// Scopes are measured by creating ProfileScope objects.  Only scopes on the thread that began the current frame
+    /// are recorded so that the profiler doesn't need any synchronization.
+    ///
+    /// While a trace is being recorded (see TraceRecorder), frames and scopes are also recorded in the trace,
+    /// even if the profiler itself is paused.
+    class Profiler
+    {
+    public:
+        /// The number of recent frames kept.
+        static constexpr std::size_t FRAME_HISTORY_COUNT = 300;
+
+        // FRAMES.
+        static void BeginFrame();
+        static void EndFrame();
+
+        // SCOPES.
+        static std::size_t BeginScope(const char* const name);
+        static void EndScope(const std::size_t scope_index);
+
+        // INPUT LATENCY.
+        static void RecordInputLatency(const std::chrono::steady_clock::time_point& input_time);
+
+        // HISTORY.
+        static std::size_t CompletedFrameCount();
+        static const ProfiledFrame& GetCompletedFrame(const std::size_t frames_ago);
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// True if recording new frames is paused (such as to inspect a specific frame); false if not.
+        static inline bool Paused = false;
+
+    private:
+        // HELPER METHODS.
+        static ProfiledFrame& CurrentFrame();
+
+        // PRIVATE MEMBER VARIABLES.
+        /// Recent frames, used as a ring buffer.
+        static inline std::array<ProfiledFrame, FRAME_HISTORY_COUNT> Frames = {};
+        /// The frame recorded into when paused but tracing, so that the history is left untouched.
+        static inline ProfiledFrame TraceOnlyFrame = {};
+        /// The total number of frames completed since the program started.
+        static inline uint64_t TotalCompletedFrameCount = 0;
+        /// True if a frame is currently being recorded; false if not.
+        static inline bool Recording = false;
+        /// True if the current frame is being recorded into the history; false if not.
+        static inline bool RecordingHistory = false;
+        /// True if the current frame is being recorded into a trace; false if not.
+        static inline bool Tracing = false;
+        /// The thread that began the current frame.
+        static inline std::thread::id RecordingThreadId = {};
+        /// The time the current frame started.
+        static inline std::chrono::steady_clock::time_point FrameStartTime = {};
+        /// The nesting depth of the next scope to begin.
+        static inline uint32_t CurrentDepth = 0;
+    };
+
+    /// Measures the time from construction to destruction as a named scope in the profiler.
+    class ProfileScope
+    {
+    public:
+        /// Begins the scope.
+        /// @param[in]  name - The name of the scope.  Must live for the duration of the program (like a string literal).
+        explicit ProfileScope(const char* const name) :
+            ScopeIndex(Profiler::BeginScope(name))
+        {}
+
+        /// Ends the scope.
+        ~ProfileScope()
+        {
+            Profiler::EndScope(ScopeIndex);
+        }
+
+        // COPYING IS DISALLOWED SINCE EACH SCOPE MUST END EXACTLY ONCE.
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        /// The index of the scope within the current frame; invalid if the scope isn't being recorded.
+        std::size_t ScopeIndex = 0;
+    };
+}
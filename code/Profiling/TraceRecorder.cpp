@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <fstream>
+#include <string_view>
+#include "Profiling/TraceRecorder.h"
+
+namespace PROFILING
+{
+    /// Starts recording a new trace, discarding any events from a previous trace that wasn't stopped.
+    /// The calling thread is identified as the main thread in the trace.
+    void TraceRecorder::Start()
+    {
+        std::lock_guard<std::mutex> events_lock(EventsMutex);
+        Events.clear();
+        RecordingStartTime = std::chrono::steady_clock::now();
+        MainThreadId = std::this_thread::get_id();
+        Recording = true;
+    }
+
+    /// Stops recording and writes the trace to the output file.
+    /// @return True if the trace was written; false otherwise (including if not recording).
+    bool TraceRecorder::Stop()
+    {
+        // STOP RECORDING.
+        // The events are moved out so that the file can be written without blocking other threads.
+        std::vector<TraceEvent> events;
+        std::filesystem::path output_filepath;
+        {
+            std::lock_guard<std::mutex> events_lock(EventsMutex);
+            if (!Recording)
+            {
+                return false;
+            }
+            Recording = false;
+            events.swap(Events);
+            output_filepath = OutputFilepath;
+        }
+
+        // WRITE THE TRACE.
+        return WriteTrace(output_filepath, events);
+    }
+
+    /// Determines if a trace is being recorded.
+    /// @return True if recording; false if not.
+    bool TraceRecorder::IsRecording()
+    {
+        return Recording;
+    }
+
+    /// Records an event that occurred on the calling thread, if recording.
+    /// @param[in]  name - The name of the event.  Must live for the duration of the program (like a string literal).
+    /// @param[in]  category - The category of the event.  Must live for the duration of the program.
+    /// @param[in]  start_time - The time the event started.
+    /// @param[in]  end_time - The time the event ended.
+    void TraceRecorder::RecordEvent(
+        const char* const name,
+        const char* const category,
+        const std::chrono::steady_clock::time_point& start_time,
+        const std::chrono::steady_clock::time_point& end_time)
+    {
+        // AVOID LOCKING IF NOT RECORDING.
+        if (!Recording)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> events_lock(EventsMutex);
+        // Recording may have stopped while waiting for the lock.
+        if (!Recording)
+        {
+            return;
+        }
+
+        // RECORD THE EVENT.
+        // Events that began before recording started are clipped to the start of the trace.
+        std::chrono::steady_clock::time_point clipped_start_time = std::max(start_time, RecordingStartTime);
+        std::chrono::duration<double, std::micro> start_time_in_microseconds = clipped_start_time - RecordingStartTime;
+        std::chrono::duration<double, std::micro> duration_in_microseconds = std::max(end_time, clipped_start_time) - clipped_start_time;
+
+        TraceEvent& event = Events.emplace_back();
+        event.Name = name;
+        event.Category = category;
+        event.ThreadId = std::this_thread::get_id();
+        event.StartTimeInMicroseconds = start_time_in_microseconds.count();
+        event.DurationInMicroseconds = duration_in_microseconds.count();
+    }
+
+    /// Writes a string as a JSON string literal, escaping any special characters.
+    /// @param[in]  text - The text to write.
+    /// @param[in,out]  file - The file to write to.
+    static void WriteJsonString(const std::string_view text, std::ofstream& file)
+    {
+        file << '"';
+        for (char character : text)
+        {
+            if ('"' == character || '\\' == character)
+            {
+                file << '\\' << character;
+            }
+            else if (static_cast<unsigned char>(character) < ' ')
+            {
+                // Control characters aren't expected in event names, so they're simply replaced.
+                file << ' ';
+            }
+            else
+            {
+                file << character;
+            }
+        }
+        file << '"';
+    }
+
+    /// Writes a trace to a file in the Chrome trace event format.
+    /// @param[in]  filepath - The path of the file to write.
+    /// @param[in]  events - The events to write.
+    /// @return True if the file was written; false otherwise.
+    bool TraceRecorder::WriteTrace(const std::filesystem::path& filepath, const std::vector<TraceEvent>& events)
+    {
+        // OPEN THE FILE.
+        std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            return false;
+        }
+
+        // ASSIGN SMALL IDS TO THREADS.
+        // Trace viewers require integer thread IDs, so threads are numbered in the order they first appear,
+        // with the main thread always first.
+        std::vector<std::thread::id> thread_ids = { MainThreadId };
+        auto get_thread_number = [&](const std::thread::id thread_id)
+        {
+            auto existing_thread_id = std::find(thread_ids.cbegin(), thread_ids.cend(), thread_id);
+            if (thread_ids.cend() != existing_thread_id)
+            {
+                return static_cast<std::size_t>(existing_thread_id - thread_ids.cbegin());
+            }
+
+            thread_ids.emplace_back(thread_id);
+            return thread_ids.size() - 1;
+        };
+
+        // WRITE ALL EVENTS AS COMPLETE EVENTS.
+        // Only a single process ever exists in the trace.
+        constexpr unsigned int PROCESS_ID = 1;
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        file.setf(std::ios::fixed);
+        file.precision(3);
+        for (const TraceEvent& event : events)
+        {
+            file << "{\"name\":";
+            WriteJsonString(event.Name, file);
+            file << ",\"cat\":";
+            WriteJsonString(event.Category, file);
+            file
+                << ",\"ph\":\"X\",\"ts\":" << event.StartTimeInMicroseconds
+                << ",\"dur\":" << event.DurationInMicroseconds
+                << ",\"pid\":" << PROCESS_ID
+                << ",\"tid\":" << get_thread_number(event.ThreadId)
+                << "},\n";
+        }
+
+        // NAME THE THREADS.
+        // These metadata events come last since threads are only known after all events have been written.
+        for (std::size_t thread_number = 0; thread_number < thread_ids.size(); ++thread_number)
+        {
+            file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << PROCESS_ID << ",\"tid\":" << thread_number << ",\"args\":{\"name\":";
+            if (0 == thread_number)
+            {
+                file << "\"Main Thread\"";
+            }
+            else
+            {
+                file << "\"Thread " << thread_number << "\"";
+            }
+            bool last_thread = (thread_number + 1 == thread_ids.size());
+            file << "}}" << (last_thread ? "\n" : ",\n");
+        }
+        file << "]}\n";
+
+        return file.good();
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace PROFILING
+{
+    /// A single timed event in a trace.
+    struct TraceEvent
+    {
+        /// The name of the event.  Must point to a string that lives for the duration of the program (like a string literal).
+        const char* Name = "";
+        /// The category of the event, for filtering in trace viewers.  Must also live for the duration of the program.
+        const char* Category = "";
+        /// The thread the event occurred on.
+        std::thread::id ThreadId = {};
+        /// The time the event started, relative to when recording started.
+        double StartTimeInMicroseconds = 0.0;
+        /// How long the event lasted.
+        double DurationInMicroseconds = 0.0;
+    };
+
+    /// Records a timeline of events from any thread to a JSON file in the Chrome trace event format,
+    /// so that captures can be inspected offline in trace viewers (chrome://tracing, Perfetto, etc.).
+    ///
+    /// Events are only kept in memory while recording, and the file is only written once recording stops,
+    /// to keep the cost of recording each event low.  When not recording, events cost only a single flag check.
+    class TraceRecorder
+    {
+    public:
+        // RECORDING.
+        static void Start();
+        static bool Stop();
+        static bool IsRecording();
+
+        // EVENTS.
+        static void RecordEvent(
+            const char* const name,
+            const char* const category,
+            const std::chrono::steady_clock::time_point& start_time,
+            const std::chrono::steady_clock::time_point& end_time);
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The path of the file to write the trace to when recording stops.
+        static inline std::filesystem::path OutputFilepath = "3DModelViewer_Trace.json";
+
+    private:
+        // HELPER METHODS.
+        static bool WriteTrace(const std::filesystem::path& filepath, const std::vector<TraceEvent>& events);
+
+        // PRIVATE MEMBER VARIABLES.
+        /// True if recording; false if not.
+        static inline std::atomic<bool> Recording = false;
+        /// Protects the variables below since events may come from any thread.
+        static inline std::mutex EventsMutex = {};
+        /// The time recording started.
+        static inline std::chrono::steady_clock::time_point RecordingStartTime = {};
+        /// The thread that started recording, which is identified as the main thread in traces.
+        static inline std::thread::id MainThreadId = {};
+        /// The events recorded so far.
+        static inline std::vector<TraceEvent> Events = {};
+    };
+
+    /// Records the time from construction to destruction as an event in the trace, if recording.
+    class TraceScope
+    {
+    public:
+        /// Begins the scope.
+        /// @param[in]  name - The name of the event.  Must live for the duration of the program (like a string literal).
+        /// @param[in]  category - The category of the event.  Must live for the duration of the program.
+        explicit TraceScope(const char* const name, const char* const category) :
+            Name(name),
+            Category(category),
+            Recording(TraceRecorder::IsRecording())
+        {
+            if (Recording)
+            {
+                StartTime = std::chrono::steady_clock::now();
+            }
+        }
+
+        /// Ends the scope, recording it.
+        ~TraceScope()
+        {
+            if (Recording)
+            {
+                TraceRecorder::RecordEvent(Name, Category, StartTime, std::chrono::steady_clock::now());
+            }
+        }
+
+        // COPYING IS DISALLOWED SINCE EACH SCOPE MUST BE RECORDED EXACTLY ONCE.
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+    private:
+        /// The name of the event.
+        const char* Name = "";
+        /// The category of the event.
+        const char* Category = "";
+        /// True if the scope is being recorded; false if not.
+        bool Recording = false;
+        /// The time the scope started.
+        std::chrono::steady_clock::time_point StartTime = {};
+    };
+}
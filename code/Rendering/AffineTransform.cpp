@@ -0,0 +1,132 @@
+#include <cmath>
+#include "Math/Vector4.h"
+#include "Rendering/AffineTransform.h"
+
+namespace RENDERING
+{
+    /// Creates an affine transform from a 4x4 matrix whose bottom row is (0, 0, 0, 1).
+    /// @param[in]  matrix - The matrix to convert.
+    /// @return The equivalent affine transform.
+    AffineTransform AffineTransform::FromMatrix(const MATH::Matrix4x4f& matrix)
+    {
+        // EXTRACT THE COLUMNS OF THE MATRIX.
+        // Multiplying by each basis vector yields the corresponding column.
+        const MATH::Vector4f columns[4] =
+        {
+            matrix * MATH::Vector4f(1.0f, 0.0f, 0.0f, 0.0f),
+            matrix * MATH::Vector4f(0.0f, 1.0f, 0.0f, 0.0f),
+            matrix * MATH::Vector4f(0.0f, 0.0f, 1.0f, 0.0f),
+            matrix * MATH::Vector4f(0.0f, 0.0f, 0.0f, 1.0f),
+        };
+
+        AffineTransform transform;
+        for (unsigned int column_index = 0; column_index < 4; ++column_index)
+        {
+            transform.Elements[0][column_index] = columns[column_index].X;
+            transform.Elements[1][column_index] = columns[column_index].Y;
+            transform.Elements[2][column_index] = columns[column_index].Z;
+        }
+
+        // COMPUTE THE NORMAL TRANSFORM.
+        // The inverse's linear part is the inverse of this transform's linear part, so its transpose is what's needed.
+        AffineTransform inverse_transform = transform.Inverse();
+        for (unsigned int row_index = 0; row_index < 3; ++row_index)
+        {
+            for (unsigned int column_index = 0; column_index < 3; ++column_index)
+            {
+                transform.NormalElements[row_index][column_index] = inverse_transform.Elements[column_index][row_index];
+            }
+        }
+
+        return transform;
+    }
+
+    /// Computes the inverse of the transform.
+    /// @return The inverse transform.  If the transform is not invertible (like with a zero scale), the identity is returned.
+    AffineTransform AffineTransform::Inverse() const
+    {
+        // COMPUTE THE DETERMINANT OF THE LINEAR PART.
+        const float (&m)[3][4] = Elements;
+        float cofactor_00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+        float cofactor_01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+        float cofactor_02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+        float determinant = m[0][0] * cofactor_00 + m[0][1] * cofactor_01 + m[0][2] * cofactor_02;
+
+        constexpr float MIN_INVERTIBLE_DETERMINANT = 1e-12f;
+        if (std::abs(determinant) < MIN_INVERTIBLE_DETERMINANT)
+        {
+            return AffineTransform();
+        }
+
+        // COMPUTE THE INVERSE OF THE LINEAR PART.
+        // This is the adjugate (transposed cofactor matrix) divided by the determinant.
+        float inverse_determinant = 1.0f / determinant;
+        AffineTransform inverse;
+        float (&inverse_m)[3][4] = inverse.Elements;
+        inverse_m[0][0] = cofactor_00 * inverse_determinant;
+        inverse_m[1][0] = cofactor_01 * inverse_determinant;
+        inverse_m[2][0] = cofactor_02 * inverse_determinant;
+        inverse_m[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inverse_determinant;
+        inverse_m[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inverse_determinant;
+        inverse_m[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inverse_determinant;
+        inverse_m[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inverse_determinant;
+        inverse_m[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inverse_determinant;
+        inverse_m[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inverse_determinant;
+
+        // COMPUTE THE INVERSE TRANSLATION.
+        for (unsigned int row_index = 0; row_index < 3; ++row_index)
+        {
+            inverse_m[row_index][3] = -(
+                inverse_m[row_index][0] * m[0][3] +
+                inverse_m[row_index][1] * m[1][3] +
+                inverse_m[row_index][2] * m[2][3]);
+        }
+
+        // The normal transform of the inverse is the transpose of the original linear part.
+        for (unsigned int row_index = 0; row_index < 3; ++row_index)
+        {
+            for (unsigned int column_index = 0; column_index < 3; ++column_index)
+            {
+                inverse.NormalElements[row_index][column_index] = m[column_index][row_index];
+            }
+        }
+
+        return inverse;
+    }
+
+    /// Transforms a point, including translation.
+    /// @param[in]  point - The point to transform.
+    /// @return The transformed point.
+    MATH::Vector3f AffineTransform::TransformPoint(const MATH::Vector3f& point) const
+    {
+        const float (&m)[3][4] = Elements;
+        return MATH::Vector3f(
+            m[0][0] * point.X + m[0][1] * point.Y + m[0][2] * point.Z + m[0][3],
+            m[1][0] * point.X + m[1][1] * point.Y + m[1][2] * point.Z + m[1][3],
+            m[2][0] * point.X + m[2][1] * point.Y + m[2][2] * point.Z + m[2][3]);
+    }
+
+    /// Transforms a direction, ignoring translation.
+    /// @param[in]  direction - The direction to transform.
+    /// @return The transformed direction (not normalized).
+    MATH::Vector3f AffineTransform::TransformDirection(const MATH::Vector3f& direction) const
+    {
+        const float (&m)[3][4] = Elements;
+        return MATH::Vector3f(
+            m[0][0] * direction.X + m[0][1] * direction.Y + m[0][2] * direction.Z,
+            m[1][0] * direction.X + m[1][1] * direction.Y + m[1][2] * direction.Z,
+            m[2][0] * direction.X + m[2][1] * direction.Y + m[2][2] * direction.Z);
+    }
+
+    /// Transforms a surface normal so that it remains perpendicular to the transformed surface.
+    /// @param[in]  normal - The normal to transform.
+    /// @return The transformed normal (not normalized).
+    MATH::Vector3f AffineTransform::TransformNormal(const MATH::Vector3f& normal) const
+    {
+        const float (&n)[3][3] = NormalElements;
+        return MATH::Vector3f(
+            n[0][0] * normal.X + n[0][1] * normal.Y + n[0][2] * normal.Z,
+            n[1][0] * normal.X + n[1][1] * normal.Y + n[1][2] * normal.Z,
+            n[2][0] * normal.X + n[2][1] * normal.Y + n[2][2] * normal.Z);
+    }
+}
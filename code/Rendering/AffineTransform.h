@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Math/Matrix4x4.h"
+#include "Math/Vector3.h"
+
+namespace RENDERING
+{
+    /// A 3D transform consisting of a linear part and a translation, stored as the top 3 rows of a 4x4 matrix.
+    /// This is used instead of a full 4x4 matrix in CPU rendering hot paths since object transforms are always affine,
+    /// which makes transforming points and normals and computing inverses much cheaper.
+    class AffineTransform
+    {
+    public:
+        // CREATION.
+        static AffineTransform FromMatrix(const MATH::Matrix4x4f& matrix);
+
+        // OPERATIONS.
+        AffineTransform Inverse() const;
+        MATH::Vector3f TransformPoint(const MATH::Vector3f& point) const;
+        MATH::Vector3f TransformDirection(const MATH::Vector3f& direction) const;
+        MATH::Vector3f TransformNormal(const MATH::Vector3f& normal) const;
+
+        // COMPARISON.
+        bool operator==(const AffineTransform& other) const = default;
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The elements of the transform, indexed by [row][column].
+        /// The first 3 columns are the linear part; the last column is the translation.
+        float Elements[3][4] =
+        {
+            { 1.0f, 0.0f, 0.0f, 0.0f },
+            { 0.0f, 1.0f, 0.0f, 0.0f },
+            { 0.0f, 0.0f, 1.0f, 0.0f },
+        };
+        /// The transpose of the inverse of the linear part, for transforming normals.
+        /// Indexed by [row][column].
+        float NormalElements[3][3] =
+        {
+            { 1.0f, 0.0f, 0.0f },
+            { 0.0f, 1.0f, 0.0f },
+            { 0.0f, 0.0f, 1.0f },
+        };
+    };
+}
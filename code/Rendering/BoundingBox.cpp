@@ -0,0 +1,81 @@
+#include <algorithm>
+#include "Rendering/BoundingBox.h"
+
+namespace RENDERING
+{
+    /// Determines if the box is empty (contains no points).
+    /// @return True if the box is empty; false if not.
+    bool BoundingBox::IsEmpty() const
+    {
+        bool empty = (Min.X > Max.X) || (Min.Y > Max.Y) || (Min.Z > Max.Z);
+        return empty;
+    }
+
+    /// Expands the box to contain a point.
+    /// @param[in]  point - The point to contain.
+    void BoundingBox::Expand(const MATH::Vector3f& point)
+    {
+        Min.X = std::min(Min.X, point.X);
+        Min.Y = std::min(Min.Y, point.Y);
+        Min.Z = std::min(Min.Z, point.Z);
+        Max.X = std::max(Max.X, point.X);
+        Max.Y = std::max(Max.Y, point.Y);
+        Max.Z = std::max(Max.Z, point.Z);
+    }
+
+    /// Expands the box to contain another box.
+    /// @param[in]  box - The box to contain.
+    void BoundingBox::Expand(const BoundingBox& box)
+    {
+        Min.X = std::min(Min.X, box.Min.X);
+        Min.Y = std::min(Min.Y, box.Min.Y);
+        Min.Z = std::min(Min.Z, box.Min.Z);
+        Max.X = std::max(Max.X, box.Max.X);
+        Max.Y = std::max(Max.Y, box.Max.Y);
+        Max.Z = std::max(Max.Z, box.Max.Z);
+    }
+
+    /// Gets the center of the box.
+    /// @return The center of the box.
+    MATH::Vector3f BoundingBox::Center() const
+    {
+        return MATH::Vector3f::Scale(0.5f, Min + Max);
+    }
+
+    /// Computes the surface area of the box.
+    /// @return The surface area of the box; 0 if empty.
+    float BoundingBox::SurfaceArea() const
+    {
+        if (IsEmpty())
+        {
+            return 0.0f;
+        }
+
+        MATH::Vector3f size = Max - Min;
+        float surface_area = 2.0f * (size.X * size.Y + size.Y * size.Z + size.Z * size.X);
+        return surface_area;
+    }
+
+    /// Computes a box containing this box after being transformed.
+    /// @param[in]  transform - The transform to apply.
+    /// @return The box containing all 8 transformed corners of this box.
+    BoundingBox BoundingBox::Transform(const AffineTransform& transform) const
+    {
+        BoundingBox transformed_box;
+        if (IsEmpty())
+        {
+            return transformed_box;
+        }
+
+        constexpr unsigned int CORNER_COUNT = 8;
+        for (unsigned int corner_index = 0; corner_index < CORNER_COUNT; ++corner_index)
+        {
+            MATH::Vector3f corner(
+                (corner_index & 1) ? Max.X : Min.X,
+                (corner_index & 2) ? Max.Y : Min.Y,
+                (corner_index & 4) ? Max.Z : Min.Z);
+            transformed_box.Expand(transform.TransformPoint(corner));
+        }
+        return transformed_box;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <limits>
+#include "Math/Vector3.h"
+#include "Rendering/AffineTransform.h"
+
+namespace RENDERING
+{
+    /// An axis-aligned bounding box.
+    /// A default-constructed box is empty (its min is greater than its max), so expanding it by any point
+    /// results in a box containing just that point.
+    struct BoundingBox
+    {
+        // OPERATIONS.
+        bool IsEmpty() const;
+        void Expand(const MATH::Vector3f& point);
+        void Expand(const BoundingBox& box);
+        MATH::Vector3f Center() const;
+        float SurfaceArea() const;
+        BoundingBox Transform(const AffineTransform& transform) const;
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The minimum corner of the box.
+        MATH::Vector3f Min = MATH::Vector3f(
+            std::numeric_limits<float>::max(),
+            std::numeric_limits<float>::max(),
+            std::numeric_limits<float>::max());
+        /// The maximum corner of the box.
+        MATH::Vector3f Max = MATH::Vector3f(
+            std::numeric_limits<float>::lowest(),
+            std::numeric_limits<float>::lowest(),
+            std::numeric_limits<float>::lowest());
+    };
+}
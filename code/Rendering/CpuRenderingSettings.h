@@ -0,0 +1,43 @@
+#pragma once
+
+/// Holds code for the viewer's own CPU rendering paths, which build on the graphics library's scene representation.
+namespace RENDERING
+{
+    /// Settings for how CPU rendering work is split across cores.
+    /// These supplement GRAPHICS::RenderingSettings, which lives in the graphics library and covers what is rendered
+    /// rather than how the work is scheduled.
+    struct CpuRenderingSettings
+    {
+        /// The number of threads to render with, including the main thread.  0 uses one thread per hardware core.
+        unsigned int ThreadCount = 0;
+        /// The width and height of the square screen tiles that work is split into.
+        unsigned int TileSizeInPixels = 32;
+        /// True if the CPU rasterizer device type should use the viewer's own multithreaded binning rasterizer;
+        /// false if it should use the graphics library's single-threaded rasterizer.
+        /// On by default since the binning rasterizer follows the library rasterizer's projection, backface rule, shading,
+        /// shadows, and texture sampling (see BinningRasterizer).
+        bool BinningRasterization = true;
+        /// True if ray traced frames should be shown at low resolution right away and refined over later frames;
+        /// false if each frame should be fully rendered before being shown.
+        bool ProgressiveRayTracing = true;
+        /// The maximum time to spend refining a progressively ray traced frame per loop iteration.
+        float ProgressiveTimeBudgetInMilliseconds = 15.0f;
+        /// True if the ray tracer should sample textures from mipmaps with trilinear filtering based on how much of a texture
+        /// each pixel covers; false if the nearest texel of the full-size texture should be sampled.
+        /// The rasterizers always sample the nearest texel.
+        bool MipmappedTextureSampling = true;
+        /// True if the binning rasterizer should render objects covering few pixels with simplified versions of their meshes;
+        /// false if full detail meshes should always be rendered.  Levels of detail are only generated while this is on.
+        bool LevelsOfDetail = true;
+        /// The number of covered pixels each triangle should account for when selecting levels of detail.
+        /// Larger values select simpler levels sooner.
+        float LevelOfDetailPixelsPerTriangle = 2.0f;
+        /// True if objects and clusters of triangles entirely outside the view should be skipped before any per-triangle work;
+        /// false if all geometry should be processed.  The graphics library's rasterizer only has whole objects culled
+        /// (see ObjectFrustumCuller).
+        bool FrustumCulling = true;
+        /// True if the binning rasterizer should skip triangles behind everything already drawn in each screen tile
+        /// by checking against the tile's farthest depth before checking individual pixels; false if every pixel should be checked.
+        bool HierarchicalDepthCulling = true;
+    };
+}
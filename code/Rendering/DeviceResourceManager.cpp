@@ -0,0 +1,201 @@
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string>
+#include "Profiling/TraceRecorder.h"
+#include "Rendering/DeviceResourceManager.h"
+
+namespace RENDERING
+{
+    /// Combines a value into a fingerprint.
+    /// @param[in]  fingerprint - The fingerprint to combine the value into.
+    /// @param[in]  value - The value to combine.
+    /// @return The combined fingerprint.
+    static uint64_t MixIntoFingerprint(uint64_t fingerprint, const uint64_t value)
+    {
+        // The multiplier is from the 64-bit FNV hash, whose multiply-xor mixing is sufficient for detecting changes.
+        constexpr uint64_t PRIME = 0x100000001b3ull;
+        fingerprint = (fingerprint ^ value) * PRIME;
+        fingerprint ^= (fingerprint >> 32);
+        return fingerprint;
+    }
+
+    /// Combines a floating-point value into a fingerprint based on its exact bits.
+    /// @param[in]  fingerprint - The fingerprint to combine the value into.
+    /// @param[in]  value - The value to combine.
+    /// @return The combined fingerprint.
+    static uint64_t MixIntoFingerprint(const uint64_t fingerprint, const float value)
+    {
+        uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return MixIntoFingerprint(fingerprint, static_cast<uint64_t>(bits));
+    }
+
+    /// Marks object geometry as possibly edited in place, so all objects are re-fingerprinted on the next update.
+    /// Objects that are added, removed, or replaced are detected automatically.
+    void DeviceResourceManager::Invalidate()
+    {
+        ContentFingerprintsStale = true;
+    }
+
+    /// Forgets all resources loaded into the previous graphics device, such as after switching to a new device.
+    /// The next update loads every object in the scene into the new device.
+    void DeviceResourceManager::DeviceReplaced()
+    {
+        LoadedContentFingerprints.clear();
+        LoadedTextures.clear();
+        Statistics = {};
+    }
+
+    /// Loads any objects in the scene that the graphics device doesn't have yet.
+    /// @param[in,out]  scene - The scene whose objects to load.
+    /// @param[in,out]  graphics_device - The graphics device to load objects into.
+    void DeviceResourceManager::Update(GRAPHICS::Scene& scene, GRAPHICS::HARDWARE::IGraphicsDevice& graphics_device)
+    {
+        // DISCARD CACHED FINGERPRINTS IF GEOMETRY MAY HAVE BEEN EDITED.
+        if (ContentFingerprintsStale)
+        {
+            ContentFingerprintsByIdentity.clear();
+            ContentFingerprintsStale = false;
+        }
+
+        // LOAD EACH OBJECT THE DEVICE DOESN'T HAVE YET.
+        // Only fingerprints for objects currently in the scene are kept so that removed objects don't accumulate.
+        // They're collected into a second array that's sorted and swapped with the first afterward so that both arrays' storage is reused.
+        Statistics.ObjectsLoadedInLastUpdate = 0;
+        CurrentContentFingerprintsByIdentity.clear();
+        for (GRAPHICS::Object3D& object : scene.Objects)
+        {
+            // GET THE OBJECT'S CONTENT FINGERPRINT.
+            uint64_t identity_fingerprint = ComputeIdentityFingerprint(object);
+            auto cached_content_fingerprint = std::lower_bound(
+                ContentFingerprintsByIdentity.cbegin(),
+                ContentFingerprintsByIdentity.cend(),
+                identity_fingerprint,
+                [](const IdentityAndContentFingerprint& fingerprints, const uint64_t identity_fingerprint)
+                {
+                    return fingerprints.first < identity_fingerprint;
+                });
+            uint64_t content_fingerprint = 0;
+            bool content_fingerprint_cached =
+                (ContentFingerprintsByIdentity.cend() != cached_content_fingerprint) &&
+                (identity_fingerprint == cached_content_fingerprint->first);
+            if (content_fingerprint_cached)
+            {
+                content_fingerprint = cached_content_fingerprint->second;
+            }
+            else
+            {
+                PROFILING::TraceScope fingerprint_scope("Fingerprint Object", "Device Resources");
+                content_fingerprint = ComputeContentFingerprint(object);
+            }
+            CurrentContentFingerprintsByIdentity.emplace_back(identity_fingerprint, content_fingerprint);
+
+            // LOAD THE OBJECT IF IT'S NEW TO THE DEVICE.
+            bool object_loaded = LoadedContentFingerprints.contains(content_fingerprint);
+            if (object_loaded)
+            {
+                continue;
+            }
+
+            PROFILING::TraceScope load_scope("Load Object Into Device", "Device Resources");
+            graphics_device.Load(object);
+            LoadedContentFingerprints.insert(content_fingerprint);
+            ++Statistics.ObjectsLoadedInLastUpdate;
+            ++Statistics.LoadedObjectCount;
+            Statistics.LoadedMeshCount += object.Model.MeshesByName.size();
+            for (const auto& [mesh_name, mesh] : object.Model.MeshesByName)
+            {
+                for (const GRAPHICS::GEOMETRY::Triangle& triangle : mesh.Triangles)
+                {
+                    if (triangle.Material && triangle.Material->DiffuseProperties.Texture)
+                    {
+                        LoadedTextures.insert(triangle.Material->DiffuseProperties.Texture.get());
+                    }
+                }
+            }
+            Statistics.LoadedTextureCount = LoadedTextures.size();
+        }
+
+        // SORT THE CURRENT FINGERPRINTS FOR LOOKUP DURING THE NEXT UPDATE.
+        // Copies of an object share its identity and content, so only one entry is needed for each identity.
+        std::sort(CurrentContentFingerprintsByIdentity.begin(), CurrentContentFingerprintsByIdentity.end());
+        auto duplicate_fingerprints = std::unique(
+            CurrentContentFingerprintsByIdentity.begin(),
+            CurrentContentFingerprintsByIdentity.end(),
+            [](const IdentityAndContentFingerprint& first_fingerprints, const IdentityAndContentFingerprint& second_fingerprints)
+            {
+                return first_fingerprints.first == second_fingerprints.first;
+            });
+        CurrentContentFingerprintsByIdentity.erase(duplicate_fingerprints, CurrentContentFingerprintsByIdentity.end());
+        ContentFingerprintsByIdentity.swap(CurrentContentFingerprintsByIdentity);
+    }
+
+    /// Computes a cheap fingerprint identifying where an object's geometry lives in memory.
+    /// This stays the same as long as the object's meshes aren't replaced, even if the object itself is moved.
+    /// @param[in]  object - The object to fingerprint.
+    /// @return The identity fingerprint.
+    uint64_t DeviceResourceManager::ComputeIdentityFingerprint(const GRAPHICS::Object3D& object)
+    {
+        constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+        uint64_t fingerprint = FNV_OFFSET_BASIS;
+        for (const auto& [mesh_name, mesh] : object.Model.MeshesByName)
+        {
+            fingerprint = MixIntoFingerprint(fingerprint, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(mesh.Triangles.data())));
+            fingerprint = MixIntoFingerprint(fingerprint, static_cast<uint64_t>(mesh.Triangles.size()));
+        }
+        fingerprint = MixIntoFingerprint(fingerprint, static_cast<uint64_t>(object.Spheres.size()));
+        return fingerprint;
+    }
+
+    /// Computes a fingerprint of all resources in an object that a graphics device may load.
+    /// Transforms aren't included since they're supplied when rendering rather than when loading.
+    /// @param[in]  object - The object to fingerprint.
+    /// @return The content fingerprint.
+    uint64_t DeviceResourceManager::ComputeContentFingerprint(const GRAPHICS::Object3D& object)
+    {
+        constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+        uint64_t fingerprint = FNV_OFFSET_BASIS;
+        for (const auto& [mesh_name, mesh] : object.Model.MeshesByName)
+        {
+            fingerprint = MixIntoFingerprint(fingerprint, static_cast<uint64_t>(std::hash<std::string>()(mesh_name)));
+            fingerprint = MixIntoFingerprint(fingerprint, static_cast<uint64_t>(mesh.Triangles.size()));
+            for (const GRAPHICS::GEOMETRY::Triangle& triangle : mesh.Triangles)
+            {
+                // Materials and textures are shared and immutable once loaded, so their addresses identify them.
+                const GRAPHICS::Material* material = triangle.Material.get();
+                fingerprint = MixIntoFingerprint(fingerprint, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(material)));
+                if (material)
+                {
+                    const GRAPHICS::IMAGES::Bitmap* texture = material->DiffuseProperties.Texture.get();
+                    fingerprint = MixIntoFingerprint(fingerprint, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(texture)));
+                }
+
+                for (const GRAPHICS::VertexWithAttributes& vertex : triangle.Vertices)
+                {
+                    fingerprint = MixIntoFingerprint(fingerprint, vertex.Position.X);
+                    fingerprint = MixIntoFingerprint(fingerprint, vertex.Position.Y);
+                    fingerprint = MixIntoFingerprint(fingerprint, vertex.Position.Z);
+                    fingerprint = MixIntoFingerprint(fingerprint, vertex.Normal.X);
+                    fingerprint = MixIntoFingerprint(fingerprint, vertex.Normal.Y);
+                    fingerprint = MixIntoFingerprint(fingerprint, vertex.Normal.Z);
+                    fingerprint = MixIntoFingerprint(fingerprint, vertex.TextureCoordinates.X);
+                    fingerprint = MixIntoFingerprint(fingerprint, vertex.TextureCoordinates.Y);
+                    fingerprint = MixIntoFingerprint(fingerprint, vertex.Color.Red);
+                    fingerprint = MixIntoFingerprint(fingerprint, vertex.Color.Green);
+                    fingerprint = MixIntoFingerprint(fingerprint, vertex.Color.Blue);
+                    fingerprint = MixIntoFingerprint(fingerprint, vertex.Color.Alpha);
+                }
+            }
+        }
+
+        for (const GRAPHICS::GEOMETRY::Sphere& sphere : object.Spheres)
+        {
+            fingerprint = MixIntoFingerprint(fingerprint, sphere.CenterPosition.X);
+            fingerprint = MixIntoFingerprint(fingerprint, sphere.CenterPosition.Y);
+            fingerprint = MixIntoFingerprint(fingerprint, sphere.CenterPosition.Z);
+            fingerprint = MixIntoFingerprint(fingerprint, sphere.Radius);
+        }
+        return fingerprint;
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "Graphics/Hardware/IGraphicsDevice.h"
+#include "Graphics/Images/Bitmap.h"
+#include "Graphics/Object3D.h"
+#include "Graphics/Scene.h"
+
+namespace RENDERING
+{
+    /// Counts of resources loaded into the current graphics device.
+    struct DeviceResourceStatistics
+    {
+        /// The number of distinct objects loaded.
+        std::size_t LoadedObjectCount = 0;
+        /// The number of meshes within loaded objects.
+        std::size_t LoadedMeshCount = 0;
+        /// The number of distinct textures referenced by loaded objects.
+        std::size_t LoadedTextureCount = 0;
+        /// The number of objects loaded during the most recent update.
+        std::size_t ObjectsLoadedInLastUpdate = 0;
+    };
+
+    /// Keeps a graphics device's resources in sync with a scene, loading only objects the device doesn't already have.
+    ///
+    /// Graphics devices only support loading entire objects, so objects are tracked by a fingerprint of their
+    /// meshes, materials, and textures.  An object is loaded into the device the first time its fingerprint is seen,
+    /// so copies of already loaded objects and objects whose edits are undone don't need to be loaded again.
+    ///
+    /// Content fingerprints require reading all of an object's geometry, so they're cached per object by a cheap
+    /// identity (where the object's geometry lives in memory).  Only objects with new identities (like newly added
+    /// objects) are fingerprinted each update unless geometry was edited in place, which must be reported via Invalidate().
+    class DeviceResourceManager
+    {
+    public:
+        // UPDATING.
+        void Invalidate();
+        void DeviceReplaced();
+        void Update(GRAPHICS::Scene& scene, GRAPHICS::HARDWARE::IGraphicsDevice& graphics_device);
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// Counts of resources loaded into the current graphics device.
+        DeviceResourceStatistics Statistics = {};
+
+    private:
+        /// A content fingerprint paired with the identity fingerprint it's cached under.
+        using IdentityAndContentFingerprint = std::pair<uint64_t, uint64_t>;
+
+        // HELPER METHODS.
+        static uint64_t ComputeIdentityFingerprint(const GRAPHICS::Object3D& object);
+        static uint64_t ComputeContentFingerprint(const GRAPHICS::Object3D& object);
+
+        // PRIVATE MEMBER VARIABLES.
+        /// True if object geometry may have been edited in place, requiring all content fingerprints to be recomputed.
+        bool ContentFingerprintsStale = false;
+        /// The content fingerprint of each object in the scene as of the last update, sorted by identity fingerprint
+        /// so that they can be found with a binary search.
+        std::vector<IdentityAndContentFingerprint> ContentFingerprintsByIdentity = {};
+        /// The content fingerprints of objects seen so far during the current update, paired with their identity fingerprints.
+        /// Only kept as a member so that its storage is reused across updates, keeping updates free of heap allocations
+        /// once the scene's object count has been reached.
+        std::vector<IdentityAndContentFingerprint> CurrentContentFingerprintsByIdentity = {};
+        /// The content fingerprints of objects loaded into the current graphics device.
+        std::unordered_set<uint64_t> LoadedContentFingerprints = {};
+        /// The textures referenced by objects loaded into the current graphics device.
+        std::unordered_set<const GRAPHICS::IMAGES::Bitmap*> LoadedTextures = {};
+    };
+}
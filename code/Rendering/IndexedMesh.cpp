@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <unordered_map>
+#include "Rendering/IndexedMesh.h"
+#include "Rendering/UniqueVertexTable.h"
+
+namespace RENDERING
+{
+    /// Removes all geometry from the mesh, keeping allocated memory for reuse.
+    void IndexedMesh::Clear()
+    {
+        Positions.clear();
+        Normals.clear();
+        TextureCoordinates.clear();
+        Colors.clear();
+        Indices.clear();
+        MaterialRanges.clear();
+        Materials.clear();
+    }
+
+    /// Reserves space for appending to an array.  Space grows geometrically so that appending many small meshes stays fast,
+    /// but a single mesh only gets exactly the space it needs, since huge meshes would otherwise waste a lot of memory.
+    /// @param[in,out]  values - The array to reserve space in.
+    /// @param[in]  appended_count - The number of values that will be appended.
+    template <typename ValueType>
+    static void ReserveToAppend(std::vector<ValueType>& values, const std::size_t appended_count)
+    {
+        std::size_t required_capacity = values.size() + appended_count;
+        if (required_capacity > values.capacity())
+        {
+            values.reserve(std::max(required_capacity, 2 * values.capacity()));
+        }
+    }
+
+    /// Appends triangles to the mesh, merging vertices whose attributes are all identical.
+    /// Vertices are only merged within a single call since meshes rarely share vertices with each other.
+    /// @param[in]  triangles - The triangles to append.
+    void IndexedMesh::AppendTriangles(const std::vector<GRAPHICS::GEOMETRY::Triangle>& triangles)
+    {
+        // APPEND THE INDICES OF EACH TRIANGLE'S VERTICES.
+        // Unique vertices are found before any are copied so that vertex arrays can be sized exactly.
+        UniqueVertexTable unique_vertices(triangles);
+        uint32_t first_vertex_index = VertexCount();
+        uint32_t corner_count = static_cast<uint32_t>(VERTICES_PER_TRIANGLE * triangles.size());
+        ReserveToAppend(Indices, corner_count);
+        for (uint32_t corner_index = 0; corner_index < corner_count; ++corner_index)
+        {
+            uint32_t vertex_index = unique_vertices.FindOrAdd(corner_index);
+            Indices.emplace_back(first_vertex_index + vertex_index);
+        }
+
+        // APPEND THE UNIQUE VERTICES.
+        uint32_t vertex_count = unique_vertices.VertexCount();
+        ReserveToAppend(Positions, vertex_count);
+        ReserveToAppend(Normals, vertex_count);
+        ReserveToAppend(TextureCoordinates, vertex_count);
+        ReserveToAppend(Colors, vertex_count);
+        for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+        {
+            const GRAPHICS::VertexWithAttributes& vertex = unique_vertices.Vertex(vertex_index);
+            Positions.emplace_back(vertex.Position);
+            Normals.emplace_back(vertex.Normal);
+            TextureCoordinates.emplace_back(vertex.TextureCoordinates);
+            Colors.emplace_back(vertex.Color);
+        }
+
+        // ASSIGN EACH TRIANGLE'S MATERIAL.
+        std::unordered_map<const GRAPHICS::Material*, uint32_t> material_ids_by_pointer;
+        for (uint32_t material_id = 0; material_id < Materials.size(); ++material_id)
+        {
+            material_ids_by_pointer[Materials[material_id]] = material_id;
+        }
+        uint32_t first_triangle_index = TriangleCount() - static_cast<uint32_t>(triangles.size());
+        for (uint32_t triangle_index = 0; triangle_index < triangles.size(); ++triangle_index)
+        {
+            uint32_t material_id = NO_MATERIAL;
+            const GRAPHICS::Material* material = triangles[triangle_index].Material.get();
+            if (material)
+            {
+                auto [material_id_entry, material_new] = material_ids_by_pointer.try_emplace(material, static_cast<uint32_t>(Materials.size()));
+                if (material_new)
+                {
+                    Materials.emplace_back(material);
+                }
+                material_id = material_id_entry->second;
+            }
+
+            AssignTriangleMaterial(first_triangle_index + triangle_index, material_id);
+        }
+    }
+
+    /// Assigns a material to a triangle.  Triangles must be assigned materials in order, after the previous triangle.
+    /// Consecutive triangles typically share materials, so they are grouped into a single range.
+    /// @param[in]  triangle_index - The index of the triangle.
+    /// @param[in]  material_id - The index of the material in the material table; NO_MATERIAL for none.
+    void IndexedMesh::AssignTriangleMaterial(const uint32_t triangle_index, const uint32_t material_id)
+    {
+        bool extends_previous_range = !MaterialRanges.empty() && (MaterialRanges.back().MaterialId == material_id);
+        if (extends_previous_range)
+        {
+            ++MaterialRanges.back().TriangleCount;
+        }
+        else
+        {
+            MaterialRange& material_range = MaterialRanges.emplace_back();
+            material_range.FirstTriangleIndex = triangle_index;
+            material_range.TriangleCount = 1;
+            material_range.MaterialId = material_id;
+        }
+    }
+
+    /// Gets the number of unique vertices in the mesh.
+    /// @return The number of vertices.
+    uint32_t IndexedMesh::VertexCount() const
+    {
+        return static_cast<uint32_t>(Positions.size());
+    }
+
+    /// Gets the number of triangles in the mesh.
+    /// @return The number of triangles.
+    uint32_t IndexedMesh::TriangleCount() const
+    {
+        return static_cast<uint32_t>(Indices.size() / VERTICES_PER_TRIANGLE);
+    }
+
+    /// Finds the material range containing a triangle.
+    /// @param[in]  triangle_index - The index of the triangle.
+    /// @return The index of the range in MaterialRanges; the number of ranges if none contains the triangle.
+    std::size_t IndexedMesh::FindMaterialRangeIndex(const uint32_t triangle_index) const
+    {
+        // Ranges are ordered and contiguous, so the containing range is the last one starting at or before the triangle.
+        auto range_after_triangle = std::upper_bound(
+            MaterialRanges.begin(),
+            MaterialRanges.end(),
+            triangle_index,
+            [](const uint32_t index, const MaterialRange& material_range)
+            {
+                return index < material_range.FirstTriangleIndex;
+            });
+        if (MaterialRanges.begin() == range_after_triangle)
+        {
+            return MaterialRanges.size();
+        }
+
+        return static_cast<std::size_t>(range_after_triangle - MaterialRanges.begin()) - 1;
+    }
+
+    /// Gets the ID of a triangle's material.
+    /// @param[in]  triangle_index - The index of the triangle.
+    /// @return The index of the triangle's material in the material table; NO_MATERIAL if it has none.
+    uint32_t IndexedMesh::TriangleMaterialId(const uint32_t triangle_index) const
+    {
+        std::size_t material_range_index = FindMaterialRangeIndex(triangle_index);
+        if (material_range_index >= MaterialRanges.size())
+        {
+            return NO_MATERIAL;
+        }
+
+        return MaterialRanges[material_range_index].MaterialId;
+    }
+
+    /// Gets the material of a triangle.
+    /// @param[in]  triangle_index - The index of the triangle.
+    /// @return The material of the triangle; null if it has none.
+    const GRAPHICS::Material* IndexedMesh::TriangleMaterial(const uint32_t triangle_index) const
+    {
+        uint32_t material_id = TriangleMaterialId(triangle_index);
+        if (NO_MATERIAL == material_id)
+        {
+            return nullptr;
+        }
+        return Materials[material_id];
+    }
+}
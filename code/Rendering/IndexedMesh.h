@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Graphics/Color.h"
+#include "Graphics/Geometry/Triangle.h"
+#include "Graphics/Material.h"
+#include "Math/Vector2.h"
+#include "Math/Vector3.h"
+
+namespace RENDERING
+{
+    /// A range of consecutive triangles in an indexed mesh that share the same material.
+    struct MaterialRange
+    {
+        /// The index of the first triangle in the range.
+        uint32_t FirstTriangleIndex = 0;
+        /// The number of triangles in the range.
+        uint32_t TriangleCount = 0;
+        /// The index of the material in the mesh's material table.
+        uint32_t MaterialId = 0;
+    };
+
+    /// Triangle geometry stored compactly for CPU rendering hot paths.
+    ///
+    /// Graphics meshes store a full copy of all vertex attributes plus a material reference for every triangle,
+    /// which duplicates shared vertices many times and scatters data for any single attribute across memory.
+    /// Here, each unique vertex is stored once, with each attribute in its own tightly-packed array
+    /// (a structure-of-arrays layout) so that loops over a single attribute (like positions when intersecting rays)
+    /// only touch the memory they need.  Triangles are 3 consecutive 32-bit indices into these arrays,
+    /// and materials are assigned to ranges of triangles rather than to each triangle individually.
+    ///
+    /// Materials are referenced by pointer, so the meshes they came from must outlive any use of this.
+    class IndexedMesh
+    {
+    public:
+        /// The number of vertex indices per triangle.
+        static constexpr uint32_t VERTICES_PER_TRIANGLE = 3;
+        /// The material ID for triangles without any material.
+        static constexpr uint32_t NO_MATERIAL = UINT32_MAX;
+
+        // BUILDING.
+        void Clear();
+        void AppendTriangles(const std::vector<GRAPHICS::GEOMETRY::Triangle>& triangles);
+        void AssignTriangleMaterial(const uint32_t triangle_index, const uint32_t material_id);
+
+        // QUERIES.
+        uint32_t VertexCount() const;
+        uint32_t TriangleCount() const;
+        std::size_t FindMaterialRangeIndex(const uint32_t triangle_index) const;
+        uint32_t TriangleMaterialId(const uint32_t triangle_index) const;
+        const GRAPHICS::Material* TriangleMaterial(const uint32_t triangle_index) const;
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The position of each vertex.
+        std::vector<MATH::Vector3f> Positions = {};
+        /// The normal of each vertex.  May be zero if the source triangles lacked normals.
+        std::vector<MATH::Vector3f> Normals = {};
+        /// The texture coordinates of each vertex.
+        std::vector<MATH::Vector2f> TextureCoordinates = {};
+        /// The color of each vertex.
+        std::vector<GRAPHICS::Color> Colors = {};
+        /// The vertex indices of each triangle, with 3 consecutive indices per triangle.
+        std::vector<uint32_t> Indices = {};
+        /// The materials of all triangles, ordered by triangle index.
+        std::vector<MaterialRange> MaterialRanges = {};
+        /// The unique materials referenced by material ranges.  Renderers map these to a table for their whole scene (see MaterialTable).
+        std::vector<const GRAPHICS::Material*> Materials = {};
+    };
+}
@@ -0,0 +1,76 @@
+#include "Assets/TextureCache.h"
+#include "Rendering/MaterialTable.h"
+
+namespace RENDERING
+{
+    /// Removes all materials from the table, invalidating all handles but keeping allocated memory for reuse.
+    void MaterialTable::Clear()
+    {
+        Materials.clear();
+        DiffuseTextures.clear();
+        HandlesByMaterial.clear();
+    }
+
+    /// Adds a material to the table if it isn't already in it.
+    /// @param[in]  material - The material to add.  May be null.
+    /// @return The handle of the material; NO_MATERIAL if the material is null.
+    MaterialHandle MaterialTable::Add(const GRAPHICS::Material* const material)
+    {
+        if (!material)
+        {
+            return NO_MATERIAL;
+        }
+
+        auto [handle_entry, material_new] = HandlesByMaterial.try_emplace(material, static_cast<MaterialHandle>(Materials.size()));
+        if (material_new)
+        {
+            Materials.emplace_back(material);
+            DiffuseTextures.emplace_back(ASSETS::TextureCache::FindMipmaps(material->DiffuseProperties.Texture.get()));
+        }
+        return handle_entry->second;
+    }
+
+    /// Adds all materials of a mesh to the table.
+    /// @param[in]  mesh - The mesh whose materials to add.
+    /// @param[out] material_handles_by_id - The handle of each material, indexed by its ID in the mesh's own material table.
+    ///     Since simplified versions of a mesh keep its material IDs, this also applies to them.
+    void MaterialTable::AddMeshMaterials(const IndexedMesh& mesh, std::vector<MaterialHandle>& material_handles_by_id)
+    {
+        material_handles_by_id.clear();
+        for (const GRAPHICS::Material* material : mesh.Materials)
+        {
+            material_handles_by_id.emplace_back(Add(material));
+        }
+    }
+
+    /// Gets the number of materials in the table.
+    /// @return The number of materials.
+    std::size_t MaterialTable::MaterialCount() const
+    {
+        return Materials.size();
+    }
+
+    /// Gets a material.
+    /// @param[in]  handle - The handle of the material.
+    /// @return The material; null for NO_MATERIAL.
+    const GRAPHICS::Material* MaterialTable::GetMaterial(const MaterialHandle handle) const
+    {
+        if (NO_MATERIAL == handle)
+        {
+            return nullptr;
+        }
+        return Materials[handle];
+    }
+
+    /// Gets the mipmapped diffuse texture of a material.
+    /// @param[in]  handle - The handle of the material.
+    /// @return The mipmapped texture; null if the material has none or for NO_MATERIAL.
+    const MipmappedTexture* MaterialTable::GetDiffuseTexture(const MaterialHandle handle) const
+    {
+        if (NO_MATERIAL == handle)
+        {
+            return nullptr;
+        }
+        return DiffuseTextures[handle].get();
+    }
+}
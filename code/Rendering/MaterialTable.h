@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "Graphics/Material.h"
+#include "Rendering/IndexedMesh.h"
+#include "Rendering/MipmappedTexture.h"
+
+namespace RENDERING
+{
+    /// A compact reference to a material in a material table: its index in the table's arrays.
+    using MaterialHandle = uint32_t;
+
+    /// The unique materials used by a scene being rendered, stored contiguously and referenced by handle.
+    ///
+    /// Graphics triangles each hold a shared pointer to their material, which is 16 bytes per triangle and
+    /// scattered across memory.  Renderers instead assign each unique material a 32-bit handle once when
+    /// objects are rebuilt, and per-triangle data only carries the handle.  Anything derived from a material
+    /// (like its mipmapped diffuse texture) is found once for the whole scene rather than once per mesh.
+    /// The graphics triangles and spheres themselves still hold their shared pointers, so copying them
+    /// still updates reference counts; this only keeps those pointers out of the renderers' inner loops.
+    ///
+    /// Materials are referenced by pointer rather than copied, so edits to them (such as through the GUI)
+    /// take effect without rebuilding the table, but the scene's objects must outlive any use of this.
+    class MaterialTable
+    {
+    public:
+        /// The handle for surfaces without any material.
+        static constexpr MaterialHandle NO_MATERIAL = UINT32_MAX;
+
+        // BUILDING.
+        void Clear();
+        MaterialHandle Add(const GRAPHICS::Material* const material);
+        void AddMeshMaterials(const IndexedMesh& mesh, std::vector<MaterialHandle>& material_handles_by_id);
+
+        // QUERIES.
+        std::size_t MaterialCount() const;
+        const GRAPHICS::Material* GetMaterial(const MaterialHandle handle) const;
+        const MipmappedTexture* GetDiffuseTexture(const MaterialHandle handle) const;
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The materials, indexed by handle.
+        std::vector<const GRAPHICS::Material*> Materials = {};
+        /// The mipmapped diffuse texture of each material, found in the texture cache and indexed by handle.
+        /// Null for materials without textures or whose textures weren't loaded through the cache.
+        std::vector<std::shared_ptr<const MipmappedTexture>> DiffuseTextures = {};
+
+    private:
+        // PRIVATE MEMBER VARIABLES.
+        /// The handle of each material in the table, for adding each material only once.
+        std::unordered_map<const GRAPHICS::Material*, MaterialHandle> HandlesByMaterial = {};
+    };
+}
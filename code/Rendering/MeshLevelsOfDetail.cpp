@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <utility>
+#include "Profiling/TraceRecorder.h"
+#include "Rendering/MeshLevelsOfDetail.h"
+#include "Rendering/MeshSimplifier.h"
+
+namespace RENDERING
+{
+    /// Determines if a mesh has enough triangles for simplified levels to be generated for it.
+    /// @param[in]  full_detail_mesh - The mesh to check.
+    /// @return True if at least one simplified level could be generated; false if the mesh is simple enough already.
+    bool MeshLevelsOfDetail::SimplificationWorthwhile(const IndexedMesh& full_detail_mesh)
+    {
+        bool simplification_worthwhile = (full_detail_mesh.TriangleCount() >= TRIANGLE_REDUCTION_FACTOR * MIN_SIMPLIFIED_TRIANGLE_COUNT);
+        return simplification_worthwhile;
+    }
+
+    /// Generates simplified levels for a mesh.
+    /// Each level is simplified from the previous one rather than from the full detail mesh, which is much faster
+    /// for large meshes.  Generation stops early once simplification stops making much progress, such as when
+    /// most remaining vertices are on borders or seams.
+    /// @param[in]  full_detail_mesh - The mesh to simplify.
+    /// @param[in]  cancel_requested - If given, generation stops before the next level once this is set, since levels for
+    ///     large meshes can take a while.  The caller should then discard the incomplete result.
+    /// @return The simplified levels of the mesh.
+    MeshLevelsOfDetail MeshLevelsOfDetail::Generate(const IndexedMesh& full_detail_mesh, const std::atomic<bool>* const cancel_requested)
+    {
+        PROFILING::TraceScope generate_scope("Generate Levels of Detail", "Levels of Detail");
+
+        MeshLevelsOfDetail levels_of_detail;
+        const IndexedMesh* previous_level = &full_detail_mesh;
+        while (levels_of_detail.SimplifiedLevels.size() < MAX_SIMPLIFIED_LEVEL_COUNT)
+        {
+            // STOP IF NO LONGER NEEDED.
+            if (cancel_requested && cancel_requested->load(std::memory_order_relaxed))
+            {
+                break;
+            }
+
+            // STOP ONCE THE MESH IS SIMPLE ENOUGH.
+            uint32_t previous_triangle_count = previous_level->TriangleCount();
+            uint32_t target_triangle_count = previous_triangle_count / TRIANGLE_REDUCTION_FACTOR;
+            if (target_triangle_count < MIN_SIMPLIFIED_TRIANGLE_COUNT)
+            {
+                break;
+            }
+
+            // SIMPLIFY THE PREVIOUS LEVEL.
+            IndexedMesh simplified_level = MeshSimplifier::Simplify(*previous_level, target_triangle_count);
+
+            // STOP IF SIMPLIFICATION BARELY HELPED.
+            // Such a level would cost nearly as much to render as the previous one while looking worse.
+            constexpr uint32_t MIN_USEFUL_REDUCTION_FACTOR = 2;
+            bool simplification_useful = (simplified_level.TriangleCount() * MIN_USEFUL_REDUCTION_FACTOR <= previous_triangle_count);
+            if (!simplification_useful)
+            {
+                break;
+            }
+
+            levels_of_detail.SimplifiedLevels.push_back(std::move(simplified_level));
+            previous_level = &levels_of_detail.SimplifiedLevels.back();
+        }
+
+        return levels_of_detail;
+    }
+
+    /// Selects the level to render a mesh with.
+    /// @param[in]  full_detail_mesh - The mesh the levels were generated from.
+    /// @param[in]  covered_pixel_count - The approximate number of pixels the mesh covers on screen.
+    /// @param[in]  pixels_per_triangle - The number of covered pixels each rendered triangle should account for.
+    ///     Smaller values select more detailed levels.
+    /// @return The least detailed level with at least the desired number of triangles; the full detail mesh if none have enough.
+    const IndexedMesh& MeshLevelsOfDetail::SelectLevel(
+        const IndexedMesh& full_detail_mesh,
+        const float covered_pixel_count,
+        const float pixels_per_triangle) const
+    {
+        float desired_triangle_count = covered_pixel_count / std::max(pixels_per_triangle, 1e-3f);
+        for (auto level = SimplifiedLevels.rbegin(); level != SimplifiedLevels.rend(); ++level)
+        {
+            if (static_cast<float>(level->TriangleCount()) >= desired_triangle_count)
+            {
+                return *level;
+            }
+        }
+        return full_detail_mesh;
+    }
+}
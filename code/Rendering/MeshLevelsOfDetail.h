@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Rendering/IndexedMesh.h"
+
+namespace RENDERING
+{
+    /// Successively simplified versions of a mesh, for rendering it with fewer triangles when it covers fewer pixels.
+    ///
+    /// Each level has about a quarter of the triangles of the previous one, matching how the number of pixels
+    /// an object covers shrinks with the square of its distance.  Levels are generated once for a mesh's content
+    /// (see MeshSimplifier and ObjectMeshCache) and then selected each frame from how large the mesh appears on screen.
+    class MeshLevelsOfDetail
+    {
+    public:
+        /// How many times fewer triangles each level aims to have than the previous one.
+        static constexpr uint32_t TRIANGLE_REDUCTION_FACTOR = 4;
+        /// Meshes with this few triangles are cheap enough to always render at full detail, so they aren't simplified further.
+        static constexpr uint32_t MIN_SIMPLIFIED_TRIANGLE_COUNT = 512;
+        /// The maximum number of simplified levels generated for a mesh.
+        static constexpr std::size_t MAX_SIMPLIFIED_LEVEL_COUNT = 6;
+
+        // CREATION.
+        static bool SimplificationWorthwhile(const IndexedMesh& full_detail_mesh);
+        static MeshLevelsOfDetail Generate(const IndexedMesh& full_detail_mesh, const std::atomic<bool>* const cancel_requested = nullptr);
+
+        // SELECTION.
+        const IndexedMesh& SelectLevel(
+            const IndexedMesh& full_detail_mesh,
+            const float covered_pixel_count,
+            const float pixels_per_triangle) const;
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The simplified levels, from most to least detailed.  The full detail mesh isn't included.
+        std::vector<IndexedMesh> SimplifiedLevels = {};
+    };
+}
@@ -0,0 +1,585 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include "Rendering/MeshSimplifier.h"
+
+namespace RENDERING
+{
+    /// The minimum cosine of the angle between a triangle's normal before and after a collapse.
+    /// Collapses that would turn any remaining triangle further than this (including flipping it over) are rejected.
+    constexpr float MIN_COLLAPSED_NORMAL_ALIGNMENT = 0.25f;
+
+    /// Simplifies a mesh.
+    /// @param[in]  mesh - The mesh to simplify.
+    /// @param[in]  target_triangle_count - The number of triangles to reduce the mesh to.  The simplified mesh may have
+    ///     more triangles if locked vertices or the shape of the mesh prevent further collapses.
+    /// @return The simplified mesh, which shares the original mesh's material table.
+    IndexedMesh MeshSimplifier::Simplify(const IndexedMesh& mesh, const uint32_t target_triangle_count)
+    {
+        // CHECK IF THE MESH IS ALREADY SIMPLE ENOUGH.
+        if (mesh.TriangleCount() <= target_triangle_count)
+        {
+            return mesh;
+        }
+
+        // SIMPLIFY THE MESH.
+        MeshSimplifier simplifier(mesh);
+        simplifier.BuildAdjacency();
+        simplifier.LockBorderVertices();
+        simplifier.ComputeQuadrics();
+        simplifier.QueueAllCollapses();
+        simplifier.CollapseEdges(target_triangle_count);
+        return simplifier.BuildSimplifiedMesh();
+    }
+
+    /// Adds a plane to the quadric.
+    /// @param[in]  normal_x - The X component of the plane's unit normal.
+    /// @param[in]  normal_y - The Y component of the plane's unit normal.
+    /// @param[in]  normal_z - The Z component of the plane's unit normal.
+    /// @param[in]  offset - The plane's offset, such that points on the plane have a dot product with the normal of -offset.
+    /// @param[in]  weight - The amount to scale the plane's squared distances by.
+    void MeshSimplifier::Quadric::AddPlane(const double normal_x, const double normal_y, const double normal_z, const double offset, const double weight)
+    {
+        Elements[0] += weight * normal_x * normal_x;
+        Elements[1] += weight * normal_x * normal_y;
+        Elements[2] += weight * normal_x * normal_z;
+        Elements[3] += weight * normal_x * offset;
+        Elements[4] += weight * normal_y * normal_y;
+        Elements[5] += weight * normal_y * normal_z;
+        Elements[6] += weight * normal_y * offset;
+        Elements[7] += weight * normal_z * normal_z;
+        Elements[8] += weight * normal_z * offset;
+        Elements[9] += weight * offset * offset;
+    }
+
+    /// Adds another quadric to this one, so that this measures distances to both quadrics' planes.
+    /// @param[in]  other - The quadric to add.
+    void MeshSimplifier::Quadric::Add(const Quadric& other)
+    {
+        for (std::size_t element_index = 0; element_index < std::size(Elements); ++element_index)
+        {
+            Elements[element_index] += other.Elements[element_index];
+        }
+    }
+
+    /// Evaluates the quadric at a point.
+    /// @param[in]  point - The point to evaluate at.
+    /// @return The weighted sum of squared distances from the point to the quadric's planes.
+    double MeshSimplifier::Quadric::Evaluate(const MATH::Vector3f& point) const
+    {
+        double x = point.X;
+        double y = point.Y;
+        double z = point.Z;
+        double error =
+            Elements[0] * x * x + 2.0 * Elements[1] * x * y + 2.0 * Elements[2] * x * z + 2.0 * Elements[3] * x +
+            Elements[4] * y * y + 2.0 * Elements[5] * y * z + 2.0 * Elements[6] * y +
+            Elements[7] * z * z + 2.0 * Elements[8] * z +
+            Elements[9];
+        // Rounding can make the error slightly negative for points on all planes.
+        return std::max(error, 0.0);
+    }
+
+    /// Orders collapses for the queue.
+    /// Collapses with equal costs are ordered by their removed vertices, so that exactly one direction
+    /// along each edge is considered cheaper.
+    /// @param[in]  other - The collapse to compare with.
+    /// @return True if this collapse is more costly than the other.
+    bool MeshSimplifier::EdgeCollapse::operator>(const EdgeCollapse& other) const
+    {
+        if (Cost != other.Cost)
+        {
+            return Cost > other.Cost;
+        }
+        return FromVertexIndex > other.FromVertexIndex;
+    }
+
+    /// Constructor.
+    /// @param[in]  mesh - The mesh to simplify.  Must outlive this simplifier.
+    MeshSimplifier::MeshSimplifier(const IndexedMesh& mesh) :
+        SourceMesh(&mesh),
+        Indices(mesh.Indices),
+        TrianglesRemoved(mesh.TriangleCount(), 0),
+        RemainingTriangleCount(mesh.TriangleCount()),
+        TriangleIndicesByVertex(mesh.VertexCount()),
+        Quadrics(mesh.VertexCount()),
+        VerticesLocked(mesh.VertexCount(), 0),
+        VerticesRemoved(mesh.VertexCount(), 0),
+        VertexVersions(mesh.VertexCount(), 0)
+    {}
+
+    /// Finds the triangles using each vertex and the material of each triangle.
+    void MeshSimplifier::BuildAdjacency()
+    {
+        // FIND THE MATERIAL OF EACH TRIANGLE.
+        TriangleMaterialIds.assign(SourceMesh->TriangleCount(), IndexedMesh::NO_MATERIAL);
+        for (const MaterialRange& material_range : SourceMesh->MaterialRanges)
+        {
+            std::fill_n(TriangleMaterialIds.begin() + material_range.FirstTriangleIndex, material_range.TriangleCount, material_range.MaterialId);
+        }
+
+        // FIND THE TRIANGLES USING EACH VERTEX.
+        // Counting first avoids repeatedly growing each vertex's list.
+        std::vector<uint32_t> triangle_counts_by_vertex(SourceMesh->VertexCount(), 0);
+        for (uint32_t vertex_index : Indices)
+        {
+            ++triangle_counts_by_vertex[vertex_index];
+        }
+        for (uint32_t vertex_index = 0; vertex_index < SourceMesh->VertexCount(); ++vertex_index)
+        {
+            TriangleIndicesByVertex[vertex_index].reserve(triangle_counts_by_vertex[vertex_index]);
+        }
+        for (uint32_t triangle_index = 0; triangle_index < SourceMesh->TriangleCount(); ++triangle_index)
+        {
+            for (uint32_t corner_index = 0; corner_index < IndexedMesh::VERTICES_PER_TRIANGLE; ++corner_index)
+            {
+                uint32_t vertex_index = Indices[IndexedMesh::VERTICES_PER_TRIANGLE * triangle_index + corner_index];
+                TriangleIndicesByVertex[vertex_index].push_back(triangle_index);
+            }
+        }
+    }
+
+    /// Locks vertices that must not move: those on any edge not shared by exactly 2 triangles
+    /// (open borders, seams, and non-manifold edges) and those between triangles of different materials.
+    void MeshSimplifier::LockBorderVertices()
+    {
+        struct NeighborEdge
+        {
+            uint32_t VertexIndex = 0;
+            uint32_t TriangleCount = 0;
+        };
+        std::vector<NeighborEdge> neighbor_edges;
+        for (uint32_t vertex_index = 0; vertex_index < SourceMesh->VertexCount(); ++vertex_index)
+        {
+            // COUNT THE TRIANGLES SHARING EACH EDGE FROM THE VERTEX.
+            neighbor_edges.clear();
+            bool multiple_materials = false;
+            const std::vector<uint32_t>& triangle_indices = TriangleIndicesByVertex[vertex_index];
+            for (uint32_t triangle_index : triangle_indices)
+            {
+                multiple_materials |= (TriangleMaterialIds[triangle_index] != TriangleMaterialIds[triangle_indices.front()]);
+
+                const uint32_t* vertex_indices = &Indices[IndexedMesh::VERTICES_PER_TRIANGLE * triangle_index];
+                for (uint32_t corner_index = 0; corner_index < IndexedMesh::VERTICES_PER_TRIANGLE; ++corner_index)
+                {
+                    uint32_t neighbor_vertex_index = vertex_indices[corner_index];
+                    if (neighbor_vertex_index == vertex_index)
+                    {
+                        continue;
+                    }
+
+                    auto neighbor_edge = std::find_if(
+                        neighbor_edges.begin(),
+                        neighbor_edges.end(),
+                        [neighbor_vertex_index](const NeighborEdge& edge) { return edge.VertexIndex == neighbor_vertex_index; });
+                    if (neighbor_edges.end() == neighbor_edge)
+                    {
+                        neighbor_edges.push_back({ neighbor_vertex_index, 1 });
+                    }
+                    else
+                    {
+                        ++neighbor_edge->TriangleCount;
+                    }
+                }
+            }
+
+            // LOCK THE VERTEX IF IT'S ON A BORDER.
+            constexpr uint32_t INTERIOR_EDGE_TRIANGLE_COUNT = 2;
+            bool on_border = std::any_of(
+                neighbor_edges.begin(),
+                neighbor_edges.end(),
+                [](const NeighborEdge& edge) { return edge.TriangleCount != INTERIOR_EDGE_TRIANGLE_COUNT; });
+            VerticesLocked[vertex_index] = (on_border || multiple_materials) ? 1 : 0;
+        }
+    }
+
+    /// Computes the quadric for each vertex from the planes of the triangles around it.
+    /// Planes are weighted by triangle area so that many tiny triangles don't outweigh a few large ones.
+    void MeshSimplifier::ComputeQuadrics()
+    {
+        const std::vector<MATH::Vector3f>& positions = SourceMesh->Positions;
+        for (uint32_t triangle_index = 0; triangle_index < SourceMesh->TriangleCount(); ++triangle_index)
+        {
+            // COMPUTE THE TRIANGLE'S PLANE.
+            const uint32_t* vertex_indices = &Indices[IndexedMesh::VERTICES_PER_TRIANGLE * triangle_index];
+            MATH::Vector3f first_position = positions[vertex_indices[0]];
+            MATH::Vector3f normal = MATH::Vector3f::CrossProduct(
+                positions[vertex_indices[1]] - first_position,
+                positions[vertex_indices[2]] - first_position);
+            double double_area = normal.Length();
+            if (double_area <= 0.0)
+            {
+                continue;
+            }
+            double normal_x = normal.X / double_area;
+            double normal_y = normal.Y / double_area;
+            double normal_z = normal.Z / double_area;
+            double offset = -(normal_x * first_position.X + normal_y * first_position.Y + normal_z * first_position.Z);
+
+            // ADD THE PLANE TO EACH OF THE TRIANGLE'S VERTICES.
+            double area = double_area / 2.0;
+            for (uint32_t corner_index = 0; corner_index < IndexedMesh::VERTICES_PER_TRIANGLE; ++corner_index)
+            {
+                Quadrics[vertex_indices[corner_index]].AddPlane(normal_x, normal_y, normal_z, offset, area);
+            }
+        }
+    }
+
+    /// Queues collapses for every edge in the mesh.
+    void MeshSimplifier::QueueAllCollapses()
+    {
+        // Closed meshes have 3 edges for every 2 triangles, so that much space is reserved up front
+        // rather than repeatedly growing the queue.
+        constexpr std::size_t EDGES_PER_TRIANGLE_PAIR = 3;
+        Collapses.reserve(EDGES_PER_TRIANGLE_PAIR * static_cast<std::size_t>(SourceMesh->TriangleCount()) / 2);
+
+        // Each edge is only queued from its lower-indexed vertex so that shared edges aren't queued twice.
+        std::vector<uint32_t> neighbor_vertex_indices;
+        for (uint32_t vertex_index = 0; vertex_index < SourceMesh->VertexCount(); ++vertex_index)
+        {
+            FindNeighbors(vertex_index, neighbor_vertex_indices);
+            for (uint32_t neighbor_vertex_index : neighbor_vertex_indices)
+            {
+                if (vertex_index < neighbor_vertex_index)
+                {
+                    QueueCollapses(vertex_index, neighbor_vertex_index);
+                }
+            }
+        }
+    }
+
+    /// Queues a collapse along an edge, in the cheaper direction whose vertex may move.
+    /// The other direction is only queued if the cheaper one is later rejected for flipping triangles,
+    /// which keeps the queue half the size it would be with both directions queued up front.
+    /// @param[in]  first_vertex_index - The vertex at one end of the edge.
+    /// @param[in]  second_vertex_index - The vertex at the other end of the edge.
+    void MeshSimplifier::QueueCollapses(const uint32_t first_vertex_index, const uint32_t second_vertex_index)
+    {
+        bool first_vertex_locked = VerticesLocked[first_vertex_index];
+        bool second_vertex_locked = VerticesLocked[second_vertex_index];
+        if (first_vertex_locked && second_vertex_locked)
+        {
+            return;
+        }
+        if (second_vertex_locked)
+        {
+            QueueCollapse(CreateCollapse(first_vertex_index, second_vertex_index));
+            return;
+        }
+        if (first_vertex_locked)
+        {
+            QueueCollapse(CreateCollapse(second_vertex_index, first_vertex_index));
+            return;
+        }
+
+        EdgeCollapse first_to_second_collapse = CreateCollapse(first_vertex_index, second_vertex_index);
+        EdgeCollapse second_to_first_collapse = CreateCollapse(second_vertex_index, first_vertex_index);
+        bool first_to_second_cheaper = second_to_first_collapse > first_to_second_collapse;
+        QueueCollapse(first_to_second_cheaper ? first_to_second_collapse : second_to_first_collapse);
+    }
+
+    /// Queues the opposite direction of a rejected collapse, if it hasn't been queued already.
+    /// @param[in]  rejected_collapse - The collapse that was rejected.  Must not be outdated.
+    void MeshSimplifier::QueueOppositeCollapse(const EdgeCollapse& rejected_collapse)
+    {
+        if (VerticesLocked[rejected_collapse.ToVertexIndex])
+        {
+            return;
+        }
+
+        // The opposite direction was only left unqueued if it was more costly, so a cheaper opposite direction
+        // means it was the one already queued and rejected.
+        EdgeCollapse opposite_collapse = CreateCollapse(rejected_collapse.ToVertexIndex, rejected_collapse.FromVertexIndex);
+        bool opposite_unqueued = opposite_collapse > rejected_collapse;
+        if (opposite_unqueued)
+        {
+            QueueCollapse(opposite_collapse);
+        }
+    }
+
+    /// Creates a collapse for the current state of its vertices.
+    /// @param[in]  from_vertex_index - The vertex to remove.
+    /// @param[in]  to_vertex_index - The vertex to remain.
+    /// @return The collapse.
+    MeshSimplifier::EdgeCollapse MeshSimplifier::CreateCollapse(const uint32_t from_vertex_index, const uint32_t to_vertex_index) const
+    {
+        Quadric combined_quadric = Quadrics[from_vertex_index];
+        combined_quadric.Add(Quadrics[to_vertex_index]);
+
+        EdgeCollapse collapse;
+        collapse.Cost = combined_quadric.Evaluate(SourceMesh->Positions[to_vertex_index]);
+        collapse.FromVertexIndex = from_vertex_index;
+        collapse.ToVertexIndex = to_vertex_index;
+        collapse.FromVertexVersion = VertexVersions[from_vertex_index];
+        collapse.ToVertexVersion = VertexVersions[to_vertex_index];
+        return collapse;
+    }
+
+    /// Adds a collapse to the queue.
+    /// Outdated collapses are removed before the queue would otherwise need to grow, so that it only grows
+    /// if most queued collapses are still current.  For large meshes, the queue takes more memory than anything
+    /// else used for simplifying.
+    /// @param[in]  collapse - The collapse to queue.
+    void MeshSimplifier::QueueCollapse(const EdgeCollapse& collapse)
+    {
+        bool queue_full = (Collapses.size() == Collapses.capacity());
+        if (queue_full)
+        {
+            RemoveOutdatedCollapses();
+
+            // If few collapses were outdated, the queue is grown instead so that it isn't scanned again right away.
+            bool mostly_current = (Collapses.size() > Collapses.capacity() / 2);
+            if (mostly_current)
+            {
+                Collapses.reserve(2 * Collapses.capacity());
+            }
+        }
+
+        Collapses.push_back(collapse);
+        std::push_heap(Collapses.begin(), Collapses.end(), std::greater<EdgeCollapse>());
+    }
+
+    /// Removes collapses that are outdated from the queue.
+    void MeshSimplifier::RemoveOutdatedCollapses()
+    {
+        std::erase_if(Collapses, [this](const EdgeCollapse& collapse) { return CollapseOutdated(collapse); });
+        std::make_heap(Collapses.begin(), Collapses.end(), std::greater<EdgeCollapse>());
+    }
+
+    /// Determines if a queued collapse is outdated.
+    /// Instead of updating queued collapses when vertices change, newer collapses are queued
+    /// and older ones are recognized by their versions.
+    /// @param[in]  collapse - The collapse to check.
+    /// @return True if either vertex has been removed or changed since the collapse was queued; false otherwise.
+    bool MeshSimplifier::CollapseOutdated(const EdgeCollapse& collapse) const
+    {
+        bool outdated =
+            VerticesRemoved[collapse.FromVertexIndex] ||
+            VerticesRemoved[collapse.ToVertexIndex] ||
+            (VertexVersions[collapse.FromVertexIndex] != collapse.FromVertexVersion) ||
+            (VertexVersions[collapse.ToVertexIndex] != collapse.ToVertexVersion);
+        return outdated;
+    }
+
+    /// Collapses edges cheapest-first until the target triangle count is reached or no more edges can collapse.
+    /// @param[in]  target_triangle_count - The number of triangles to reduce the mesh to.
+    void MeshSimplifier::CollapseEdges(const uint32_t target_triangle_count)
+    {
+        while (RemainingTriangleCount > target_triangle_count && !Collapses.empty())
+        {
+            std::pop_heap(Collapses.begin(), Collapses.end(), std::greater<EdgeCollapse>());
+            EdgeCollapse collapse = Collapses.back();
+            Collapses.pop_back();
+
+            // SKIP COLLAPSES THAT ARE OUTDATED.
+            if (CollapseOutdated(collapse))
+            {
+                continue;
+            }
+
+            // COLLAPSE THE EDGE IF IT WOULDN'T DAMAGE THE MESH.
+            // Otherwise, the edge may still be collapsible in the opposite direction.
+            if (CollapseAllowed(collapse.FromVertexIndex, collapse.ToVertexIndex))
+            {
+                Collapse(collapse.FromVertexIndex, collapse.ToVertexIndex);
+            }
+            else
+            {
+                QueueOppositeCollapse(collapse);
+            }
+        }
+    }
+
+    /// Determines if a collapse would keep the mesh well-formed.
+    /// @param[in]  from_vertex_index - The vertex that would be removed.
+    /// @param[in]  to_vertex_index - The vertex that would remain.
+    /// @return True if the collapse is allowed; false if it would fold triangles over or join surfaces that shouldn't touch.
+    bool MeshSimplifier::CollapseAllowed(const uint32_t from_vertex_index, const uint32_t to_vertex_index)
+    {
+        // CHECK THAT THE VERTICES ONLY SHARE THE NEIGHBORS OPPOSITE THEIR EDGE.
+        // Any other shared neighbor would end up with duplicate edges after the collapse, pinching the surface.
+        const std::vector<MATH::Vector3f>& positions = SourceMesh->Positions;
+        uint32_t shared_triangle_count = 0;
+        for (uint32_t triangle_index : TriangleIndicesByVertex[from_vertex_index])
+        {
+            const uint32_t* vertex_indices = &Indices[IndexedMesh::VERTICES_PER_TRIANGLE * triangle_index];
+            bool shared = !TrianglesRemoved[triangle_index] && std::find(vertex_indices, vertex_indices + IndexedMesh::VERTICES_PER_TRIANGLE, to_vertex_index) != vertex_indices + IndexedMesh::VERTICES_PER_TRIANGLE;
+            if (shared)
+            {
+                ++shared_triangle_count;
+            }
+        }
+        FindNeighbors(from_vertex_index, FromNeighborVertexIndices);
+        FindNeighbors(to_vertex_index, ToNeighborVertexIndices);
+        std::size_t shared_neighbor_count = 0;
+        for (uint32_t neighbor_vertex_index : FromNeighborVertexIndices)
+        {
+            bool shared = (neighbor_vertex_index != to_vertex_index) && std::binary_search(ToNeighborVertexIndices.begin(), ToNeighborVertexIndices.end(), neighbor_vertex_index);
+            if (shared)
+            {
+                ++shared_neighbor_count;
+            }
+        }
+        if (shared_neighbor_count != shared_triangle_count)
+        {
+            return false;
+        }
+
+        // CHECK THAT NO REMAINING TRIANGLE WOULD TURN TOO FAR.
+        const MATH::Vector3f& new_position = positions[to_vertex_index];
+        for (uint32_t triangle_index : TriangleIndicesByVertex[from_vertex_index])
+        {
+            if (TrianglesRemoved[triangle_index])
+            {
+                continue;
+            }
+
+            // COMPUTE THE TRIANGLE'S NORMAL BEFORE AND AFTER THE COLLAPSE.
+            const uint32_t* vertex_indices = &Indices[IndexedMesh::VERTICES_PER_TRIANGLE * triangle_index];
+            MATH::Vector3f old_positions[IndexedMesh::VERTICES_PER_TRIANGLE] = {};
+            MATH::Vector3f new_positions[IndexedMesh::VERTICES_PER_TRIANGLE] = {};
+            bool removed_by_collapse = false;
+            for (uint32_t corner_index = 0; corner_index < IndexedMesh::VERTICES_PER_TRIANGLE; ++corner_index)
+            {
+                uint32_t vertex_index = vertex_indices[corner_index];
+                removed_by_collapse |= (vertex_index == to_vertex_index);
+                old_positions[corner_index] = positions[vertex_index];
+                new_positions[corner_index] = (vertex_index == from_vertex_index) ? new_position : positions[vertex_index];
+            }
+            if (removed_by_collapse)
+            {
+                continue;
+            }
+            MATH::Vector3f old_normal = MATH::Vector3f::CrossProduct(old_positions[1] - old_positions[0], old_positions[2] - old_positions[0]);
+            MATH::Vector3f new_normal = MATH::Vector3f::CrossProduct(new_positions[1] - new_positions[0], new_positions[2] - new_positions[0]);
+
+            // REJECT THE COLLAPSE IF THE TRIANGLE WOULD FLIP OR DEGENERATE.
+            float old_normal_length = old_normal.Length();
+            float new_normal_length = new_normal.Length();
+            if (new_normal_length <= 0.0f)
+            {
+                return false;
+            }
+            if (old_normal_length > 0.0f)
+            {
+                float alignment = MATH::Vector3f::DotProduct(old_normal, new_normal) / (old_normal_length * new_normal_length);
+                if (alignment < MIN_COLLAPSED_NORMAL_ALIGNMENT)
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    /// Moves one vertex onto another, removing the triangles that shared the edge between them.
+    /// @param[in]  from_vertex_index - The vertex to remove.
+    /// @param[in]  to_vertex_index - The vertex to remain.
+    void MeshSimplifier::Collapse(const uint32_t from_vertex_index, const uint32_t to_vertex_index)
+    {
+        // MOVE THE REMOVED VERTEX'S TRIANGLES TO THE REMAINING VERTEX.
+        std::vector<uint32_t>& remaining_vertex_triangle_indices = TriangleIndicesByVertex[to_vertex_index];
+        for (uint32_t triangle_index : TriangleIndicesByVertex[from_vertex_index])
+        {
+            if (TrianglesRemoved[triangle_index])
+            {
+                continue;
+            }
+
+            uint32_t* vertex_indices = &Indices[IndexedMesh::VERTICES_PER_TRIANGLE * triangle_index];
+            bool shares_edge = std::find(vertex_indices, vertex_indices + IndexedMesh::VERTICES_PER_TRIANGLE, to_vertex_index) != vertex_indices + IndexedMesh::VERTICES_PER_TRIANGLE;
+            if (shares_edge)
+            {
+                TrianglesRemoved[triangle_index] = 1;
+                --RemainingTriangleCount;
+            }
+            else
+            {
+                std::replace(vertex_indices, vertex_indices + IndexedMesh::VERTICES_PER_TRIANGLE, from_vertex_index, to_vertex_index);
+                remaining_vertex_triangle_indices.push_back(triangle_index);
+            }
+        }
+        std::erase_if(
+            remaining_vertex_triangle_indices,
+            [this](const uint32_t triangle_index) { return TrianglesRemoved[triangle_index]; });
+        TriangleIndicesByVertex[from_vertex_index] = std::vector<uint32_t>();
+        VerticesRemoved[from_vertex_index] = 1;
+
+        // UPDATE THE REMAINING VERTEX.
+        // Its quadric now includes the removed vertex's planes, so all collapses along its edges must be re-queued.
+        Quadrics[to_vertex_index].Add(Quadrics[from_vertex_index]);
+        ++VertexVersions[to_vertex_index];
+        FindNeighbors(to_vertex_index, ToNeighborVertexIndices);
+        for (uint32_t neighbor_vertex_index : ToNeighborVertexIndices)
+        {
+            QueueCollapses(to_vertex_index, neighbor_vertex_index);
+        }
+    }
+
+    /// Finds the vertices sharing a remaining triangle with a vertex.
+    /// @param[in]  vertex_index - The vertex whose neighbors to find.
+    /// @param[out] neighbor_vertex_indices - The neighboring vertices, sorted and without duplicates.
+    void MeshSimplifier::FindNeighbors(const uint32_t vertex_index, std::vector<uint32_t>& neighbor_vertex_indices) const
+    {
+        neighbor_vertex_indices.clear();
+        for (uint32_t triangle_index : TriangleIndicesByVertex[vertex_index])
+        {
+            if (TrianglesRemoved[triangle_index])
+            {
+                continue;
+            }
+
+            const uint32_t* vertex_indices = &Indices[IndexedMesh::VERTICES_PER_TRIANGLE * triangle_index];
+            for (uint32_t corner_index = 0; corner_index < IndexedMesh::VERTICES_PER_TRIANGLE; ++corner_index)
+            {
+                if (vertex_indices[corner_index] != vertex_index)
+                {
+                    neighbor_vertex_indices.push_back(vertex_indices[corner_index]);
+                }
+            }
+        }
+        std::sort(neighbor_vertex_indices.begin(), neighbor_vertex_indices.end());
+        neighbor_vertex_indices.erase(std::unique(neighbor_vertex_indices.begin(), neighbor_vertex_indices.end()), neighbor_vertex_indices.end());
+    }
+
+    /// Builds a mesh from the remaining triangles.
+    /// Triangles stay in their original order so that material ranges stay as coalesced as in the original mesh.
+    /// @return The simplified mesh.
+    IndexedMesh MeshSimplifier::BuildSimplifiedMesh() const
+    {
+        IndexedMesh simplified_mesh;
+        simplified_mesh.Materials = SourceMesh->Materials;
+        simplified_mesh.Indices.reserve(IndexedMesh::VERTICES_PER_TRIANGLE * RemainingTriangleCount);
+
+        constexpr uint32_t NOT_YET_ADDED = UINT32_MAX;
+        std::vector<uint32_t> new_vertex_indices(SourceMesh->VertexCount(), NOT_YET_ADDED);
+        for (uint32_t triangle_index = 0; triangle_index < SourceMesh->TriangleCount(); ++triangle_index)
+        {
+            if (TrianglesRemoved[triangle_index])
+            {
+                continue;
+            }
+
+            // ADD THE TRIANGLE'S VERTICES THE FIRST TIME THEY'RE USED.
+            const uint32_t* vertex_indices = &Indices[IndexedMesh::VERTICES_PER_TRIANGLE * triangle_index];
+            for (uint32_t corner_index = 0; corner_index < IndexedMesh::VERTICES_PER_TRIANGLE; ++corner_index)
+            {
+                uint32_t vertex_index = vertex_indices[corner_index];
+                uint32_t& new_vertex_index = new_vertex_indices[vertex_index];
+                if (NOT_YET_ADDED == new_vertex_index)
+                {
+                    new_vertex_index = simplified_mesh.VertexCount();
+                    simplified_mesh.Positions.push_back(SourceMesh->Positions[vertex_index]);
+                    simplified_mesh.Normals.push_back(SourceMesh->Normals[vertex_index]);
+                    simplified_mesh.TextureCoordinates.push_back(SourceMesh->TextureCoordinates[vertex_index]);
+                    simplified_mesh.Colors.push_back(SourceMesh->Colors[vertex_index]);
+                }
+                simplified_mesh.Indices.push_back(new_vertex_index);
+            }
+
+            simplified_mesh.AssignTriangleMaterial(simplified_mesh.TriangleCount() - 1, TriangleMaterialIds[triangle_index]);
+        }
+
+        return simplified_mesh;
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Math/Vector3.h"
+#include "Rendering/IndexedMesh.h"
+
+namespace RENDERING
+{
+    /// Reduces the number of triangles in a mesh while keeping its shape as close as possible to the original.
+    ///
+    /// This uses quadric error metric simplification: each vertex accumulates the planes of the triangles around it
+    /// into a quadric, whose value at a point is the (area-weighted) sum of squared distances from the point to those planes.
+    /// Edges are then collapsed cheapest-first, where the cost of moving one vertex onto another is their combined
+    /// quadric evaluated at the remaining vertex.
+    ///
+    /// Vertices are only ever collapsed onto existing vertices (half-edge collapses), so every remaining vertex keeps
+    /// its original attributes and simplified meshes can share the original mesh's material table.  Vertices on open
+    /// borders, on seams (which are borders too since vertices with differing normals or texture coordinates aren't merged),
+    /// and between materials never move, so simplification doesn't open cracks or smear materials into each other.
+    class MeshSimplifier
+    {
+    public:
+        // SIMPLIFICATION.
+        static IndexedMesh Simplify(const IndexedMesh& mesh, const uint32_t target_triangle_count);
+
+    private:
+        /// A symmetric 4x4 matrix for computing the sum of squared distances from a point to a set of planes.
+        /// Only the 10 unique elements are stored.  Double precision is used since sums over many tiny triangles
+        /// quickly lose precision in single precision.
+        struct Quadric
+        {
+            /// The unique elements of the matrix, row by row from the diagonal.
+            double Elements[10] = {};
+
+            void AddPlane(const double normal_x, const double normal_y, const double normal_z, const double offset, const double weight);
+            void Add(const Quadric& other);
+            double Evaluate(const MATH::Vector3f& point) const;
+        };
+
+        /// A candidate for moving one vertex onto another, removing the triangles that shared the edge between them.
+        struct EdgeCollapse
+        {
+            /// The error introduced by the collapse.
+            double Cost = 0.0;
+            /// The vertex that gets removed.
+            uint32_t FromVertexIndex = 0;
+            /// The vertex that remains.
+            uint32_t ToVertexIndex = 0;
+            /// The version of the removed vertex when the cost was computed.
+            uint32_t FromVertexVersion = 0;
+            /// The version of the remaining vertex when the cost was computed.
+            uint32_t ToVertexVersion = 0;
+
+            bool operator>(const EdgeCollapse& other) const;
+        };
+
+        // CONSTRUCTION.
+        explicit MeshSimplifier(const IndexedMesh& mesh);
+
+        // HELPER METHODS.
+        void BuildAdjacency();
+        void LockBorderVertices();
+        void ComputeQuadrics();
+        void QueueAllCollapses();
+        void QueueCollapses(const uint32_t first_vertex_index, const uint32_t second_vertex_index);
+        void QueueOppositeCollapse(const EdgeCollapse& rejected_collapse);
+        EdgeCollapse CreateCollapse(const uint32_t from_vertex_index, const uint32_t to_vertex_index) const;
+        void QueueCollapse(const EdgeCollapse& collapse);
+        void RemoveOutdatedCollapses();
+        bool CollapseOutdated(const EdgeCollapse& collapse) const;
+        void CollapseEdges(const uint32_t target_triangle_count);
+        bool CollapseAllowed(const uint32_t from_vertex_index, const uint32_t to_vertex_index);
+        void Collapse(const uint32_t from_vertex_index, const uint32_t to_vertex_index);
+        void FindNeighbors(const uint32_t vertex_index, std::vector<uint32_t>& neighbor_vertex_indices) const;
+        IndexedMesh BuildSimplifiedMesh() const;
+
+        // PRIVATE MEMBER VARIABLES.
+        /// The mesh being simplified.
+        const IndexedMesh* SourceMesh = nullptr;
+        /// The vertex indices of each triangle, updated as edges collapse.
+        std::vector<uint32_t> Indices = {};
+        /// The material ID of each triangle.
+        std::vector<uint32_t> TriangleMaterialIds = {};
+        /// Whether each triangle has been removed by a collapse.
+        std::vector<uint8_t> TrianglesRemoved = {};
+        /// The number of triangles that haven't been removed.
+        uint32_t RemainingTriangleCount = 0;
+        /// The triangles using each vertex.  May include removed triangles, which are skipped.
+        std::vector<std::vector<uint32_t>> TriangleIndicesByVertex = {};
+        /// The quadric for each vertex.
+        std::vector<Quadric> Quadrics = {};
+        /// Whether each vertex must stay where it is.
+        std::vector<uint8_t> VerticesLocked = {};
+        /// Whether each vertex has been removed by a collapse.
+        std::vector<uint8_t> VerticesRemoved = {};
+        /// Incremented whenever a vertex's quadric or triangles change, so that queued collapses computed
+        /// before the change can be recognized as outdated.
+        std::vector<uint32_t> VertexVersions = {};
+        /// The candidate collapses, as a heap with the cheapest first.  Kept as a plain vector rather than
+        /// a priority queue so that outdated collapses can be removed instead of growing its memory.
+        std::vector<EdgeCollapse> Collapses = {};
+        /// Scratch memory for the neighbors of a collapse's removed vertex.
+        std::vector<uint32_t> FromNeighborVertexIndices = {};
+        /// Scratch memory for the neighbors of a collapse's remaining vertex.
+        std::vector<uint32_t> ToNeighborVertexIndices = {};
+    };
+}
@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include "Rendering/MipmappedTexture.h"
+#include "Rendering/PackedColor.h"
+
+namespace RENDERING
+{
+    /// The number of texels in a single block.
+    constexpr unsigned int TEXELS_PER_BLOCK = MipmappedTexture::BLOCK_SIZE_IN_TEXELS * MipmappedTexture::BLOCK_SIZE_IN_TEXELS;
+
+    /// Gets a single 8-bit component of a packed color.
+    /// @param[in]  packed_color - The packed color.
+    /// @param[in]  shift - The bit position of the component.
+    /// @return The component value.
+    static uint32_t PackedComponent(const uint32_t packed_color, const uint32_t shift)
+    {
+        return (packed_color >> shift) & 0xFF;
+    }
+
+    /// Generates a mipmapped texture from a bitmap.
+    /// @param[in]  texture - The full-size texture.
+    /// @return The mipmapped texture.  Empty if the texture has no pixels.
+    MipmappedTexture MipmappedTexture::Generate(const GRAPHICS::IMAGES::Bitmap& texture)
+    {
+        MipmappedTexture mipmapped_texture;
+        unsigned int width_in_texels = texture.GetWidthInPixels();
+        unsigned int height_in_texels = texture.GetHeightInPixels();
+        if (width_in_texels <= 0 || height_in_texels <= 0)
+        {
+            return mipmapped_texture;
+        }
+
+        // COPY THE FULL-SIZE TEXTURE INTO BLOCKS.
+        Level& full_size_level = mipmapped_texture.Levels.emplace_back(CreateLevel(width_in_texels, height_in_texels));
+        for (unsigned int y = 0; y < height_in_texels; ++y)
+        {
+            for (unsigned int x = 0; x < width_in_texels; ++x)
+            {
+                full_size_level.SetTexel(x, y, PackedColor::FromColor(texture.GetPixel(x, y)));
+            }
+        }
+
+        // GENERATE SMALLER LEVELS UNTIL REACHING A SINGLE TEXEL.
+        while (mipmapped_texture.Levels.back().WidthInTexels > 1 || mipmapped_texture.Levels.back().HeightInTexels > 1)
+        {
+            Level smaller_level = Downsample(mipmapped_texture.Levels.back());
+            mipmapped_texture.Levels.emplace_back(std::move(smaller_level));
+        }
+
+        return mipmapped_texture;
+    }
+
+    /// Samples the texture with trilinear filtering, wrapping texture coordinates.
+    /// @param[in]  texture_coordinates - The texture coordinates to sample at.
+    /// @param[in]  texture_coordinate_footprint - The approximate width in texture coordinates covered by the pixel
+    ///     being shaded, which selects the mipmap levels to blend between.  0 samples only the full-size level.
+    /// @return The filtered color.
+    GRAPHICS::Color MipmappedTexture::Sample(const MATH::Vector2f& texture_coordinates, const float texture_coordinate_footprint) const
+    {
+        if (Levels.empty())
+        {
+            return GRAPHICS::Color::WHITE;
+        }
+
+        // DETERMINE THE LEVEL OF DETAIL.
+        // This is how many times the texture would need to be halved for one texel to cover the pixel.
+        const Level& full_size_level = Levels.front();
+        float footprint_in_texels = texture_coordinate_footprint * static_cast<float>(std::max(full_size_level.WidthInTexels, full_size_level.HeightInTexels));
+        constexpr float MIN_MINIFIED_FOOTPRINT_IN_TEXELS = 1.0f;
+        if (!(footprint_in_texels > MIN_MINIFIED_FOOTPRINT_IN_TEXELS))
+        {
+            // The texture is magnified, so only the full-size level has enough detail.
+            return SampleBilinear(full_size_level, texture_coordinates);
+        }
+        float max_level_of_detail = static_cast<float>(Levels.size() - 1);
+        float level_of_detail = std::min(std::log2(footprint_in_texels), max_level_of_detail);
+
+        // BLEND BETWEEN THE TWO NEAREST LEVELS.
+        std::size_t detailed_level_index = static_cast<std::size_t>(level_of_detail);
+        std::size_t coarse_level_index = std::min(detailed_level_index + 1, Levels.size() - 1);
+        float coarse_proportion = level_of_detail - static_cast<float>(detailed_level_index);
+        GRAPHICS::Color detailed_color = SampleBilinear(Levels[detailed_level_index], texture_coordinates);
+        if (detailed_level_index == coarse_level_index || coarse_proportion <= 0.0f)
+        {
+            return detailed_color;
+        }
+        GRAPHICS::Color coarse_color = SampleBilinear(Levels[coarse_level_index], texture_coordinates);
+        float detailed_proportion = 1.0f - coarse_proportion;
+        return GRAPHICS::Color(
+            detailed_proportion * detailed_color.Red + coarse_proportion * coarse_color.Red,
+            detailed_proportion * detailed_color.Green + coarse_proportion * coarse_color.Green,
+            detailed_proportion * detailed_color.Blue + coarse_proportion * coarse_color.Blue,
+            detailed_proportion * detailed_color.Alpha + coarse_proportion * coarse_color.Alpha);
+    }
+
+    /// Gets the number of mipmap levels.
+    /// @return The number of levels; 0 if the texture is empty.
+    std::size_t MipmappedTexture::LevelCount() const
+    {
+        return Levels.size();
+    }
+
+    /// Gets the memory used by texels of all levels.
+    /// @return The size of the texture.
+    std::size_t MipmappedTexture::SizeInBytes() const
+    {
+        std::size_t size_in_bytes = 0;
+        for (const Level& level : Levels)
+        {
+            size_in_bytes += level.Texels.size() * sizeof(uint32_t);
+        }
+        return size_in_bytes;
+    }
+
+    /// Gets a texel from the level.
+    /// @param[in]  x - The column of the texel.
+    /// @param[in]  y - The row of the texel.
+    /// @return The packed color of the texel.
+    uint32_t MipmappedTexture::Level::Texel(const unsigned int x, const unsigned int y) const
+    {
+        std::size_t block_index = static_cast<std::size_t>(y / BLOCK_SIZE_IN_TEXELS) * BlocksPerRow + (x / BLOCK_SIZE_IN_TEXELS);
+        std::size_t texel_index = block_index * TEXELS_PER_BLOCK + (y % BLOCK_SIZE_IN_TEXELS) * BLOCK_SIZE_IN_TEXELS + (x % BLOCK_SIZE_IN_TEXELS);
+        return Texels[texel_index];
+    }
+
+    /// Sets a texel in the level.
+    /// @param[in]  x - The column of the texel.
+    /// @param[in]  y - The row of the texel.
+    /// @param[in]  packed_color - The packed color of the texel.
+    void MipmappedTexture::Level::SetTexel(const unsigned int x, const unsigned int y, const uint32_t packed_color)
+    {
+        std::size_t block_index = static_cast<std::size_t>(y / BLOCK_SIZE_IN_TEXELS) * BlocksPerRow + (x / BLOCK_SIZE_IN_TEXELS);
+        std::size_t texel_index = block_index * TEXELS_PER_BLOCK + (y % BLOCK_SIZE_IN_TEXELS) * BLOCK_SIZE_IN_TEXELS + (x % BLOCK_SIZE_IN_TEXELS);
+        Texels[texel_index] = packed_color;
+    }
+
+    /// Creates an empty level with space for all texels.
+    /// @param[in]  width_in_texels - The width of the level.
+    /// @param[in]  height_in_texels - The height of the level.
+    /// @return The level.
+    MipmappedTexture::Level MipmappedTexture::CreateLevel(const unsigned int width_in_texels, const unsigned int height_in_texels)
+    {
+        Level level;
+        level.WidthInTexels = width_in_texels;
+        level.HeightInTexels = height_in_texels;
+        level.BlocksPerRow = (width_in_texels + BLOCK_SIZE_IN_TEXELS - 1) / BLOCK_SIZE_IN_TEXELS;
+        unsigned int block_row_count = (height_in_texels + BLOCK_SIZE_IN_TEXELS - 1) / BLOCK_SIZE_IN_TEXELS;
+        level.Texels.resize(static_cast<std::size_t>(level.BlocksPerRow) * block_row_count * TEXELS_PER_BLOCK);
+        return level;
+    }
+
+    /// Creates the next smaller level by averaging each 2x2 group of texels.
+    /// @param[in]  source_level - The level to downsample.
+    /// @return The half-size level.
+    MipmappedTexture::Level MipmappedTexture::Downsample(const Level& source_level)
+    {
+        unsigned int width_in_texels = std::max(source_level.WidthInTexels / 2, 1u);
+        unsigned int height_in_texels = std::max(source_level.HeightInTexels / 2, 1u);
+        Level level = CreateLevel(width_in_texels, height_in_texels);
+        for (unsigned int y = 0; y < height_in_texels; ++y)
+        {
+            // Odd source dimensions just drop the last row or column, except for 1-texel dimensions which are reused.
+            unsigned int top_source_y = std::min(2 * y, source_level.HeightInTexels - 1);
+            unsigned int bottom_source_y = std::min(2 * y + 1, source_level.HeightInTexels - 1);
+            for (unsigned int x = 0; x < width_in_texels; ++x)
+            {
+                unsigned int left_source_x = std::min(2 * x, source_level.WidthInTexels - 1);
+                unsigned int right_source_x = std::min(2 * x + 1, source_level.WidthInTexels - 1);
+                uint32_t source_texels[] =
+                {
+                    source_level.Texel(left_source_x, top_source_y),
+                    source_level.Texel(right_source_x, top_source_y),
+                    source_level.Texel(left_source_x, bottom_source_y),
+                    source_level.Texel(right_source_x, bottom_source_y),
+                };
+
+                // AVERAGE EACH COMPONENT, ROUNDING TO THE NEAREST VALUE.
+                uint32_t packed_color = 0;
+                constexpr uint32_t COMPONENT_SHIFTS[] = { 24, 16, 8, 0 };
+                for (uint32_t shift : COMPONENT_SHIFTS)
+                {
+                    uint32_t component_sum = 0;
+                    for (uint32_t source_texel : source_texels)
+                    {
+                        component_sum += PackedComponent(source_texel, shift);
+                    }
+                    constexpr uint32_t ROUNDING_OFFSET = 2;
+                    uint32_t average_component = (component_sum + ROUNDING_OFFSET) / 4;
+                    packed_color |= (average_component << shift);
+                }
+                level.SetTexel(x, y, packed_color);
+            }
+        }
+        return level;
+    }
+
+    /// Samples a single level with bilinear filtering, wrapping texture coordinates.
+    /// @param[in]  level - The level to sample.
+    /// @param[in]  texture_coordinates - The texture coordinates to sample at.
+    /// @return The filtered color.
+    GRAPHICS::Color MipmappedTexture::SampleBilinear(const Level& level, const MATH::Vector2f& texture_coordinates)
+    {
+        // FIND THE 2x2 TEXELS SURROUNDING THE SAMPLE POSITION.
+        // Texel centers are at half-texel offsets, and texels on opposite edges wrap around to each other.
+        float wrapped_u = texture_coordinates.X - std::floor(texture_coordinates.X);
+        float wrapped_v = texture_coordinates.Y - std::floor(texture_coordinates.Y);
+        constexpr float TEXEL_CENTER_OFFSET = 0.5f;
+        float texel_x = wrapped_u * static_cast<float>(level.WidthInTexels) - TEXEL_CENTER_OFFSET;
+        float texel_y = wrapped_v * static_cast<float>(level.HeightInTexels) - TEXEL_CENTER_OFFSET;
+        float left_texel_x = std::floor(texel_x);
+        float top_texel_y = std::floor(texel_y);
+        float right_proportion = texel_x - left_texel_x;
+        float bottom_proportion = texel_y - top_texel_y;
+
+        int width_in_texels = static_cast<int>(level.WidthInTexels);
+        int height_in_texels = static_cast<int>(level.HeightInTexels);
+        unsigned int left_x = static_cast<unsigned int>((static_cast<int>(left_texel_x) + width_in_texels) % width_in_texels);
+        unsigned int top_y = static_cast<unsigned int>((static_cast<int>(top_texel_y) + height_in_texels) % height_in_texels);
+        unsigned int right_x = (left_x + 1) % level.WidthInTexels;
+        unsigned int bottom_y = (top_y + 1) % level.HeightInTexels;
+        uint32_t top_left = level.Texel(left_x, top_y);
+        uint32_t top_right = level.Texel(right_x, top_y);
+        uint32_t bottom_left = level.Texel(left_x, bottom_y);
+        uint32_t bottom_right = level.Texel(right_x, bottom_y);
+
+        // BLEND THE TEXELS.
+        float top_left_weight = (1.0f - right_proportion) * (1.0f - bottom_proportion);
+        float top_right_weight = right_proportion * (1.0f - bottom_proportion);
+        float bottom_left_weight = (1.0f - right_proportion) * bottom_proportion;
+        float bottom_right_weight = right_proportion * bottom_proportion;
+        auto blend_component = [&](const uint32_t shift)
+        {
+            constexpr float MAX_COMPONENT_VALUE = 255.0f;
+            float blended_component =
+                top_left_weight * static_cast<float>(PackedComponent(top_left, shift)) +
+                top_right_weight * static_cast<float>(PackedComponent(top_right, shift)) +
+                bottom_left_weight * static_cast<float>(PackedComponent(bottom_left, shift)) +
+                bottom_right_weight * static_cast<float>(PackedComponent(bottom_right, shift));
+            return blended_component / MAX_COMPONENT_VALUE;
+        };
+        return GRAPHICS::Color(blend_component(16), blend_component(8), blend_component(0), blend_component(24));
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Graphics/Color.h"
+#include "Graphics/Images/Bitmap.h"
+#include "Math/Vector2.h"
+
+namespace RENDERING
+{
+    /// A texture prepared for filtered sampling by the CPU rendering paths.
+    ///
+    /// A chain of successively half-sized copies (mipmap levels) is generated once up front so that surfaces
+    /// covering few pixels can sample a smaller level instead of skipping over most texels, which both avoids
+    /// aliasing and keeps the texels touched by nearby pixels close together in memory.
+    ///
+    /// Each level is stored in 4x4 blocks of texels, with each block's 16 texels contiguous, rather than
+    /// row by row.  A block is exactly 64 bytes (a typical cache line), so the 2x2 texels read for bilinear
+    /// filtering are usually in a single cache line no matter which direction a surface is sampled along.
+    ///
+    /// Textures are immutable once generated, so they may be sampled from any number of threads at once.
+    class MipmappedTexture
+    {
+    public:
+        /// The width and height of the square blocks that texels are stored in.
+        static constexpr unsigned int BLOCK_SIZE_IN_TEXELS = 4;
+
+        // CREATION.
+        static MipmappedTexture Generate(const GRAPHICS::IMAGES::Bitmap& texture);
+
+        // SAMPLING.
+        GRAPHICS::Color Sample(const MATH::Vector2f& texture_coordinates, const float texture_coordinate_footprint) const;
+
+        // QUERIES.
+        std::size_t LevelCount() const;
+        std::size_t SizeInBytes() const;
+
+    private:
+        /// A single mipmap level.
+        struct Level
+        {
+            /// The width of the level.
+            unsigned int WidthInTexels = 0;
+            /// The height of the level.
+            unsigned int HeightInTexels = 0;
+            /// The number of blocks in each row of blocks.
+            unsigned int BlocksPerRow = 0;
+            /// The texels in 4x4 blocks, packed as 0xAARRGGBB.  Blocks at the right and bottom edges are padded.
+            std::vector<uint32_t> Texels = {};
+
+            uint32_t Texel(const unsigned int x, const unsigned int y) const;
+            void SetTexel(const unsigned int x, const unsigned int y, const uint32_t packed_color);
+        };
+
+        // HELPER METHODS.
+        static Level CreateLevel(const unsigned int width_in_texels, const unsigned int height_in_texels);
+        static Level Downsample(const Level& source_level);
+        static GRAPHICS::Color SampleBilinear(const Level& level, const MATH::Vector2f& texture_coordinates);
+
+        // PRIVATE MEMBER VARIABLES.
+        /// The mipmap levels, from full size down to 1x1.
+        std::vector<Level> Levels = {};
+    };
+}
@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "Profiling/TraceRecorder.h"
+#include "Rendering/AffineTransform.h"
+#include "Rendering/ObjectFrustumCuller.h"
+
+namespace RENDERING
+{
+    /// Marks all cached object bounds as needing to be recomputed on the next update.
+    /// This must be called when geometry is edited in place.  Added, removed, or replaced objects are detected automatically.
+    void ObjectFrustumCuller::Invalidate()
+    {
+        RebuildNeeded = true;
+    }
+
+    /// Hides the meshes of all objects entirely outside the camera's view, so that rendering the scene skips them.
+    /// ShowHiddenObjects() must be called after rendering to restore the scene.
+    /// @param[in,out]  scene - The scene to cull objects in.
+    /// @param[in]  camera - The camera the scene will be rendered through.
+    /// @param[in]  width_in_pixels - The width of the image that will be rendered.
+    /// @param[in]  height_in_pixels - The height of the image that will be rendered.
+    /// @param[in]  frustum_culling - True to cull objects; false to just count them.
+    void ObjectFrustumCuller::HideObjectsOutsideFrustum(
+        GRAPHICS::Scene& scene,
+        const GRAPHICS::VIEWING::Camera& camera,
+        const unsigned int width_in_pixels,
+        const unsigned int height_in_pixels,
+        const bool frustum_culling)
+    {
+        PROFILING::TraceScope cull_scope("Cull Objects", "Rasterization");
+
+        Statistics = {};
+        Statistics.ObjectCount = scene.Objects.size();
+        HiddenMeshes.clear();
+        bool view_valid = (width_in_pixels > 0) && (height_in_pixels > 0);
+        if (!frustum_culling || !view_valid)
+        {
+            return;
+        }
+
+        // HIDE EACH OBJECT OUTSIDE THE VIEW.
+        UpdateObjectBounds(scene);
+        ViewFrustum frustum = ComputeFrustum(camera, width_in_pixels, height_in_pixels);
+        for (std::size_t object_index = 0; object_index < scene.Objects.size(); ++object_index)
+        {
+            // SKIP OBJECTS THAT MAY BE VISIBLE.
+            // Objects without any triangles have nothing to hide.
+            GRAPHICS::Object3D& object = scene.Objects[object_index];
+            const BoundingBox& mesh_bounds = Objects[object_index].MeshBounds;
+            if (mesh_bounds.IsEmpty())
+            {
+                continue;
+            }
+            AffineTransform world_transform = AffineTransform::FromMatrix(object.WorldTransform());
+            bool outside_frustum = frustum.Excludes(mesh_bounds.Transform(world_transform));
+            if (!outside_frustum)
+            {
+                continue;
+            }
+
+            // HIDE THE OBJECT'S MESHES.
+            // Only meshes that were visible are hidden so that restoring them doesn't show meshes the user hid.
+            ++Statistics.ObjectsOutsideFrustum;
+            for (auto& [mesh_name, mesh] : object.Model.MeshesByName)
+            {
+                if (mesh.Visible)
+                {
+                    mesh.Visible = false;
+                    HiddenMeshes.push_back(&mesh);
+                }
+            }
+        }
+    }
+
+    /// Shows all meshes hidden by the most recent culling, restoring the scene to how it was before.
+    void ObjectFrustumCuller::ShowHiddenObjects()
+    {
+        for (GRAPHICS::Mesh* mesh : HiddenMeshes)
+        {
+            mesh->Visible = true;
+        }
+        HiddenMeshes.clear();
+    }
+
+    /// Updates the cached bounds of objects in the scene.
+    /// Bounds are only recomputed if they were invalidated or the set of objects changed.
+    /// @param[in]  scene - The scene to update bounds for.
+    void ObjectFrustumCuller::UpdateObjectBounds(const GRAPHICS::Scene& scene)
+    {
+        // DETERMINE IF THE SET OF OBJECTS CHANGED.
+        bool objects_changed = RebuildNeeded || (Objects.size() != scene.Objects.size());
+        for (std::size_t object_index = 0; !objects_changed && object_index < scene.Objects.size(); ++object_index)
+        {
+            objects_changed = (Objects[object_index].SourceObject != &scene.Objects[object_index]);
+        }
+        if (!objects_changed)
+        {
+            return;
+        }
+
+        // RECOMPUTE THE BOUNDS OF ALL OBJECTS.
+        PROFILING::TraceScope bounds_scope("Compute Object Bounds", "Rasterization");
+        Objects.resize(scene.Objects.size());
+        for (std::size_t object_index = 0; object_index < scene.Objects.size(); ++object_index)
+        {
+            const GRAPHICS::Object3D& object = scene.Objects[object_index];
+            ObjectBounds& object_bounds = Objects[object_index];
+            object_bounds.SourceObject = &object;
+            object_bounds.MeshBounds = BoundingBox();
+            for (const auto& [mesh_name, mesh] : object.Model.MeshesByName)
+            {
+                for (const GRAPHICS::GEOMETRY::Triangle& triangle : mesh.Triangles)
+                {
+                    for (const GRAPHICS::VertexWithAttributes& vertex : triangle.Vertices)
+                    {
+                        object_bounds.MeshBounds.Expand(vertex.Position);
+                    }
+                }
+            }
+        }
+        RebuildNeeded = false;
+    }
+
+    /// Computes the region visible through a camera.
+    /// The frustum uses the same field of view and aspect ratio as the rasterizers but doesn't stop at the near or far planes,
+    /// so that no object the graphics library might still draw is ever culled.
+    /// @param[in]  camera - The camera to compute the frustum for.
+    /// @param[in]  width_in_pixels - The width of the image being rendered.
+    /// @param[in]  height_in_pixels - The height of the image being rendered.
+    /// @return The view frustum.
+    ViewFrustum ObjectFrustumCuller::ComputeFrustum(
+        const GRAPHICS::VIEWING::Camera& camera,
+        const unsigned int width_in_pixels,
+        const unsigned int height_in_pixels)
+    {
+        // COMPUTE THE VIEWING PLANE EXTENTS.
+        float aspect_ratio = static_cast<float>(width_in_pixels) / static_cast<float>(std::max(height_in_pixels, 1u));
+        bool perspective = (GRAPHICS::VIEWING::ProjectionType::PERSPECTIVE == camera.Projection);
+        float half_height = 0.0f;
+        if (perspective)
+        {
+            constexpr float PI = 3.14159265358979f;
+            float field_of_view_in_radians = camera.FieldOfView.Value * PI / 180.0f;
+            half_height = std::tan(field_of_view_in_radians / 2.0f);
+        }
+        else
+        {
+            constexpr float DEFAULT_VIEWING_PLANE_HEIGHT = 2.0f;
+            float viewing_plane_height = (camera.ViewingPlane.Height > 0.0f) ? camera.ViewingPlane.Height : DEFAULT_VIEWING_PLANE_HEIGHT;
+            half_height = viewing_plane_height / 2.0f;
+        }
+        float half_width = half_height * aspect_ratio;
+
+        // CREATE THE FRUSTUM.
+        constexpr float NEAR_DISTANCE = 0.0f;
+        constexpr float FAR_DISTANCE = std::numeric_limits<float>::infinity();
+        ViewFrustum frustum = ViewFrustum::Create(
+            camera.WorldPosition,
+            MATH::Vector3f::Normalize(camera.CoordinateFrame.Right),
+            MATH::Vector3f::Normalize(camera.CoordinateFrame.Up),
+            MATH::Vector3f::Normalize(camera.CoordinateFrame.Forward),
+            perspective,
+            half_width,
+            half_height,
+            NEAR_DISTANCE,
+            FAR_DISTANCE);
+        return frustum;
+    }
+}
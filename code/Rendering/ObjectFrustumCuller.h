@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+#include "Graphics/Mesh.h"
+#include "Graphics/Object3D.h"
+#include "Graphics/Scene.h"
+#include "Graphics/Viewing/Camera.h"
+#include "Rendering/BoundingBox.h"
+#include "Rendering/ViewFrustum.h"
+
+namespace RENDERING
+{
+    /// Culls entire objects outside the view frustum before a scene is handed to a renderer that doesn't cull them itself,
+    /// namely the graphics library's rasterizer.
+    ///
+    /// The graphics library only renders whole scenes, so culled objects are temporarily hidden by marking their meshes
+    /// invisible (which the library already respects) and shown again right after rendering.  Objects stay in place
+    /// in the scene, so nothing tracking them by address is disturbed.
+    ///
+    /// Bounds of each object's meshes are cached in object space, so they're only recomputed when the set of objects changes
+    /// or geometry is edited in place, which must be reported via Invalidate().
+    class ObjectFrustumCuller
+    {
+    public:
+        // UPDATING.
+        void Invalidate();
+
+        // CULLING.
+        void HideObjectsOutsideFrustum(
+            GRAPHICS::Scene& scene,
+            const GRAPHICS::VIEWING::Camera& camera,
+            const unsigned int width_in_pixels,
+            const unsigned int height_in_pixels,
+            const bool frustum_culling);
+        void ShowHiddenObjects();
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// Counts of objects culled in the most recent frame.
+        CullingStatistics Statistics = {};
+
+    private:
+        /// The cached bounds of a single object.
+        struct ObjectBounds
+        {
+            /// The object the bounds were computed for.
+            const GRAPHICS::Object3D* SourceObject = nullptr;
+            /// The bounds of all of the object's meshes, in object space.
+            /// Hidden meshes are included so that toggling visibility doesn't require recomputing bounds.
+            BoundingBox MeshBounds = {};
+        };
+
+        // HELPER METHODS.
+        void UpdateObjectBounds(const GRAPHICS::Scene& scene);
+        static ViewFrustum ComputeFrustum(
+            const GRAPHICS::VIEWING::Camera& camera,
+            const unsigned int width_in_pixels,
+            const unsigned int height_in_pixels);
+
+        // PRIVATE MEMBER VARIABLES.
+        /// True if all cached bounds must be recomputed on the next update, such as after geometry is edited.
+        bool RebuildNeeded = true;
+        /// The bounds of each object in the scene, in the same order as the scene's objects.
+        std::vector<ObjectBounds> Objects = {};
+        /// The meshes hidden for being in objects outside the view frustum, to be shown again after rendering.
+        /// Kept between frames to reuse its memory.
+        std::vector<GRAPHICS::Mesh*> HiddenMeshes = {};
+    };
+}
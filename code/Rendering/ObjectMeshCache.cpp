@@ -0,0 +1,244 @@
+#include <cstring>
+#include "Profiling/TraceRecorder.h"
+#include "Rendering/ObjectMeshCache.h"
+
+namespace RENDERING
+{
+    /// Mixes a value into a hash a 32-bit word at a time.
+    /// @param[in]  hash - The hash to mix the value into.
+    /// @param[in]  value - The value to mix in.  Its size must be a multiple of 4 bytes.
+    /// @return The updated hash.
+    template <typename Value>
+    static uint64_t MixValueIntoHash(uint64_t hash, const Value& value)
+    {
+        static_assert(0 == sizeof(Value) % sizeof(uint32_t));
+
+        // The multiplier is from the 64-bit FNV hash.
+        constexpr uint64_t PRIME = 0x100000001b3ull;
+        constexpr std::size_t WORD_COUNT = sizeof(Value) / sizeof(uint32_t);
+        uint32_t words[WORD_COUNT] = {};
+        std::memcpy(words, &value, sizeof(Value));
+        for (uint32_t word : words)
+        {
+            hash = (hash ^ word) * PRIME;
+        }
+        return hash;
+    }
+
+    /// Gets the indexed mesh of all visible triangles in a model, only building it if it isn't already cached.
+    /// The mesh is built without holding the cache's lock, so meshes may be built on multiple threads at once.
+    /// @param[in]  model - The model whose visible triangles to get the mesh for.
+    /// @return The shared mesh.
+    std::shared_ptr<const IndexedMesh> ObjectMeshCache::FindOrBuild(const GRAPHICS::MODELING::Model& model)
+    {
+        // CHECK IF THE MESH IS ALREADY CACHED.
+        uint64_t source_hash = ComputeSourceHash(model);
+        std::size_t source_triangle_count = CountVisibleTriangles(model);
+        {
+            std::lock_guard<std::mutex> lock(CacheMutex);
+            auto cached_mesh = MeshesBySourceHash.find(source_hash);
+            if (MeshesBySourceHash.end() != cached_mesh && cached_mesh->second.SourceTriangleCount == source_triangle_count)
+            {
+                std::shared_ptr<const IndexedMesh> mesh = cached_mesh->second.Mesh.lock();
+                if (mesh)
+                {
+                    return mesh;
+                }
+            }
+        }
+
+        // BUILD THE MESH.
+        std::shared_ptr<IndexedMesh> built_mesh = std::make_shared<IndexedMesh>();
+        {
+            PROFILING::TraceScope build_scope("Build Indexed Mesh", "Rendering");
+            for (const auto& [mesh_name, mesh] : model.MeshesByName)
+            {
+                if (mesh.Visible)
+                {
+                    built_mesh->AppendTriangles(mesh.Triangles);
+                }
+            }
+        }
+
+        // CACHE THE MESH.
+        // Another thread may have built the same mesh in the meantime, in which case its mesh is shared instead.
+        std::lock_guard<std::mutex> lock(CacheMutex);
+        CachedMesh& cached_mesh = MeshesBySourceHash[source_hash];
+        std::shared_ptr<const IndexedMesh> existing_mesh = cached_mesh.Mesh.lock();
+        if (existing_mesh && cached_mesh.SourceTriangleCount == source_triangle_count)
+        {
+            return existing_mesh;
+        }
+        ForgetMeshAddressLocked(cached_mesh.MeshAddress, source_hash);
+        cached_mesh.Mesh = built_mesh;
+        cached_mesh.MeshAddress = built_mesh.get();
+        cached_mesh.SourceTriangleCount = source_triangle_count;
+        cached_mesh.LevelsOfDetail = {};
+        SourceHashesByMesh[built_mesh.get()] = source_hash;
+        RemoveExpiredLocked();
+        return built_mesh;
+    }
+
+    /// Gets the levels of detail already generated for a mesh from the cache.
+    /// @param[in]  mesh - The mesh to get levels of detail for.
+    /// @return The shared levels of detail, if generated and still in use; null otherwise.
+    std::shared_ptr<const MeshLevelsOfDetail> ObjectMeshCache::FindLevelsOfDetail(const std::shared_ptr<const IndexedMesh>& mesh)
+    {
+        std::lock_guard<std::mutex> lock(CacheMutex);
+        CachedMesh* cached_mesh = FindLocked(mesh.get());
+        if (!cached_mesh)
+        {
+            return nullptr;
+        }
+
+        return cached_mesh->LevelsOfDetail.lock();
+    }
+
+    /// Gets the levels of detail for a mesh, only generating them if they aren't already cached.
+    /// Levels are generated without holding the cache's lock, since that can take a while for large meshes.
+    /// @param[in]  mesh - The mesh to get levels of detail for.  Should be from this cache for the levels to be cached.
+    /// @param[in]  cancel_requested - If given and set while generating, generation stops early and nothing is returned.
+    /// @return The shared levels of detail; null if the mesh is too simple to need them or generation was cancelled.
+    std::shared_ptr<const MeshLevelsOfDetail> ObjectMeshCache::FindOrGenerateLevelsOfDetail(
+        const std::shared_ptr<const IndexedMesh>& mesh,
+        const std::atomic<bool>* const cancel_requested)
+    {
+        // CHECK IF THE LEVELS OF DETAIL ARE NEEDED.
+        if (!MeshLevelsOfDetail::SimplificationWorthwhile(*mesh))
+        {
+            return nullptr;
+        }
+
+        // CHECK IF THE LEVELS OF DETAIL ARE ALREADY CACHED.
+        std::shared_ptr<const MeshLevelsOfDetail> cached_levels_of_detail = FindLevelsOfDetail(mesh);
+        if (cached_levels_of_detail)
+        {
+            return cached_levels_of_detail;
+        }
+
+        // GENERATE THE LEVELS OF DETAIL.
+        std::shared_ptr<const MeshLevelsOfDetail> generated_levels_of_detail = std::make_shared<const MeshLevelsOfDetail>(
+            MeshLevelsOfDetail::Generate(*mesh, cancel_requested));
+        bool generation_cancelled = cancel_requested && cancel_requested->load(std::memory_order_relaxed);
+        if (generation_cancelled)
+        {
+            return nullptr;
+        }
+
+        // CACHE THE LEVELS OF DETAIL.
+        // Another thread may have generated them in the meantime, in which case its levels are shared instead.
+        std::lock_guard<std::mutex> lock(CacheMutex);
+        CachedMesh* cached_mesh = FindLocked(mesh.get());
+        if (!cached_mesh)
+        {
+            return generated_levels_of_detail;
+        }
+        std::shared_ptr<const MeshLevelsOfDetail> existing_levels_of_detail = cached_mesh->LevelsOfDetail.lock();
+        if (existing_levels_of_detail)
+        {
+            return existing_levels_of_detail;
+        }
+        cached_mesh->LevelsOfDetail = generated_levels_of_detail;
+        return generated_levels_of_detail;
+    }
+
+    /// Computes a hash of everything in a model's visible triangles that affects its indexed mesh.
+    /// Attributes are hashed individually rather than as raw bytes of the triangles so that padding
+    /// and material reference counts don't affect the hash.
+    /// @param[in]  model - The model to hash.
+    /// @return The hash of the model's visible triangles.
+    uint64_t ObjectMeshCache::ComputeSourceHash(const GRAPHICS::MODELING::Model& model)
+    {
+        // The offset basis is from the 64-bit FNV hash.
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (const auto& [mesh_name, mesh] : model.MeshesByName)
+        {
+            if (!mesh.Visible)
+            {
+                continue;
+            }
+
+            // Triangle counts are included so that meshes can't be confused with others split at different points.
+            hash = MixValueIntoHash(hash, static_cast<uint64_t>(mesh.Triangles.size()));
+            for (const GRAPHICS::GEOMETRY::Triangle& triangle : mesh.Triangles)
+            {
+                hash = MixValueIntoHash(hash, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(triangle.Material.get())));
+                for (const GRAPHICS::VertexWithAttributes& vertex : triangle.Vertices)
+                {
+                    hash = MixValueIntoHash(hash, vertex.Position);
+                    hash = MixValueIntoHash(hash, vertex.Normal);
+                    hash = MixValueIntoHash(hash, vertex.TextureCoordinates);
+                    hash = MixValueIntoHash(hash, vertex.Color);
+                }
+            }
+        }
+        return hash;
+    }
+
+    /// Counts the visible triangles in a model.
+    /// @param[in]  model - The model whose triangles to count.
+    /// @return The number of triangles in visible meshes.
+    std::size_t ObjectMeshCache::CountVisibleTriangles(const GRAPHICS::MODELING::Model& model)
+    {
+        std::size_t triangle_count = 0;
+        for (const auto& [mesh_name, mesh] : model.MeshesByName)
+        {
+            if (mesh.Visible)
+            {
+                triangle_count += mesh.Triangles.size();
+            }
+        }
+        return triangle_count;
+    }
+
+    /// Finds the cache entry for a mesh.  The cache's lock must be held.
+    /// @param[in]  mesh - The mesh to find, which must be kept alive by the caller.
+    /// @return The cache entry for the mesh; null if the mesh isn't from the cache.
+    ObjectMeshCache::CachedMesh* ObjectMeshCache::FindLocked(const IndexedMesh* const mesh)
+    {
+        // Since the caller keeps the mesh alive, an entry whose mesh has the same address must be for this exact mesh.
+        auto source_hash = SourceHashesByMesh.find(mesh);
+        if (SourceHashesByMesh.end() == source_hash)
+        {
+            return nullptr;
+        }
+        auto cached_mesh = MeshesBySourceHash.find(source_hash->second);
+        if (MeshesBySourceHash.end() == cached_mesh || cached_mesh->second.Mesh.lock().get() != mesh)
+        {
+            return nullptr;
+        }
+        return &cached_mesh->second;
+    }
+
+    /// Forgets the address of a freed or replaced mesh.  The cache's lock must be held.
+    /// The address is only forgotten if it still refers to the same cache entry, since a newer mesh
+    /// may have been allocated at the same address after the old one was freed.
+    /// @param[in]  mesh_address - The address of the mesh to forget; may be null.
+    /// @param[in]  source_hash - The source hash of the mesh's cache entry.
+    void ObjectMeshCache::ForgetMeshAddressLocked(const IndexedMesh* const mesh_address, const uint64_t source_hash)
+    {
+        auto mapped_source_hash = SourceHashesByMesh.find(mesh_address);
+        if (SourceHashesByMesh.end() != mapped_source_hash && mapped_source_hash->second == source_hash)
+        {
+            SourceHashesByMesh.erase(mapped_source_hash);
+        }
+    }
+
+    /// Forgets meshes that have been freed, so that entries for meshes no longer in use don't accumulate.
+    /// The cache's lock must be held.
+    void ObjectMeshCache::RemoveExpiredLocked()
+    {
+        for (auto cached_mesh = MeshesBySourceHash.begin(); MeshesBySourceHash.end() != cached_mesh;)
+        {
+            if (cached_mesh->second.Mesh.expired())
+            {
+                ForgetMeshAddressLocked(cached_mesh->second.MeshAddress, cached_mesh->first);
+                cached_mesh = MeshesBySourceHash.erase(cached_mesh);
+            }
+            else
+            {
+                ++cached_mesh;
+            }
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "Graphics/Modeling/Model.h"
+#include "Rendering/IndexedMesh.h"
+#include "Rendering/MeshLevelsOfDetail.h"
+
+namespace RENDERING
+{
+    /// A cache of indexed meshes built from models, shared by all CPU renderers so that each distinct
+    /// object mesh is only kept in memory once no matter how many renderers are using it.
+    ///
+    /// Meshes are found by a hash of the visible triangles they're built from, so a mesh built by one renderer
+    /// (or ahead of time while a model loads) is reused by any other renderer given the same model.
+    /// Materials are identified by pointer as in IndexedMesh, so the same geometry with different materials
+    /// gets a different mesh.
+    ///
+    /// Levels of detail generated for a mesh are cached along with it, so they're only generated once per mesh
+    /// no matter how many renderers or objects use it.
+    ///
+    /// The cache only holds weak references: a mesh or its levels of detail are freed as soon as nothing outside
+    /// the cache uses them.  Meshes and levels of detail handed out by the cache are shared and must not be modified.
+    ///
+    /// The cache may be used from any thread, such as while models are loaded in the background.
+    class ObjectMeshCache
+    {
+    public:
+        // MESH ACCESS.
+        static std::shared_ptr<const IndexedMesh> FindOrBuild(const GRAPHICS::MODELING::Model& model);
+        static std::shared_ptr<const MeshLevelsOfDetail> FindLevelsOfDetail(const std::shared_ptr<const IndexedMesh>& mesh);
+        static std::shared_ptr<const MeshLevelsOfDetail> FindOrGenerateLevelsOfDetail(
+            const std::shared_ptr<const IndexedMesh>& mesh,
+            const std::atomic<bool>* const cancel_requested);
+
+        // HASHING.
+        static uint64_t ComputeSourceHash(const GRAPHICS::MODELING::Model& model);
+
+    private:
+        /// A mesh held by the cache.
+        struct CachedMesh
+        {
+            /// The mesh, which may have been freed since nothing else uses it.
+            std::weak_ptr<const IndexedMesh> Mesh = {};
+            /// The address of the mesh, for forgetting it once freed.
+            const IndexedMesh* MeshAddress = nullptr;
+            /// The number of triangles the mesh was built from, to guard against hash collisions.
+            std::size_t SourceTriangleCount = 0;
+            /// The levels of detail for the mesh, if generated and still in use.
+            std::weak_ptr<const MeshLevelsOfDetail> LevelsOfDetail = {};
+        };
+
+        // HELPER METHODS.
+        static std::size_t CountVisibleTriangles(const GRAPHICS::MODELING::Model& model);
+        static CachedMesh* FindLocked(const IndexedMesh* const mesh);
+        static void ForgetMeshAddressLocked(const IndexedMesh* const mesh_address, const uint64_t source_hash);
+        static void RemoveExpiredLocked();
+
+        // PRIVATE MEMBER VARIABLES.
+        /// Protects the variables below since meshes may be requested from any thread.
+        static inline std::mutex CacheMutex = {};
+        /// Cached meshes by the hash of the triangles they were built from.
+        static inline std::unordered_map<uint64_t, CachedMesh> MeshesBySourceHash = {};
+        /// The source hashes of cached meshes by the meshes' addresses, for finding their levels of detail.
+        static inline std::unordered_map<const IndexedMesh*, uint64_t> SourceHashesByMesh = {};
+    };
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include "Graphics/Color.h"
+
+namespace RENDERING
+{
+    /// Converts colors to the packed 32-bit 0xAARRGGBB format of CPU color buffers.
+    /// The components are written directly rather than through the graphics library
+    /// since this is done for every pixel in the CPU rendering hot paths.
+    class PackedColor
+    {
+    public:
+        /// Packs a color, clamping components to the valid range.
+        /// @param[in]  color - The color to pack.
+        /// @return The packed color.
+        static uint32_t FromColor(const GRAPHICS::Color& color)
+        {
+            constexpr float MAX_COMPONENT_VALUE = 255.0f;
+            auto to_byte = [](const float component) -> uint32_t
+            {
+                float clamped_component = std::clamp(component, 0.0f, 1.0f);
+                // Adding 0.5 rounds to the nearest integer.
+                return static_cast<uint32_t>(clamped_component * MAX_COMPONENT_VALUE + 0.5f);
+            };
+
+            uint32_t packed_color =
+                (to_byte(color.Alpha) << 24) |
+                (to_byte(color.Red) << 16) |
+                (to_byte(color.Green) << 8) |
+                to_byte(color.Blue);
+            return packed_color;
+        }
+    };
+}
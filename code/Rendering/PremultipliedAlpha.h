@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+// SSE2 is used when available, which is always the case for x64.
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PREMULTIPLIED_ALPHA_SSE2 1
+#include <emmintrin.h>
+#else
+#define PREMULTIPLIED_ALPHA_SSE2 0
+#endif
+
+namespace RENDERING
+{
+    /// Blends packed 0xAARRGGBB colors using premultiplied alpha.
+    ///
+    /// Scaling by a factor in [0, 255] divides by 255 with rounding as (x + 128 + ((x + 128) >> 8)) >> 8,
+    /// which is exact for all products of two bytes.  The SSE2 versions, operating on 4 pixels at a time,
+    /// therefore produce results identical to the scalar versions.
+    class PremultipliedAlpha
+    {
+    public:
+        /// Scales each component of a color by a factor.
+        /// @param[in]  color - The color to scale.
+        /// @param[in]  factor - The factor in [0, 255], representing [0, 1].
+        /// @return The scaled color.
+        static uint32_t Scale(const uint32_t color, const uint32_t factor)
+        {
+            uint32_t scaled_color = 0;
+            for (uint32_t shift = 0; shift < 32; shift += 8)
+            {
+                uint32_t product = ((color >> shift) & 0xFF) * factor + 128;
+                uint32_t scaled_component = (product + (product >> 8)) >> 8;
+                scaled_color |= (scaled_component << shift);
+            }
+            return scaled_color;
+        }
+
+        /// Converts a color with straight alpha to premultiplied alpha.
+        /// @param[in]  straight_color - The color to convert.
+        /// @param[in]  coverage - Additional coverage in [0, 255] to multiply into the alpha (like from a font texture).
+        /// @return The premultiplied color.
+        static uint32_t Premultiply(const uint32_t straight_color, const uint32_t coverage)
+        {
+            uint32_t alpha = Scale(straight_color >> 24, coverage);
+            constexpr uint32_t OPAQUE_ALPHA = 0xFF000000;
+            return Scale(straight_color | OPAQUE_ALPHA, alpha);
+        }
+
+        /// Blends a premultiplied source color over a premultiplied destination color.
+        /// @param[in]  source - The color to blend on top.
+        /// @param[in]  destination - The color underneath.
+        /// @return The blended color.
+        static uint32_t BlendOver(const uint32_t source, const uint32_t destination)
+        {
+            uint32_t scaled_destination = Scale(destination, 255 - (source >> 24));
+            uint32_t blended_color = 0;
+            for (uint32_t shift = 0; shift < 32; shift += 8)
+            {
+                uint32_t component = std::min<uint32_t>(((scaled_destination >> shift) & 0xFF) + ((source >> shift) & 0xFF), 255);
+                blended_color |= (component << shift);
+            }
+            return blended_color;
+        }
+
+#if PREMULTIPLIED_ALPHA_SSE2
+        /// Copies the lowest byte of each 32-bit lane to all bytes in the lane.
+        /// @param[in]  values - Values in [0, 255] in each 32-bit lane.
+        /// @return The broadcast values.
+        static __m128i BroadcastLowByte(const __m128i values)
+        {
+            __m128i broadcast_values = _mm_or_si128(values, _mm_slli_epi32(values, 8));
+            return _mm_or_si128(broadcast_values, _mm_slli_epi32(broadcast_values, 16));
+        }
+
+        /// Scales each component of 4 colors by factors.
+        /// @param[in]  colors - The colors to scale.
+        /// @param[in]  factors - The factors in [0, 255] for each component of each color.
+        /// @return The scaled colors.
+        static __m128i Scale(const __m128i colors, const __m128i factors)
+        {
+            // Components are widened to 16 bits so that products don't overflow.
+            const __m128i ZERO = _mm_setzero_si128();
+            const __m128i ROUNDING = _mm_set1_epi16(128);
+            auto scale_components = [&](const __m128i components, const __m128i component_factors)
+            {
+                __m128i products = _mm_add_epi16(_mm_mullo_epi16(components, component_factors), ROUNDING);
+                return _mm_srli_epi16(_mm_add_epi16(products, _mm_srli_epi16(products, 8)), 8);
+            };
+            __m128i low_scaled = scale_components(_mm_unpacklo_epi8(colors, ZERO), _mm_unpacklo_epi8(factors, ZERO));
+            __m128i high_scaled = scale_components(_mm_unpackhi_epi8(colors, ZERO), _mm_unpackhi_epi8(factors, ZERO));
+            return _mm_packus_epi16(low_scaled, high_scaled);
+        }
+
+        /// Converts 4 colors with straight alpha to premultiplied alpha.
+        /// @param[in]  straight_colors - The colors to convert.
+        /// @param[in]  coverages - Additional coverage in [0, 255] for each color, in each 32-bit lane.
+        /// @return The premultiplied colors.
+        static __m128i Premultiply(const __m128i straight_colors, const __m128i coverages)
+        {
+            // Alphas and coverages are bytes in the low half of 32-bit lanes, so their products fit in 16 bits.
+            const __m128i ROUNDING = _mm_set1_epi32(128);
+            __m128i alphas = _mm_srli_epi32(straight_colors, 24);
+            __m128i products = _mm_add_epi16(_mm_mullo_epi16(alphas, coverages), ROUNDING);
+            __m128i covered_alphas = _mm_srli_epi16(_mm_add_epi16(products, _mm_srli_epi16(products, 8)), 8);
+
+            const __m128i OPAQUE_ALPHA = _mm_set1_epi32(static_cast<int>(0xFF000000));
+            return Scale(_mm_or_si128(straight_colors, OPAQUE_ALPHA), BroadcastLowByte(covered_alphas));
+        }
+
+        /// Blends 4 premultiplied source colors over 4 premultiplied destination colors.
+        /// @param[in]  sources - The colors to blend on top.
+        /// @param[in]  destinations - The colors underneath.
+        /// @return The blended colors.
+        static __m128i BlendOver(const __m128i sources, const __m128i destinations)
+        {
+            const __m128i ALL_ONES = _mm_set1_epi32(-1);
+            __m128i inverse_alphas = _mm_xor_si128(BroadcastLowByte(_mm_srli_epi32(sources, 24)), ALL_ONES);
+            return _mm_adds_epu8(Scale(destinations, inverse_alphas), sources);
+        }
+#endif
+    };
+}
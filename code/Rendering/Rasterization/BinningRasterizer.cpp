@@ -0,0 +1,1461 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <utility>
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "Profiling/TraceRecorder.h"
+#include "Rendering/ObjectMeshCache.h"
+#include "Rendering/PackedColor.h"
+#include "Rendering/Rasterization/BinningRasterizer.h"
+#include "Rendering/SurfaceShading.h"
+
+namespace RENDERING::RASTERIZATION
+{
+    /// The number of fractional bits in fixed-point screen positions.
+    constexpr int64_t SUBPIXEL_BITS = 8;
+    /// The number of fixed-point units per pixel.
+    constexpr int64_t SUBPIXELS_PER_PIXEL = int64_t(1) << SUBPIXEL_BITS;
+    /// The offset from a pixel's corner to its center, in fixed-point units.
+    constexpr int64_t HALF_PIXEL = SUBPIXELS_PER_PIXEL / 2;
+    /// How far geometry may extend past the center of the screen before being clipped.
+    /// This keeps fixed-point positions small enough that edge functions can't overflow,
+    /// while being large enough that almost no triangles actually need clipping at the sides of the screen.
+    constexpr float GUARD_BAND_IN_PIXELS = 16384.0f;
+    /// The closest the near plane may be for perspective projection, to avoid dividing by zero.
+    constexpr float MIN_PERSPECTIVE_NEAR_DISTANCE = 1e-3f;
+    /// The number of vertices transformed in a single task.
+    constexpr uint32_t VERTICES_PER_TASK = 16384;
+    /// The number of triangles set up in a single task.
+    constexpr uint32_t TRIANGLES_PER_TASK = 4096;
+    /// The relative amount that closenesses interpolated within a triangle may exceed its vertices' closenesses
+    /// due to rounding.  Hierarchical depth culling allows for this so that it never skips a triangle that could be visible.
+    constexpr float CLOSENESS_ROUNDING_MARGIN = 1e-5f;
+    /// The minimum distance along shadow rays for hits, to avoid surfaces shadowing themselves.
+    constexpr float SHADOW_RAY_MIN_DISTANCE = 1e-3f;
+
+    /// Divides integers, rounding down rather than towards zero.
+    /// @param[in]  dividend - The number to divide.
+    /// @param[in]  divisor - The positive number to divide by.
+    /// @return The quotient rounded down.
+    static int64_t FloorDivide(const int64_t dividend, const int64_t divisor)
+    {
+        int64_t quotient = dividend / divisor;
+        bool rounded_up = (quotient * divisor > dividend);
+        if (rounded_up)
+        {
+            --quotient;
+        }
+        return quotient;
+    }
+
+    /// Destructor.  Stops generating levels of detail and waits for the level of detail thread to finish.
+    /// Generation is checked for cancellation between levels, so this only waits for at most a single level.
+    BinningRasterizer::~BinningRasterizer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(LevelOfDetailMutex);
+            LevelOfDetailStopRequested = true;
+        }
+        LevelOfDetailJobQueued.notify_all();
+        if (LevelOfDetailThread.joinable())
+        {
+            LevelOfDetailThread.join();
+        }
+    }
+
+    /// Marks all object geometry as needing to be rebuilt on the next render.
+    /// This must be called when objects are loaded or when their geometry is edited, since such changes
+    /// can't be cheaply detected.  Transform changes are picked up automatically.
+    void BinningRasterizer::Invalidate()
+    {
+        RebuildNeeded = true;
+        ShadowScene.Invalidate();
+    }
+
+    /// Frees all object geometry, such as when switching to another renderer.
+    /// This releases the rasterizer's references to shared object meshes, so they're freed unless another renderer uses them.
+    /// Levels of detail still queued are dropped, though any being generated still finish.  Everything is rebuilt on the next render.
+    void BinningRasterizer::Release()
+    {
+        if (Objects.empty())
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(LevelOfDetailMutex);
+            LevelOfDetailJobs.clear();
+            PendingLevelsOfDetail.clear();
+        }
+        Objects = std::vector<ObjectGeometry>();
+        Materials.Clear();
+        ShadowScene.Release();
+        VertexRanges = std::vector<ObjectRange>();
+        TriangleRanges = std::vector<ObjectRange>();
+        TriangleRangeBounds = std::vector<BoundingBox>();
+        VisibleVertexRangeIndices = std::vector<uint32_t>();
+        VisibleTriangleRangeIndices = std::vector<uint32_t>();
+        TileIndicesToRender = std::vector<uint32_t>();
+        RenderedPixels = nullptr;
+        Statistics = {};
+        RebuildNeeded = true;
+    }
+
+    /// Renders the scene into the color buffer.
+    /// @param[in]  scene - The scene to render.
+    /// @param[in]  camera - The camera to render the scene through.
+    /// @param[in]  rendering_settings - The settings for what to render.
+    /// @param[in]  cpu_rendering_settings - The settings for how to split up rendering work.
+    ///     Mipmapped texture sampling doesn't apply since textures are sampled at the nearest texel like the library's rasterizer.
+    /// @param[in]  only_object_transforms_changed - True if nothing but object transforms changed since the last render
+    ///     and the color buffer still holds just that render, so only where moved objects were and are need re-rendering.
+    ///     False to render the whole screen.
+    /// @param[in,out]  thread_pool - The threads to render with.
+    /// @param[in,out]  color_buffer - The buffer to render into.
+    void BinningRasterizer::Render(
+        const GRAPHICS::Scene& scene,
+        const GRAPHICS::VIEWING::Camera& camera,
+        const GRAPHICS::RenderingSettings& rendering_settings,
+        const CpuRenderingSettings& cpu_rendering_settings,
+        const bool only_object_transforms_changed,
+        THREADING::WorkStealingThreadPool& thread_pool,
+        GRAPHICS::IMAGES::Bitmap& color_buffer)
+    {
+        // DETERMINE HOW TO SPLIT THE SCREEN INTO TILES.
+        unsigned int width_in_pixels = color_buffer.GetWidthInPixels();
+        unsigned int height_in_pixels = color_buffer.GetHeightInPixels();
+        if (width_in_pixels <= 0 || height_in_pixels <= 0)
+        {
+            return;
+        }
+        TileGrid tile_grid;
+        tile_grid.TileSizeInPixels = std::max(cpu_rendering_settings.TileSizeInPixels, 1u);
+        tile_grid.ColumnCount = (width_in_pixels + tile_grid.TileSizeInPixels - 1) / tile_grid.TileSizeInPixels;
+        tile_grid.RowCount = (height_in_pixels + tile_grid.TileSizeInPixels - 1) / tile_grid.TileSizeInPixels;
+
+        // PREPARE THE SCENE GEOMETRY.
+        // This happens after computing the projection since how detailed meshes are depends on how large they appear.
+        Projection projection = ComputeProjection(camera, width_in_pixels, height_in_pixels);
+        bool objects_rebuilt = UpdateObjectGeometry(scene, projection, cpu_rendering_settings);
+        CullGeometry(projection, cpu_rendering_settings.FrustumCulling);
+
+        // DETERMINE WHICH TILES TO RENDER.
+        // Only changed objects can be re-rendered if the rest of the color buffer still holds the last render of the same objects.
+        // Shadows from moved objects can fall anywhere, so the whole screen is rendered if they're enabled.
+        bool shadows_enabled = rendering_settings.Shading.Lighting.Enabled && rendering_settings.Shading.Lighting.ShadowsEnabled;
+        uint32_t* pixels = color_buffer.GetRawData();
+        bool previous_render_kept =
+            only_object_transforms_changed &&
+            !objects_rebuilt &&
+            (RenderedPixels == pixels) &&
+            (RenderedWidthInPixels == width_in_pixels) &&
+            (RenderedHeightInPixels == height_in_pixels);
+        bool only_changed_objects = previous_render_kept && !shadows_enabled;
+        FindTilesToRender(projection, tile_grid, only_changed_objects);
+        RenderedPixels = pixels;
+        RenderedWidthInPixels = width_in_pixels;
+        RenderedHeightInPixels = height_in_pixels;
+
+        // TRANSFORM ALL VISIBLE VERTICES IN PARALLEL.
+        {
+            PROFILING::TraceScope transform_scope("Transform Vertices", "Rasterization");
+            thread_pool.ParallelFor(VisibleVertexRangeIndices.size(), [&](const std::size_t visible_range_index, const unsigned int)
+            {
+                TransformVertices(VertexRanges[VisibleVertexRangeIndices[visible_range_index]], projection);
+            });
+        }
+
+        // SET UP AND BIN ALL VISIBLE TRIANGLES IN PARALLEL.
+        {
+            PROFILING::TraceScope setup_scope("Set Up Triangles", "Rasterization");
+            TriangleBatches.resize(VisibleTriangleRangeIndices.size());
+            thread_pool.ParallelFor(VisibleTriangleRangeIndices.size(), [&](const std::size_t visible_range_index, const unsigned int worker_index)
+            {
+                SetUpTriangles(
+                    TriangleRanges[VisibleTriangleRangeIndices[visible_range_index]],
+                    projection,
+                    rendering_settings.CullBackfaces,
+                    tile_grid,
+                    thread_pool.WorkerArena(worker_index),
+                    TriangleBatches[visible_range_index]);
+            });
+        }
+
+        // PREPARE TO TRACE SHADOW RAYS IF NEEDED.
+        // Shadows need all geometry that could block lights, not just what's in view, so nothing is culled.
+        if (shadows_enabled)
+        {
+            PROFILING::TraceScope shadow_scope("Update Shadow Scene", "Rasterization");
+            ShadowScene.Update(scene, nullptr);
+        }
+        else
+        {
+            // Its world-space copies of geometry would otherwise stay in memory until shadows are enabled again.
+            ShadowScene.Release();
+        }
+        auto test_shadow_ray = [this](
+            const MATH::Vector3f& surface_position,
+            const MATH::Vector3f& direction_to_light,
+            const float distance_to_light)
+        {
+            RAY_TRACING::Ray shadow_ray;
+            shadow_ray.Origin = surface_position;
+            shadow_ray.Direction = direction_to_light;
+            return ShadowScene.IsOccluded(shadow_ray, SHADOW_RAY_MIN_DISTANCE, distance_to_light);
+        };
+        SurfaceShading::ShadowTestFunction is_shadowed = shadows_enabled ?
+            SurfaceShading::ShadowTestFunction(test_shadow_ray) :
+            SurfaceShading::ShadowTestFunction();
+
+        // RASTERIZE THE TILES IN PARALLEL.
+        // Each worker gets its own scratch memory so that tiles can be rasterized without any synchronization.
+        TileScratches.resize(thread_pool.ThreadCount());
+        for (TileScratch& scratch : TileScratches)
+        {
+            scratch.OccludedTriangleCount = 0;
+        }
+        thread_pool.ParallelFor(TileIndicesToRender.size(), [&](const std::size_t rendered_tile_index, const unsigned int worker_index)
+        {
+            RasterizeTile(
+                TileIndicesToRender[rendered_tile_index],
+                tile_grid,
+                projection,
+                scene,
+                rendering_settings,
+                cpu_rendering_settings.HierarchicalDepthCulling,
+                is_shadowed,
+                TileScratches[worker_index],
+                pixels);
+        });
+        for (const TileScratch& scratch : TileScratches)
+        {
+            Statistics.OccludedTriangleCount += scratch.OccludedTriangleCount;
+        }
+
+        // RELEASE THE TRIANGLE BATCHES.
+        // Their memory is in the worker arenas, so they must not outlive the frame.
+        TriangleBatches.clear();
+    }
+
+    /// Updates object geometry for the scene.
+    /// Meshes are only rebuilt if geometry was invalidated or the set of objects changed,
+    /// but world transforms and levels of detail are always updated since they depend on the current frame.
+    /// @param[in]  scene - The scene to update geometry for.
+    /// @param[in]  projection - Information about the camera, for selecting levels of detail.
+    /// @param[in]  cpu_rendering_settings - The settings for whether and how to select levels of detail.
+    /// @return True if objects were rebuilt; false if only their transforms and levels of detail were updated.
+    bool BinningRasterizer::UpdateObjectGeometry(
+        const GRAPHICS::Scene& scene,
+        const Projection& projection,
+        const CpuRenderingSettings& cpu_rendering_settings)
+    {
+        // DETERMINE IF THE SET OF OBJECTS CHANGED.
+        bool object_count_changed = (Objects.size() != scene.Objects.size());
+        bool objects_changed = RebuildNeeded || object_count_changed;
+        for (std::size_t object_index = 0; !objects_changed && object_index < scene.Objects.size(); ++object_index)
+        {
+            objects_changed = (Objects[object_index].SourceObject != &scene.Objects[object_index]);
+        }
+
+        // UPDATE THE GEOMETRY FOR EACH OBJECT.
+        // Previous meshes are held onto while rebuilding so that any still used can be shared by the rebuilt objects,
+        // while meshes only used by removed or edited objects are freed afterward.
+        // The material table is also rebuilt along with objects so that it only holds materials still in the scene.
+        if (objects_changed)
+        {
+            PreviousObjectMeshes.clear();
+            for (ObjectGeometry& object_geometry : Objects)
+            {
+                PreviousObjectMeshes.push_back({ std::move(object_geometry.FullDetailMesh), std::move(object_geometry.LevelsOfDetail) });
+            }
+            Materials.Clear();
+        }
+        Objects.resize(scene.Objects.size());
+        bool rendered_meshes_changed = objects_changed;
+        for (std::size_t object_index = 0; object_index < scene.Objects.size(); ++object_index)
+        {
+            const GRAPHICS::Object3D& object = scene.Objects[object_index];
+            ObjectGeometry& object_geometry = Objects[object_index];
+            AffineTransform world_transform = AffineTransform::FromMatrix(object.WorldTransform());
+            object_geometry.Changed = objects_changed || (world_transform != object_geometry.WorldTransform);
+            object_geometry.WorldTransform = world_transform;
+            if (objects_changed)
+            {
+                // REBUILD THE OBJECT'S MESH FROM ITS VISIBLE MESHES.
+                PROFILING::TraceScope rebuild_scope("Build Object Geometry", "Rasterization");
+                object_geometry.SourceObject = &object;
+                // The mesh is shared with any other renderer using the same model, so it's usually only built once.
+                std::shared_ptr<const IndexedMesh> full_detail_mesh = ObjectMeshCache::FindOrBuild(object.Model);
+                object_geometry.MeshBounds = {};
+                for (const MATH::Vector3f& position : full_detail_mesh->Positions)
+                {
+                    object_geometry.MeshBounds.Expand(position);
+                }
+                object_geometry.FullDetailMesh = std::move(full_detail_mesh);
+                object_geometry.RenderedMesh = nullptr;
+                Materials.AddMeshMaterials(*object_geometry.FullDetailMesh, object_geometry.MaterialHandles);
+                object_geometry.LevelsOfDetail = {};
+            }
+
+            // FIND OR QUEUE GENERATING LEVELS OF DETAIL FOR THE MESH IF THEY'LL BE USED.
+            // This waits until levels of detail are enabled so that they're never generated just to go unused.
+            bool levels_of_detail_needed =
+                cpu_rendering_settings.LevelsOfDetail &&
+                !object_geometry.LevelsOfDetail.valid() &&
+                MeshLevelsOfDetail::SimplificationWorthwhile(*object_geometry.FullDetailMesh);
+            if (levels_of_detail_needed)
+            {
+                object_geometry.LevelsOfDetail = FindOrQueueLevelsOfDetail(object_geometry.FullDetailMesh);
+            }
+
+            // SELECT HOW DETAILED THE RENDERED MESH SHOULD BE.
+            const IndexedMesh& rendered_mesh = SelectLevelOfDetail(object_geometry, projection, cpu_rendering_settings);
+            if (&rendered_mesh != object_geometry.RenderedMesh)
+            {
+                // ALLOCATE SPACE FOR TRANSFORMED VERTICES.
+                object_geometry.RenderedMesh = &rendered_mesh;
+                uint32_t vertex_count = rendered_mesh.VertexCount();
+                object_geometry.WorldPositions.resize(vertex_count);
+                object_geometry.WorldNormals.resize(vertex_count);
+                object_geometry.CameraPositions.resize(vertex_count);
+                object_geometry.Changed = true;
+                rendered_meshes_changed = true;
+            }
+        }
+
+        // SPLIT THE GEOMETRY INTO TASKS IF IT CHANGED.
+        // Ranges never span objects so that each task only needs a single object's transform.
+        if (rendered_meshes_changed)
+        {
+            VertexRanges.clear();
+            TriangleRanges.clear();
+            TriangleRangeBounds.clear();
+            for (std::size_t object_index = 0; object_index < Objects.size(); ++object_index)
+            {
+                const IndexedMesh& mesh = *Objects[object_index].RenderedMesh;
+                uint32_t vertex_count = mesh.VertexCount();
+                for (uint32_t first_vertex_index = 0; first_vertex_index < vertex_count; first_vertex_index += VERTICES_PER_TASK)
+                {
+                    uint32_t range_vertex_count = std::min(VERTICES_PER_TASK, vertex_count - first_vertex_index);
+                    VertexRanges.push_back({ static_cast<uint32_t>(object_index), first_vertex_index, range_vertex_count });
+                }
+
+                uint32_t triangle_count = mesh.TriangleCount();
+                for (uint32_t first_triangle_index = 0; first_triangle_index < triangle_count; first_triangle_index += TRIANGLES_PER_TASK)
+                {
+                    uint32_t range_triangle_count = std::min(TRIANGLES_PER_TASK, triangle_count - first_triangle_index);
+                    TriangleRanges.push_back({ static_cast<uint32_t>(object_index), first_triangle_index, range_triangle_count });
+
+                    // Triangles in a range are usually near each other since meshes tend to list them that way,
+                    // which makes ranges useful clusters for culling.
+                    BoundingBox& range_bounds = TriangleRangeBounds.emplace_back();
+                    std::size_t begin_index_index = static_cast<std::size_t>(IndexedMesh::VERTICES_PER_TRIANGLE) * first_triangle_index;
+                    std::size_t end_index_index = begin_index_index + static_cast<std::size_t>(IndexedMesh::VERTICES_PER_TRIANGLE) * range_triangle_count;
+                    for (std::size_t index_index = begin_index_index; index_index < end_index_index; ++index_index)
+                    {
+                        range_bounds.Expand(mesh.Positions[mesh.Indices[index_index]]);
+                    }
+                }
+            }
+        }
+        PreviousObjectMeshes.clear();
+        RebuildNeeded = false;
+        return objects_changed;
+    }
+
+    /// Gets the levels of detail for a mesh, queuing them to be generated on the level of detail thread if needed.
+    /// Rendering never waits for them; the full detail mesh is rendered until they're ready.
+    /// @param[in]  full_detail_mesh - The mesh to get levels of detail for.
+    /// @return The levels of detail, once generated.
+    std::shared_future<std::shared_ptr<const MeshLevelsOfDetail>> BinningRasterizer::FindOrQueueLevelsOfDetail(
+        const std::shared_ptr<const IndexedMesh>& full_detail_mesh)
+    {
+        // USE ANY LEVELS OF DETAIL ALREADY GENERATED.
+        // They may have been for another object with the same mesh or before objects were last rebuilt.
+        std::shared_ptr<const MeshLevelsOfDetail> cached_levels_of_detail = ObjectMeshCache::FindLevelsOfDetail(full_detail_mesh);
+        if (cached_levels_of_detail)
+        {
+            std::promise<std::shared_ptr<const MeshLevelsOfDetail>> levels_of_detail_promise;
+            levels_of_detail_promise.set_value(std::move(cached_levels_of_detail));
+            return levels_of_detail_promise.get_future().share();
+        }
+
+        // USE ANY LEVELS OF DETAIL ALREADY BEING GENERATED.
+        std::lock_guard<std::mutex> lock(LevelOfDetailMutex);
+        auto pending_levels_of_detail = PendingLevelsOfDetail.find(full_detail_mesh.get());
+        if (PendingLevelsOfDetail.end() != pending_levels_of_detail)
+        {
+            return pending_levels_of_detail->second;
+        }
+
+        // QUEUE GENERATING THE LEVELS OF DETAIL.
+        LevelOfDetailJob& job = LevelOfDetailJobs.emplace_back();
+        job.FullDetailMesh = full_detail_mesh;
+        std::shared_future<std::shared_ptr<const MeshLevelsOfDetail>> levels_of_detail = job.LevelsOfDetail.get_future().share();
+        PendingLevelsOfDetail[full_detail_mesh.get()] = levels_of_detail;
+        if (!LevelOfDetailThread.joinable())
+        {
+            LevelOfDetailThread = std::thread(&BinningRasterizer::GenerateQueuedLevelsOfDetail, this);
+        }
+        LevelOfDetailJobQueued.notify_one();
+        return levels_of_detail;
+    }
+
+    /// Generates levels of detail for queued meshes one at a time until the rasterizer is destroyed.
+    /// Runs on the level of detail thread.  A single thread keeps generation from competing with rendering
+    /// for more than one core no matter how many meshes are loaded at once.
+    void BinningRasterizer::GenerateQueuedLevelsOfDetail()
+    {
+        while (true)
+        {
+            // WAIT FOR A JOB.
+            LevelOfDetailJob job;
+            {
+                std::unique_lock<std::mutex> lock(LevelOfDetailMutex);
+                LevelOfDetailJobQueued.wait(lock, [this]() { return LevelOfDetailStopRequested || !LevelOfDetailJobs.empty(); });
+                if (LevelOfDetailStopRequested)
+                {
+                    return;
+                }
+                job = std::move(LevelOfDetailJobs.front());
+                LevelOfDetailJobs.pop_front();
+            }
+
+            // GENERATE THE LEVELS OF DETAIL.
+            // They're cached so that other renderers or a later rebuild of this one can find them.
+            std::shared_ptr<const MeshLevelsOfDetail> levels_of_detail = nullptr;
+            try
+            {
+                levels_of_detail = ObjectMeshCache::FindOrGenerateLevelsOfDetail(job.FullDetailMesh, &LevelOfDetailStopRequested);
+            }
+            catch (...)
+            {
+                // The full detail mesh is simply always rendered if generation fails.
+                levels_of_detail = nullptr;
+            }
+            job.LevelsOfDetail.set_value(std::move(levels_of_detail));
+
+            // MARK THE JOB AS FINISHED.
+            std::lock_guard<std::mutex> lock(LevelOfDetailMutex);
+            PendingLevelsOfDetail.erase(job.FullDetailMesh.get());
+        }
+    }
+
+    /// Selects the mesh to render for an object based on how large it appears on screen.
+    /// The object's bounds are approximated by a sphere, and the number of pixels it covers by the area of its projected disc.
+    /// @param[in]  object_geometry - The object to select a mesh for.
+    /// @param[in]  projection - Information about the camera.
+    /// @param[in]  cpu_rendering_settings - The settings for whether and how to select levels of detail.
+    /// @return The full detail mesh or one of its levels of detail.
+    const IndexedMesh& BinningRasterizer::SelectLevelOfDetail(
+        const ObjectGeometry& object_geometry,
+        const Projection& projection,
+        const CpuRenderingSettings& cpu_rendering_settings)
+    {
+        // USE THE FULL DETAIL MESH IF NO LEVELS OF DETAIL ARE READY.
+        const IndexedMesh& full_detail_mesh = *object_geometry.FullDetailMesh;
+        if (!cpu_rendering_settings.LevelsOfDetail || !object_geometry.LevelsOfDetail.valid())
+        {
+            return full_detail_mesh;
+        }
+        constexpr std::chrono::seconds NO_WAITING(0);
+        bool levels_of_detail_ready = (std::future_status::ready == object_geometry.LevelsOfDetail.wait_for(NO_WAITING));
+        if (!levels_of_detail_ready)
+        {
+            return full_detail_mesh;
+        }
+        const std::shared_ptr<const MeshLevelsOfDetail>& levels_of_detail = object_geometry.LevelsOfDetail.get();
+        if (!levels_of_detail)
+        {
+            return full_detail_mesh;
+        }
+
+        // COMPUTE THE OBJECT'S BOUNDING SPHERE IN WORLD SPACE.
+        BoundingBox world_bounds = object_geometry.MeshBounds.Transform(object_geometry.WorldTransform);
+        if (world_bounds.IsEmpty())
+        {
+            return full_detail_mesh;
+        }
+        float radius = (world_bounds.Max - world_bounds.Min).Length() / 2.0f;
+        float depth = MATH::Vector3f::DotProduct(world_bounds.Center() - projection.Origin, projection.Forward);
+
+        // ESTIMATE HOW MANY PIXELS THE OBJECT COVERS.
+        // Objects the camera is inside or very close to get full detail since parts of them may be arbitrarily close.
+        float pixels_per_viewing_plane_unit = static_cast<float>(projection.HeightInPixels) / (2.0f * projection.HalfHeight);
+        float projected_radius_in_pixels = radius * pixels_per_viewing_plane_unit;
+        if (projection.Perspective)
+        {
+            if (depth <= radius)
+            {
+                return full_detail_mesh;
+            }
+            projected_radius_in_pixels /= depth;
+        }
+        constexpr float PI = 3.14159265358979f;
+        float covered_pixel_count = PI * projected_radius_in_pixels * projected_radius_in_pixels;
+
+        return levels_of_detail->SelectLevel(full_detail_mesh, covered_pixel_count, cpu_rendering_settings.LevelOfDetailPixelsPerTriangle);
+    }
+
+    /// Determines which geometry might be visible for the current frame, skipping objects and then clusters of triangles
+    /// that are entirely outside the view frustum.
+    /// @param[in]  projection - Information about the camera.
+    /// @param[in]  frustum_culling - True if geometry outside the view frustum should be skipped; false to keep all geometry.
+    void BinningRasterizer::CullGeometry(const Projection& projection, const bool frustum_culling)
+    {
+        PROFILING::TraceScope cull_scope("Cull Geometry", "Rasterization");
+        Statistics = {};
+        Statistics.ObjectCount = Objects.size();
+
+        // CULL OBJECTS.
+        for (ObjectGeometry& object_geometry : Objects)
+        {
+            object_geometry.OutsideFrustum = false;
+            if (frustum_culling)
+            {
+                BoundingBox world_bounds = object_geometry.MeshBounds.Transform(object_geometry.WorldTransform);
+                object_geometry.OutsideFrustum = projection.Frustum.Excludes(world_bounds);
+            }
+            if (object_geometry.OutsideFrustum)
+            {
+                ++Statistics.ObjectsOutsideFrustum;
+            }
+        }
+
+        // FIND VERTICES IN VISIBLE OBJECTS.
+        // Vertices are only transformed per object since a vertex may be shared by triangles in different clusters.
+        VisibleVertexRangeIndices.clear();
+        for (uint32_t range_index = 0; range_index < VertexRanges.size(); ++range_index)
+        {
+            if (!Objects[VertexRanges[range_index].ObjectIndex].OutsideFrustum)
+            {
+                VisibleVertexRangeIndices.push_back(range_index);
+            }
+        }
+
+        // CULL CLUSTERS OF TRIANGLES IN VISIBLE OBJECTS.
+        VisibleTriangleRangeIndices.clear();
+        for (uint32_t range_index = 0; range_index < TriangleRanges.size(); ++range_index)
+        {
+            const ObjectGeometry& object_geometry = Objects[TriangleRanges[range_index].ObjectIndex];
+            if (object_geometry.OutsideFrustum)
+            {
+                continue;
+            }
+
+            ++Statistics.ClusterCount;
+            if (frustum_culling)
+            {
+                BoundingBox world_bounds = TriangleRangeBounds[range_index].Transform(object_geometry.WorldTransform);
+                if (projection.Frustum.Excludes(world_bounds))
+                {
+                    ++Statistics.ClustersOutsideFrustum;
+                    continue;
+                }
+            }
+
+            VisibleTriangleRangeIndices.push_back(range_index);
+        }
+    }
+
+    /// Finds the tiles to rasterize for the current frame and updates the screen bounds of all objects.
+    /// @param[in]  projection - Information about the camera.
+    /// @param[in]  tile_grid - How the screen is split into tiles.
+    /// @param[in]  only_changed_objects - True if only tiles overlapping where changed objects were in the most recent render
+    ///     or are now need to be rendered; false to render all tiles.
+    void BinningRasterizer::FindTilesToRender(const Projection& projection, const TileGrid& tile_grid, const bool only_changed_objects)
+    {
+        TileIndicesToRender.clear();
+        int tile_size_in_pixels = static_cast<int>(tile_grid.TileSizeInPixels);
+        auto add_tiles = [&](const ScreenRectangle& area)
+        {
+            if (area.IsEmpty())
+            {
+                return;
+            }
+            for (int tile_row = area.TopY / tile_size_in_pixels; tile_row <= (area.BottomY - 1) / tile_size_in_pixels; ++tile_row)
+            {
+                for (int tile_column = area.LeftX / tile_size_in_pixels; tile_column <= (area.RightX - 1) / tile_size_in_pixels; ++tile_column)
+                {
+                    uint32_t tile_index = static_cast<uint32_t>(tile_row) * tile_grid.ColumnCount + static_cast<uint32_t>(tile_column);
+                    TileIndicesToRender.push_back(tile_index);
+                }
+            }
+        };
+
+        // FIND THE DAMAGED AREAS OF THE SCREEN.
+        // Each changed object damages both where it was and where it now is, which are kept as separate areas
+        // so that an object moving across the screen doesn't damage everything in between.
+        for (ObjectGeometry& object_geometry : Objects)
+        {
+            ScreenRectangle screen_bounds = ComputeScreenBounds(object_geometry, projection);
+            if (only_changed_objects && object_geometry.Changed)
+            {
+                add_tiles(object_geometry.ScreenBounds);
+                add_tiles(screen_bounds);
+            }
+            object_geometry.ScreenBounds = screen_bounds;
+        }
+
+        // FIND THE TILES TO RENDER.
+        // Tiles overlapped by several damaged areas must only be rendered once.
+        if (only_changed_objects)
+        {
+            std::sort(TileIndicesToRender.begin(), TileIndicesToRender.end());
+            TileIndicesToRender.erase(std::unique(TileIndicesToRender.begin(), TileIndicesToRender.end()), TileIndicesToRender.end());
+        }
+        else
+        {
+            ScreenRectangle screen = { .RightX = static_cast<int>(projection.WidthInPixels), .BottomY = static_cast<int>(projection.HeightInPixels) };
+            add_tiles(screen);
+        }
+    }
+
+    /// Finds the pixels an object's triangles may cover, by projecting the corners of its bounds onto the screen.
+    /// @param[in]  object_geometry - The object, with its world transform for the current frame.
+    /// @param[in]  projection - Information about the camera.
+    /// @return The pixels the object may cover, within the screen.  Empty if the object can't cover any.
+    ScreenRectangle BinningRasterizer::ComputeScreenBounds(const ObjectGeometry& object_geometry, const Projection& projection)
+    {
+        // OBJECTS WITHOUT ANY TRIANGLES COVER NOTHING.
+        // Levels of detail keep vertices of the full detail mesh, so its bounds contain any rendered mesh.
+        const BoundingBox& mesh_bounds = object_geometry.MeshBounds;
+        if (mesh_bounds.IsEmpty())
+        {
+            return {};
+        }
+
+        // PROJECT EACH CORNER OF THE BOUNDS ONTO THE SCREEN.
+        // Projection keeps points inside the box within the projected corners, unless some corners are behind the camera.
+        float near_distance = -projection.ClipPlanes[0].Offset;
+        constexpr unsigned int CORNER_COUNT = 8;
+        unsigned int corners_in_front_of_near_plane_count = 0;
+        bool corner_behind_camera = false;
+        float min_normalized_x = std::numeric_limits<float>::max();
+        float max_normalized_x = std::numeric_limits<float>::lowest();
+        float min_normalized_y = std::numeric_limits<float>::max();
+        float max_normalized_y = std::numeric_limits<float>::lowest();
+        for (unsigned int corner_index = 0; corner_index < CORNER_COUNT; ++corner_index)
+        {
+            MATH::Vector3f corner(
+                (corner_index & 1) ? mesh_bounds.Max.X : mesh_bounds.Min.X,
+                (corner_index & 2) ? mesh_bounds.Max.Y : mesh_bounds.Min.Y,
+                (corner_index & 4) ? mesh_bounds.Max.Z : mesh_bounds.Min.Z);
+            MATH::Vector3f offset_from_camera = object_geometry.WorldTransform.TransformPoint(corner) - projection.Origin;
+            float depth = MATH::Vector3f::DotProduct(offset_from_camera, projection.Forward);
+            if (depth >= near_distance)
+            {
+                ++corners_in_front_of_near_plane_count;
+            }
+
+            float normalized_x = MATH::Vector3f::DotProduct(offset_from_camera, projection.Right) / projection.HalfWidth;
+            float normalized_y = MATH::Vector3f::DotProduct(offset_from_camera, projection.Up) / projection.HalfHeight;
+            if (projection.Perspective)
+            {
+                if (depth <= 0.0f)
+                {
+                    corner_behind_camera = true;
+                    continue;
+                }
+                normalized_x /= depth;
+                normalized_y /= depth;
+            }
+            min_normalized_x = std::min(min_normalized_x, normalized_x);
+            max_normalized_x = std::max(max_normalized_x, normalized_x);
+            min_normalized_y = std::min(min_normalized_y, normalized_y);
+            max_normalized_y = std::max(max_normalized_y, normalized_y);
+        }
+
+        // HANDLE OBJECTS THAT AREN'T ENTIRELY IN FRONT OF THE CAMERA.
+        // Triangles entirely behind the near plane are clipped away, while objects partly behind the camera could cover anywhere.
+        ScreenRectangle screen = { .RightX = static_cast<int>(projection.WidthInPixels), .BottomY = static_cast<int>(projection.HeightInPixels) };
+        if (corners_in_front_of_near_plane_count <= 0)
+        {
+            return {};
+        }
+        if (corner_behind_camera)
+        {
+            return screen;
+        }
+
+        // CONVERT THE PROJECTED CORNERS TO PIXELS.
+        // The y-coordinate is flipped like for vertices.  A margin covers any difference in rounding from how vertices
+        // are projected, and positions are clamped to the screen before converting to integers since they may be far off screen.
+        constexpr float MARGIN_IN_PIXELS = 2.0f;
+        float width_in_pixels = static_cast<float>(projection.WidthInPixels);
+        float height_in_pixels = static_cast<float>(projection.HeightInPixels);
+        float half_width_in_pixels = width_in_pixels / 2.0f;
+        float half_height_in_pixels = height_in_pixels / 2.0f;
+        float left_x = (min_normalized_x + 1.0f) * half_width_in_pixels - MARGIN_IN_PIXELS;
+        float right_x = (max_normalized_x + 1.0f) * half_width_in_pixels + MARGIN_IN_PIXELS;
+        float top_y = (1.0f - max_normalized_y) * half_height_in_pixels - MARGIN_IN_PIXELS;
+        float bottom_y = (1.0f - min_normalized_y) * half_height_in_pixels + MARGIN_IN_PIXELS;
+        ScreenRectangle bounds;
+        bounds.LeftX = static_cast<int>(std::floor(std::clamp(left_x, 0.0f, width_in_pixels)));
+        bounds.TopY = static_cast<int>(std::floor(std::clamp(top_y, 0.0f, height_in_pixels)));
+        bounds.RightX = static_cast<int>(std::ceil(std::clamp(right_x, 0.0f, width_in_pixels)));
+        bounds.BottomY = static_cast<int>(std::ceil(std::clamp(bottom_y, 0.0f, height_in_pixels)));
+        return bounds;
+    }
+
+    /// Precomputes camera information for projecting vertices.
+    /// The projection matches the primary rays of the ray tracer, so both renderers show the same view.
+    /// @param[in]  camera - The camera to project through.
+    /// @param[in]  width_in_pixels - The width of the screen.
+    /// @param[in]  height_in_pixels - The height of the screen.
+    /// @return The projection information.
+    BinningRasterizer::Projection BinningRasterizer::ComputeProjection(
+        const GRAPHICS::VIEWING::Camera& camera,
+        const unsigned int width_in_pixels,
+        const unsigned int height_in_pixels)
+    {
+        Projection projection;
+        projection.Origin = camera.WorldPosition;
+        projection.Right = MATH::Vector3f::Normalize(camera.CoordinateFrame.Right);
+        projection.Up = MATH::Vector3f::Normalize(camera.CoordinateFrame.Up);
+        projection.Forward = MATH::Vector3f::Normalize(camera.CoordinateFrame.Forward);
+        projection.WidthInPixels = width_in_pixels;
+        projection.HeightInPixels = height_in_pixels;
+
+        // COMPUTE THE VIEWING PLANE EXTENTS.
+        float aspect_ratio = static_cast<float>(width_in_pixels) / static_cast<float>(std::max(height_in_pixels, 1u));
+        projection.Perspective = (GRAPHICS::VIEWING::ProjectionType::PERSPECTIVE == camera.Projection);
+        if (projection.Perspective)
+        {
+            constexpr float PI = 3.14159265358979f;
+            float field_of_view_in_radians = camera.FieldOfView.Value * PI / 180.0f;
+            projection.HalfHeight = std::tan(field_of_view_in_radians / 2.0f);
+        }
+        else
+        {
+            constexpr float DEFAULT_VIEWING_PLANE_HEIGHT = 2.0f;
+            float viewing_plane_height = (camera.ViewingPlane.Height > 0.0f) ? camera.ViewingPlane.Height : DEFAULT_VIEWING_PLANE_HEIGHT;
+            projection.HalfHeight = viewing_plane_height / 2.0f;
+        }
+        projection.HalfWidth = projection.HalfHeight * aspect_ratio;
+
+        // COMPUTE THE NEAR AND FAR CLIP PLANES.
+        float near_distance = camera.NearClipPlaneViewDistance;
+        if (projection.Perspective)
+        {
+            near_distance = std::max(near_distance, MIN_PERSPECTIVE_NEAR_DISTANCE);
+        }
+        projection.ClipPlanes[0] = { MATH::Vector3f(0.0f, 0.0f, 1.0f), -near_distance };
+        projection.ClipPlanes[1] = { MATH::Vector3f(0.0f, 0.0f, -1.0f), camera.FarClipPlaneViewDistance };
+
+        // COMPUTE THE VIEW FRUSTUM.
+        // Unlike the guard band, this is exactly the visible region of the screen.
+        projection.Frustum = ViewFrustum::Create(
+            projection.Origin,
+            projection.Right,
+            projection.Up,
+            projection.Forward,
+            projection.Perspective,
+            projection.HalfWidth,
+            projection.HalfHeight,
+            near_distance,
+            camera.FarClipPlaneViewDistance);
+
+        // COMPUTE THE GUARD BAND CLIP PLANES.
+        // These limit normalized screen coordinates to the guard band, which for perspective projection
+        // scales with distance from the camera.
+        float guard_band_half_width = projection.HalfWidth * 2.0f * GUARD_BAND_IN_PIXELS / static_cast<float>(width_in_pixels);
+        float guard_band_half_height = projection.HalfHeight * 2.0f * GUARD_BAND_IN_PIXELS / static_cast<float>(height_in_pixels);
+        if (projection.Perspective)
+        {
+            projection.ClipPlanes[2] = { MATH::Vector3f(1.0f, 0.0f, guard_band_half_width), 0.0f };
+            projection.ClipPlanes[3] = { MATH::Vector3f(-1.0f, 0.0f, guard_band_half_width), 0.0f };
+            projection.ClipPlanes[4] = { MATH::Vector3f(0.0f, 1.0f, guard_band_half_height), 0.0f };
+            projection.ClipPlanes[5] = { MATH::Vector3f(0.0f, -1.0f, guard_band_half_height), 0.0f };
+        }
+        else
+        {
+            projection.ClipPlanes[2] = { MATH::Vector3f(1.0f, 0.0f, 0.0f), guard_band_half_width };
+            projection.ClipPlanes[3] = { MATH::Vector3f(-1.0f, 0.0f, 0.0f), guard_band_half_width };
+            projection.ClipPlanes[4] = { MATH::Vector3f(0.0f, 1.0f, 0.0f), guard_band_half_height };
+            projection.ClipPlanes[5] = { MATH::Vector3f(0.0f, -1.0f, 0.0f), guard_band_half_height };
+        }
+
+        return projection;
+    }
+
+    /// Transforms a range of vertices into world space and camera space.
+    /// @param[in]  vertex_range - The vertices to transform.
+    /// @param[in]  projection - Information about the camera.
+    void BinningRasterizer::TransformVertices(const ObjectRange& vertex_range, const Projection& projection)
+    {
+        ObjectGeometry& object_geometry = Objects[vertex_range.ObjectIndex];
+        const IndexedMesh& mesh = *object_geometry.RenderedMesh;
+        uint32_t end_vertex_index = vertex_range.FirstIndex + vertex_range.Count;
+        for (uint32_t vertex_index = vertex_range.FirstIndex; vertex_index < end_vertex_index; ++vertex_index)
+        {
+            MATH::Vector3f world_position = object_geometry.WorldTransform.TransformPoint(mesh.Positions[vertex_index]);
+            object_geometry.WorldPositions[vertex_index] = world_position;
+            object_geometry.WorldNormals[vertex_index] = object_geometry.WorldTransform.TransformNormal(mesh.Normals[vertex_index]);
+
+            MATH::Vector3f offset_from_camera = world_position - projection.Origin;
+            object_geometry.CameraPositions[vertex_index] = MATH::Vector3f(
+                MATH::Vector3f::DotProduct(offset_from_camera, projection.Right),
+                MATH::Vector3f::DotProduct(offset_from_camera, projection.Up),
+                MATH::Vector3f::DotProduct(offset_from_camera, projection.Forward));
+        }
+    }
+
+    /// Clips, projects, and sets up a range of triangles for rasterization, sorting them into bins for tiles.
+    /// @param[in]  triangle_range - The triangles to set up.
+    /// @param[in]  projection - Information about the camera.
+    /// @param[in]  cull_backfaces - True if triangles facing away from the camera should be skipped.
+    ///     Front faces wind counterclockwise as seen by the camera.
+    /// @param[in]  tile_grid - How the screen is split into tiles.
+    /// @param[in,out]  arena - The arena of the worker running the task, for the batch's memory.
+    /// @param[out] batch - The batch to fill with set up triangles.
+    void BinningRasterizer::SetUpTriangles(
+        const ObjectRange& triangle_range,
+        const Projection& projection,
+        const bool cull_backfaces,
+        const TileGrid& tile_grid,
+        MEMORY::LinearArena& arena,
+        TriangleBatch& batch) const
+    {
+        // START THE BATCH IN THE WORKER'S ARENA.
+        MEMORY::ArenaAllocator<uint32_t> allocator(&arena);
+        batch.Triangles = MEMORY::ArenaVector<ScreenTriangle>(allocator);
+        batch.TileBinOffsets = MEMORY::ArenaVector<uint32_t>(allocator);
+        batch.TileBinCursors = MEMORY::ArenaVector<uint32_t>(allocator);
+        batch.BinnedTriangleIndices = MEMORY::ArenaVector<uint32_t>(allocator);
+
+        // SET UP EACH TRIANGLE.
+        // Clipping may split a triangle into several, all of which refer back to the original.
+        // Roughly one screen triangle is expected per triangle, so reserving avoids growing the array in the arena,
+        // which would leave behind every smaller copy.
+        batch.Triangles.reserve(triangle_range.Count);
+        const ObjectGeometry& object_geometry = Objects[triangle_range.ObjectIndex];
+        const IndexedMesh& mesh = *object_geometry.RenderedMesh;
+        uint32_t end_triangle_index = triangle_range.FirstIndex + triangle_range.Count;
+        uint32_t triangle_index = triangle_range.FirstIndex;
+        for (std::size_t material_range_index = mesh.FindMaterialRangeIndex(triangle_index);
+            material_range_index < mesh.MaterialRanges.size() && triangle_index < end_triangle_index;
+            ++material_range_index)
+        {
+            // LOOK UP THE MATERIAL ONCE FOR ALL TRIANGLES SHARING IT.
+            // Triangles are processed a material range at a time so that the material isn't searched for per triangle.
+            const MaterialRange& material_range = mesh.MaterialRanges[material_range_index];
+            MaterialHandle material_handle = MaterialTable::NO_MATERIAL;
+            if (IndexedMesh::NO_MATERIAL != material_range.MaterialId)
+            {
+                material_handle = object_geometry.MaterialHandles[material_range.MaterialId];
+            }
+
+            uint32_t material_end_triangle_index = std::min(material_range.FirstTriangleIndex + material_range.TriangleCount, end_triangle_index);
+            for (; triangle_index < material_end_triangle_index; ++triangle_index)
+            {
+                const uint32_t* vertex_indices = &mesh.Indices[IndexedMesh::VERTICES_PER_TRIANGLE * triangle_index];
+
+                // SKIP THE TRIANGLE IF IT FACES AWAY FROM THE CAMERA.
+                // This is checked in world space before clipping and snapping to pixels, like the library's rasterizer,
+                // so that which side of a triangle is seen never depends on rounding of its screen position.
+                // Triangles seen exactly edge-on count as facing away.
+                if (cull_backfaces)
+                {
+                    const MATH::Vector3f& first_world_position = object_geometry.WorldPositions[vertex_indices[0]];
+                    MATH::Vector3f edge_1 = object_geometry.WorldPositions[vertex_indices[1]] - first_world_position;
+                    MATH::Vector3f edge_2 = object_geometry.WorldPositions[vertex_indices[2]] - first_world_position;
+                    MATH::Vector3f geometric_normal = MATH::Vector3f::CrossProduct(edge_1, edge_2);
+                    MATH::Vector3f view_direction = projection.Perspective ? (first_world_position - projection.Origin) : projection.Forward;
+                    bool facing_away = (MATH::Vector3f::DotProduct(geometric_normal, view_direction) >= 0.0f);
+                    if (facing_away)
+                    {
+                        continue;
+                    }
+                }
+
+                ClipVertex clip_vertices[MAX_CLIPPED_VERTEX_COUNT];
+                clip_vertices[0] = { object_geometry.CameraPositions[vertex_indices[0]], MATH::Vector3f(1.0f, 0.0f, 0.0f) };
+                clip_vertices[1] = { object_geometry.CameraPositions[vertex_indices[1]], MATH::Vector3f(0.0f, 1.0f, 0.0f) };
+                clip_vertices[2] = { object_geometry.CameraPositions[vertex_indices[2]], MATH::Vector3f(0.0f, 0.0f, 1.0f) };
+                std::size_t clip_vertex_count = ClipTriangle(projection, clip_vertices);
+                if (clip_vertex_count <= 0)
+                {
+                    continue;
+                }
+
+                ScreenTriangle original_triangle;
+                original_triangle.ObjectIndex = triangle_range.ObjectIndex;
+                original_triangle.TriangleIndex = triangle_index;
+                original_triangle.Material = material_handle;
+                for (std::size_t vertex_index = 1; vertex_index + 1 < clip_vertex_count; ++vertex_index)
+                {
+                    AddScreenTriangle(
+                        projection,
+                        clip_vertices[0],
+                        clip_vertices[vertex_index],
+                        clip_vertices[vertex_index + 1],
+                        original_triangle,
+                        batch.Triangles);
+                }
+            }
+        }
+
+        // COUNT THE TRIANGLES OVERLAPPING EACH TILE.
+        // Each tile's count is stored just past its offset so that a running sum turns counts into offsets.
+        std::size_t tile_count = static_cast<std::size_t>(tile_grid.ColumnCount) * static_cast<std::size_t>(tile_grid.RowCount);
+        batch.TileBinOffsets.assign(tile_count + 1, 0);
+        int tile_size_in_pixels = static_cast<int>(tile_grid.TileSizeInPixels);
+        for (const ScreenTriangle& triangle : batch.Triangles)
+        {
+            for (int tile_row = triangle.Bounds.TopY / tile_size_in_pixels; tile_row <= (triangle.Bounds.BottomY - 1) / tile_size_in_pixels; ++tile_row)
+            {
+                for (int tile_column = triangle.Bounds.LeftX / tile_size_in_pixels; tile_column <= (triangle.Bounds.RightX - 1) / tile_size_in_pixels; ++tile_column)
+                {
+                    std::size_t tile_index = static_cast<std::size_t>(tile_row) * tile_grid.ColumnCount + static_cast<std::size_t>(tile_column);
+                    ++batch.TileBinOffsets[tile_index + 1];
+                }
+            }
+        }
+        for (std::size_t tile_index = 0; tile_index < tile_count; ++tile_index)
+        {
+            batch.TileBinOffsets[tile_index + 1] += batch.TileBinOffsets[tile_index];
+        }
+
+        // SORT THE TRIANGLES INTO BINS.
+        // Triangles are visited in order, so each bin keeps the original triangle order.
+        batch.TileBinCursors.assign(batch.TileBinOffsets.begin(), batch.TileBinOffsets.end() - 1);
+        batch.BinnedTriangleIndices.resize(batch.TileBinOffsets.back());
+        for (uint32_t triangle_index = 0; triangle_index < batch.Triangles.size(); ++triangle_index)
+        {
+            const ScreenTriangle& triangle = batch.Triangles[triangle_index];
+            for (int tile_row = triangle.Bounds.TopY / tile_size_in_pixels; tile_row <= (triangle.Bounds.BottomY - 1) / tile_size_in_pixels; ++tile_row)
+            {
+                for (int tile_column = triangle.Bounds.LeftX / tile_size_in_pixels; tile_column <= (triangle.Bounds.RightX - 1) / tile_size_in_pixels; ++tile_column)
+                {
+                    std::size_t tile_index = static_cast<std::size_t>(tile_row) * tile_grid.ColumnCount + static_cast<std::size_t>(tile_column);
+                    batch.BinnedTriangleIndices[batch.TileBinCursors[tile_index]++] = triangle_index;
+                }
+            }
+        }
+    }
+
+    /// Clips a triangle against all clip planes.
+    /// @param[in]  projection - Information about the camera, including the clip planes.
+    /// @param[in,out]  vertices - The 3 vertices of the triangle on input, replaced by the vertices of the clipped
+    ///     convex polygon on output.  Must have space for MAX_CLIPPED_VERTEX_COUNT vertices.
+    /// @return The number of vertices in the clipped polygon (0 if the triangle is entirely clipped).
+    std::size_t BinningRasterizer::ClipTriangle(const Projection& projection, ClipVertex* vertices)
+    {
+        // CHECK IF THE TRIANGLE IS ENTIRELY INSIDE ALL PLANES.
+        // This is the case for almost all triangles, which can then skip clipping.
+        auto plane_function = [](const ClipPlane& plane, const ClipVertex& vertex)
+        {
+            return MATH::Vector3f::DotProduct(plane.Normal, vertex.CameraPosition) + plane.Offset;
+        };
+        bool entirely_inside = true;
+        for (const ClipPlane& plane : projection.ClipPlanes)
+        {
+            for (std::size_t vertex_index = 0; vertex_index < IndexedMesh::VERTICES_PER_TRIANGLE; ++vertex_index)
+            {
+                entirely_inside = entirely_inside && (plane_function(plane, vertices[vertex_index]) >= 0.0f);
+            }
+        }
+        if (entirely_inside)
+        {
+            return IndexedMesh::VERTICES_PER_TRIANGLE;
+        }
+
+        // CLIP THE POLYGON AGAINST EACH PLANE IN TURN.
+        // Each plane can add at most one vertex to a convex polygon.
+        std::size_t vertex_count = IndexedMesh::VERTICES_PER_TRIANGLE;
+        ClipVertex clipped_vertices[MAX_CLIPPED_VERTEX_COUNT];
+        for (const ClipPlane& plane : projection.ClipPlanes)
+        {
+            std::size_t clipped_vertex_count = 0;
+            for (std::size_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+            {
+                const ClipVertex& current_vertex = vertices[vertex_index];
+                const ClipVertex& next_vertex = vertices[(vertex_index + 1) % vertex_count];
+                float current_value = plane_function(plane, current_vertex);
+                float next_value = plane_function(plane, next_vertex);
+                bool current_inside = (current_value >= 0.0f);
+                bool next_inside = (next_value >= 0.0f);
+                if (current_inside)
+                {
+                    clipped_vertices[clipped_vertex_count++] = current_vertex;
+                }
+
+                if (current_inside != next_inside)
+                {
+                    float intersection_fraction = current_value / (current_value - next_value);
+                    ClipVertex& intersection_vertex = clipped_vertices[clipped_vertex_count++];
+                    intersection_vertex.CameraPosition = current_vertex.CameraPosition + MATH::Vector3f::Scale(
+                        intersection_fraction,
+                        next_vertex.CameraPosition - current_vertex.CameraPosition);
+                    intersection_vertex.SourceBarycentrics = current_vertex.SourceBarycentrics + MATH::Vector3f::Scale(
+                        intersection_fraction,
+                        next_vertex.SourceBarycentrics - current_vertex.SourceBarycentrics);
+                }
+            }
+
+            std::copy(clipped_vertices, clipped_vertices + clipped_vertex_count, vertices);
+            vertex_count = clipped_vertex_count;
+            if (vertex_count < IndexedMesh::VERTICES_PER_TRIANGLE)
+            {
+                return 0;
+            }
+        }
+
+        return vertex_count;
+    }
+
+    /// Projects a clipped triangle onto the screen and sets it up for rasterization, if it covers any pixels.
+    /// @param[in]  projection - Information about the camera.
+    /// @param[in]  first_vertex - The first vertex of the triangle.
+    /// @param[in]  second_vertex - The second vertex of the triangle.
+    /// @param[in]  third_vertex - The third vertex of the triangle.
+    /// @param[in]  original_triangle - Identifies the original triangle the clipped triangle came from.
+    /// @param[in,out]  triangles - The triangles to add the set up triangle to.
+    void BinningRasterizer::AddScreenTriangle(
+        const Projection& projection,
+        const ClipVertex& first_vertex,
+        const ClipVertex& second_vertex,
+        const ClipVertex& third_vertex,
+        const ScreenTriangle& original_triangle,
+        MEMORY::ArenaVector<ScreenTriangle>& triangles)
+    {
+        // PROJECT THE VERTICES ONTO THE SCREEN.
+        // Positions are snapped to fixed point so that everything after this is exact.
+        const ClipVertex* vertices[IndexedMesh::VERTICES_PER_TRIANGLE] = { &first_vertex, &second_vertex, &third_vertex };
+        int64_t fixed_xs[IndexedMesh::VERTICES_PER_TRIANGLE] = {};
+        int64_t fixed_ys[IndexedMesh::VERTICES_PER_TRIANGLE] = {};
+        ScreenTriangle triangle = original_triangle;
+        float half_width_in_pixels = static_cast<float>(projection.WidthInPixels) / 2.0f;
+        float half_height_in_pixels = static_cast<float>(projection.HeightInPixels) / 2.0f;
+        for (std::size_t vertex_index = 0; vertex_index < IndexedMesh::VERTICES_PER_TRIANGLE; ++vertex_index)
+        {
+            const MATH::Vector3f& camera_position = vertices[vertex_index]->CameraPosition;
+            float normalized_x = camera_position.X / projection.HalfWidth;
+            float normalized_y = camera_position.Y / projection.HalfHeight;
+            if (projection.Perspective)
+            {
+                // Attributes vary linearly with 1/z across the screen for perspective projection.
+                float inverse_depth = 1.0f / camera_position.Z;
+                normalized_x *= inverse_depth;
+                normalized_y *= inverse_depth;
+                triangle.Closenesses[vertex_index] = inverse_depth;
+                triangle.PerspectiveWeights[vertex_index] = inverse_depth;
+            }
+            else
+            {
+                triangle.Closenesses[vertex_index] = -camera_position.Z;
+                triangle.PerspectiveWeights[vertex_index] = 1.0f;
+            }
+            triangle.SourceBarycentrics[vertex_index] = vertices[vertex_index]->SourceBarycentrics;
+
+            // The y-coordinate is flipped since screen rows go down while the camera's up vector goes up.
+            float screen_x = (normalized_x + 1.0f) * half_width_in_pixels;
+            float screen_y = (1.0f - normalized_y) * half_height_in_pixels;
+            fixed_xs[vertex_index] = static_cast<int64_t>(std::floor(screen_x * static_cast<float>(SUBPIXELS_PER_PIXEL) + 0.5f));
+            fixed_ys[vertex_index] = static_cast<int64_t>(std::floor(screen_y * static_cast<float>(SUBPIXELS_PER_PIXEL) + 0.5f));
+        }
+
+        // CHECK WHICH WAY THE TRIANGLE WINDS ON THE SCREEN.
+        // Back faces were already culled if needed, so this only orients the edge functions.
+        // Counterclockwise winding as seen by the camera is a negative area with screen rows going down.
+        int64_t double_area =
+            (fixed_xs[1] - fixed_xs[0]) * (fixed_ys[2] - fixed_ys[0]) -
+            (fixed_ys[1] - fixed_ys[0]) * (fixed_xs[2] - fixed_xs[0]);
+        if (double_area == 0)
+        {
+            return;
+        }
+        bool counterclockwise = (double_area < 0);
+        if (counterclockwise)
+        {
+            // Vertices are swapped to get a positive area so that edge functions are positive inside.
+            std::swap(fixed_xs[1], fixed_xs[2]);
+            std::swap(fixed_ys[1], fixed_ys[2]);
+            std::swap(triangle.Closenesses[1], triangle.Closenesses[2]);
+            std::swap(triangle.PerspectiveWeights[1], triangle.PerspectiveWeights[2]);
+            std::swap(triangle.SourceBarycentrics[1], triangle.SourceBarycentrics[2]);
+            double_area = -double_area;
+        }
+        triangle.InverseDoubleArea = 1.0f / static_cast<float>(double_area);
+        triangle.MaxCloseness = std::max({ triangle.Closenesses[0], triangle.Closenesses[1], triangle.Closenesses[2] });
+
+        // FIND THE PIXELS WHOSE CENTERS MIGHT BE COVERED.
+        int64_t min_fixed_x = std::min({ fixed_xs[0], fixed_xs[1], fixed_xs[2] });
+        int64_t max_fixed_x = std::max({ fixed_xs[0], fixed_xs[1], fixed_xs[2] });
+        int64_t min_fixed_y = std::min({ fixed_ys[0], fixed_ys[1], fixed_ys[2] });
+        int64_t max_fixed_y = std::max({ fixed_ys[0], fixed_ys[1], fixed_ys[2] });
+        ScreenRectangle bounds;
+        bounds.LeftX = static_cast<int>(FloorDivide(min_fixed_x - HALF_PIXEL + SUBPIXELS_PER_PIXEL - 1, SUBPIXELS_PER_PIXEL));
+        bounds.TopY = static_cast<int>(FloorDivide(min_fixed_y - HALF_PIXEL + SUBPIXELS_PER_PIXEL - 1, SUBPIXELS_PER_PIXEL));
+        bounds.RightX = static_cast<int>(FloorDivide(max_fixed_x - HALF_PIXEL, SUBPIXELS_PER_PIXEL) + 1);
+        bounds.BottomY = static_cast<int>(FloorDivide(max_fixed_y - HALF_PIXEL, SUBPIXELS_PER_PIXEL) + 1);
+        triangle.Bounds = bounds.ClampedTo(static_cast<int>(projection.WidthInPixels), static_cast<int>(projection.HeightInPixels));
+        if (triangle.Bounds.IsEmpty())
+        {
+            return;
+        }
+
+        // SET UP THE EDGE FUNCTIONS.
+        // Each vertex's function is for the edge opposite it.  Pixel centers exactly on an edge are only covered
+        // if it's a top or left edge, which any other triangle sharing the edge sees as a bottom or right edge.
+        for (std::size_t vertex_index = 0; vertex_index < IndexedMesh::VERTICES_PER_TRIANGLE; ++vertex_index)
+        {
+            std::size_t edge_start_index = (vertex_index + 1) % IndexedMesh::VERTICES_PER_TRIANGLE;
+            std::size_t edge_end_index = (vertex_index + 2) % IndexedMesh::VERTICES_PER_TRIANGLE;
+            int64_t edge_x = fixed_xs[edge_end_index] - fixed_xs[edge_start_index];
+            int64_t edge_y = fixed_ys[edge_end_index] - fixed_ys[edge_start_index];
+            triangle.EdgeA[vertex_index] = -edge_y;
+            triangle.EdgeB[vertex_index] = edge_x;
+            triangle.EdgeC[vertex_index] = edge_y * fixed_xs[edge_start_index] - edge_x * fixed_ys[edge_start_index];
+
+            bool top_left_edge = (edge_y > 0) || (edge_y == 0 && edge_x < 0);
+            triangle.EdgeBiases[vertex_index] = top_left_edge ? 0 : -1;
+        }
+
+        triangles.push_back(triangle);
+    }
+
+    /// Rasterizes all triangles overlapping a single tile.
+    /// @param[in]  tile_index - The index of the tile, in row-major order.
+    /// @param[in]  tile_grid - How the screen is split into tiles.
+    /// @param[in]  projection - Information about the camera.
+    /// @param[in]  scene - The scene being rendered.
+    /// @param[in]  rendering_settings - The settings for what to render, including whether to check pixel coverage with SIMD.
+    /// @param[in]  hierarchical_depth_culling - True if triangles behind everything already drawn in the tile should be
+    ///     skipped without checking their pixels.
+    /// @param[in]  is_shadowed - The function for checking if lights are blocked.  Shadows are skipped if empty.
+    /// @param[in,out]  scratch - Scratch memory for the current thread.
+    /// @param[out] pixels - The pixels of the color buffer.
+    void BinningRasterizer::RasterizeTile(
+        const std::size_t tile_index,
+        const TileGrid& tile_grid,
+        const Projection& projection,
+        const GRAPHICS::Scene& scene,
+        const GRAPHICS::RenderingSettings& rendering_settings,
+        const bool hierarchical_depth_culling,
+        const SurfaceShading::ShadowTestFunction& is_shadowed,
+        TileScratch& scratch,
+        uint32_t* pixels) const
+    {
+        PROFILING::TraceScope tile_scope("Rasterize Tile", "Rasterization");
+
+        // DETERMINE THE PIXELS IN THE TILE.
+        int tile_size_in_pixels = static_cast<int>(tile_grid.TileSizeInPixels);
+        ScreenRectangle tile;
+        tile.LeftX = static_cast<int>(tile_index % tile_grid.ColumnCount) * tile_size_in_pixels;
+        tile.TopY = static_cast<int>(tile_index / tile_grid.ColumnCount) * tile_size_in_pixels;
+        tile.RightX = tile.LeftX + tile_size_in_pixels;
+        tile.BottomY = tile.TopY + tile_size_in_pixels;
+        tile = tile.ClampedTo(static_cast<int>(projection.WidthInPixels), static_cast<int>(projection.HeightInPixels));
+        int tile_width_in_pixels = tile.WidthInPixels();
+        std::size_t tile_pixel_count = static_cast<std::size_t>(tile_width_in_pixels) * static_cast<std::size_t>(tile.HeightInPixels());
+
+        // CLEAR THE TILE'S DEPTH BUFFER.
+        scratch.Closenesses.assign(tile_pixel_count, std::numeric_limits<float>::lowest());
+        scratch.VisibleTriangles.assign(tile_pixel_count, nullptr);
+
+        // FIND THE VISIBLE TRIANGLE FOR EACH PIXEL.
+        // Batches and their bins are visited in the original triangle order, so ties and disabled depth buffering
+        // resolve the same way no matter how work was split up.
+        //
+        // The farthest closeness in the tile is the coarsest level of a depth hierarchy over it: a triangle that's nowhere
+        // closer can't be visible at any pixel, so its pixels needn't be checked.  It's only useful once every pixel has been
+        // drawn, and it's only recomputed after about as many pixel writes as the tile has pixels so that recomputing it
+        // costs no more than the writes themselves.
+        bool depth_buffering = rendering_settings.DepthBuffering;
+        bool hierarchical_depth_culling_enabled = hierarchical_depth_culling && depth_buffering;
+        float tile_farthest_closeness = std::numeric_limits<float>::lowest();
+        std::size_t pixel_writes_since_farthest_closeness_update = 0;
+        for (const TriangleBatch& batch : TriangleBatches)
+        {
+            uint32_t bin_begin = batch.TileBinOffsets[tile_index];
+            uint32_t bin_end = batch.TileBinOffsets[tile_index + 1];
+            for (uint32_t bin_index = bin_begin; bin_index < bin_end; ++bin_index)
+            {
+                const ScreenTriangle& triangle = batch.Triangles[batch.BinnedTriangleIndices[bin_index]];
+
+                // SKIP THE TRIANGLE IF IT'S BEHIND EVERYTHING ALREADY DRAWN IN THE TILE.
+                if (hierarchical_depth_culling_enabled)
+                {
+                    if (pixel_writes_since_farthest_closeness_update >= tile_pixel_count)
+                    {
+                        tile_farthest_closeness = *std::min_element(scratch.Closenesses.begin(), scratch.Closenesses.end());
+                        pixel_writes_since_farthest_closeness_update = 0;
+                    }
+
+                    float max_closeness_with_margin = triangle.MaxCloseness + std::abs(triangle.MaxCloseness) * CLOSENESS_ROUNDING_MARGIN;
+                    if (max_closeness_with_margin < tile_farthest_closeness)
+                    {
+                        ++scratch.OccludedTriangleCount;
+                        continue;
+                    }
+                }
+
+                ScreenRectangle covered_pixels = triangle.Bounds.Intersection(tile);
+
+                int64_t first_pixel_center_x = covered_pixels.LeftX * SUBPIXELS_PER_PIXEL + HALF_PIXEL;
+                int64_t edge_steps[IndexedMesh::VERTICES_PER_TRIANGLE] = {};
+                for (std::size_t vertex_index = 0; vertex_index < IndexedMesh::VERTICES_PER_TRIANGLE; ++vertex_index)
+                {
+                    edge_steps[vertex_index] = triangle.EdgeA[vertex_index] * SUBPIXELS_PER_PIXEL;
+                }
+
+                // Keeps the triangle for a covered pixel if it's closer than any found so far.
+                auto draw_covered_pixel = [&](const std::size_t tile_pixel_index, const int64_t* const pixel_edge_values)
+                {
+                    float closeness = triangle.InverseDoubleArea * (
+                        static_cast<float>(pixel_edge_values[0]) * triangle.Closenesses[0] +
+                        static_cast<float>(pixel_edge_values[1]) * triangle.Closenesses[1] +
+                        static_cast<float>(pixel_edge_values[2]) * triangle.Closenesses[2]);
+                    if (!depth_buffering || closeness > scratch.Closenesses[tile_pixel_index])
+                    {
+                        scratch.Closenesses[tile_pixel_index] = closeness;
+                        scratch.VisibleTriangles[tile_pixel_index] = &triangle;
+                        ++pixel_writes_since_farthest_closeness_update;
+                    }
+                };
+
+                for (int y = covered_pixels.TopY; y < covered_pixels.BottomY; ++y)
+                {
+                    // EVALUATE THE EDGE FUNCTIONS AT THE START OF THE ROW.
+                    int64_t pixel_center_y = y * SUBPIXELS_PER_PIXEL + HALF_PIXEL;
+                    int64_t edge_values[IndexedMesh::VERTICES_PER_TRIANGLE] = {};
+                    for (std::size_t vertex_index = 0; vertex_index < IndexedMesh::VERTICES_PER_TRIANGLE; ++vertex_index)
+                    {
+                        edge_values[vertex_index] =
+                            triangle.EdgeA[vertex_index] * first_pixel_center_x +
+                            triangle.EdgeB[vertex_index] * pixel_center_y +
+                            triangle.EdgeC[vertex_index];
+                    }
+
+                    std::size_t tile_row_offset = static_cast<std::size_t>(y - tile.TopY) * static_cast<std::size_t>(tile_width_in_pixels);
+                    int x = covered_pixels.LeftX;
+#if defined(_M_X64) || defined(__SSE2__)
+                    if (rendering_settings.UseCpuSimd)
+                    {
+                        // CHECK IF PAIRS OF PIXEL CENTERS ARE COVERED.
+                        // Edge values are 64-bit, so an SSE2 register holds the biased values for 2 adjacent pixels.
+                        // The sign bits of all 3 are combined just like for single pixels, so exactly the same pixels are covered.
+                        __m128i biased_pair_edge_values[IndexedMesh::VERTICES_PER_TRIANGLE] = {};
+                        __m128i pair_edge_steps[IndexedMesh::VERTICES_PER_TRIANGLE] = {};
+                        for (std::size_t vertex_index = 0; vertex_index < IndexedMesh::VERTICES_PER_TRIANGLE; ++vertex_index)
+                        {
+                            int64_t biased_edge_value = edge_values[vertex_index] + triangle.EdgeBiases[vertex_index];
+                            biased_pair_edge_values[vertex_index] = _mm_set_epi64x(biased_edge_value + edge_steps[vertex_index], biased_edge_value);
+                            pair_edge_steps[vertex_index] = _mm_set1_epi64x(2 * edge_steps[vertex_index]);
+                        }
+
+                        for (; x + 1 < covered_pixels.RightX; x += 2)
+                        {
+                            __m128i combined_edge_values = _mm_or_si128(
+                                _mm_or_si128(biased_pair_edge_values[0], biased_pair_edge_values[1]),
+                                biased_pair_edge_values[2]);
+                            int uncovered_pixel_mask = _mm_movemask_pd(_mm_castsi128_pd(combined_edge_values));
+                            std::size_t tile_pixel_index = tile_row_offset + static_cast<std::size_t>(x - tile.LeftX);
+                            if (!(uncovered_pixel_mask & 0b01))
+                            {
+                                draw_covered_pixel(tile_pixel_index, edge_values);
+                            }
+                            if (!(uncovered_pixel_mask & 0b10))
+                            {
+                                int64_t next_edge_values[IndexedMesh::VERTICES_PER_TRIANGLE] =
+                                {
+                                    edge_values[0] + edge_steps[0],
+                                    edge_values[1] + edge_steps[1],
+                                    edge_values[2] + edge_steps[2],
+                                };
+                                draw_covered_pixel(tile_pixel_index + 1, next_edge_values);
+                            }
+
+                            for (std::size_t vertex_index = 0; vertex_index < IndexedMesh::VERTICES_PER_TRIANGLE; ++vertex_index)
+                            {
+                                edge_values[vertex_index] += 2 * edge_steps[vertex_index];
+                                biased_pair_edge_values[vertex_index] = _mm_add_epi64(biased_pair_edge_values[vertex_index], pair_edge_steps[vertex_index]);
+                            }
+                        }
+                    }
+#endif
+
+                    for (; x < covered_pixels.RightX; ++x)
+                    {
+                        // CHECK IF THE PIXEL CENTER IS COVERED.
+                        // The sign bits of all biased edge values are combined to check them all at once.
+                        int64_t biased_edge_values =
+                            (edge_values[0] + triangle.EdgeBiases[0]) |
+                            (edge_values[1] + triangle.EdgeBiases[1]) |
+                            (edge_values[2] + triangle.EdgeBiases[2]);
+                        if (biased_edge_values >= 0)
+                        {
+                            std::size_t tile_pixel_index = tile_row_offset + static_cast<std::size_t>(x - tile.LeftX);
+                            draw_covered_pixel(tile_pixel_index, edge_values);
+                        }
+
+                        edge_values[0] += edge_steps[0];
+                        edge_values[1] += edge_steps[1];
+                        edge_values[2] += edge_steps[2];
+                    }
+                }
+            }
+        }
+
+        // SHADE EACH PIXEL.
+        // Only the visible triangle is shaded, so shading cost doesn't grow with overdraw.
+        uint32_t background_color = PackedColor::FromColor(scene.BackgroundColor);
+        for (int y = tile.TopY; y < tile.BottomY; ++y)
+        {
+            std::size_t tile_row_offset = static_cast<std::size_t>(y - tile.TopY) * static_cast<std::size_t>(tile_width_in_pixels);
+            std::size_t screen_row_offset = static_cast<std::size_t>(y) * projection.WidthInPixels;
+            for (int x = tile.LeftX; x < tile.RightX; ++x)
+            {
+                const ScreenTriangle* visible_triangle = scratch.VisibleTriangles[tile_row_offset + static_cast<std::size_t>(x - tile.LeftX)];
+                uint32_t packed_color = background_color;
+                if (visible_triangle)
+                {
+                    GRAPHICS::Color color = ShadePixel(*visible_triangle, x, y, projection, scene, rendering_settings, is_shadowed);
+                    packed_color = PackedColor::FromColor(color);
+                }
+                pixels[screen_row_offset + static_cast<std::size_t>(x)] = packed_color;
+            }
+        }
+    }
+
+    /// Computes perspective-correct barycentric coordinates within a triangle's original unclipped triangle.
+    /// @param[in]  triangle - The triangle on the screen.
+    /// @param[in]  x - The fixed-point horizontal screen position.
+    /// @param[in]  y - The fixed-point vertical screen position.
+    /// @return The barycentric coordinates of the screen position within the original triangle.
+    MATH::Vector3f BinningRasterizer::ComputeSourceBarycentrics(const ScreenTriangle& triangle, const int64_t x, const int64_t y)
+    {
+        float weights[IndexedMesh::VERTICES_PER_TRIANGLE] = {};
+        float total_weight = 0.0f;
+        for (std::size_t vertex_index = 0; vertex_index < IndexedMesh::VERTICES_PER_TRIANGLE; ++vertex_index)
+        {
+            int64_t edge_value =
+                triangle.EdgeA[vertex_index] * x +
+                triangle.EdgeB[vertex_index] * y +
+                triangle.EdgeC[vertex_index];
+            weights[vertex_index] = static_cast<float>(edge_value) * triangle.InverseDoubleArea * triangle.PerspectiveWeights[vertex_index];
+            total_weight += weights[vertex_index];
+        }
+        MATH::Vector3f source_barycentrics(0.0f, 0.0f, 0.0f);
+        for (std::size_t vertex_index = 0; vertex_index < IndexedMesh::VERTICES_PER_TRIANGLE; ++vertex_index)
+        {
+            source_barycentrics += MATH::Vector3f::Scale(weights[vertex_index] / total_weight, triangle.SourceBarycentrics[vertex_index]);
+        }
+        return source_barycentrics;
+    }
+
+    /// Interpolates the texture coordinates of a triangle's original vertices.
+    /// @param[in]  triangle - The triangle on the screen.
+    /// @param[in]  source_barycentrics - The barycentric coordinates within the original triangle.
+    /// @return The interpolated texture coordinates.
+    MATH::Vector2f BinningRasterizer::InterpolateTextureCoordinates(const ScreenTriangle& triangle, const MATH::Vector3f& source_barycentrics) const
+    {
+        const IndexedMesh& mesh = *Objects[triangle.ObjectIndex].RenderedMesh;
+        const uint32_t* vertex_indices = &mesh.Indices[IndexedMesh::VERTICES_PER_TRIANGLE * triangle.TriangleIndex];
+        const MATH::Vector2f& first_texture_coordinates = mesh.TextureCoordinates[vertex_indices[0]];
+        const MATH::Vector2f& second_texture_coordinates = mesh.TextureCoordinates[vertex_indices[1]];
+        const MATH::Vector2f& third_texture_coordinates = mesh.TextureCoordinates[vertex_indices[2]];
+        return MATH::Vector2f(
+            source_barycentrics.X * first_texture_coordinates.X + source_barycentrics.Y * second_texture_coordinates.X + source_barycentrics.Z * third_texture_coordinates.X,
+            source_barycentrics.X * first_texture_coordinates.Y + source_barycentrics.Y * second_texture_coordinates.Y + source_barycentrics.Z * third_texture_coordinates.Y);
+    }
+
+    /// Computes the color of a triangle at a pixel.
+    /// @param[in]  triangle - The triangle visible at the pixel.
+    /// @param[in]  x - The column of the pixel.
+    /// @param[in]  y - The row of the pixel.
+    /// @param[in]  projection - Information about the camera.
+    /// @param[in]  scene - The scene being rendered.
+    /// @param[in]  rendering_settings - The settings for what to render.
+    /// @param[in]  is_shadowed - The function for checking if lights are blocked.  Shadows are skipped if empty.
+    /// @return The color of the pixel.
+    GRAPHICS::Color BinningRasterizer::ShadePixel(
+        const ScreenTriangle& triangle,
+        const int x,
+        const int y,
+        const Projection& projection,
+        const GRAPHICS::Scene& scene,
+        const GRAPHICS::RenderingSettings& rendering_settings,
+        const SurfaceShading::ShadowTestFunction& is_shadowed) const
+    {
+        // COMPUTE PERSPECTIVE-CORRECT BARYCENTRIC COORDINATES WITHIN THE ORIGINAL TRIANGLE.
+        int64_t pixel_center_x = x * SUBPIXELS_PER_PIXEL + HALF_PIXEL;
+        int64_t pixel_center_y = y * SUBPIXELS_PER_PIXEL + HALF_PIXEL;
+        MATH::Vector3f source_barycentrics = ComputeSourceBarycentrics(triangle, pixel_center_x, pixel_center_y);
+
+        // INTERPOLATE VERTEX ATTRIBUTES.
+        const ObjectGeometry& object_geometry = Objects[triangle.ObjectIndex];
+        const IndexedMesh& mesh = *object_geometry.RenderedMesh;
+        const uint32_t* vertex_indices = &mesh.Indices[IndexedMesh::VERTICES_PER_TRIANGLE * triangle.TriangleIndex];
+        float first_weight = source_barycentrics.X;
+        float second_weight = source_barycentrics.Y;
+        float third_weight = source_barycentrics.Z;
+
+        SurfacePoint surface;
+        surface.IsTriangle = true;
+        surface.TriangleBarycentricCoordinates = MATH::Vector2f(second_weight, third_weight);
+        surface.Material = Materials.GetMaterial(triangle.Material);
+        surface.Position =
+            MATH::Vector3f::Scale(first_weight, object_geometry.WorldPositions[vertex_indices[0]]) +
+            MATH::Vector3f::Scale(second_weight, object_geometry.WorldPositions[vertex_indices[1]]) +
+            MATH::Vector3f::Scale(third_weight, object_geometry.WorldPositions[vertex_indices[2]]);
+        MATH::Vector3f interpolated_normal =
+            MATH::Vector3f::Scale(first_weight, object_geometry.WorldNormals[vertex_indices[0]]) +
+            MATH::Vector3f::Scale(second_weight, object_geometry.WorldNormals[vertex_indices[1]]) +
+            MATH::Vector3f::Scale(third_weight, object_geometry.WorldNormals[vertex_indices[2]]);
+        // Textures are sampled at the nearest texel like the library's rasterizer, so no mipmapped texture is set.
+        surface.TextureCoordinates = InterpolateTextureCoordinates(triangle, source_barycentrics);
+        const GRAPHICS::Color& first_color = mesh.Colors[vertex_indices[0]];
+        const GRAPHICS::Color& second_color = mesh.Colors[vertex_indices[1]];
+        const GRAPHICS::Color& third_color = mesh.Colors[vertex_indices[2]];
+        surface.VertexColor = GRAPHICS::Color(
+            first_weight * first_color.Red + second_weight * second_color.Red + third_weight * third_color.Red,
+            first_weight * first_color.Green + second_weight * second_color.Green + third_weight * third_color.Green,
+            first_weight * first_color.Blue + second_weight * second_color.Blue + third_weight * third_color.Blue,
+            first_weight * first_color.Alpha + second_weight * second_color.Alpha + third_weight * third_color.Alpha);
+
+        // DETERMINE THE DIRECTION TO THE VIEWER.
+        MATH::Vector3f direction_to_viewer = MATH::Vector3f::Scale(-1.0f, projection.Forward);
+        if (projection.Perspective)
+        {
+            MATH::Vector3f offset_to_viewer = projection.Origin - surface.Position;
+            float distance_to_viewer = offset_to_viewer.Length();
+            if (distance_to_viewer > 0.0f)
+            {
+                direction_to_viewer = MATH::Vector3f::Scale(1.0f / distance_to_viewer, offset_to_viewer);
+            }
+        }
+
+        // DETERMINE THE NORMAL.
+        // Models without vertex normals fall back to the flat geometric normal.
+        constexpr float MIN_NORMAL_LENGTH = 1e-6f;
+        float interpolated_normal_length = interpolated_normal.Length();
+        if (interpolated_normal_length > MIN_NORMAL_LENGTH)
+        {
+            surface.Normal = MATH::Vector3f::Scale(1.0f / interpolated_normal_length, interpolated_normal);
+        }
+        else
+        {
+            const MATH::Vector3f& first_vertex_position = object_geometry.WorldPositions[vertex_indices[0]];
+            MATH::Vector3f edge_1 = object_geometry.WorldPositions[vertex_indices[1]] - first_vertex_position;
+            MATH::Vector3f edge_2 = object_geometry.WorldPositions[vertex_indices[2]] - first_vertex_position;
+            MATH::Vector3f geometric_normal = MATH::Vector3f::CrossProduct(edge_1, edge_2);
+            float geometric_normal_length = geometric_normal.Length();
+            if (geometric_normal_length > 0.0f)
+            {
+                surface.Normal = MATH::Vector3f::Scale(1.0f / geometric_normal_length, geometric_normal);
+            }
+        }
+
+        // SHADE THE SURFACE.
+        // Triangles are single-sided like in the library's rasterizer, so the normal isn't flipped for back faces
+        // drawn with backface culling off, which leaves them lit only by ambient and emitted light.
+        return SurfaceShading::Shade(surface, direction_to_viewer, scene, rendering_settings, is_shadowed);
+    }
+}
@@ -0,0 +1,396 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Graphics/Color.h"
+#include "Graphics/Images/Bitmap.h"
+#include "Graphics/Material.h"
+#include "Graphics/RenderingSettings.h"
+#include "Graphics/Scene.h"
+#include "Graphics/Viewing/Camera.h"
+#include "Math/Vector2.h"
+#include "Math/Vector3.h"
+#include "Memory/ArenaAllocator.h"
+#include "Memory/LinearArena.h"
+#include "Rendering/AffineTransform.h"
+#include "Rendering/BoundingBox.h"
+#include "Rendering/CpuRenderingSettings.h"
+#include "Rendering/IndexedMesh.h"
+#include "Rendering/MaterialTable.h"
+#include "Rendering/MeshLevelsOfDetail.h"
+#include "Rendering/MipmappedTexture.h"
+#include "Rendering/RayTracing/RayTracingScene.h"
+#include "Rendering/ScreenRectangle.h"
+#include "Rendering/SurfaceShading.h"
+#include "Rendering/ViewFrustum.h"
+#include "Threading/WorkStealingThreadPool.h"
+
+/// Holds code for the viewer's own CPU rasterizer.
+namespace RENDERING::RASTERIZATION
+{
+    /// A CPU rasterizer that spreads work across all cores by sorting triangles into bins for screen tiles.
+    ///
+    /// Each frame is rendered in 3 phases, each split into tasks run in parallel:
+    /// 1. Vertices are transformed into world and camera space in batches.
+    /// 2. Triangles are clipped, projected onto the screen, and set up for rasterization in batches.
+    ///    Each batch sorts its triangles into bins for the screen tiles they overlap.
+    /// 3. Each tile is rasterized on its own, with its own slice of the depth buffer.  The closest triangle is first
+    ///    found for each pixel from all batches' bins for the tile, and then only that triangle is shaded.
+    ///
+    /// Triangle edges are evaluated exactly in fixed point, and every pixel is computed from the same triangles
+    /// in their original order no matter which thread handles which task or how the screen is split into tiles.
+    /// The output is therefore bit-identical to rendering on a single thread.
+    ///
+    /// This is the default for the CPU rasterizer device type, so it follows the graphics library's rasterizer rather than
+    /// the ray tracer wherever the two differ: triangles are single-sided, with back faces determined in world space
+    /// from their winding and culled if enabled; textures are sampled at the nearest texel without mipmaps; and shadows
+    /// are found by tracing rays toward lights through the same scene geometry as the ray tracer, but no reflections are.
+    /// Spheres are only rendered by the ray tracer.  Pixel coverage is checked 2 pixels at a time with SSE2 if CPU SIMD
+    /// is enabled, which produces exactly the same pixels as the scalar code.  The headless renderer's
+    /// --compare-rasterizers option reports any pixels that still differ from the library's rasterizer for a scene.
+    ///
+    /// Objects covering few pixels may be rendered with simplified meshes (see MeshLevelsOfDetail).  Since nothing else
+    /// uses them, levels are only generated once this renders a mesh with levels of detail enabled: unless already in
+    /// the object mesh cache, they're queued for the rasterizer's own background thread, and the full detail mesh
+    /// is rendered until they're ready.  That thread is stopped and joined when the rasterizer is destroyed.
+    ///
+    /// Before any per-triangle work, objects and then clusters of triangles (the triangles set up by a single task)
+    /// entirely outside the view frustum are skipped.  While rasterizing, the farthest depth drawn in each tile
+    /// serves as a coarse level of a depth hierarchy, so triangles behind everything already drawn in a tile
+    /// are skipped without checking their pixels.  Neither affects the output since only geometry that
+    /// couldn't have been visible is skipped.
+    ///
+    /// When only objects moved since the last render, just the tiles overlapping where moved objects were and now are
+    /// on screen (from their projected bounds) are rasterized again, and the rest of the color buffer is kept.
+    /// Each re-rendered tile still gets all triangles overlapping it, so its pixels are the same as for a full render.
+    /// Shadows from moved objects can fall anywhere, so the whole screen is always rendered while shadows are enabled.
+    class BinningRasterizer
+    {
+    public:
+        // CONSTRUCTION/DESTRUCTION.
+        BinningRasterizer() = default;
+        ~BinningRasterizer();
+        BinningRasterizer(const BinningRasterizer&) = delete;
+        BinningRasterizer& operator=(const BinningRasterizer&) = delete;
+
+        // RENDERING.
+        void Invalidate();
+        void Release();
+        void Render(
+            const GRAPHICS::Scene& scene,
+            const GRAPHICS::VIEWING::Camera& camera,
+            const GRAPHICS::RenderingSettings& rendering_settings,
+            const CpuRenderingSettings& cpu_rendering_settings,
+            const bool only_object_transforms_changed,
+            THREADING::WorkStealingThreadPool& thread_pool,
+            GRAPHICS::IMAGES::Bitmap& color_buffer);
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// Counts of geometry skipped by culling in the most recent render.
+        CullingStatistics Statistics = {};
+
+    private:
+        /// The maximum number of vertices a triangle can have after being clipped by all clip planes.
+        static constexpr std::size_t MAX_CLIPPED_VERTEX_COUNT = 9;
+        /// The number of planes triangles are clipped against.
+        static constexpr std::size_t CLIP_PLANE_COUNT = 6;
+
+        /// An object's triangles along with where their vertices are for the current frame.
+        struct ObjectGeometry
+        {
+            /// The object this geometry was created from.
+            const GRAPHICS::Object3D* SourceObject = nullptr;
+            /// The world transform of the object for the current frame.
+            AffineTransform WorldTransform = {};
+            /// All visible triangles in the object, in object space.
+            /// Shared with other renderers through the object mesh cache, and so that levels of detail can be generated from it in the background.
+            std::shared_ptr<const IndexedMesh> FullDetailMesh = nullptr;
+            /// The bounds of the full detail mesh, in object space.
+            BoundingBox MeshBounds = {};
+            /// The handle in the material table of each material in the mesh, by its ID in the mesh.
+            /// Levels of detail keep the full detail mesh's material IDs, so this applies to all of them.
+            std::vector<MaterialHandle> MaterialHandles = {};
+            /// Simplified versions of the full detail mesh, which may still be being generated.
+            /// Not valid if the mesh is too simple to need them or levels of detail haven't been enabled since it was built.
+            std::shared_future<std::shared_ptr<const MeshLevelsOfDetail>> LevelsOfDetail = {};
+            /// The mesh rendered for the current frame: either the full detail mesh or one of its levels of detail.
+            const IndexedMesh* RenderedMesh = nullptr;
+            /// True if the object moved or its rendered mesh changed since the previous frame.
+            bool Changed = true;
+            /// The pixels the object may cover on screen in the most recent render, from its projected bounds.
+            ScreenRectangle ScreenBounds = {};
+            /// True if the object is entirely outside the view frustum for the current frame.
+            bool OutsideFrustum = false;
+            /// The world position of each vertex in the rendered mesh.
+            std::vector<MATH::Vector3f> WorldPositions = {};
+            /// The world normal of each vertex in the rendered mesh.  May be zero if the model lacks normals.
+            std::vector<MATH::Vector3f> WorldNormals = {};
+            /// The position of each vertex relative to the camera, along the camera's right (X), up (Y), and forward (Z) directions.
+            std::vector<MATH::Vector3f> CameraPositions = {};
+        };
+
+        /// A request to generate levels of detail for a mesh on the level of detail thread.
+        struct LevelOfDetailJob
+        {
+            /// The mesh to generate levels of detail for, kept alive until they're generated.
+            std::shared_ptr<const IndexedMesh> FullDetailMesh = nullptr;
+            /// The generated levels of detail; null if generation failed.
+            std::promise<std::shared_ptr<const MeshLevelsOfDetail>> LevelsOfDetail = {};
+        };
+
+        /// The meshes of an object from before objects were rebuilt.
+        struct PreviousObjectMesh
+        {
+            /// The full detail mesh.
+            std::shared_ptr<const IndexedMesh> FullDetailMesh = nullptr;
+            /// The levels of detail for the mesh, if any.
+            std::shared_future<std::shared_ptr<const MeshLevelsOfDetail>> LevelsOfDetail = {};
+        };
+
+        /// A range of consecutive vertices or triangles within a single object, processed as a single task.
+        struct ObjectRange
+        {
+            /// The index of the object.
+            uint32_t ObjectIndex = 0;
+            /// The index of the first vertex or triangle in the range.
+            uint32_t FirstIndex = 0;
+            /// The number of vertices or triangles in the range.
+            uint32_t Count = 0;
+        };
+
+        /// A plane in camera space that geometry is clipped against.  Points are inside where the plane's function is non-negative.
+        struct ClipPlane
+        {
+            /// The normal of the plane, pointing inside.
+            MATH::Vector3f Normal = MATH::Vector3f(0.0f, 0.0f, 1.0f);
+            /// The offset of the plane's function.
+            float Offset = 0.0f;
+        };
+
+        /// Camera and screen information precomputed once per frame for projecting vertices.
+        struct Projection
+        {
+            /// The position of the camera.
+            MATH::Vector3f Origin = MATH::Vector3f(0.0f, 0.0f, 0.0f);
+            /// The camera's normalized right direction.
+            MATH::Vector3f Right = MATH::Vector3f(1.0f, 0.0f, 0.0f);
+            /// The camera's normalized up direction.
+            MATH::Vector3f Up = MATH::Vector3f(0.0f, 1.0f, 0.0f);
+            /// The camera's normalized forward direction.
+            MATH::Vector3f Forward = MATH::Vector3f(0.0f, 0.0f, -1.0f);
+            /// True for perspective projection; false for orthographic.
+            bool Perspective = true;
+            /// Half of the viewing plane width (at a distance of 1 for perspective projection).
+            float HalfWidth = 1.0f;
+            /// Half of the viewing plane height (at a distance of 1 for perspective projection).
+            float HalfHeight = 1.0f;
+            /// The width of the screen.
+            unsigned int WidthInPixels = 0;
+            /// The height of the screen.
+            unsigned int HeightInPixels = 0;
+            /// The planes that triangles are clipped against: the near and far planes and a guard band around the screen.
+            ClipPlane ClipPlanes[CLIP_PLANE_COUNT] = {};
+            /// The region of world space visible on screen, for culling.
+            ViewFrustum Frustum = {};
+        };
+
+        /// How the screen is split into tiles.
+        struct TileGrid
+        {
+            /// The width and height of tiles.
+            unsigned int TileSizeInPixels = 1;
+            /// The number of columns of tiles.
+            unsigned int ColumnCount = 0;
+            /// The number of rows of tiles.
+            unsigned int RowCount = 0;
+        };
+
+        /// A vertex of a triangle being clipped.
+        struct ClipVertex
+        {
+            /// The position of the vertex relative to the camera.
+            MATH::Vector3f CameraPosition = MATH::Vector3f(0.0f, 0.0f, 0.0f);
+            /// The barycentric coordinates of the vertex within the original unclipped triangle.
+            MATH::Vector3f SourceBarycentrics = MATH::Vector3f(0.0f, 0.0f, 0.0f);
+        };
+
+        /// A triangle projected onto the screen and set up for rasterization.
+        ///
+        /// Screen positions are in fixed point with SUBPIXEL_BITS bits of fraction.  For each vertex, the edge function
+        /// (A * x + B * y + C) is zero along the opposite edge and equals twice the triangle's area at the vertex,
+        /// so it's positive inside the triangle and proportional to the barycentric coordinate of the vertex.
+        struct ScreenTriangle
+        {
+            /// The change in each edge function per fixed-point unit in the x direction.
+            int64_t EdgeA[3] = {};
+            /// The change in each edge function per fixed-point unit in the y direction.
+            int64_t EdgeB[3] = {};
+            /// The value of each edge function at the origin.
+            int64_t EdgeC[3] = {};
+            /// Added to each edge function before checking if it's non-negative, so that pixels exactly on
+            /// a shared edge are only covered by one of the triangles sharing it.
+            int64_t EdgeBiases[3] = {};
+            /// The reciprocal of twice the triangle's area, for normalizing edge functions into barycentric coordinates.
+            float InverseDoubleArea = 0.0f;
+            /// For each vertex, a value that's larger closer to the camera and varies linearly across the screen.
+            float Closenesses[3] = {};
+            /// The largest of the vertex closenesses, which no pixel in the triangle can exceed.
+            float MaxCloseness = 0.0f;
+            /// For each vertex, the weight for perspective-correct interpolation of attributes.
+            float PerspectiveWeights[3] = {};
+            /// For each vertex, its barycentric coordinates within the original unclipped triangle.
+            MATH::Vector3f SourceBarycentrics[3] = {};
+            /// The index of the object containing the original triangle.
+            uint32_t ObjectIndex = 0;
+            /// The index of the original triangle within its object's mesh.
+            uint32_t TriangleIndex = 0;
+            /// The handle of the triangle's material in the material table.
+            MaterialHandle Material = MaterialTable::NO_MATERIAL;
+            /// The pixels that might be covered by the triangle, within the screen.
+            ScreenRectangle Bounds = {};
+        };
+
+        /// The triangles set up by a single task, sorted into bins for the tiles they overlap.
+        /// Batches only last for a single frame, so their memory comes from the frame arena of the worker setting them up.
+        struct TriangleBatch
+        {
+            /// The triangles in their original order.
+            MEMORY::ArenaVector<ScreenTriangle> Triangles = {};
+            /// The offset of each tile's bin in the binned triangle indices, with an extra entry at the end.
+            MEMORY::ArenaVector<uint32_t> TileBinOffsets = {};
+            /// The next offset to fill in each tile's bin while sorting.
+            MEMORY::ArenaVector<uint32_t> TileBinCursors = {};
+            /// The indices of triangles in each tile's bin, in their original order within each bin.
+            MEMORY::ArenaVector<uint32_t> BinnedTriangleIndices = {};
+        };
+
+        /// Scratch memory for rasterizing a single tile at a time on a single thread.
+        struct TileScratch
+        {
+            /// The closeness of the closest triangle found so far for each pixel in the tile.
+            std::vector<float> Closenesses = {};
+            /// The closest triangle found so far for each pixel in the tile; null if none.
+            std::vector<const ScreenTriangle*> VisibleTriangles = {};
+            /// The number of triangles skipped by hierarchical depth culling in all tiles rasterized with this scratch memory.
+            std::size_t OccludedTriangleCount = 0;
+        };
+
+        // HELPER METHODS.
+        bool UpdateObjectGeometry(
+            const GRAPHICS::Scene& scene,
+            const Projection& projection,
+            const CpuRenderingSettings& cpu_rendering_settings);
+        std::shared_future<std::shared_ptr<const MeshLevelsOfDetail>> FindOrQueueLevelsOfDetail(
+            const std::shared_ptr<const IndexedMesh>& full_detail_mesh);
+        void GenerateQueuedLevelsOfDetail();
+        static const IndexedMesh& SelectLevelOfDetail(
+            const ObjectGeometry& object_geometry,
+            const Projection& projection,
+            const CpuRenderingSettings& cpu_rendering_settings);
+        void CullGeometry(const Projection& projection, const bool frustum_culling);
+        void FindTilesToRender(const Projection& projection, const TileGrid& tile_grid, const bool only_changed_objects);
+        static ScreenRectangle ComputeScreenBounds(const ObjectGeometry& object_geometry, const Projection& projection);
+        static Projection ComputeProjection(
+            const GRAPHICS::VIEWING::Camera& camera,
+            const unsigned int width_in_pixels,
+            const unsigned int height_in_pixels);
+        void TransformVertices(const ObjectRange& vertex_range, const Projection& projection);
+        void SetUpTriangles(
+            const ObjectRange& triangle_range,
+            const Projection& projection,
+            const bool cull_backfaces,
+            const TileGrid& tile_grid,
+            MEMORY::LinearArena& arena,
+            TriangleBatch& batch) const;
+        static std::size_t ClipTriangle(const Projection& projection, ClipVertex* vertices);
+        static void AddScreenTriangle(
+            const Projection& projection,
+            const ClipVertex& first_vertex,
+            const ClipVertex& second_vertex,
+            const ClipVertex& third_vertex,
+            const ScreenTriangle& original_triangle,
+            MEMORY::ArenaVector<ScreenTriangle>& triangles);
+        void RasterizeTile(
+            const std::size_t tile_index,
+            const TileGrid& tile_grid,
+            const Projection& projection,
+            const GRAPHICS::Scene& scene,
+            const GRAPHICS::RenderingSettings& rendering_settings,
+            const bool hierarchical_depth_culling,
+            const SurfaceShading::ShadowTestFunction& is_shadowed,
+            TileScratch& scratch,
+            uint32_t* pixels) const;
+        static MATH::Vector3f ComputeSourceBarycentrics(const ScreenTriangle& triangle, const int64_t x, const int64_t y);
+        MATH::Vector2f InterpolateTextureCoordinates(const ScreenTriangle& triangle, const MATH::Vector3f& source_barycentrics) const;
+        GRAPHICS::Color ShadePixel(
+            const ScreenTriangle& triangle,
+            const int x,
+            const int y,
+            const Projection& projection,
+            const GRAPHICS::Scene& scene,
+            const GRAPHICS::RenderingSettings& rendering_settings,
+            const SurfaceShading::ShadowTestFunction& is_shadowed) const;
+
+        // PRIVATE MEMBER VARIABLES.
+        /// True if object geometry must be fully rebuilt on the next render, such as after objects are loaded
+        /// or edited in ways other than their transforms; false if it can be reused.
+        bool RebuildNeeded = true;
+        /// The geometry for each object in the scene, in the same order as the scene's objects.
+        std::vector<ObjectGeometry> Objects = {};
+        /// The unique materials of all objects, referenced by handle from triangles being rendered.
+        MaterialTable Materials = {};
+        /// The scene's geometry prepared for tracing shadow rays.  Only kept while shadows are enabled.
+        RAY_TRACING::RayTracingScene ShadowScene = {};
+        /// The meshes of objects from before they were rebuilt, only filled while rebuilding.  They're kept until all objects
+        /// are rebuilt so that meshes and levels of detail still used (such as when other objects are loaded or removed)
+        /// are found in the object mesh cache rather than freed and generated again.
+        /// Kept between renders so that a vector doesn't need to be created each frame.
+        std::vector<PreviousObjectMesh> PreviousObjectMeshes = {};
+        /// Protects the level of detail jobs below, which are shared with the level of detail thread.
+        std::mutex LevelOfDetailMutex = {};
+        /// Signaled when a level of detail job is queued or the level of detail thread should stop.
+        std::condition_variable LevelOfDetailJobQueued = {};
+        /// Meshes waiting for levels of detail to be generated, in the order they were queued.
+        std::deque<LevelOfDetailJob> LevelOfDetailJobs = {};
+        /// The levels of detail queued or being generated, by the address of their full detail mesh, so that meshes aren't
+        /// queued twice.  Jobs keep their meshes alive, so the addresses can't be reused by other meshes while in here.
+        std::unordered_map<const IndexedMesh*, std::shared_future<std::shared_ptr<const MeshLevelsOfDetail>>> PendingLevelsOfDetail = {};
+        /// Set when the rasterizer is destroyed to stop the level of detail thread, including any generation in progress.
+        std::atomic<bool> LevelOfDetailStopRequested = false;
+        /// The thread generating levels of detail, only started once levels of detail are first queued.
+        std::thread LevelOfDetailThread = {};
+        /// The vertices to transform in each task.
+        std::vector<ObjectRange> VertexRanges = {};
+        /// The triangles to set up in each task.
+        std::vector<ObjectRange> TriangleRanges = {};
+        /// The object-space bounds of the triangles in each triangle range, for culling clusters of triangles.
+        std::vector<BoundingBox> TriangleRangeBounds = {};
+        /// The indices of vertex ranges in objects that weren't culled for the current frame.
+        std::vector<uint32_t> VisibleVertexRangeIndices = {};
+        /// The indices of triangle ranges that weren't culled for the current frame.
+        std::vector<uint32_t> VisibleTriangleRangeIndices = {};
+        /// The triangles set up by each task for visible triangle ranges.  Emptied at the end of each render
+        /// since the batches' memory is only valid until worker arenas are reset for the next frame.
+        std::vector<TriangleBatch> TriangleBatches = {};
+        /// Scratch memory for each worker thread.
+        std::vector<TileScratch> TileScratches = {};
+        /// The indices of tiles to rasterize for the current frame, in increasing order.
+        std::vector<uint32_t> TileIndicesToRender = {};
+        /// The pixels of the color buffer most recently rendered into; null if nothing was rendered since objects were released.
+        /// Only changed objects may be re-rendered if the same color buffer is rendered into again at the same size.
+        const uint32_t* RenderedPixels = nullptr;
+        /// The width of the color buffer most recently rendered into.
+        unsigned int RenderedWidthInPixels = 0;
+        /// The height of the color buffer most recently rendered into.
+        unsigned int RenderedHeightInPixels = 0;
+    };
+}
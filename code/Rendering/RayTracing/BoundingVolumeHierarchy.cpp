@@ -0,0 +1,287 @@
+#include <array>
+#include <limits>
+#include <numeric>
+#include "Rendering/RayTracing/BoundingVolumeHierarchy.h"
+
+namespace RENDERING::RAY_TRACING
+{
+    /// The number of bins that primitive centers are sorted into along each axis when searching for splits.
+    /// Binning is much faster than evaluating every possible split and loses very little quality.
+    constexpr std::size_t SAH_BIN_COUNT = 16;
+    /// The cost of traversing an interior node, relative to intersecting a single primitive.
+    constexpr float SAH_TRAVERSAL_COST = 1.0f;
+    /// The maximum number of primitives in a leaf.  Nodes with more are always split if possible.
+    constexpr uint32_t MAX_LEAF_PRIMITIVE_COUNT = 8;
+
+    /// Gets a single component of a vector by axis index.
+    /// @param[in]  vector - The vector to get a component of.
+    /// @param[in]  axis_index - The axis (0 = X, 1 = Y, 2 = Z).
+    /// @return The component of the vector along the axis.
+    static float GetAxisComponent(const MATH::Vector3f& vector, const std::size_t axis_index)
+    {
+        switch (axis_index)
+        {
+            case 0:
+                return vector.X;
+            case 1:
+                return vector.Y;
+            default:
+                return vector.Z;
+        }
+    }
+
+    /// Builds the hierarchy from scratch for a set of primitives.
+    /// @param[in]  primitive_bounds - The bounds of each primitive.  Indices into this are the primitive indices.
+    void BoundingVolumeHierarchy::Build(const std::vector<BoundingBox>& primitive_bounds)
+    {
+        // RESET THE HIERARCHY.
+        Nodes.clear();
+        PrimitiveIndices.resize(primitive_bounds.size());
+        std::iota(PrimitiveIndices.begin(), PrimitiveIndices.end(), 0);
+        if (primitive_bounds.empty())
+        {
+            return;
+        }
+
+        // PRECOMPUTE PRIMITIVE CENTERS.
+        // Splits are chosen based on centers since each primitive ends up entirely on one side.
+        PrimitiveCenters.clear();
+        for (const BoundingBox& bounds : primitive_bounds)
+        {
+            PrimitiveCenters.emplace_back(bounds.Center());
+        }
+
+        // BUILD ALL NODES STARTING AT THE ROOT.
+        // A binary tree with at least 1 primitive per leaf has fewer than 2 nodes per primitive.
+        // Nodes are built from an explicit stack rather than recursively so that deep hierarchies can't overflow
+        // the call stack.  Left children are pushed last so that they're built right after their parents.
+        Nodes.reserve(2 * primitive_bounds.size());
+        NodeBuildTasks.clear();
+        NodeBuildTasks.push_back(NodeBuildTask { .PrimitiveCount = static_cast<uint32_t>(primitive_bounds.size()) });
+        while (!NodeBuildTasks.empty())
+        {
+            NodeBuildTask task = NodeBuildTasks.back();
+            NodeBuildTasks.pop_back();
+
+            // LINK RIGHT CHILDREN TO THEIR PARENTS.
+            uint32_t node_index = static_cast<uint32_t>(Nodes.size());
+            if (NO_PARENT != task.ParentIndex)
+            {
+                Nodes[task.ParentIndex].FirstPrimitiveOrRightChildIndex = node_index;
+            }
+
+            // BUILD THE NODE.
+            uint32_t left_primitive_count = BuildNode(primitive_bounds, PrimitiveCenters, task);
+
+            // QUEUE ANY CHILDREN.
+            bool node_split = (left_primitive_count > 0);
+            if (node_split)
+            {
+                NodeBuildTasks.push_back(NodeBuildTask
+                {
+                    .FirstPrimitiveIndex = task.FirstPrimitiveIndex + left_primitive_count,
+                    .PrimitiveCount = task.PrimitiveCount - left_primitive_count,
+                    .Depth = task.Depth + 1,
+                    .ParentIndex = node_index,
+                });
+                NodeBuildTasks.push_back(NodeBuildTask
+                {
+                    .FirstPrimitiveIndex = task.FirstPrimitiveIndex,
+                    .PrimitiveCount = left_primitive_count,
+                    .Depth = task.Depth + 1,
+                });
+            }
+        }
+    }
+
+    /// Updates node bounds for moved primitives without changing the structure of the hierarchy.
+    /// This is much cheaper than rebuilding, but the hierarchy may become less efficient if primitives
+    /// move relative to each other.  Rigid object transforms keep it efficient.
+    /// @param[in]  primitive_bounds - The new bounds of each primitive.  Must be the same primitives as when built.
+    void BoundingVolumeHierarchy::Refit(const std::vector<BoundingBox>& primitive_bounds)
+    {
+        // UPDATE NODES FROM THE BOTTOM UP.
+        // Since nodes are stored depth-first, children always come after their parents,
+        // so iterating in reverse order updates children before parents.
+        for (std::size_t node_index = Nodes.size(); node_index-- > 0;)
+        {
+            BoundingVolumeHierarchyNode& node = Nodes[node_index];
+            node.Bounds = BoundingBox();
+            if (node.PrimitiveCount > 0)
+            {
+                for (uint32_t leaf_index = 0; leaf_index < node.PrimitiveCount; ++leaf_index)
+                {
+                    uint32_t primitive_index = PrimitiveIndices[node.FirstPrimitiveOrRightChildIndex + leaf_index];
+                    node.Bounds.Expand(primitive_bounds[primitive_index]);
+                }
+            }
+            else
+            {
+                node.Bounds.Expand(Nodes[node_index + 1].Bounds);
+                node.Bounds.Expand(Nodes[node.FirstPrimitiveOrRightChildIndex].Bounds);
+            }
+        }
+    }
+
+    /// Gets the bounds of all primitives in the hierarchy.
+    /// @return The bounds of the root node; empty if there are no primitives.
+    BoundingBox BoundingVolumeHierarchy::Bounds() const
+    {
+        if (Nodes.empty())
+        {
+            return BoundingBox();
+        }
+
+        return Nodes.front().Bounds;
+    }
+
+    /// Builds a single node at the end of the node list, either as a leaf or as an interior node whose primitives
+    /// are partitioned between its children.  The children are left for the caller to build.
+    /// @param[in]  primitive_bounds - The bounds of each primitive.
+    /// @param[in]  primitive_centers - The center of each primitive's bounds.
+    /// @param[in]  task - The node to build.
+    /// @return The number of primitives in the left child if the node was split; 0 if the node is a leaf.
+    uint32_t BoundingVolumeHierarchy::BuildNode(
+        const std::vector<BoundingBox>& primitive_bounds,
+        const std::vector<MATH::Vector3f>& primitive_centers,
+        const NodeBuildTask& task)
+    {
+        const uint32_t first_primitive_index = task.FirstPrimitiveIndex;
+        const uint32_t primitive_count = task.PrimitiveCount;
+
+        // CREATE THE NODE.
+        uint32_t node_index = static_cast<uint32_t>(Nodes.size());
+        Nodes.emplace_back();
+
+        // COMPUTE THE BOUNDS OF THE NODE AND ITS PRIMITIVE CENTERS.
+        BoundingBox node_bounds;
+        BoundingBox center_bounds;
+        for (uint32_t index = first_primitive_index; index < first_primitive_index + primitive_count; ++index)
+        {
+            uint32_t primitive_index = PrimitiveIndices[index];
+            node_bounds.Expand(primitive_bounds[primitive_index]);
+            center_bounds.Expand(primitive_centers[primitive_index]);
+        }
+        Nodes[node_index].Bounds = node_bounds;
+
+        // MAKE A LEAF IF THERE ARE TOO FEW PRIMITIVES TO BE WORTH SPLITTING OR THE NODE IS AS DEEP AS ALLOWED.
+        // Only degenerate inputs get anywhere near the maximum depth, so the larger leaves this can create are rare.
+        auto make_leaf = [&]()
+        {
+            Nodes[node_index].FirstPrimitiveOrRightChildIndex = first_primitive_index;
+            Nodes[node_index].PrimitiveCount = primitive_count;
+            return 0u;
+        };
+        constexpr uint32_t MIN_SPLITTABLE_PRIMITIVE_COUNT = 2;
+        bool max_depth_reached = (task.Depth >= MAX_DEPTH);
+        if (primitive_count < MIN_SPLITTABLE_PRIMITIVE_COUNT || max_depth_reached)
+        {
+            return make_leaf();
+        }
+
+        // FIND THE BEST SPLIT ACROSS ALL AXES USING THE SURFACE AREA HEURISTIC.
+        // The expected cost of a split is proportional to the surface areas of the children
+        // (the probability of a ray hitting them) times their primitive counts.
+        struct Bin
+        {
+            BoundingBox Bounds = {};
+            uint32_t PrimitiveCount = 0;
+        };
+        float best_split_cost = std::numeric_limits<float>::max();
+        std::size_t best_axis_index = 0;
+        std::size_t best_split_bin_index = 0;
+        for (std::size_t axis_index = 0; axis_index < 3; ++axis_index)
+        {
+            // SKIP AXES WHERE ALL CENTERS ARE THE SAME.
+            float axis_min = GetAxisComponent(center_bounds.Min, axis_index);
+            float axis_max = GetAxisComponent(center_bounds.Max, axis_index);
+            float axis_extent = axis_max - axis_min;
+            if (axis_extent <= 0.0f)
+            {
+                continue;
+            }
+
+            // SORT PRIMITIVES INTO BINS.
+            std::array<Bin, SAH_BIN_COUNT> bins = {};
+            float bins_per_unit = static_cast<float>(SAH_BIN_COUNT) / axis_extent;
+            for (uint32_t index = first_primitive_index; index < first_primitive_index + primitive_count; ++index)
+            {
+                uint32_t primitive_index = PrimitiveIndices[index];
+                float center = GetAxisComponent(primitive_centers[primitive_index], axis_index);
+                std::size_t bin_index = std::min(static_cast<std::size_t>((center - axis_min) * bins_per_unit), SAH_BIN_COUNT - 1);
+                bins[bin_index].Bounds.Expand(primitive_bounds[primitive_index]);
+                ++bins[bin_index].PrimitiveCount;
+            }
+
+            // SWEEP FROM THE RIGHT TO COMPUTE COSTS FOR THE RIGHT SIDE OF EACH SPLIT.
+            // Split i puts bins [0, i] on the left and (i, SAH_BIN_COUNT) on the right.
+            std::array<float, SAH_BIN_COUNT - 1> right_costs = {};
+            BoundingBox right_bounds;
+            uint32_t right_count = 0;
+            for (std::size_t bin_index = SAH_BIN_COUNT - 1; bin_index > 0; --bin_index)
+            {
+                right_bounds.Expand(bins[bin_index].Bounds);
+                right_count += bins[bin_index].PrimitiveCount;
+                right_costs[bin_index - 1] = right_bounds.SurfaceArea() * static_cast<float>(right_count);
+            }
+
+            // SWEEP FROM THE LEFT TO FIND THE CHEAPEST SPLIT.
+            BoundingBox left_bounds;
+            uint32_t left_count = 0;
+            for (std::size_t split_index = 0; split_index < SAH_BIN_COUNT - 1; ++split_index)
+            {
+                left_bounds.Expand(bins[split_index].Bounds);
+                left_count += bins[split_index].PrimitiveCount;
+                bool split_separates_primitives = (left_count > 0) && (left_count < primitive_count);
+                if (!split_separates_primitives)
+                {
+                    continue;
+                }
+
+                float split_cost = left_bounds.SurfaceArea() * static_cast<float>(left_count) + right_costs[split_index];
+                if (split_cost < best_split_cost)
+                {
+                    best_split_cost = split_cost;
+                    best_axis_index = axis_index;
+                    best_split_bin_index = split_index;
+                }
+            }
+        }
+
+        // MAKE A LEAF IF NO SPLIT IS POSSIBLE OR IF SPLITTING ISN'T WORTH IT.
+        bool split_found = (best_split_cost < std::numeric_limits<float>::max());
+        if (!split_found)
+        {
+            return make_leaf();
+        }
+        float node_surface_area = node_bounds.SurfaceArea();
+        float normalized_split_cost = SAH_TRAVERSAL_COST + ((node_surface_area > 0.0f) ? best_split_cost / node_surface_area : 0.0f);
+        float leaf_cost = static_cast<float>(primitive_count);
+        bool splitting_worthwhile = (normalized_split_cost < leaf_cost) || (primitive_count > MAX_LEAF_PRIMITIVE_COUNT);
+        if (!splitting_worthwhile)
+        {
+            return make_leaf();
+        }
+
+        // PARTITION PRIMITIVES BASED ON THE SPLIT.
+        float axis_min = GetAxisComponent(center_bounds.Min, best_axis_index);
+        float axis_extent = GetAxisComponent(center_bounds.Max, best_axis_index) - axis_min;
+        float bins_per_unit = static_cast<float>(SAH_BIN_COUNT) / axis_extent;
+        auto first_index = PrimitiveIndices.begin() + first_primitive_index;
+        auto middle_index = std::partition(
+            first_index,
+            first_index + primitive_count,
+            [&](const uint32_t primitive_index)
+            {
+                float center = GetAxisComponent(primitive_centers[primitive_index], best_axis_index);
+                std::size_t bin_index = std::min(static_cast<std::size_t>((center - axis_min) * bins_per_unit), SAH_BIN_COUNT - 1);
+                return bin_index <= best_split_bin_index;
+            });
+        uint32_t left_primitive_count = static_cast<uint32_t>(middle_index - first_index);
+
+        // MAKE THE NODE AN INTERIOR NODE.
+        // The right child index is filled in once the right child is built.
+        Nodes[node_index].PrimitiveCount = 0;
+        return left_primitive_count;
+    }
+}
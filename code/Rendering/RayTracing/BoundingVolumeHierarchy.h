@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Rendering/BoundingBox.h"
+#include "Rendering/RayTracing/Ray.h"
+
+namespace RENDERING::RAY_TRACING
+{
+    /// A node in a bounding volume hierarchy.
+    /// Nodes are stored depth-first, so the left child of an interior node immediately follows it.
+    struct BoundingVolumeHierarchyNode
+    {
+        /// The bounds of all primitives under the node.
+        BoundingBox Bounds = {};
+        /// For leaves, the index of the first primitive index in the hierarchy's primitive index list.
+        /// For interior nodes, the index of the right child node.
+        uint32_t FirstPrimitiveOrRightChildIndex = 0;
+        /// The number of primitives in a leaf.  0 for interior nodes.
+        uint32_t PrimitiveCount = 0;
+    };
+
+    /// A bounding volume hierarchy (BVH) over arbitrary primitives, built using the surface area heuristic (SAH)
+    /// so that rays only need to be tested against a small fraction of primitives.
+    ///
+    /// The hierarchy only knows primitive bounds; callers intersect the primitives themselves via Traverse().
+    /// When primitives move without changing topology (such as when an object is moved), the hierarchy
+    /// can be cheaply refit to new bounds instead of being rebuilt.
+    ///
+    /// Hierarchies are never deeper than MAX_DEPTH, even for degenerate inputs (such as many tiny primitives
+    /// packed next to a distant one), so traversal always fits in a fixed-size stack.
+    class BoundingVolumeHierarchy
+    {
+    public:
+        // CONSTANTS.
+        /// The maximum depth of any node, with the root at a depth of 0.  Nodes this deep are always leaves.
+        static constexpr uint32_t MAX_DEPTH = 63;
+        /// The maximum number of nodes waiting to be visited during traversal.  Each level visited leaves at most
+        /// one sibling waiting, so this is one more than the maximum depth.
+        static constexpr std::size_t MAX_TRAVERSAL_STACK_SIZE = MAX_DEPTH + 1;
+
+        // BUILDING.
+        void Build(const std::vector<BoundingBox>& primitive_bounds);
+        void Refit(const std::vector<BoundingBox>& primitive_bounds);
+
+        // QUERIES.
+        BoundingBox Bounds() const;
+
+        /// Visits all primitives whose bounds may be hit by a ray, nearest nodes first.
+        /// @tparam VisitPrimitiveFunction - A function taking a primitive index and returning true to stop traversal
+        ///     (such as for any-hit queries) or false to continue.
+        /// @param[in]  ray - The ray to traverse the hierarchy with.
+        /// @param[in]  min_distance - The minimum distance along the ray to consider.
+        /// @param[in]  max_distance - The maximum distance along the ray to consider.  This is read through
+        ///     a reference so that closest-hit queries can shrink it as closer hits are found, culling farther nodes.
+        /// @param[in]  visit_primitive - The function to visit each primitive with.
+        /// @return True if traversal was stopped by the visit function; false otherwise.
+        template <typename VisitPrimitiveFunction>
+        bool Traverse(const Ray& ray, const float min_distance, const float& max_distance, VisitPrimitiveFunction visit_primitive) const
+        {
+            // HANDLE EMPTY HIERARCHIES.
+            if (Nodes.empty())
+            {
+                return false;
+            }
+
+            // PRECOMPUTE RAY INFORMATION FOR BOX TESTS.
+            MATH::Vector3f inverse_direction(1.0f / ray.Direction.X, 1.0f / ray.Direction.Y, 1.0f / ray.Direction.Z);
+
+            // TRAVERSE NODES USING AN EXPLICIT STACK.
+            // The build limits the depth of the hierarchy so that this can't overflow.
+            uint32_t node_index_stack[MAX_TRAVERSAL_STACK_SIZE];
+            std::size_t stack_size = 0;
+            node_index_stack[stack_size++] = 0;
+            while (stack_size > 0)
+            {
+                const BoundingVolumeHierarchyNode& node = Nodes[node_index_stack[--stack_size]];
+                float node_entry_distance = 0.0f;
+                if (!IntersectBox(ray, inverse_direction, node.Bounds, min_distance, max_distance, node_entry_distance))
+                {
+                    continue;
+                }
+
+                // VISIT PRIMITIVES IN LEAVES.
+                if (node.PrimitiveCount > 0)
+                {
+                    for (uint32_t leaf_index = 0; leaf_index < node.PrimitiveCount; ++leaf_index)
+                    {
+                        uint32_t primitive_index = PrimitiveIndices[node.FirstPrimitiveOrRightChildIndex + leaf_index];
+                        if (visit_primitive(primitive_index))
+                        {
+                            return true;
+                        }
+                    }
+                    continue;
+                }
+
+                // VISIT THE NEARER CHILD FIRST.
+                // It is pushed last so that it is popped first, which helps closest-hit queries cull the farther child.
+                uint32_t left_child_index = static_cast<uint32_t>(&node - Nodes.data()) + 1;
+                uint32_t right_child_index = node.FirstPrimitiveOrRightChildIndex;
+                float left_entry_distance = 0.0f;
+                float right_entry_distance = 0.0f;
+                bool left_hit = IntersectBox(ray, inverse_direction, Nodes[left_child_index].Bounds, min_distance, max_distance, left_entry_distance);
+                bool right_hit = IntersectBox(ray, inverse_direction, Nodes[right_child_index].Bounds, min_distance, max_distance, right_entry_distance);
+                if (left_hit && right_hit)
+                {
+                    assert(stack_size + 2 <= MAX_TRAVERSAL_STACK_SIZE);
+                    bool left_nearer = (left_entry_distance <= right_entry_distance);
+                    node_index_stack[stack_size++] = left_nearer ? right_child_index : left_child_index;
+                    node_index_stack[stack_size++] = left_nearer ? left_child_index : right_child_index;
+                }
+                else if (left_hit)
+                {
+                    assert(stack_size < MAX_TRAVERSAL_STACK_SIZE);
+                    node_index_stack[stack_size++] = left_child_index;
+                }
+                else if (right_hit)
+                {
+                    assert(stack_size < MAX_TRAVERSAL_STACK_SIZE);
+                    node_index_stack[stack_size++] = right_child_index;
+                }
+            }
+
+            return false;
+        }
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The nodes of the hierarchy, with the root first.
+        std::vector<BoundingVolumeHierarchyNode> Nodes = {};
+        /// Indices of primitives, ordered so that each leaf references a contiguous range.
+        std::vector<uint32_t> PrimitiveIndices = {};
+
+    private:
+        /// A node waiting to be built.
+        struct NodeBuildTask
+        {
+            /// The index of the first primitive index for the node.
+            uint32_t FirstPrimitiveIndex = 0;
+            /// The number of primitives under the node.
+            uint32_t PrimitiveCount = 0;
+            /// The depth of the node, with the root at a depth of 0.
+            uint32_t Depth = 0;
+            /// For right children, the index of the parent node, which needs to reference the child once it's created.
+            /// NO_PARENT for the root and left children, which always immediately follow their parents.
+            uint32_t ParentIndex = NO_PARENT;
+        };
+        /// Indicates that a node being built doesn't need to be referenced by its parent.
+        static constexpr uint32_t NO_PARENT = UINT32_MAX;
+
+        // HELPER METHODS.
+        uint32_t BuildNode(
+            const std::vector<BoundingBox>& primitive_bounds,
+            const std::vector<MATH::Vector3f>& primitive_centers,
+            const NodeBuildTask& task);
+
+        /// Intersects a ray with a box using the slab method.
+        /// @param[in]  ray - The ray to intersect.
+        /// @param[in]  inverse_direction - The reciprocal of each component of the ray direction.
+        /// @param[in]  box - The box to intersect.
+        /// @param[in]  min_distance - The minimum distance along the ray to consider.
+        /// @param[in]  max_distance - The maximum distance along the ray to consider.
+        /// @param[out] entry_distance - The distance along the ray where it enters the box, if hit.
+        /// @return True if the ray overlaps the box within the distance range; false otherwise.
+        static bool IntersectBox(
+            const Ray& ray,
+            const MATH::Vector3f& inverse_direction,
+            const BoundingBox& box,
+            const float min_distance,
+            const float max_distance,
+            float& entry_distance)
+        {
+            float x_distance_to_min = (box.Min.X - ray.Origin.X) * inverse_direction.X;
+            float x_distance_to_max = (box.Max.X - ray.Origin.X) * inverse_direction.X;
+            float y_distance_to_min = (box.Min.Y - ray.Origin.Y) * inverse_direction.Y;
+            float y_distance_to_max = (box.Max.Y - ray.Origin.Y) * inverse_direction.Y;
+            float z_distance_to_min = (box.Min.Z - ray.Origin.Z) * inverse_direction.Z;
+            float z_distance_to_max = (box.Max.Z - ray.Origin.Z) * inverse_direction.Z;
+
+            // The ray enters the box once it is within all slabs and exits once it leaves any slab.
+            float x_near = std::min(x_distance_to_min, x_distance_to_max);
+            float x_far = std::max(x_distance_to_min, x_distance_to_max);
+            float y_near = std::min(y_distance_to_min, y_distance_to_max);
+            float y_far = std::max(y_distance_to_min, y_distance_to_max);
+            float z_near = std::min(z_distance_to_min, z_distance_to_max);
+            float z_far = std::max(z_distance_to_min, z_distance_to_max);
+
+            entry_distance = std::max(std::max(x_near, y_near), std::max(z_near, min_distance));
+            float exit_distance = std::min(std::min(x_far, y_far), std::min(z_far, max_distance));
+            return entry_distance <= exit_distance;
+        }
+
+        // PRIVATE MEMBER VARIABLES.
+        /// The center of each primitive's bounds while building.  Kept between builds to reuse its memory.
+        std::vector<MATH::Vector3f> PrimitiveCenters = {};
+        /// The nodes waiting to be built, as a stack.  Kept between builds to reuse its memory.
+        std::vector<NodeBuildTask> NodeBuildTasks = {};
+    };
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Math/Vector3.h"
+#include "Rendering/SurfaceShading.h"
+
+namespace RENDERING::RAY_TRACING
+{
+    /// A ray traced through a scene.
+    struct Ray
+    {
+        /// The position the ray starts from.
+        MATH::Vector3f Origin = MATH::Vector3f(0.0f, 0.0f, 0.0f);
+        /// The normalized direction of the ray.
+        MATH::Vector3f Direction = MATH::Vector3f(0.0f, 0.0f, -1.0f);
+        /// The width at the origin of the cone of space around the ray that its pixel covers.
+        /// Only tracked for choosing texture mipmap levels, so it ignores surface curvature at reflections.
+        float ConeWidth = 0.0f;
+        /// The angle in radians that the cone of space around the ray widens by per unit of distance.
+        float ConeSpreadAngle = 0.0f;
+    };
+
+    /// Information about where a ray hit a surface.
+    struct RayHit : public SurfacePoint
+    {
+        /// The distance along the ray to the hit.
+        float Distance = 0.0f;
+        /// How fast texture coordinates change per unit of distance along the surface, on average.
+        /// Used with the ray's cone to determine how much of the diffuse texture a pixel covers.
+        float TextureCoordinatesPerWorldUnit = 0.0f;
+    };
+}
@@ -0,0 +1,584 @@
+#include <algorithm>
+#include <cmath>
+#include "Profiling/TraceRecorder.h"
+#include "Rendering/AffineTransform.h"
+#include "Rendering/ObjectMeshCache.h"
+#include "Rendering/RayTracing/RayTracingScene.h"
+
+namespace RENDERING::RAY_TRACING
+{
+    /// Marks all object geometry as needing to be rebuilt on the next update.
+    /// This must be called when objects are loaded or when their geometry is edited, since such changes
+    /// can't be cheaply detected.  Transform changes are detected automatically.
+    void RayTracingScene::Invalidate()
+    {
+        RebuildNeeded = true;
+    }
+
+    /// Frees all geometry, such as when the renderer using the scene is no longer in use.
+    /// This releases the scene's references to shared object meshes, so they're freed unless another renderer uses them.
+    /// Everything is rebuilt on the next update.
+    void RayTracingScene::Release()
+    {
+        if (Objects.empty())
+        {
+            return;
+        }
+
+        Objects = std::vector<ObjectGeometry>();
+        ObjectHierarchy = BoundingVolumeHierarchy();
+        HierarchyObjectIndices = std::vector<uint32_t>();
+        ObjectBounds = std::vector<BoundingBox>();
+        Materials.Clear();
+        Statistics = {};
+        RebuildNeeded = true;
+    }
+
+    /// Updates world-space geometry for the scene.
+    /// Object hierarchies are only rebuilt if geometry was invalidated or the set of objects changed.
+    /// Otherwise, only objects whose transforms changed are re-transformed and have their hierarchies refit.
+    /// @param[in]  scene - The scene to update geometry for.
+    /// @param[in]  primary_ray_frustum - The region visible to primary rays, if those are the only rays that will be traced
+    ///     and objects outside it should be culled; null if all objects must be kept.
+    void RayTracingScene::Update(const GRAPHICS::Scene& scene, const ViewFrustum* const primary_ray_frustum)
+    {
+        // DETERMINE IF THE SET OF OBJECTS CHANGED.
+        bool object_count_changed = (Objects.size() != scene.Objects.size());
+        bool objects_changed = RebuildNeeded || object_count_changed;
+        for (std::size_t object_index = 0; !objects_changed && object_index < scene.Objects.size(); ++object_index)
+        {
+            objects_changed = (Objects[object_index].SourceObject != &scene.Objects[object_index]);
+        }
+
+        // UPDATE THE GEOMETRY FOR EACH OBJECT.
+        // The material table is rebuilt along with objects so that it only holds materials still in the scene.
+        Statistics = {};
+        Statistics.ObjectCount = scene.Objects.size();
+        Objects.resize(scene.Objects.size());
+        if (objects_changed)
+        {
+            Materials.Clear();
+        }
+        for (std::size_t object_index = 0; object_index < scene.Objects.size(); ++object_index)
+        {
+            const GRAPHICS::Object3D& object = scene.Objects[object_index];
+            ObjectGeometry& object_geometry = Objects[object_index];
+            AffineTransform world_transform = AffineTransform::FromMatrix(object.WorldTransform());
+            if (objects_changed)
+            {
+                // REBUILD THE OBJECT'S MESH.
+                // Its world-space geometry and hierarchy are only built once it's known to be needed.
+                PROFILING::TraceScope mesh_scope("Build Object Mesh", "Ray Tracing");
+                object_geometry.SourceObject = &object;
+                BuildObjectMesh(object, object_geometry);
+                AddObjectMaterials(object, object_geometry);
+                object_geometry.HierarchyBuilt = false;
+            }
+
+            // SKIP THE OBJECT IF IT'S OUTSIDE THE VIEW.
+            object_geometry.OutsideFrustum = primary_ray_frustum && primary_ray_frustum->Excludes(ComputeWorldBounds(object, object_geometry, world_transform));
+            if (object_geometry.OutsideFrustum)
+            {
+                ++Statistics.ObjectsOutsideFrustum;
+                continue;
+            }
+
+            if (!object_geometry.HierarchyBuilt)
+            {
+                // FULLY BUILD THE OBJECT'S WORLD-SPACE GEOMETRY.
+                PROFILING::TraceScope rebuild_scope("Build Object Geometry", "Ray Tracing");
+                object_geometry.WorldTransform = world_transform;
+                TransformObjectGeometry(object, object_geometry);
+                object_geometry.Hierarchy.Build(object_geometry.PrimitiveBounds);
+                object_geometry.HierarchyBuilt = true;
+            }
+            else if (!(object_geometry.WorldTransform == world_transform))
+            {
+                // REFIT THE OBJECT'S HIERARCHY TO ITS NEW TRANSFORM.
+                // The primitives are the same, just in different world positions.
+                PROFILING::TraceScope refit_scope("Refit Object Geometry", "Ray Tracing");
+                object_geometry.WorldTransform = world_transform;
+                TransformObjectGeometry(object, object_geometry);
+                object_geometry.Hierarchy.Refit(object_geometry.PrimitiveBounds);
+            }
+        }
+        RebuildNeeded = false;
+
+        // REBUILD THE TOP-LEVEL HIERARCHY.
+        // There are few enough objects that this is always cheap.
+        ObjectBounds.clear();
+        HierarchyObjectIndices.clear();
+        for (uint32_t object_index = 0; object_index < Objects.size(); ++object_index)
+        {
+            const ObjectGeometry& object_geometry = Objects[object_index];
+            if (!object_geometry.OutsideFrustum)
+            {
+                ObjectBounds.emplace_back(object_geometry.Hierarchy.Bounds());
+                HierarchyObjectIndices.push_back(object_index);
+            }
+        }
+        ObjectHierarchy.Build(ObjectBounds);
+    }
+
+    /// Finds the closest surface hit by a ray.
+    /// @param[in]  ray - The ray to trace.
+    /// @param[in]  min_distance - The minimum distance along the ray for valid hits (to avoid self-intersection).
+    /// @param[in]  max_distance - The maximum distance along the ray for valid hits.
+    /// @return The closest hit, if any.
+    std::optional<RayHit> RayTracingScene::FindClosestHit(const Ray& ray, const float min_distance, const float max_distance) const
+    {
+        // FIND THE CLOSEST PRIMITIVE.
+        // The closest distance is shrunk as hits are found, which lets traversal skip farther nodes.
+        float closest_distance = max_distance;
+        const ObjectGeometry* closest_triangle_object = nullptr;
+        uint32_t closest_triangle_index = 0;
+        const WorldSphere* closest_sphere = nullptr;
+        float closest_barycentric_u = 0.0f;
+        float closest_barycentric_v = 0.0f;
+        ObjectHierarchy.Traverse(ray, min_distance, closest_distance, [&](const uint32_t hierarchy_object_index)
+        {
+            const ObjectGeometry& object_geometry = Objects[HierarchyObjectIndices[hierarchy_object_index]];
+            uint32_t triangle_count = object_geometry.Mesh->TriangleCount();
+            object_geometry.Hierarchy.Traverse(ray, min_distance, closest_distance, [&](const uint32_t primitive_index)
+            {
+                if (primitive_index < triangle_count)
+                {
+                    float distance = 0.0f;
+                    float barycentric_u = 0.0f;
+                    float barycentric_v = 0.0f;
+                    bool triangle_hit = IntersectTriangle(ray, object_geometry, primitive_index, min_distance, closest_distance, distance, barycentric_u, barycentric_v);
+                    if (triangle_hit)
+                    {
+                        closest_distance = distance;
+                        closest_triangle_object = &object_geometry;
+                        closest_triangle_index = primitive_index;
+                        closest_sphere = nullptr;
+                        closest_barycentric_u = barycentric_u;
+                        closest_barycentric_v = barycentric_v;
+                    }
+                }
+                else
+                {
+                    const WorldSphere& sphere = object_geometry.Spheres[primitive_index - triangle_count];
+                    float distance = 0.0f;
+                    bool sphere_hit = IntersectSphere(ray, sphere, min_distance, closest_distance, distance);
+                    if (sphere_hit)
+                    {
+                        closest_distance = distance;
+                        closest_sphere = &sphere;
+                        closest_triangle_object = nullptr;
+                    }
+                }
+
+                // All potentially hit primitives must be checked to find the closest.
+                constexpr bool CONTINUE_TRAVERSAL = false;
+                return CONTINUE_TRAVERSAL;
+            });
+
+            constexpr bool CONTINUE_TRAVERSAL = false;
+            return CONTINUE_TRAVERSAL;
+        });
+
+        // RETURN INFORMATION ABOUT THE CLOSEST HIT.
+        if (closest_sphere)
+        {
+            return CreateSphereHit(ray, *closest_sphere, closest_distance);
+        }
+        else if (closest_triangle_object)
+        {
+            return CreateTriangleHit(ray, *closest_triangle_object, closest_triangle_index, closest_distance, closest_barycentric_u, closest_barycentric_v);
+        }
+        else
+        {
+            return std::nullopt;
+        }
+    }
+
+    /// Determines if any surface blocks a ray, such as for shadows.
+    /// This is cheaper than finding the closest hit since it can stop at the first hit.
+    /// @param[in]  ray - The ray to trace.
+    /// @param[in]  min_distance - The minimum distance along the ray for blocking surfaces.
+    /// @param[in]  max_distance - The maximum distance along the ray for blocking surfaces.
+    /// @return True if any surface blocks the ray; false otherwise.
+    bool RayTracingScene::IsOccluded(const Ray& ray, const float min_distance, const float max_distance) const
+    {
+        bool occluded = ObjectHierarchy.Traverse(ray, min_distance, max_distance, [&](const uint32_t hierarchy_object_index)
+        {
+            const ObjectGeometry& object_geometry = Objects[HierarchyObjectIndices[hierarchy_object_index]];
+            uint32_t triangle_count = object_geometry.Mesh->TriangleCount();
+            return object_geometry.Hierarchy.Traverse(ray, min_distance, max_distance, [&](const uint32_t primitive_index)
+            {
+                // Traversal stops as soon as any hit is found.
+                float distance = 0.0f;
+                if (primitive_index < triangle_count)
+                {
+                    float barycentric_u = 0.0f;
+                    float barycentric_v = 0.0f;
+                    return IntersectTriangle(ray, object_geometry, primitive_index, min_distance, max_distance, distance, barycentric_u, barycentric_v);
+                }
+                else
+                {
+                    return IntersectSphere(ray, object_geometry.Spheres[primitive_index - triangle_count], min_distance, max_distance, distance);
+                }
+            });
+        });
+        return occluded;
+    }
+
+    /// Gets the indexed mesh of all visible triangles of an object.
+    /// The mesh is shared with any other renderer using the same model, so it's usually only built once.
+    /// @param[in]  object - The object whose triangles to gather.
+    /// @param[in,out]  object_geometry - The geometry to update.
+    void RayTracingScene::BuildObjectMesh(const GRAPHICS::Object3D& object, ObjectGeometry& object_geometry)
+    {
+        object_geometry.Mesh = ObjectMeshCache::FindOrBuild(object.Model);
+
+        object_geometry.MeshBounds = {};
+        for (const MATH::Vector3f& position : object_geometry.Mesh->Positions)
+        {
+            object_geometry.MeshBounds.Expand(position);
+        }
+    }
+
+    /// Adds an object's materials to the scene's material table.
+    /// @param[in]  object - The object whose materials to add.
+    /// @param[in,out]  object_geometry - The geometry to update with material handles, with the mesh already built.
+    void RayTracingScene::AddObjectMaterials(const GRAPHICS::Object3D& object, ObjectGeometry& object_geometry)
+    {
+        Materials.AddMeshMaterials(*object_geometry.Mesh, object_geometry.MaterialHandles);
+
+        object_geometry.SphereMaterialHandles.clear();
+        for (const GRAPHICS::GEOMETRY::Sphere& sphere : object.Spheres)
+        {
+            object_geometry.SphereMaterialHandles.emplace_back(Materials.Add(sphere.Material.get()));
+        }
+    }
+
+    /// Transforms an object's geometry into world space based on its current world transform.
+    /// @param[in]  object - The object whose geometry to transform.
+    /// @param[in,out]  object_geometry - The geometry to update, with the mesh already built and the world transform already set.
+    ///     Memory from any previous geometry is reused.
+    void RayTracingScene::TransformObjectGeometry(const GRAPHICS::Object3D& object, ObjectGeometry& object_geometry)
+    {
+        // CLEAR ANY PREVIOUS GEOMETRY.
+        object_geometry.WorldPositions.clear();
+        object_geometry.WorldNormals.clear();
+        object_geometry.Spheres.clear();
+        object_geometry.PrimitiveBounds.clear();
+        const AffineTransform& world_transform = object_geometry.WorldTransform;
+
+        // TRANSFORM ALL VERTICES.
+        // Since vertices are shared between triangles, each only needs to be transformed once.
+        const IndexedMesh& mesh = *object_geometry.Mesh;
+        object_geometry.WorldPositions.reserve(mesh.VertexCount());
+        object_geometry.WorldNormals.reserve(mesh.VertexCount());
+        for (uint32_t vertex_index = 0; vertex_index < mesh.VertexCount(); ++vertex_index)
+        {
+            object_geometry.WorldPositions.emplace_back(world_transform.TransformPoint(mesh.Positions[vertex_index]));
+            object_geometry.WorldNormals.emplace_back(world_transform.TransformNormal(mesh.Normals[vertex_index]));
+        }
+
+        // COMPUTE THE BOUNDS OF ALL TRIANGLES.
+        object_geometry.PrimitiveBounds.reserve(mesh.TriangleCount() + object.Spheres.size());
+        for (uint32_t triangle_index = 0; triangle_index < mesh.TriangleCount(); ++triangle_index)
+        {
+            BoundingBox& triangle_bounds = object_geometry.PrimitiveBounds.emplace_back();
+            for (uint32_t corner_index = 0; corner_index < IndexedMesh::VERTICES_PER_TRIANGLE; ++corner_index)
+            {
+                uint32_t vertex_index = mesh.Indices[IndexedMesh::VERTICES_PER_TRIANGLE * triangle_index + corner_index];
+                triangle_bounds.Expand(object_geometry.WorldPositions[vertex_index]);
+            }
+        }
+
+        // TRANSFORM ALL SPHERES.
+        float max_scale = ComputeMaxScale(world_transform);
+        for (std::size_t sphere_index = 0; sphere_index < object.Spheres.size(); ++sphere_index)
+        {
+            const GRAPHICS::GEOMETRY::Sphere& sphere = object.Spheres[sphere_index];
+            WorldSphere& world_sphere = object_geometry.Spheres.emplace_back();
+            world_sphere.CenterPosition = world_transform.TransformPoint(sphere.CenterPosition);
+            world_sphere.Radius = std::abs(sphere.Radius * max_scale);
+            world_sphere.Material = object_geometry.SphereMaterialHandles[sphere_index];
+
+            BoundingBox& sphere_bounds = object_geometry.PrimitiveBounds.emplace_back();
+            MATH::Vector3f radius_extents(world_sphere.Radius, world_sphere.Radius, world_sphere.Radius);
+            sphere_bounds.Expand(world_sphere.CenterPosition - radius_extents);
+            sphere_bounds.Expand(world_sphere.CenterPosition + radius_extents);
+        }
+    }
+
+    /// Computes the bounds of an object's geometry for a world transform without transforming all of its geometry.
+    /// @param[in]  object - The object whose spheres to include.
+    /// @param[in]  object_geometry - The geometry whose mesh bounds to include.
+    /// @param[in]  world_transform - The object's world transform.
+    /// @return Bounds containing all of the object's triangles and spheres in world space.  May be larger than the exact bounds.
+    BoundingBox RayTracingScene::ComputeWorldBounds(
+        const GRAPHICS::Object3D& object,
+        const ObjectGeometry& object_geometry,
+        const AffineTransform& world_transform)
+    {
+        BoundingBox world_bounds = object_geometry.MeshBounds.Transform(world_transform);
+
+        float max_scale = ComputeMaxScale(world_transform);
+        for (const GRAPHICS::GEOMETRY::Sphere& sphere : object.Spheres)
+        {
+            MATH::Vector3f world_center_position = world_transform.TransformPoint(sphere.CenterPosition);
+            float world_radius = std::abs(sphere.Radius * max_scale);
+            MATH::Vector3f radius_extents(world_radius, world_radius, world_radius);
+            world_bounds.Expand(world_center_position - radius_extents);
+            world_bounds.Expand(world_center_position + radius_extents);
+        }
+
+        return world_bounds;
+    }
+
+    /// Computes how much a transform scales lengths along its most-scaled axis.
+    /// Non-uniform scaling would turn spheres into ellipsoids, which aren't supported,
+    /// so spheres are scaled by this to keep them enclosing their scaled extents.
+    /// @param[in]  transform - The transform to check.
+    /// @return The largest scale of any of the transform's axes.
+    float RayTracingScene::ComputeMaxScale(const AffineTransform& transform)
+    {
+        float max_scale = 0.0f;
+        for (unsigned int axis_index = 0; axis_index < 3; ++axis_index)
+        {
+            MATH::Vector3f axis(
+                transform.Elements[0][axis_index],
+                transform.Elements[1][axis_index],
+                transform.Elements[2][axis_index]);
+            max_scale = std::max(max_scale, axis.Length());
+        }
+        return max_scale;
+    }
+
+    /// Intersects a ray with a triangle using the Moller-Trumbore algorithm.
+    /// Both sides of the triangle are considered.
+    /// @param[in]  ray - The ray to intersect.
+    /// @param[in]  object_geometry - The geometry containing the triangle.
+    /// @param[in]  triangle_index - The index of the triangle to intersect.
+    /// @param[in]  min_distance - The minimum distance along the ray for a valid hit.
+    /// @param[in]  max_distance - The maximum distance along the ray for a valid hit.
+    /// @param[out] distance - The distance along the ray to the hit, if any.
+    /// @param[out] barycentric_u - The barycentric coordinate of the 2nd vertex at the hit, if any.
+    /// @param[out] barycentric_v - The barycentric coordinate of the 3rd vertex at the hit, if any.
+    /// @return True if the ray hit the triangle within the distance range; false otherwise.
+    bool RayTracingScene::IntersectTriangle(
+        const Ray& ray,
+        const ObjectGeometry& object_geometry,
+        const uint32_t triangle_index,
+        const float min_distance,
+        const float max_distance,
+        float& distance,
+        float& barycentric_u,
+        float& barycentric_v)
+    {
+        // GET THE TRIANGLE'S VERTICES.
+        const uint32_t* vertex_indices = &object_geometry.Mesh->Indices[IndexedMesh::VERTICES_PER_TRIANGLE * triangle_index];
+        const MATH::Vector3f& first_vertex_position = object_geometry.WorldPositions[vertex_indices[0]];
+        MATH::Vector3f edge_1 = object_geometry.WorldPositions[vertex_indices[1]] - first_vertex_position;
+        MATH::Vector3f edge_2 = object_geometry.WorldPositions[vertex_indices[2]] - first_vertex_position;
+
+        // CHECK IF THE RAY IS PARALLEL TO THE TRIANGLE.
+        MATH::Vector3f p = MATH::Vector3f::CrossProduct(ray.Direction, edge_2);
+        float determinant = MATH::Vector3f::DotProduct(edge_1, p);
+        constexpr float PARALLEL_EPSILON = 1e-9f;
+        if (std::abs(determinant) < PARALLEL_EPSILON)
+        {
+            return false;
+        }
+        float inverse_determinant = 1.0f / determinant;
+
+        // CHECK IF THE HIT IS WITHIN THE TRIANGLE.
+        MATH::Vector3f first_vertex_to_origin = ray.Origin - first_vertex_position;
+        barycentric_u = MATH::Vector3f::DotProduct(first_vertex_to_origin, p) * inverse_determinant;
+        if (barycentric_u < 0.0f || barycentric_u > 1.0f)
+        {
+            return false;
+        }
+
+        MATH::Vector3f q = MATH::Vector3f::CrossProduct(first_vertex_to_origin, edge_1);
+        barycentric_v = MATH::Vector3f::DotProduct(ray.Direction, q) * inverse_determinant;
+        if (barycentric_v < 0.0f || barycentric_u + barycentric_v > 1.0f)
+        {
+            return false;
+        }
+
+        // CHECK IF THE HIT IS WITHIN THE DISTANCE RANGE.
+        distance = MATH::Vector3f::DotProduct(edge_2, q) * inverse_determinant;
+        bool within_distance_range = (min_distance < distance) && (distance < max_distance);
+        return within_distance_range;
+    }
+
+    /// Intersects a ray with a sphere.
+    /// @param[in]  ray - The ray to intersect.
+    /// @param[in]  sphere - The sphere to intersect.
+    /// @param[in]  min_distance - The minimum distance along the ray for a valid hit.
+    /// @param[in]  max_distance - The maximum distance along the ray for a valid hit.
+    /// @param[out] distance - The distance along the ray to the closest valid hit, if any.
+    /// @return True if the ray hit the sphere within the distance range; false otherwise.
+    bool RayTracingScene::IntersectSphere(
+        const Ray& ray,
+        const WorldSphere& sphere,
+        const float min_distance,
+        const float max_distance,
+        float& distance)
+    {
+        // SOLVE THE QUADRATIC EQUATION FOR THE HIT DISTANCES.
+        // Since the ray direction is normalized, the quadratic coefficient is 1.
+        MATH::Vector3f center_to_origin = ray.Origin - sphere.CenterPosition;
+        float half_b = MATH::Vector3f::DotProduct(center_to_origin, ray.Direction);
+        float c = MATH::Vector3f::DotProduct(center_to_origin, center_to_origin) - sphere.Radius * sphere.Radius;
+        float discriminant = half_b * half_b - c;
+        if (discriminant < 0.0f)
+        {
+            return false;
+        }
+
+        // CHECK THE CLOSER HIT FIRST.
+        float square_root_of_discriminant = std::sqrt(discriminant);
+        float closer_distance = -half_b - square_root_of_discriminant;
+        if ((min_distance < closer_distance) && (closer_distance < max_distance))
+        {
+            distance = closer_distance;
+            return true;
+        }
+
+        // CHECK THE FARTHER HIT, WHICH OCCURS IF THE RAY STARTS INSIDE THE SPHERE.
+        float farther_distance = -half_b + square_root_of_discriminant;
+        if ((min_distance < farther_distance) && (farther_distance < max_distance))
+        {
+            distance = farther_distance;
+            return true;
+        }
+
+        return false;
+    }
+
+    /// Creates hit information for a triangle.
+    /// @param[in]  ray - The ray that hit the triangle.
+    /// @param[in]  object_geometry - The geometry containing the triangle.
+    /// @param[in]  triangle_index - The index of the triangle that was hit.
+    /// @param[in]  distance - The distance along the ray to the hit.
+    /// @param[in]  barycentric_u - The barycentric coordinate of the 2nd vertex at the hit.
+    /// @param[in]  barycentric_v - The barycentric coordinate of the 3rd vertex at the hit.
+    /// @return Information about the hit.
+    RayHit RayTracingScene::CreateTriangleHit(
+        const Ray& ray,
+        const ObjectGeometry& object_geometry,
+        const uint32_t triangle_index,
+        const float distance,
+        const float barycentric_u,
+        const float barycentric_v) const
+    {
+        const IndexedMesh& mesh = *object_geometry.Mesh;
+        const uint32_t* vertex_indices = &mesh.Indices[IndexedMesh::VERTICES_PER_TRIANGLE * triangle_index];
+
+        RayHit hit;
+        hit.Distance = distance;
+        hit.Position = ray.Origin + MATH::Vector3f::Scale(distance, ray.Direction);
+        hit.IsTriangle = true;
+        hit.TriangleBarycentricCoordinates = MATH::Vector2f(barycentric_u, barycentric_v);
+        uint32_t material_id = mesh.TriangleMaterialId(triangle_index);
+        if (IndexedMesh::NO_MATERIAL != material_id)
+        {
+            MaterialHandle material_handle = object_geometry.MaterialHandles[material_id];
+            hit.Material = Materials.GetMaterial(material_handle);
+            hit.DiffuseTexture = Materials.GetDiffuseTexture(material_handle);
+        }
+
+        // INTERPOLATE VERTEX ATTRIBUTES.
+        float barycentric_w = 1.0f - barycentric_u - barycentric_v;
+        MATH::Vector3f interpolated_normal =
+            MATH::Vector3f::Scale(barycentric_w, object_geometry.WorldNormals[vertex_indices[0]]) +
+            MATH::Vector3f::Scale(barycentric_u, object_geometry.WorldNormals[vertex_indices[1]]) +
+            MATH::Vector3f::Scale(barycentric_v, object_geometry.WorldNormals[vertex_indices[2]]);
+        const MATH::Vector2f& first_texture_coordinates = mesh.TextureCoordinates[vertex_indices[0]];
+        const MATH::Vector2f& second_texture_coordinates = mesh.TextureCoordinates[vertex_indices[1]];
+        const MATH::Vector2f& third_texture_coordinates = mesh.TextureCoordinates[vertex_indices[2]];
+        hit.TextureCoordinates = MATH::Vector2f(
+            barycentric_w * first_texture_coordinates.X + barycentric_u * second_texture_coordinates.X + barycentric_v * third_texture_coordinates.X,
+            barycentric_w * first_texture_coordinates.Y + barycentric_u * second_texture_coordinates.Y + barycentric_v * third_texture_coordinates.Y);
+        if (hit.DiffuseTexture)
+        {
+            // The ratio of the triangle's areas in texture and world space gives the average rate of change.
+            const MATH::Vector3f& first_vertex_position = object_geometry.WorldPositions[vertex_indices[0]];
+            MATH::Vector3f world_edge_1 = object_geometry.WorldPositions[vertex_indices[1]] - first_vertex_position;
+            MATH::Vector3f world_edge_2 = object_geometry.WorldPositions[vertex_indices[2]] - first_vertex_position;
+            float double_world_area = MATH::Vector3f::CrossProduct(world_edge_1, world_edge_2).Length();
+            float double_texture_area = std::abs(
+                (second_texture_coordinates.X - first_texture_coordinates.X) * (third_texture_coordinates.Y - first_texture_coordinates.Y) -
+                (third_texture_coordinates.X - first_texture_coordinates.X) * (second_texture_coordinates.Y - first_texture_coordinates.Y));
+            if (double_world_area > 0.0f)
+            {
+                hit.TextureCoordinatesPerWorldUnit = std::sqrt(double_texture_area / double_world_area);
+            }
+        }
+        const GRAPHICS::Color& first_color = mesh.Colors[vertex_indices[0]];
+        const GRAPHICS::Color& second_color = mesh.Colors[vertex_indices[1]];
+        const GRAPHICS::Color& third_color = mesh.Colors[vertex_indices[2]];
+        hit.VertexColor = GRAPHICS::Color(
+            barycentric_w * first_color.Red + barycentric_u * second_color.Red + barycentric_v * third_color.Red,
+            barycentric_w * first_color.Green + barycentric_u * second_color.Green + barycentric_v * third_color.Green,
+            barycentric_w * first_color.Blue + barycentric_u * second_color.Blue + barycentric_v * third_color.Blue,
+            barycentric_w * first_color.Alpha + barycentric_u * second_color.Alpha + barycentric_v * third_color.Alpha);
+
+        // DETERMINE THE NORMAL.
+        // Models without vertex normals fall back to the flat geometric normal.
+        constexpr float MIN_NORMAL_LENGTH = 1e-6f;
+        float interpolated_normal_length = interpolated_normal.Length();
+        if (interpolated_normal_length > MIN_NORMAL_LENGTH)
+        {
+            hit.Normal = MATH::Vector3f::Scale(1.0f / interpolated_normal_length, interpolated_normal);
+        }
+        else
+        {
+            const MATH::Vector3f& first_vertex_position = object_geometry.WorldPositions[vertex_indices[0]];
+            MATH::Vector3f edge_1 = object_geometry.WorldPositions[vertex_indices[1]] - first_vertex_position;
+            MATH::Vector3f edge_2 = object_geometry.WorldPositions[vertex_indices[2]] - first_vertex_position;
+            MATH::Vector3f geometric_normal = MATH::Vector3f::CrossProduct(edge_1, edge_2);
+            float geometric_normal_length = geometric_normal.Length();
+            if (geometric_normal_length > 0.0f)
+            {
+                hit.Normal = MATH::Vector3f::Scale(1.0f / geometric_normal_length, geometric_normal);
+            }
+        }
+
+        // Triangles are double-sided, so the normal is flipped to face the ray if needed.
+        if (MATH::Vector3f::DotProduct(hit.Normal, ray.Direction) > 0.0f)
+        {
+            hit.Normal = MATH::Vector3f::Scale(-1.0f, hit.Normal);
+        }
+
+        return hit;
+    }
+
+    /// Creates hit information for a sphere.
+    /// @param[in]  ray - The ray that hit the sphere.
+    /// @param[in]  sphere - The sphere that was hit.
+    /// @param[in]  distance - The distance along the ray to the hit.
+    /// @return Information about the hit.
+    RayHit RayTracingScene::CreateSphereHit(const Ray& ray, const WorldSphere& sphere, const float distance) const
+    {
+        RayHit hit;
+        hit.Distance = distance;
+        hit.Position = ray.Origin + MATH::Vector3f::Scale(distance, ray.Direction);
+        hit.IsTriangle = false;
+        hit.Material = Materials.GetMaterial(sphere.Material);
+
+        MATH::Vector3f outward_normal = MATH::Vector3f::Scale(1.0f / sphere.Radius, hit.Position - sphere.CenterPosition);
+        // The normal is flipped if the ray started inside the sphere.
+        bool ray_inside_sphere = MATH::Vector3f::DotProduct(outward_normal, ray.Direction) > 0.0f;
+        hit.Normal = ray_inside_sphere ? MATH::Vector3f::Scale(-1.0f, outward_normal) : outward_normal;
+
+        // Spherical texture coordinates are used so that textures can be mapped onto spheres.
+        constexpr float PI = 3.14159265358979f;
+        float u = 0.5f + std::atan2(outward_normal.Z, outward_normal.X) / (2.0f * PI);
+        float v = 0.5f - std::asin(std::clamp(outward_normal.Y, -1.0f, 1.0f)) / PI;
+        hit.TextureCoordinates = MATH::Vector2f(u, v);
+        hit.DiffuseTexture = Materials.GetDiffuseTexture(sphere.Material);
+        // The vertical texture coordinate spans half the sphere's circumference.
+        hit.TextureCoordinatesPerWorldUnit = 1.0f / (PI * sphere.Radius);
+
+        return hit;
+    }
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "Graphics/Material.h"
+#include "Graphics/Scene.h"
+#include "Math/Vector3.h"
+#include "Rendering/AffineTransform.h"
+#include "Rendering/BoundingBox.h"
+#include "Rendering/IndexedMesh.h"
+#include "Rendering/MaterialTable.h"
+#include "Rendering/RayTracing/BoundingVolumeHierarchy.h"
+#include "Rendering/RayTracing/Ray.h"
+#include "Rendering/ViewFrustum.h"
+
+namespace RENDERING::RAY_TRACING
+{
+    /// A sphere transformed into world space.
+    struct WorldSphere
+    {
+        /// The world position of the center.
+        MATH::Vector3f CenterPosition = MATH::Vector3f(0.0f, 0.0f, 0.0f);
+        /// The world radius.
+        float Radius = 0.0f;
+        /// The handle of the sphere's material in the scene's material table.
+        MaterialHandle Material = MaterialTable::NO_MATERIAL;
+    };
+
+    /// The world-space geometry of a single object along with a hierarchy for tracing rays against it.
+    /// Each object has its own hierarchy so that moving an object only requires refitting that object's hierarchy.
+    struct ObjectGeometry
+    {
+        /// The object this geometry was created from.
+        const GRAPHICS::Object3D* SourceObject = nullptr;
+        /// The world transform of the object when its geometry was last transformed.
+        AffineTransform WorldTransform = {};
+        /// All visible triangles in the object, in object space.
+        /// Only vertex positions and normals depend on the object's transform, so other attributes are used directly from here.
+        /// Shared with other renderers through the object mesh cache.
+        std::shared_ptr<const IndexedMesh> Mesh = nullptr;
+        /// The bounds of the mesh, in object space.
+        BoundingBox MeshBounds = {};
+        /// The handle in the scene's material table of each material in the mesh, by its ID in the mesh.
+        std::vector<MaterialHandle> MaterialHandles = {};
+        /// The handle in the scene's material table of each sphere's material, in the same order as the object's spheres.
+        std::vector<MaterialHandle> SphereMaterialHandles = {};
+        /// True if the world-space geometry and hierarchy below have been built for the current mesh;
+        /// false if they still need to be, such as for objects that were outside the view since being loaded.
+        bool HierarchyBuilt = false;
+        /// True if the object was skipped in the most recent update for being outside the view frustum.
+        /// Its world-space geometry may be out of date and it's left out of the scene's top-level hierarchy.
+        bool OutsideFrustum = false;
+        /// The world position of each vertex in the mesh.
+        std::vector<MATH::Vector3f> WorldPositions = {};
+        /// The world normal of each vertex in the mesh.  May be zero if the model lacks normals.
+        std::vector<MATH::Vector3f> WorldNormals = {};
+        /// All spheres in the object.
+        std::vector<WorldSphere> Spheres = {};
+        /// The bounds of all primitives.  Triangles come first, followed by spheres,
+        /// which defines the primitive indices used in the hierarchy.
+        std::vector<BoundingBox> PrimitiveBounds = {};
+        /// The hierarchy over all primitives.
+        BoundingVolumeHierarchy Hierarchy = {};
+    };
+
+    /// A world-space copy of a scene's geometry prepared for tracing rays.
+    /// Materials are referenced by pointer, so the scene must outlive any use of this.
+    ///
+    /// Geometry is organized as a two-level hierarchy: a small top-level hierarchy over objects,
+    /// each of which has its own hierarchy over its triangles and spheres.  Hierarchies for objects are built
+    /// once when objects are loaded and only refit when objects are moved, rotated, or scaled.
+    ///
+    /// If only primary rays will be traced, objects outside the view frustum can't be hit and are culled:
+    /// they're left out of the top-level hierarchy, and building or refitting their own hierarchies is
+    /// put off until they're back in view.
+    class RayTracingScene
+    {
+    public:
+        // UPDATING.
+        void Invalidate();
+        void Release();
+        void Update(const GRAPHICS::Scene& scene, const ViewFrustum* const primary_ray_frustum);
+
+        // RAY QUERIES.
+        std::optional<RayHit> FindClosestHit(const Ray& ray, const float min_distance, const float max_distance) const;
+        bool IsOccluded(const Ray& ray, const float min_distance, const float max_distance) const;
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The geometry for each object in the scene, in the same order as the scene's objects.
+        std::vector<ObjectGeometry> Objects = {};
+        /// The top-level hierarchy over the bounds of all objects not culled in the most recent update.
+        BoundingVolumeHierarchy ObjectHierarchy = {};
+        /// The index in Objects of each object in the top-level hierarchy, by its index in the hierarchy.
+        std::vector<uint32_t> HierarchyObjectIndices = {};
+        /// Counts of objects culled in the most recent update.
+        CullingStatistics Statistics = {};
+        /// The unique materials of all objects, referenced by handle from their geometry.
+        MaterialTable Materials = {};
+
+    private:
+        // GEOMETRY HELPERS.
+        static void BuildObjectMesh(const GRAPHICS::Object3D& object, ObjectGeometry& object_geometry);
+        void AddObjectMaterials(const GRAPHICS::Object3D& object, ObjectGeometry& object_geometry);
+        static void TransformObjectGeometry(const GRAPHICS::Object3D& object, ObjectGeometry& object_geometry);
+        static BoundingBox ComputeWorldBounds(
+            const GRAPHICS::Object3D& object,
+            const ObjectGeometry& object_geometry,
+            const AffineTransform& world_transform);
+        static float ComputeMaxScale(const AffineTransform& transform);
+
+        // INTERSECTION HELPERS.
+        static bool IntersectTriangle(
+            const Ray& ray,
+            const ObjectGeometry& object_geometry,
+            const uint32_t triangle_index,
+            const float min_distance,
+            const float max_distance,
+            float& distance,
+            float& barycentric_u,
+            float& barycentric_v);
+        static bool IntersectSphere(
+            const Ray& ray,
+            const WorldSphere& sphere,
+            const float min_distance,
+            const float max_distance,
+            float& distance);
+        RayHit CreateTriangleHit(
+            const Ray& ray,
+            const ObjectGeometry& object_geometry,
+            const uint32_t triangle_index,
+            const float distance,
+            const float barycentric_u,
+            const float barycentric_v) const;
+        RayHit CreateSphereHit(const Ray& ray, const WorldSphere& sphere, const float distance) const;
+
+        // PRIVATE MEMBER VARIABLES.
+        /// True if object geometry must be fully rebuilt on the next update, such as after objects are loaded
+        /// or edited in ways other than their transforms; false if hierarchies can just be refit.
+        bool RebuildNeeded = true;
+        /// The bounds of each object in the top-level hierarchy while rebuilding it.  Kept between updates to reuse its memory.
+        std::vector<BoundingBox> ObjectBounds = {};
+    };
+}
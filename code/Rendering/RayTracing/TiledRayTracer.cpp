@@ -0,0 +1,568 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include "Profiling/TraceRecorder.h"
+#include "Rendering/PackedColor.h"
+#include "Rendering/RayTracing/TiledRayTracer.h"
+
+namespace RENDERING::RAY_TRACING
+{
+    /// The minimum distance along secondary rays for hits, to avoid surfaces shadowing or reflecting themselves.
+    constexpr float SECONDARY_RAY_MIN_DISTANCE = 1e-3f;
+    /// The width and height of blocks of pixels covered by a single ray in the first progressive rendering pass.
+    /// This quickly gives a complete low-resolution image.
+    constexpr unsigned int INITIAL_PROGRESSIVE_BLOCK_SIZE_IN_PIXELS = 8;
+
+    /// Renders the scene into the color buffer.
+    /// @param[in]  scene - The scene to render.
+    /// @param[in]  camera - The camera to render the scene through.
+    /// @param[in]  rendering_settings - The settings for what to render.
+    /// @param[in]  cpu_rendering_settings - The settings for how to split up rendering work.
+    /// @param[in,out]  thread_pool - The threads to render with.
+    /// @param[out] color_buffer - The buffer to render into.
+    void TiledRayTracer::Render(
+        const GRAPHICS::Scene& scene,
+        const GRAPHICS::VIEWING::Camera& camera,
+        const GRAPHICS::RenderingSettings& rendering_settings,
+        const CpuRenderingSettings& cpu_rendering_settings,
+        THREADING::WorkStealingThreadPool& thread_pool,
+        GRAPHICS::IMAGES::Bitmap& color_buffer)
+    {
+        // PREPARE THE SCENE GEOMETRY.
+        unsigned int width_in_pixels = color_buffer.GetWidthInPixels();
+        unsigned int height_in_pixels = color_buffer.GetHeightInPixels();
+        CameraRayBasis camera_ray_basis = ComputeCameraRayBasis(camera, width_in_pixels, height_in_pixels);
+        UpdateScene(scene, camera_ray_basis, rendering_settings, cpu_rendering_settings);
+
+        // DETERMINE HOW TO SPLIT THE SCREEN INTO TILES.
+        unsigned int tile_size_in_pixels = std::max(cpu_rendering_settings.TileSizeInPixels, 1u);
+        unsigned int tile_column_count = (width_in_pixels + tile_size_in_pixels - 1) / tile_size_in_pixels;
+        unsigned int tile_row_count = (height_in_pixels + tile_size_in_pixels - 1) / tile_size_in_pixels;
+        std::size_t tile_count = static_cast<std::size_t>(tile_column_count) * static_cast<std::size_t>(tile_row_count);
+
+        // RENDER ALL TILES IN PARALLEL.
+        // Every pixel is traced in a single pass.
+        PrepareTileScratches(thread_pool, tile_size_in_pixels);
+        uint32_t* pixels = color_buffer.GetRawData();
+        thread_pool.ParallelFor(tile_count, [&](const std::size_t tile_index, const unsigned int worker_index)
+        {
+            constexpr unsigned int SINGLE_PIXEL_BLOCKS = 1;
+            constexpr bool ONLY_PASS = true;
+            RenderTile(
+                tile_index,
+                tile_size_in_pixels,
+                SINGLE_PIXEL_BLOCKS,
+                ONLY_PASS,
+                camera_ray_basis,
+                scene,
+                rendering_settings,
+                cpu_rendering_settings.MipmappedTextureSampling,
+                width_in_pixels,
+                height_in_pixels,
+                TileScratches[worker_index],
+                pixels);
+        });
+        ReleaseTileScratches();
+    }
+
+    /// Determines if a progressive render must be (re)started before it can be continued,
+    /// which is the case if none has been started or if the color buffer has been resized.
+    /// @param[in]  color_buffer - The buffer being rendered into.
+    /// @return True if a progressive render must be started; false if the current one can be continued.
+    bool TiledRayTracer::ProgressiveRenderNeedsRestart(const GRAPHICS::IMAGES::Bitmap& color_buffer) const
+    {
+        if (!Progressive.Started)
+        {
+            return true;
+        }
+
+        bool color_buffer_resized =
+            (Progressive.WidthInPixels != color_buffer.GetWidthInPixels()) ||
+            (Progressive.HeightInPixels != color_buffer.GetHeightInPixels());
+        return color_buffer_resized;
+    }
+
+    /// Determines if the current progressive render has been fully refined, in which case continuing it
+    /// wouldn't change the frame.
+    /// @return True if a progressive render was started and is complete; false otherwise.
+    bool TiledRayTracer::ProgressiveRenderComplete() const
+    {
+        return Progressive.Started && Progressive.Complete;
+    }
+
+    /// Starts progressively rendering a new frame, discarding any partially refined previous frame.
+    /// No rays are traced until the render is continued.
+    /// @param[in]  scene - The scene to render.  Must remain unchanged until the render is restarted.
+    /// @param[in]  camera - The camera to render the scene through.
+    /// @param[in]  rendering_settings - The settings for what to render.  Must be the same when the render is continued.
+    /// @param[in]  cpu_rendering_settings - The settings for how to split up rendering work.
+    /// @param[in]  color_buffer - The buffer that will be rendered into, for its dimensions.
+    void TiledRayTracer::StartProgressiveRender(
+        const GRAPHICS::Scene& scene,
+        const GRAPHICS::VIEWING::Camera& camera,
+        const GRAPHICS::RenderingSettings& rendering_settings,
+        const CpuRenderingSettings& cpu_rendering_settings,
+        const GRAPHICS::IMAGES::Bitmap& color_buffer)
+    {
+        // RESET THE PROGRESSIVE STATE.
+        Progressive.Started = true;
+        Progressive.Complete = false;
+        Progressive.WidthInPixels = color_buffer.GetWidthInPixels();
+        Progressive.HeightInPixels = color_buffer.GetHeightInPixels();
+        Progressive.CameraRays = ComputeCameraRayBasis(camera, Progressive.WidthInPixels, Progressive.HeightInPixels);
+
+        // PREPARE THE SCENE GEOMETRY.
+        UpdateScene(scene, Progressive.CameraRays, rendering_settings, cpu_rendering_settings);
+
+        Progressive.TileSizeInPixels = std::max(cpu_rendering_settings.TileSizeInPixels, 1u);
+        Progressive.BlockSizeInPixels = INITIAL_PROGRESSIVE_BLOCK_SIZE_IN_PIXELS;
+        Progressive.NextTileIndex = 0;
+        std::size_t pixel_count = static_cast<std::size_t>(Progressive.WidthInPixels) * static_cast<std::size_t>(Progressive.HeightInPixels);
+        Progressive.Pixels.assign(pixel_count, 0);
+    }
+
+    /// Continues refining the current progressive frame for up to the configured time budget,
+    /// then copies the frame so far into the color buffer.
+    /// The first, coarsest pass is always fully finished so that a complete image is available right away.
+    /// @param[in]  scene - The scene being rendered.  Must be the same as when the render was started.
+    /// @param[in]  rendering_settings - The settings for what to render.
+    /// @param[in]  cpu_rendering_settings - The settings for the time budget.
+    /// @param[in,out]  thread_pool - The threads to render with.
+    /// @param[out] color_buffer - The buffer to copy the frame so far into.
+    /// @return True if the frame is fully refined; false if more refinement remains.
+    bool TiledRayTracer::ContinueProgressiveRender(
+        const GRAPHICS::Scene& scene,
+        const GRAPHICS::RenderingSettings& rendering_settings,
+        const CpuRenderingSettings& cpu_rendering_settings,
+        THREADING::WorkStealingThreadPool& thread_pool,
+        GRAPHICS::IMAGES::Bitmap& color_buffer)
+    {
+        // THERE IS NOTHING TO REFINE IF NO FRAME HAS BEEN STARTED.
+        if (!Progressive.Started)
+        {
+            return false;
+        }
+
+        // REFINE THE FRAME UNTIL IT IS COMPLETE OR THE TIME BUDGET RUNS OUT.
+        std::size_t tile_column_count = (Progressive.WidthInPixels + Progressive.TileSizeInPixels - 1) / Progressive.TileSizeInPixels;
+        std::size_t tile_row_count = (Progressive.HeightInPixels + Progressive.TileSizeInPixels - 1) / Progressive.TileSizeInPixels;
+        std::size_t tile_count = tile_column_count * tile_row_count;
+        // A few tiles per thread are refined between time checks to keep all cores busy while still stopping promptly.
+        constexpr std::size_t TILES_PER_THREAD_PER_BATCH = 2;
+        std::size_t tiles_per_batch = std::max<std::size_t>(thread_pool.ThreadCount() * TILES_PER_THREAD_PER_BATCH, 1);
+        std::chrono::duration<float, std::milli> time_budget(cpu_rendering_settings.ProgressiveTimeBudgetInMilliseconds);
+        auto start_time = std::chrono::steady_clock::now();
+        PrepareTileScratches(thread_pool, Progressive.TileSizeInPixels);
+        while (!Progressive.Complete)
+        {
+            // STOP IF THE TIME BUDGET HAS RUN OUT.
+            // The first pass is exempt so that the entire screen always gets updated.
+            bool first_pass = (INITIAL_PROGRESSIVE_BLOCK_SIZE_IN_PIXELS == Progressive.BlockSizeInPixels);
+            auto elapsed_time = std::chrono::steady_clock::now() - start_time;
+            if (!first_pass && elapsed_time >= time_budget)
+            {
+                break;
+            }
+
+            // REFINE THE NEXT BATCH OF TILES.
+            std::size_t batch_start_tile_index = Progressive.NextTileIndex;
+            std::size_t batch_tile_count = first_pass ? tile_count : std::min(tiles_per_batch, tile_count - batch_start_tile_index);
+            PROFILING::TraceScope batch_scope("Ray Trace Batch", "Ray Tracing");
+            thread_pool.ParallelFor(batch_tile_count, [&](const std::size_t batch_tile_index, const unsigned int worker_index)
+            {
+                RenderTile(
+                    batch_start_tile_index + batch_tile_index,
+                    Progressive.TileSizeInPixels,
+                    Progressive.BlockSizeInPixels,
+                    first_pass,
+                    Progressive.CameraRays,
+                    scene,
+                    rendering_settings,
+                    cpu_rendering_settings.MipmappedTextureSampling,
+                    Progressive.WidthInPixels,
+                    Progressive.HeightInPixels,
+                    TileScratches[worker_index],
+                    Progressive.Pixels.data());
+            });
+            Progressive.NextTileIndex += batch_tile_count;
+
+            // MOVE TO THE NEXT PASS IF ALL TILES HAVE BEEN REFINED.
+            bool pass_complete = (Progressive.NextTileIndex >= tile_count);
+            if (pass_complete)
+            {
+                Progressive.NextTileIndex = 0;
+                if (1 == Progressive.BlockSizeInPixels)
+                {
+                    Progressive.Complete = true;
+                }
+                else
+                {
+                    Progressive.BlockSizeInPixels /= 2;
+                }
+            }
+        }
+
+        ReleaseTileScratches();
+
+        // COPY THE FRAME SO FAR INTO THE COLOR BUFFER.
+        std::copy(Progressive.Pixels.cbegin(), Progressive.Pixels.cend(), color_buffer.GetRawData());
+        return Progressive.Complete;
+    }
+
+    /// Gives each worker thread scratch memory from its frame arena for tracing tiles.
+    /// @param[in,out]  thread_pool - The threads that will trace tiles, for their arenas.
+    /// @param[in]  tile_size_in_pixels - The width and height of tiles.
+    void TiledRayTracer::PrepareTileScratches(THREADING::WorkStealingThreadPool& thread_pool, const unsigned int tile_size_in_pixels)
+    {
+        std::size_t max_block_count_per_tile = static_cast<std::size_t>(tile_size_in_pixels) * static_cast<std::size_t>(tile_size_in_pixels);
+        TileScratches.resize(thread_pool.ThreadCount());
+        for (unsigned int worker_index = 0; worker_index < TileScratches.size(); ++worker_index)
+        {
+            // Space for the largest possible tile is reserved up-front so that the array never grows within the arena.
+            MEMORY::ArenaAllocator<BlockRayHit> allocator(&thread_pool.WorkerArena(worker_index));
+            TileScratch& scratch = TileScratches[worker_index];
+            scratch.BlockHits = MEMORY::ArenaVector<BlockRayHit>(allocator);
+            scratch.BlockHits.reserve(max_block_count_per_tile);
+        }
+    }
+
+    /// Releases the scratch memory for tracing tiles.
+    /// Its memory is in the worker arenas, so it must not outlive the frame.
+    void TiledRayTracer::ReleaseTileScratches()
+    {
+        for (TileScratch& scratch : TileScratches)
+        {
+            scratch.BlockHits = MEMORY::ArenaVector<BlockRayHit>();
+        }
+    }
+
+    /// Updates world-space geometry for the scene, culling objects that can't be hit if possible.
+    /// Culling is only done when just primary rays will be traced, since shadow and reflection rays
+    /// can hit objects outside the view.
+    /// @param[in]  scene - The scene to update geometry for.
+    /// @param[in]  camera_ray_basis - The camera information for primary rays.
+    /// @param[in]  rendering_settings - The settings for what to render, for which rays will be traced.
+    /// @param[in]  cpu_rendering_settings - The settings for whether to cull.
+    void TiledRayTracer::UpdateScene(
+        const GRAPHICS::Scene& scene,
+        const CameraRayBasis& camera_ray_basis,
+        const GRAPHICS::RenderingSettings& rendering_settings,
+        const CpuRenderingSettings& cpu_rendering_settings)
+    {
+        // CHECK IF ONLY PRIMARY RAYS WILL BE TRACED.
+        bool shadow_rays_traced = rendering_settings.Shading.Lighting.Enabled && rendering_settings.Shading.Lighting.ShadowsEnabled;
+        bool only_primary_rays_traced = !shadow_rays_traced && !rendering_settings.Reflections;
+
+        // CHECK IF THE VIEW IS WELL-DEFINED.
+        float half_width = camera_ray_basis.HalfWidthRight.Length();
+        float half_height = camera_ray_basis.HalfHeightUp.Length();
+        bool view_valid = (half_width > 0.0f) && (half_height > 0.0f);
+
+        // UPDATE THE SCENE.
+        bool culling = cpu_rendering_settings.FrustumCulling && only_primary_rays_traced && view_valid;
+        if (!culling)
+        {
+            Scene.Update(scene, nullptr);
+            return;
+        }
+
+        // Primary rays start at the camera's plane and travel without limit.
+        constexpr float NEAR_DISTANCE = 0.0f;
+        constexpr float FAR_DISTANCE = std::numeric_limits<float>::infinity();
+        ViewFrustum primary_ray_frustum = ViewFrustum::Create(
+            camera_ray_basis.Origin,
+            MATH::Vector3f::Scale(1.0f / half_width, camera_ray_basis.HalfWidthRight),
+            MATH::Vector3f::Scale(1.0f / half_height, camera_ray_basis.HalfHeightUp),
+            camera_ray_basis.Forward,
+            camera_ray_basis.Perspective,
+            half_width,
+            half_height,
+            NEAR_DISTANCE,
+            FAR_DISTANCE);
+        Scene.Update(scene, &primary_ray_frustum);
+    }
+
+    /// Traces the pixels in a single tile for a single refinement pass.
+    /// Within the tile, one ray is traced at the top-left of each block, and its color fills the whole block.
+    /// Blocks whose top-left pixel was already traced in a coarser pass are skipped, so each pixel is
+    /// traced exactly once across all passes.
+    /// @param[in]  tile_index - The index of the tile, in row-major order across the screen.
+    /// @param[in]  tile_size_in_pixels - The width and height of tiles.
+    /// @param[in]  block_size_in_pixels - The width and height of blocks for this pass.
+    /// @param[in]  first_pass - True if this is the first pass for the frame; false if not.
+    /// @param[in]  camera_ray_basis - Information about the camera.
+    /// @param[in]  scene - The scene being rendered.
+    /// @param[in]  rendering_settings - The settings for what to render.
+    /// @param[in]  mipmapped_texture_sampling - True to sample textures from mipmaps; false to sample the nearest texel.
+    /// @param[in]  width_in_pixels - The width of the frame.
+    /// @param[in]  height_in_pixels - The height of the frame.
+    /// @param[in,out]  scratch - Scratch memory for the thread tracing the tile.
+    /// @param[out] pixels - The pixels of the frame to write to.
+    void TiledRayTracer::RenderTile(
+        const std::size_t tile_index,
+        const unsigned int tile_size_in_pixels,
+        const unsigned int block_size_in_pixels,
+        const bool first_pass,
+        const CameraRayBasis& camera_ray_basis,
+        const GRAPHICS::Scene& scene,
+        const GRAPHICS::RenderingSettings& rendering_settings,
+        const bool mipmapped_texture_sampling,
+        const unsigned int width_in_pixels,
+        const unsigned int height_in_pixels,
+        TileScratch& scratch,
+        uint32_t* pixels) const
+    {
+        PROFILING::TraceScope tile_scope("Ray Trace Tile", "Ray Tracing");
+
+        // COMPUTE THE PIXEL BOUNDS OF THE TILE.
+        unsigned int tile_column_count = (width_in_pixels + tile_size_in_pixels - 1) / tile_size_in_pixels;
+        unsigned int tile_column_index = static_cast<unsigned int>(tile_index % tile_column_count);
+        unsigned int tile_row_index = static_cast<unsigned int>(tile_index / tile_column_count);
+        unsigned int min_x = tile_column_index * tile_size_in_pixels;
+        unsigned int min_y = tile_row_index * tile_size_in_pixels;
+        unsigned int end_x = std::min(min_x + tile_size_in_pixels, width_in_pixels);
+        unsigned int end_y = std::min(min_y + tile_size_in_pixels, height_in_pixels);
+
+        // FIND WHAT A RAY FOR EACH BLOCK IN THE TILE HITS.
+        // Blocks are aligned to the tile rather than the screen so that they never cross into neighboring tiles,
+        // which may be written by other threads.  All hits in the tile are found before any are shaded
+        // so that traversal of the scene's hierarchies stays together.
+        scratch.BlockHits.clear();
+        unsigned int previous_block_size_in_pixels = 2 * block_size_in_pixels;
+        for (unsigned int y = min_y; y < end_y; y += block_size_in_pixels)
+        {
+            unsigned int tile_relative_y = y - min_y;
+            bool row_traced_previously = (0 == tile_relative_y % previous_block_size_in_pixels);
+            for (unsigned int x = min_x; x < end_x; x += block_size_in_pixels)
+            {
+                // SKIP BLOCKS ALREADY TRACED IN A COARSER PASS.
+                unsigned int tile_relative_x = x - min_x;
+                bool column_traced_previously = (0 == tile_relative_x % previous_block_size_in_pixels);
+                bool traced_previously = !first_pass && row_traced_previously && column_traced_previously;
+                if (traced_previously)
+                {
+                    continue;
+                }
+
+                // TRACE A RAY THROUGH THE CENTER OF THE BLOCK'S TOP-LEFT PIXEL.
+                // Primary rays start at the camera and thus don't need to worry about self-intersection.
+                constexpr float PIXEL_CENTER_OFFSET = 0.5f;
+                BlockRayHit& block_hit = scratch.BlockHits.emplace_back();
+                block_hit.X = x;
+                block_hit.Y = y;
+                block_hit.PrimaryRay = CreatePrimaryRay(
+                    camera_ray_basis,
+                    static_cast<float>(x) + PIXEL_CENTER_OFFSET,
+                    static_cast<float>(y) + PIXEL_CENTER_OFFSET,
+                    width_in_pixels,
+                    height_in_pixels);
+                constexpr float PRIMARY_RAY_MIN_DISTANCE = 0.0f;
+                block_hit.Hit = Scene.FindClosestHit(block_hit.PrimaryRay, PRIMARY_RAY_MIN_DISTANCE, std::numeric_limits<float>::max());
+            }
+        }
+
+        // SHADE EACH BLOCK.
+        for (const BlockRayHit& block_hit : scratch.BlockHits)
+        {
+            GRAPHICS::Color color = scene.BackgroundColor;
+            if (block_hit.Hit)
+            {
+                constexpr unsigned int NO_REFLECTIONS_YET = 0;
+                color = ShadeHit(block_hit.PrimaryRay, *block_hit.Hit, scene, rendering_settings, mipmapped_texture_sampling, NO_REFLECTIONS_YET);
+            }
+            uint32_t packed_color = PackedColor::FromColor(color);
+
+            // FILL THE BLOCK WITH THE COLOR.
+            unsigned int block_end_x = std::min(block_hit.X + block_size_in_pixels, end_x);
+            unsigned int block_end_y = std::min(block_hit.Y + block_size_in_pixels, end_y);
+            for (unsigned int block_y = block_hit.Y; block_y < block_end_y; ++block_y)
+            {
+                uint32_t* row_pixels = pixels + static_cast<std::size_t>(block_y) * width_in_pixels;
+                std::fill(row_pixels + block_hit.X, row_pixels + block_end_x, packed_color);
+            }
+        }
+    }
+
+    /// Precomputes camera information for generating primary rays.
+    /// @param[in]  camera - The camera to generate rays for.
+    /// @param[in]  width_in_pixels - The width of the image being rendered.
+    /// @param[in]  height_in_pixels - The height of the image being rendered.
+    /// @return Information for generating primary rays.
+    TiledRayTracer::CameraRayBasis TiledRayTracer::ComputeCameraRayBasis(
+        const GRAPHICS::VIEWING::Camera& camera,
+        const unsigned int width_in_pixels,
+        const unsigned int height_in_pixels)
+    {
+        CameraRayBasis camera_ray_basis;
+        camera_ray_basis.Origin = camera.WorldPosition;
+        camera_ray_basis.Forward = MATH::Vector3f::Normalize(camera.CoordinateFrame.Forward);
+        MATH::Vector3f right = MATH::Vector3f::Normalize(camera.CoordinateFrame.Right);
+        MATH::Vector3f up = MATH::Vector3f::Normalize(camera.CoordinateFrame.Up);
+
+        float aspect_ratio = static_cast<float>(width_in_pixels) / static_cast<float>(std::max(height_in_pixels, 1u));
+        camera_ray_basis.Perspective = (GRAPHICS::VIEWING::ProjectionType::PERSPECTIVE == camera.Projection);
+        if (camera_ray_basis.Perspective)
+        {
+            // COMPUTE THE VIEWING PLANE EXTENTS AT A DISTANCE OF 1 FROM THE FIELD OF VIEW.
+            // This matches the vertical field of view used for perspective projection when rasterizing.
+            constexpr float PI = 3.14159265358979f;
+            float field_of_view_in_radians = camera.FieldOfView.Value * PI / 180.0f;
+            float half_height = std::tan(field_of_view_in_radians / 2.0f);
+            float half_width = half_height * aspect_ratio;
+            camera_ray_basis.HalfWidthRight = MATH::Vector3f::Scale(half_width, right);
+            camera_ray_basis.HalfHeightUp = MATH::Vector3f::Scale(half_height, up);
+        }
+        else
+        {
+            // USE THE VIEWING PLANE DIMENSIONS FOR ORTHOGRAPHIC EXTENTS.
+            // A default extent is used if the viewing plane is degenerate to still produce a visible image.
+            constexpr float DEFAULT_VIEWING_PLANE_HEIGHT = 2.0f;
+            float viewing_plane_height = (camera.ViewingPlane.Height > 0.0f) ? camera.ViewingPlane.Height : DEFAULT_VIEWING_PLANE_HEIGHT;
+            float half_height = viewing_plane_height / 2.0f;
+            float half_width = half_height * aspect_ratio;
+            camera_ray_basis.HalfWidthRight = MATH::Vector3f::Scale(half_width, right);
+            camera_ray_basis.HalfHeightUp = MATH::Vector3f::Scale(half_height, up);
+        }
+
+        return camera_ray_basis;
+    }
+
+    /// Creates a primary ray from the camera through a position on the screen.
+    /// @param[in]  camera_ray_basis - Information about the camera.
+    /// @param[in]  x_position_in_pixels - The horizontal screen position, from the left.
+    /// @param[in]  y_position_in_pixels - The vertical screen position, from the top.
+    /// @param[in]  width_in_pixels - The width of the screen.
+    /// @param[in]  height_in_pixels - The height of the screen.
+    /// @return The primary ray.
+    Ray TiledRayTracer::CreatePrimaryRay(
+        const CameraRayBasis& camera_ray_basis,
+        const float x_position_in_pixels,
+        const float y_position_in_pixels,
+        const unsigned int width_in_pixels,
+        const unsigned int height_in_pixels)
+    {
+        // CONVERT TO NORMALIZED COORDINATES IN [-1, 1].
+        // The y-coordinate is flipped since screen rows go down while the camera's up vector goes up.
+        float normalized_x = (2.0f * x_position_in_pixels / static_cast<float>(width_in_pixels)) - 1.0f;
+        float normalized_y = 1.0f - (2.0f * y_position_in_pixels / static_cast<float>(height_in_pixels));
+        MATH::Vector3f viewing_plane_offset =
+            MATH::Vector3f::Scale(normalized_x, camera_ray_basis.HalfWidthRight) +
+            MATH::Vector3f::Scale(normalized_y, camera_ray_basis.HalfHeightUp);
+
+        // CREATE THE RAY BASED ON THE PROJECTION.
+        // The ray's cone covers a single pixel, which widens with distance only for perspective projection.
+        float pixel_height = 2.0f * camera_ray_basis.HalfHeightUp.Length() / static_cast<float>(height_in_pixels);
+        Ray ray;
+        if (camera_ray_basis.Perspective)
+        {
+            ray.Origin = camera_ray_basis.Origin;
+            ray.Direction = MATH::Vector3f::Normalize(camera_ray_basis.Forward + viewing_plane_offset);
+            ray.ConeSpreadAngle = pixel_height;
+        }
+        else
+        {
+            ray.Origin = camera_ray_basis.Origin + viewing_plane_offset;
+            ray.Direction = camera_ray_basis.Forward;
+            ray.ConeWidth = pixel_height;
+        }
+        return ray;
+    }
+
+    /// Traces a ray through the scene to compute the color seen along it.
+    /// @param[in]  ray - The ray to trace.
+    /// @param[in]  scene - The scene being rendered, for lights and the background.
+    /// @param[in]  rendering_settings - The settings for what to render.
+    /// @param[in]  mipmapped_texture_sampling - True to sample textures from mipmaps; false to sample the nearest texel.
+    /// @param[in]  reflection_count - The number of reflections that have already occurred to produce this ray.
+    /// @return The color seen along the ray.
+    GRAPHICS::Color TiledRayTracer::TraceRay(
+        const Ray& ray,
+        const GRAPHICS::Scene& scene,
+        const GRAPHICS::RenderingSettings& rendering_settings,
+        const bool mipmapped_texture_sampling,
+        const unsigned int reflection_count) const
+    {
+        // FIND THE CLOSEST SURFACE ALONG THE RAY.
+        // Primary rays start at the camera and thus don't need to worry about self-intersection.
+        float min_distance = (reflection_count > 0) ? SECONDARY_RAY_MIN_DISTANCE : 0.0f;
+        std::optional<RayHit> hit = Scene.FindClosestHit(ray, min_distance, std::numeric_limits<float>::max());
+        if (!hit)
+        {
+            return scene.BackgroundColor;
+        }
+
+        return ShadeHit(ray, *hit, scene, rendering_settings, mipmapped_texture_sampling, reflection_count);
+    }
+
+    /// Computes the color of a surface hit by a ray, including any reflections.
+    /// @param[in]  ray - The ray that hit the surface.
+    /// @param[in]  hit - The hit surface.
+    /// @param[in]  scene - The scene being rendered, for lights and the background.
+    /// @param[in]  rendering_settings - The settings for what to render.
+    /// @param[in]  mipmapped_texture_sampling - True to sample textures from mipmaps; false to sample the nearest texel.
+    /// @param[in]  reflection_count - The number of reflections that have already occurred to produce the ray.
+    /// @return The color of the surface.
+    GRAPHICS::Color TiledRayTracer::ShadeHit(
+        const Ray& ray,
+        RayHit hit,
+        const GRAPHICS::Scene& scene,
+        const GRAPHICS::RenderingSettings& rendering_settings,
+        const bool mipmapped_texture_sampling,
+        const unsigned int reflection_count) const
+    {
+        // DETERMINE HOW MUCH OF THE TEXTURE THE PIXEL COVERS.
+        // The ray's cone is projected onto the surface, stretching it the more the surface is tilted away.
+        float cone_width_at_hit = ray.ConeWidth + ray.ConeSpreadAngle * hit.Distance;
+        if (mipmapped_texture_sampling)
+        {
+            constexpr float MIN_SURFACE_ALIGNMENT = 0.01f;
+            float surface_alignment = std::max(std::abs(MATH::Vector3f::DotProduct(ray.Direction, hit.Normal)), MIN_SURFACE_ALIGNMENT);
+            hit.TextureCoordinateFootprint = cone_width_at_hit * hit.TextureCoordinatesPerWorldUnit / surface_alignment;
+        }
+        else
+        {
+            hit.DiffuseTexture = nullptr;
+        }
+
+        // SHADE THE SURFACE.
+        // Shadows are checked by tracing rays toward lights.
+        auto test_shadow_ray = [this](
+            const MATH::Vector3f& surface_position,
+            const MATH::Vector3f& direction_to_light,
+            const float distance_to_light)
+        {
+            Ray shadow_ray;
+            shadow_ray.Origin = surface_position;
+            shadow_ray.Direction = direction_to_light;
+            return Scene.IsOccluded(shadow_ray, SECONDARY_RAY_MIN_DISTANCE, distance_to_light);
+        };
+        SurfaceShading::ShadowTestFunction is_shadowed(test_shadow_ray);
+        MATH::Vector3f direction_to_viewer = MATH::Vector3f::Scale(-1.0f, ray.Direction);
+        GRAPHICS::Color color = SurfaceShading::Shade(hit, direction_to_viewer, scene, rendering_settings, is_shadowed);
+
+        // ADD ANY REFLECTIONS.
+        bool surface_reflective = hit.Material && (hit.Material->ReflectivityProportion > 0.0f);
+        bool more_reflections_allowed = rendering_settings.Reflections && (reflection_count < rendering_settings.MaxReflectionCount);
+        if (surface_reflective && more_reflections_allowed)
+        {
+            // REFLECT THE RAY ABOUT THE NORMAL.
+            float direction_along_normal = MATH::Vector3f::DotProduct(ray.Direction, hit.Normal);
+            Ray reflected_ray;
+            reflected_ray.Origin = hit.Position;
+            reflected_ray.Direction = MATH::Vector3f::Normalize(ray.Direction - MATH::Vector3f::Scale(2.0f * direction_along_normal, hit.Normal));
+            reflected_ray.ConeWidth = cone_width_at_hit;
+            reflected_ray.ConeSpreadAngle = ray.ConeSpreadAngle;
+
+            // BLEND THE REFLECTED COLOR WITH THE SURFACE COLOR.
+            GRAPHICS::Color reflected_color = TraceRay(reflected_ray, scene, rendering_settings, mipmapped_texture_sampling, reflection_count + 1);
+            float reflectivity = std::clamp(hit.Material->ReflectivityProportion, 0.0f, 1.0f);
+            float surface_proportion = 1.0f - reflectivity;
+            color.Red = surface_proportion * color.Red + reflectivity * reflected_color.Red;
+            color.Green = surface_proportion * color.Green + reflectivity * reflected_color.Green;
+            color.Blue = surface_proportion * color.Blue + reflectivity * reflected_color.Blue;
+        }
+
+        return color;
+    }
+}
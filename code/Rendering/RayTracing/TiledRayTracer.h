@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "Graphics/Color.h"
+#include "Graphics/Images/Bitmap.h"
+#include "Graphics/RenderingSettings.h"
+#include "Graphics/Scene.h"
+#include "Graphics/Viewing/Camera.h"
+#include "Math/Vector3.h"
+#include "Memory/ArenaAllocator.h"
+#include "Rendering/CpuRenderingSettings.h"
+#include "Rendering/RayTracing/Ray.h"
+#include "Rendering/RayTracing/RayTracingScene.h"
+#include "Threading/WorkStealingThreadPool.h"
+
+namespace RENDERING::RAY_TRACING
+{
+    /// A CPU ray tracer that splits the screen into tiles and traces them in parallel across all cores.
+    /// Tiles are independent (each pixel is written by exactly one tile), so no synchronization is needed
+    /// beyond the thread pool's work distribution.
+    ///
+    /// Frames can either be rendered all at once or progressively.  Progressive rendering first traces
+    /// one ray per coarse block of pixels to get a complete low-resolution image immediately, then refines
+    /// blocks over later calls within a time budget.  Each pixel is still traced exactly once in total,
+    /// so a finished progressive frame is identical to a frame rendered all at once.
+    class TiledRayTracer
+    {
+    public:
+        // RENDERING.
+        void Render(
+            const GRAPHICS::Scene& scene,
+            const GRAPHICS::VIEWING::Camera& camera,
+            const GRAPHICS::RenderingSettings& rendering_settings,
+            const CpuRenderingSettings& cpu_rendering_settings,
+            THREADING::WorkStealingThreadPool& thread_pool,
+            GRAPHICS::IMAGES::Bitmap& color_buffer);
+
+        // PROGRESSIVE RENDERING.
+        bool ProgressiveRenderNeedsRestart(const GRAPHICS::IMAGES::Bitmap& color_buffer) const;
+        bool ProgressiveRenderComplete() const;
+        void StartProgressiveRender(
+            const GRAPHICS::Scene& scene,
+            const GRAPHICS::VIEWING::Camera& camera,
+            const GRAPHICS::RenderingSettings& rendering_settings,
+            const CpuRenderingSettings& cpu_rendering_settings,
+            const GRAPHICS::IMAGES::Bitmap& color_buffer);
+        bool ContinueProgressiveRender(
+            const GRAPHICS::Scene& scene,
+            const GRAPHICS::RenderingSettings& rendering_settings,
+            const CpuRenderingSettings& cpu_rendering_settings,
+            THREADING::WorkStealingThreadPool& thread_pool,
+            GRAPHICS::IMAGES::Bitmap& color_buffer);
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The world-space geometry for the most recently rendered scene.
+        RayTracingScene Scene = {};
+
+    private:
+        /// Camera information precomputed once per frame for generating primary rays.
+        struct CameraRayBasis
+        {
+            /// The position of the camera.
+            MATH::Vector3f Origin = MATH::Vector3f(0.0f, 0.0f, 0.0f);
+            /// The camera's forward direction.
+            MATH::Vector3f Forward = MATH::Vector3f(0.0f, 0.0f, -1.0f);
+            /// The camera's right direction, scaled to span half of the viewing plane width.
+            MATH::Vector3f HalfWidthRight = MATH::Vector3f(1.0f, 0.0f, 0.0f);
+            /// The camera's up direction, scaled to span half of the viewing plane height.
+            MATH::Vector3f HalfHeightUp = MATH::Vector3f(0.0f, 1.0f, 0.0f);
+            /// True for perspective projection; false for orthographic.
+            bool Perspective = true;
+        };
+
+        /// The state of a frame being rendered progressively over multiple calls.
+        struct ProgressiveRenderState
+        {
+            /// True if a progressive render has been started; false if not.
+            bool Started = false;
+            /// True if all pixels in the frame have been traced; false if not.
+            bool Complete = false;
+            /// The camera information captured when the frame was started.
+            CameraRayBasis CameraRays = {};
+            /// The width of the frame.
+            unsigned int WidthInPixels = 0;
+            /// The height of the frame.
+            unsigned int HeightInPixels = 0;
+            /// The tile size captured when the frame was started, so that changes mid-frame don't skip pixels.
+            unsigned int TileSizeInPixels = 0;
+            /// The size of the square blocks for the current refinement pass.  1 for the final pass.
+            unsigned int BlockSizeInPixels = 0;
+            /// The index of the next tile to refine in the current pass.
+            std::size_t NextTileIndex = 0;
+            /// The pixels of the frame so far.  These are kept separately from the color buffer
+            /// since other things (like the GUI) may be drawn over the color buffer between calls.
+            std::vector<uint32_t> Pixels = {};
+        };
+
+        /// The primary ray traced for a single block of pixels in a tile, along with what it hit.
+        struct BlockRayHit
+        {
+            /// The left of the block on the screen.
+            unsigned int X = 0;
+            /// The top of the block on the screen.
+            unsigned int Y = 0;
+            /// The primary ray traced for the block.
+            Ray PrimaryRay = {};
+            /// The closest surface hit by the ray, if any.
+            std::optional<RayHit> Hit = std::nullopt;
+        };
+
+        /// Scratch memory for tracing a single tile at a time on a single thread.
+        /// It only lasts for a single frame, so its memory comes from the frame arena of its worker.
+        struct TileScratch
+        {
+            /// The hits for each block traced in the current tile.
+            MEMORY::ArenaVector<BlockRayHit> BlockHits = {};
+        };
+
+        // HELPER METHODS.
+        void PrepareTileScratches(THREADING::WorkStealingThreadPool& thread_pool, const unsigned int tile_size_in_pixels);
+        void ReleaseTileScratches();
+        void UpdateScene(
+            const GRAPHICS::Scene& scene,
+            const CameraRayBasis& camera_ray_basis,
+            const GRAPHICS::RenderingSettings& rendering_settings,
+            const CpuRenderingSettings& cpu_rendering_settings);
+        void RenderTile(
+            const std::size_t tile_index,
+            const unsigned int tile_size_in_pixels,
+            const unsigned int block_size_in_pixels,
+            const bool first_pass,
+            const CameraRayBasis& camera_ray_basis,
+            const GRAPHICS::Scene& scene,
+            const GRAPHICS::RenderingSettings& rendering_settings,
+            const bool mipmapped_texture_sampling,
+            const unsigned int width_in_pixels,
+            const unsigned int height_in_pixels,
+            TileScratch& scratch,
+            uint32_t* pixels) const;
+        static CameraRayBasis ComputeCameraRayBasis(
+            const GRAPHICS::VIEWING::Camera& camera,
+            const unsigned int width_in_pixels,
+            const unsigned int height_in_pixels);
+        static Ray CreatePrimaryRay(
+            const CameraRayBasis& camera_ray_basis,
+            const float x_position_in_pixels,
+            const float y_position_in_pixels,
+            const unsigned int width_in_pixels,
+            const unsigned int height_in_pixels);
+        GRAPHICS::Color TraceRay(
+            const Ray& ray,
+            const GRAPHICS::Scene& scene,
+            const GRAPHICS::RenderingSettings& rendering_settings,
+            const bool mipmapped_texture_sampling,
+            const unsigned int reflection_count) const;
+        GRAPHICS::Color ShadeHit(
+            const Ray& ray,
+            RayHit hit,
+            const GRAPHICS::Scene& scene,
+            const GRAPHICS::RenderingSettings& rendering_settings,
+            const bool mipmapped_texture_sampling,
+            const unsigned int reflection_count) const;
+
+        // PRIVATE MEMBER VARIABLES.
+        /// The frame currently being rendered progressively, if any.
+        ProgressiveRenderState Progressive = {};
+        /// Scratch memory for each worker thread, indexed by worker.  Kept between frames to reuse the array itself,
+        /// but each scratch's contents are only valid during a single frame.
+        std::vector<TileScratch> TileScratches = {};
+    };
+}
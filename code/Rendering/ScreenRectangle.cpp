@@ -0,0 +1,74 @@
+#include <algorithm>
+#include "Rendering/ScreenRectangle.h"
+
+namespace RENDERING
+{
+    /// Determines if the rectangle is empty (contains no pixels).
+    /// @return True if the rectangle is empty; false if not.
+    bool ScreenRectangle::IsEmpty() const
+    {
+        bool empty = (LeftX >= RightX) || (TopY >= BottomY);
+        return empty;
+    }
+
+    /// Gets the width of the rectangle.
+    /// @return The width of the rectangle; 0 if empty.
+    int ScreenRectangle::WidthInPixels() const
+    {
+        return std::max(RightX - LeftX, 0);
+    }
+
+    /// Gets the height of the rectangle.
+    /// @return The height of the rectangle; 0 if empty.
+    int ScreenRectangle::HeightInPixels() const
+    {
+        return std::max(BottomY - TopY, 0);
+    }
+
+    /// Expands the rectangle to contain another rectangle.
+    /// @param[in]  rectangle - The rectangle to contain.  Empty rectangles are ignored.
+    void ScreenRectangle::Expand(const ScreenRectangle& rectangle)
+    {
+        if (rectangle.IsEmpty())
+        {
+            return;
+        }
+        if (IsEmpty())
+        {
+            *this = rectangle;
+            return;
+        }
+
+        LeftX = std::min(LeftX, rectangle.LeftX);
+        TopY = std::min(TopY, rectangle.TopY);
+        RightX = std::max(RightX, rectangle.RightX);
+        BottomY = std::max(BottomY, rectangle.BottomY);
+    }
+
+    /// Gets the part of the rectangle within a screen of the specified size.
+    /// @param[in]  width_in_pixels - The width of the screen.
+    /// @param[in]  height_in_pixels - The height of the screen.
+    /// @return The part of the rectangle on screen (possibly empty).
+    ScreenRectangle ScreenRectangle::ClampedTo(const int width_in_pixels, const int height_in_pixels) const
+    {
+        ScreenRectangle clamped_rectangle;
+        clamped_rectangle.LeftX = std::clamp(LeftX, 0, width_in_pixels);
+        clamped_rectangle.TopY = std::clamp(TopY, 0, height_in_pixels);
+        clamped_rectangle.RightX = std::clamp(RightX, 0, width_in_pixels);
+        clamped_rectangle.BottomY = std::clamp(BottomY, 0, height_in_pixels);
+        return clamped_rectangle;
+    }
+
+    /// Gets the part of the rectangle that overlaps another rectangle.
+    /// @param[in]  rectangle - The rectangle to intersect with.
+    /// @return The overlapping part of the rectangles (possibly empty).
+    ScreenRectangle ScreenRectangle::Intersection(const ScreenRectangle& rectangle) const
+    {
+        ScreenRectangle intersection;
+        intersection.LeftX = std::max(LeftX, rectangle.LeftX);
+        intersection.TopY = std::max(TopY, rectangle.TopY);
+        intersection.RightX = std::min(RightX, rectangle.RightX);
+        intersection.BottomY = std::min(BottomY, rectangle.BottomY);
+        return intersection;
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+namespace RENDERING
+{
+    /// An axis-aligned rectangle of pixels on screen, such as a region that needs to be redrawn.
+    /// The left and top edges are inclusive, while the right and bottom edges are exclusive.
+    /// A default-constructed rectangle is empty, so expanding it by any rectangle results in just that rectangle.
+    struct ScreenRectangle
+    {
+        // OPERATIONS.
+        bool IsEmpty() const;
+        int WidthInPixels() const;
+        int HeightInPixels() const;
+        void Expand(const ScreenRectangle& rectangle);
+        ScreenRectangle ClampedTo(const int width_in_pixels, const int height_in_pixels) const;
+        ScreenRectangle Intersection(const ScreenRectangle& rectangle) const;
+
+        // PUBLIC MEMBER VARIABLES FOR EASY ACCESS.
+        /// The leftmost column of pixels in the rectangle.
+        int LeftX = 0;
+        /// The topmost row of pixels in the rectangle.
+        int TopY = 0;
+        /// The column just past the rightmost column of pixels in the rectangle.
+        int RightX = 0;
+        /// The row just past the bottommost row of pixels in the rectangle.
+        int BottomY = 0;
+    };
+}
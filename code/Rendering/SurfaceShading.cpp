@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "Rendering/SurfaceShading.h"
+
+namespace RENDERING
+{
+    /// Computes the color of a point on a surface, excluding reflections.
+    /// @param[in]  surface - The point on the surface to shade.
+    /// @param[in]  direction_to_viewer - The normalized direction from the surface to the viewer.
+    /// @param[in]  scene - The scene being rendered, for lights and the background.
+    /// @param[in]  rendering_settings - The settings for what to render.
+    /// @param[in]  is_shadowed - The function for checking if lights are blocked.  Shadows are skipped if empty.
+    /// @return The color of the surface.
+    GRAPHICS::Color SurfaceShading::Shade(
+        const SurfacePoint& surface,
+        const MATH::Vector3f& direction_to_viewer,
+        const GRAPHICS::Scene& scene,
+        const GRAPHICS::RenderingSettings& rendering_settings,
+        const ShadowTestFunction& is_shadowed)
+    {
+        // USE A DEFAULT MATERIAL IF NEEDED.
+        static const GRAPHICS::Material DEFAULT_MATERIAL = {};
+        const GRAPHICS::Material& material = surface.Material ? *surface.Material : DEFAULT_MATERIAL;
+
+        // DETERMINE THE SHADING TYPE.
+        // The shading type in the rendering settings overrides the material's, unless it is set to use materials.
+        GRAPHICS::SHADING::ShadingType shading_type = rendering_settings.Shading.ShadingType;
+        if (GRAPHICS::SHADING::ShadingType::MATERIAL == shading_type)
+        {
+            shading_type = material.Shading;
+        }
+
+        // COMPUTE THE BASE COLOR OF THE SURFACE.
+        GRAPHICS::Color base_color(
+            material.DiffuseProperties.Color.Red * surface.VertexColor.Red,
+            material.DiffuseProperties.Color.Green * surface.VertexColor.Green,
+            material.DiffuseProperties.Color.Blue * surface.VertexColor.Blue,
+            1.0f);
+        const GRAPHICS::IMAGES::Bitmap* texture = material.DiffuseProperties.Texture.get();
+        if (rendering_settings.Shading.TextureMappingEnabled && surface.DiffuseTexture)
+        {
+            // SAMPLE THE MIPMAPPED TEXTURE WITH TRILINEAR FILTERING.
+            GRAPHICS::Color texel = surface.DiffuseTexture->Sample(surface.TextureCoordinates, surface.TextureCoordinateFootprint);
+            base_color.Red *= texel.Red;
+            base_color.Green *= texel.Green;
+            base_color.Blue *= texel.Blue;
+        }
+        else if (rendering_settings.Shading.TextureMappingEnabled && texture)
+        {
+            // SAMPLE THE NEAREST TEXEL, WRAPPING TEXTURE COORDINATES.
+            unsigned int texture_width_in_pixels = texture->GetWidthInPixels();
+            unsigned int texture_height_in_pixels = texture->GetHeightInPixels();
+            if (texture_width_in_pixels > 0 && texture_height_in_pixels > 0)
+            {
+                float wrapped_u = surface.TextureCoordinates.X - std::floor(surface.TextureCoordinates.X);
+                float wrapped_v = surface.TextureCoordinates.Y - std::floor(surface.TextureCoordinates.Y);
+                unsigned int texel_x = std::min(static_cast<unsigned int>(wrapped_u * static_cast<float>(texture_width_in_pixels)), texture_width_in_pixels - 1);
+                unsigned int texel_y = std::min(static_cast<unsigned int>(wrapped_v * static_cast<float>(texture_height_in_pixels)), texture_height_in_pixels - 1);
+                GRAPHICS::Color texel = texture->GetPixel(texel_x, texel_y);
+                base_color.Red *= texel.Red;
+                base_color.Green *= texel.Green;
+                base_color.Blue *= texel.Blue;
+            }
+        }
+
+        // HANDLE SHADING TYPES THAT DON'T USE LIGHTING.
+        switch (shading_type)
+        {
+            case GRAPHICS::SHADING::ShadingType::WIREFRAME:
+            {
+                // Only pixels near triangle edges are drawn for wireframes.
+                // Spheres have no edges and are just drawn flat.
+                if (surface.IsTriangle)
+                {
+                    constexpr float EDGE_BARYCENTRIC_THRESHOLD = 0.02f;
+                    float first_vertex_barycentric = 1.0f - surface.TriangleBarycentricCoordinates.X - surface.TriangleBarycentricCoordinates.Y;
+                    float min_barycentric = std::min({ first_vertex_barycentric, surface.TriangleBarycentricCoordinates.X, surface.TriangleBarycentricCoordinates.Y });
+                    if (min_barycentric > EDGE_BARYCENTRIC_THRESHOLD)
+                    {
+                        return scene.BackgroundColor;
+                    }
+                }
+                return base_color;
+            }
+            case GRAPHICS::SHADING::ShadingType::FLAT:
+            {
+                return base_color;
+            }
+            default:
+            {
+                break;
+            }
+        }
+        if (!rendering_settings.Shading.Lighting.Enabled)
+        {
+            return base_color;
+        }
+
+        // START WITH ANY EMITTED LIGHT.
+        GRAPHICS::Color color(material.EmissiveColor.Red, material.EmissiveColor.Green, material.EmissiveColor.Blue, 1.0f);
+
+        // ADD THE CONTRIBUTION FROM EACH LIGHT.
+        for (const GRAPHICS::SHADING::LIGHTING::Light& light : scene.Lights)
+        {
+            // HANDLE AMBIENT LIGHTS.
+            if (GRAPHICS::SHADING::LIGHTING::LightType::AMBIENT == light.Type)
+            {
+                if (rendering_settings.Shading.Lighting.AmbientLightingEnabled)
+                {
+                    color.Red += material.AmbientProperties.Color.Red * light.Color.Red;
+                    color.Green += material.AmbientProperties.Color.Green * light.Color.Green;
+                    color.Blue += material.AmbientProperties.Color.Blue * light.Color.Blue;
+                }
+                continue;
+            }
+
+            // DETERMINE THE DIRECTION TO THE LIGHT.
+            MATH::Vector3f direction_to_light = MATH::Vector3f(0.0f, 0.0f, 0.0f);
+            float distance_to_light = std::numeric_limits<float>::max();
+            if (GRAPHICS::SHADING::LIGHTING::LightType::POINT == light.Type)
+            {
+                MATH::Vector3f surface_to_light = light.PointLightWorldPosition - surface.Position;
+                distance_to_light = surface_to_light.Length();
+                if (distance_to_light <= 0.0f)
+                {
+                    continue;
+                }
+                direction_to_light = MATH::Vector3f::Scale(1.0f / distance_to_light, surface_to_light);
+            }
+            else
+            {
+                direction_to_light = MATH::Vector3f::Normalize(MATH::Vector3f::Scale(-1.0f, light.DirectionalLightDirection));
+            }
+
+            // SKIP LIGHTS BEHIND THE SURFACE.
+            float illumination_proportion = MATH::Vector3f::DotProduct(surface.Normal, direction_to_light);
+            if (illumination_proportion <= 0.0f)
+            {
+                continue;
+            }
+
+            // SKIP LIGHTS THAT ARE BLOCKED.
+            if (rendering_settings.Shading.Lighting.ShadowsEnabled && is_shadowed)
+            {
+                bool in_shadow = is_shadowed(surface.Position, direction_to_light, distance_to_light);
+                if (in_shadow)
+                {
+                    continue;
+                }
+            }
+
+            // ADD DIFFUSE LIGHTING.
+            if (rendering_settings.Shading.Lighting.DiffuseLightingEnabled)
+            {
+                color.Red += base_color.Red * light.Color.Red * illumination_proportion;
+                color.Green += base_color.Green * light.Color.Green * illumination_proportion;
+                color.Blue += base_color.Blue * light.Color.Blue * illumination_proportion;
+            }
+
+            // ADD SPECULAR LIGHTING.
+            if (rendering_settings.Shading.Lighting.SpecularLightingEnabled && material.SpecularProperties.SpecularPower > 0.0f)
+            {
+                MATH::Vector3f reflected_light_direction =
+                    MATH::Vector3f::Scale(2.0f * illumination_proportion, surface.Normal) - direction_to_light;
+                float specular_alignment = MATH::Vector3f::DotProduct(reflected_light_direction, direction_to_viewer);
+                if (specular_alignment > 0.0f)
+                {
+                    float specular_proportion = std::pow(specular_alignment, material.SpecularProperties.SpecularPower);
+                    color.Red += material.SpecularProperties.Color.Red * light.Color.Red * specular_proportion;
+                    color.Green += material.SpecularProperties.Color.Green * light.Color.Green * specular_proportion;
+                    color.Blue += material.SpecularProperties.Color.Blue * light.Color.Blue * specular_proportion;
+                }
+            }
+        }
+
+        return color;
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Graphics/Color.h"
+#include "Graphics/Material.h"
+#include "Graphics/RenderingSettings.h"
+#include "Graphics/Scene.h"
+#include "Math/Vector2.h"
+#include "Math/Vector3.h"
+#include "Rendering/MipmappedTexture.h"
+
+namespace RENDERING
+{
+    /// A point on a surface being rendered, with the information needed to shade it.
+    struct SurfacePoint
+    {
+        /// The world position of the point.
+        MATH::Vector3f Position = MATH::Vector3f(0.0f, 0.0f, 0.0f);
+        /// The normalized surface normal at the point.  Renderers with double-sided surfaces flip it to face the viewer.
+        MATH::Vector3f Normal = MATH::Vector3f(0.0f, 0.0f, 1.0f);
+        /// The interpolated texture coordinates at the point.
+        MATH::Vector2f TextureCoordinates = MATH::Vector2f(0.0f, 0.0f);
+        /// The interpolated vertex color at the point.
+        GRAPHICS::Color VertexColor = GRAPHICS::Color::WHITE;
+        /// The barycentric coordinates of the point if on a triangle, for wireframe rendering.
+        /// The first two components are for the 2nd and 3rd vertices; the 1st vertex's is implied.
+        MATH::Vector2f TriangleBarycentricCoordinates = MATH::Vector2f(0.0f, 0.0f);
+        /// True if the point is on a triangle; false if on a sphere.
+        bool IsTriangle = false;
+        /// The material of the surface.  May be null.
+        const GRAPHICS::Material* Material = nullptr;
+        /// The mipmapped form of the material's diffuse texture, for filtered sampling.
+        /// If null, the material's texture is sampled directly at the nearest texel.
+        const MipmappedTexture* DiffuseTexture = nullptr;
+        /// The approximate width in texture coordinates covered by the pixel being shaded,
+        /// which selects the mipmap levels of the diffuse texture to sample.
+        float TextureCoordinateFootprint = 0.0f;
+    };
+
+    /// Computes colors of surfaces based on their materials and the scene's lights.
+    /// This is shared by the CPU rendering paths so that they all shade surfaces the same way.
+    class SurfaceShading
+    {
+    public:
+        /// A reference to a function for checking if a light is blocked from reaching a surface, for shadows.
+        /// The function is given the surface's position, the normalized direction to the light, and the distance to the light.
+        /// It's referred to rather than copied into a std::function, which could allocate memory for every shaded point,
+        /// so it must outlive the reference.
+        class ShadowTestFunction
+        {
+        public:
+            /// Constructor for an empty reference, which skips shadows.
+            ShadowTestFunction() = default;
+
+            /// Constructor.
+            /// @param[in]  function - The function to refer to.
+            template <typename FunctionType>
+            explicit ShadowTestFunction(const FunctionType& function) :
+                Function(&function),
+                Call([](const void* const function, const MATH::Vector3f& surface_position, const MATH::Vector3f& direction_to_light, const float distance_to_light)
+                {
+                    return (*static_cast<const FunctionType*>(function))(surface_position, direction_to_light, distance_to_light);
+                })
+            {}
+
+            /// Determines if a function is referred to.
+            /// @return True if a function is referred to; false if the reference is empty.
+            explicit operator bool() const
+            {
+                return nullptr != Call;
+            }
+
+            /// Calls the function.
+            /// @param[in]  surface_position - The position on the surface.
+            /// @param[in]  direction_to_light - The normalized direction from the surface to the light.
+            /// @param[in]  distance_to_light - The distance from the surface to the light.
+            /// @return True if the light is blocked; false otherwise.
+            bool operator()(const MATH::Vector3f& surface_position, const MATH::Vector3f& direction_to_light, const float distance_to_light) const
+            {
+                return Call(Function, surface_position, direction_to_light, distance_to_light);
+            }
+
+        private:
+            /// The function referred to; null if none.
+            const void* Function = nullptr;
+            /// Calls the function referred to; null if none.
+            bool (*Call)(const void* const function, const MATH::Vector3f& surface_position, const MATH::Vector3f& direction_to_light, const float distance_to_light) = nullptr;
+        };
+
+        // SHADING.
+        static GRAPHICS::Color Shade(
+            const SurfacePoint& surface,
+            const MATH::Vector3f& direction_to_viewer,
+            const GRAPHICS::Scene& scene,
+            const GRAPHICS::RenderingSettings& rendering_settings,
+            const ShadowTestFunction& is_shadowed);
+    };
+}
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include "Rendering/UniqueVertexTable.h"
+
+namespace RENDERING
+{
+    /// All attributes of a vertex packed together, so that vertices are only merged if fully identical.
+    using VertexKey = std::array<float, 12>;
+
+    /// Packs all attributes of a vertex into a key.
+    /// @param[in]  vertex - The vertex to get the key for.
+    /// @return The vertex's key.
+    static VertexKey GetVertexKey(const GRAPHICS::VertexWithAttributes& vertex)
+    {
+        VertexKey vertex_key =
+        {
+            vertex.Position.X, vertex.Position.Y, vertex.Position.Z,
+            vertex.Normal.X, vertex.Normal.Y, vertex.Normal.Z,
+            vertex.TextureCoordinates.X, vertex.TextureCoordinates.Y,
+            vertex.Color.Red, vertex.Color.Green, vertex.Color.Blue, vertex.Color.Alpha,
+        };
+        return vertex_key;
+    }
+
+    /// Constructor.
+    /// @param[in]  triangles - The triangles whose corners to index.
+    UniqueVertexTable::UniqueVertexTable(const std::vector<GRAPHICS::GEOMETRY::Triangle>& triangles) :
+        Triangles(triangles)
+    {
+        // Triangles in typical meshes share most vertices, so there are usually fewer unique vertices than triangles.
+        // Sizing the table for that keeps it at most half full without having to grow.
+        constexpr std::size_t MIN_SLOT_COUNT = 16;
+        std::size_t slot_count = std::bit_ceil(std::max(2 * triangles.size(), MIN_SLOT_COUNT));
+        VertexIndicesBySlot.assign(slot_count, NO_VERTEX);
+    }
+
+    /// Finds the unique vertex at a triangle corner, adding it if it's the first corner with that vertex.
+    /// @param[in]  corner_index - The index of the corner, which is the triangle's index times 3 plus the corner within the triangle.
+    /// @return The index of the unique vertex.  New vertices are numbered consecutively in the order found.
+    uint32_t UniqueVertexTable::FindOrAdd(const uint32_t corner_index)
+    {
+        // CHECK IF THE VERTEX WAS ALREADY FOUND.
+        const GRAPHICS::VertexWithAttributes& vertex = Corner(corner_index);
+        std::size_t slot_index = FindSlot(vertex);
+        uint32_t vertex_index = VertexIndicesBySlot[slot_index];
+        if (NO_VERTEX != vertex_index)
+        {
+            return vertex_index;
+        }
+
+        // ADD THE NEW VERTEX.
+        vertex_index = VertexCount();
+        FirstCornerIndices.emplace_back(corner_index);
+        VertexIndicesBySlot[slot_index] = vertex_index;
+
+        // KEEP THE TABLE AT MOST HALF FULL.
+        // Longer runs of occupied slots would otherwise make lookups much slower.
+        bool table_too_full = (2 * FirstCornerIndices.size() > VertexIndicesBySlot.size());
+        if (table_too_full)
+        {
+            Grow();
+        }
+        return vertex_index;
+    }
+
+    /// Finds the unique vertex at a triangle corner that was already added.
+    /// @param[in]  corner_index - The index of the corner, which is the triangle's index times 3 plus the corner within the triangle.
+    /// @return The index of the unique vertex; NO_VERTEX if the vertex was never added.
+    uint32_t UniqueVertexTable::Find(const uint32_t corner_index) const
+    {
+        std::size_t slot_index = FindSlot(Corner(corner_index));
+        return VertexIndicesBySlot[slot_index];
+    }
+
+    /// Gets the number of unique vertices found so far.
+    /// @return The number of unique vertices.
+    uint32_t UniqueVertexTable::VertexCount() const
+    {
+        return static_cast<uint32_t>(FirstCornerIndices.size());
+    }
+
+    /// Gets a unique vertex.
+    /// @param[in]  vertex_index - The index of the vertex, which must have been found.
+    /// @return The vertex.
+    const GRAPHICS::VertexWithAttributes& UniqueVertexTable::Vertex(const uint32_t vertex_index) const
+    {
+        return Corner(FirstCornerIndices[vertex_index]);
+    }
+
+    /// Gets the vertex at a triangle corner.
+    /// @param[in]  corner_index - The index of the corner, which is the triangle's index times 3 plus the corner within the triangle.
+    /// @return The vertex at the corner.
+    const GRAPHICS::VertexWithAttributes& UniqueVertexTable::Corner(const uint32_t corner_index) const
+    {
+        return Triangles[corner_index / CORNERS_PER_TRIANGLE].Vertices[corner_index % CORNERS_PER_TRIANGLE];
+    }
+
+    /// Finds the hash table slot for a vertex.
+    /// @param[in]  vertex - The vertex to find.
+    /// @return The slot holding the vertex if it was already added; otherwise, the empty slot where it would be added.
+    std::size_t UniqueVertexTable::FindSlot(const GRAPHICS::VertexWithAttributes& vertex) const
+    {
+        // Keys are compared and hashed as bytes so that the two are consistent for special values like negative zero.
+        VertexKey vertex_key = GetVertexKey(vertex);
+        std::string_view vertex_key_bytes(reinterpret_cast<const char*>(vertex_key.data()), sizeof(VertexKey));
+        std::size_t slot_index_mask = VertexIndicesBySlot.size() - 1;
+        std::size_t slot_index = std::hash<std::string_view>()(vertex_key_bytes) & slot_index_mask;
+        while (true)
+        {
+            uint32_t vertex_index = VertexIndicesBySlot[slot_index];
+            if (NO_VERTEX == vertex_index)
+            {
+                return slot_index;
+            }
+
+            VertexKey slot_vertex_key = GetVertexKey(Vertex(vertex_index));
+            bool vertex_found = (0 == std::memcmp(slot_vertex_key.data(), vertex_key.data(), sizeof(VertexKey)));
+            if (vertex_found)
+            {
+                return slot_index;
+            }
+
+            slot_index = (slot_index + 1) & slot_index_mask;
+        }
+    }
+
+    /// Doubles the size of the hash table, re-adding all vertices.
+    void UniqueVertexTable::Grow()
+    {
+        VertexIndicesBySlot.assign(2 * VertexIndicesBySlot.size(), NO_VERTEX);
+        for (uint32_t vertex_index = 0; vertex_index < VertexCount(); ++vertex_index)
+        {
+            std::size_t slot_index = FindSlot(Vertex(vertex_index));
+            VertexIndicesBySlot[slot_index] = vertex_index;
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Graphics/Geometry/Triangle.h"
+
+namespace RENDERING
+{
+    /// Finds the unique vertices among the corners of a list of triangles, for storing shared vertices only once.
+    /// Vertices are only merged if all of their attributes are identical.
+    ///
+    /// Meshes can have millions of vertices, so this is built to need little memory beyond the triangles themselves.
+    /// Rather than copying vertices into keys, each unique vertex is identified by the first triangle corner it was found at,
+    /// and the hash table (using open addressing) only holds 32-bit vertex indices.
+    ///
+    /// The triangles must outlive the table and not change while it's in use.
+    class UniqueVertexTable
+    {
+    public:
+        /// The number of corners per triangle.
+        static constexpr uint32_t CORNERS_PER_TRIANGLE = 3;
+        /// The vertex index for no vertex, such as for empty hash table slots.
+        static constexpr uint32_t NO_VERTEX = UINT32_MAX;
+
+        // CONSTRUCTION.
+        explicit UniqueVertexTable(const std::vector<GRAPHICS::GEOMETRY::Triangle>& triangles);
+
+        // INDEXING.
+        uint32_t FindOrAdd(const uint32_t corner_index);
+        uint32_t Find(const uint32_t corner_index) const;
+
+        // QUERIES.
+        uint32_t VertexCount() const;
+        const GRAPHICS::VertexWithAttributes& Vertex(const uint32_t vertex_index) const;
+
+    private:
+        // HELPER METHODS.
+        const GRAPHICS::VertexWithAttributes& Corner(const uint32_t corner_index) const;
+        std::size_t FindSlot(const GRAPHICS::VertexWithAttributes& vertex) const;
+        void Grow();
+
+        // PRIVATE MEMBER VARIABLES.
+        /// The triangles whose corners are being indexed.
+        const std::vector<GRAPHICS::GEOMETRY::Triangle>& Triangles;
+        /// The index of the first corner found for each unique vertex, ordered by vertex index.
+        std::vector<uint32_t> FirstCornerIndices = {};
+        /// The hash table of vertex indices.  Its size is always a power of 2, and empty slots hold NO_VERTEX.
+        std::vector<uint32_t> VertexIndicesBySlot = {};
+    };
+}
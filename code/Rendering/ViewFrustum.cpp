@@ -0,0 +1,98 @@
+#include <cmath>
+#include "Rendering/ViewFrustum.h"
+
+namespace RENDERING
+{
+    /// Creates a frustum for a camera.
+    /// @param[in]  origin - The position of the camera.
+    /// @param[in]  right - The camera's normalized right direction.
+    /// @param[in]  up - The camera's normalized up direction.
+    /// @param[in]  forward - The camera's normalized forward direction.
+    /// @param[in]  perspective - True for perspective projection; false for orthographic.
+    /// @param[in]  half_width - Half of the viewing plane width (at a distance of 1 for perspective projection).
+    /// @param[in]  half_height - Half of the viewing plane height (at a distance of 1 for perspective projection).
+    /// @param[in]  near_distance - The distance in front of the camera where the frustum starts.
+    /// @param[in]  far_distance - The distance in front of the camera where the frustum ends.  May be infinite.
+    /// @return The frustum.
+    ViewFrustum ViewFrustum::Create(
+        const MATH::Vector3f& origin,
+        const MATH::Vector3f& right,
+        const MATH::Vector3f& up,
+        const MATH::Vector3f& forward,
+        const bool perspective,
+        const float half_width,
+        const float half_height,
+        const float near_distance,
+        const float far_distance)
+    {
+        ViewFrustum frustum;
+
+        // ADD THE PLANES FOR THE SIDES OF THE SCREEN.
+        if (perspective)
+        {
+            // All side planes pass through the camera, angled outward by the field of view.
+            frustum.AddPlane(MATH::Vector3f::Scale(half_width, forward) - right, origin);
+            frustum.AddPlane(MATH::Vector3f::Scale(half_width, forward) + right, origin);
+            frustum.AddPlane(MATH::Vector3f::Scale(half_height, forward) - up, origin);
+            frustum.AddPlane(MATH::Vector3f::Scale(half_height, forward) + up, origin);
+        }
+        else
+        {
+            frustum.AddPlane(MATH::Vector3f::Scale(-1.0f, right), origin + MATH::Vector3f::Scale(half_width, right));
+            frustum.AddPlane(right, origin - MATH::Vector3f::Scale(half_width, right));
+            frustum.AddPlane(MATH::Vector3f::Scale(-1.0f, up), origin + MATH::Vector3f::Scale(half_height, up));
+            frustum.AddPlane(up, origin - MATH::Vector3f::Scale(half_height, up));
+        }
+
+        // ADD THE NEAR AND FAR PLANES.
+        frustum.AddPlane(forward, origin + MATH::Vector3f::Scale(near_distance, forward));
+        if (std::isfinite(far_distance))
+        {
+            frustum.AddPlane(MATH::Vector3f::Scale(-1.0f, forward), origin + MATH::Vector3f::Scale(far_distance, forward));
+        }
+
+        return frustum;
+    }
+
+    /// Determines if a box is entirely outside the frustum.
+    /// This is conservative: a box outside the frustum but not entirely outside any single plane
+    /// (such as one diagonally past a corner) isn't excluded, which only costs some extra work for it.
+    /// @param[in]  box - The box to check, in world space.
+    /// @return True if the box is definitely outside the frustum (or empty); false if it may be visible.
+    bool ViewFrustum::Excludes(const BoundingBox& box) const
+    {
+        if (box.IsEmpty())
+        {
+            return true;
+        }
+
+        for (std::size_t plane_index = 0; plane_index < PlaneCount; ++plane_index)
+        {
+            // CHECK THE CORNER OF THE BOX FARTHEST INSIDE THE PLANE.
+            // If even that corner is outside, the whole box is.
+            const Plane& plane = Planes[plane_index];
+            MATH::Vector3f farthest_inside_corner(
+                (plane.Normal.X >= 0.0f) ? box.Max.X : box.Min.X,
+                (plane.Normal.Y >= 0.0f) ? box.Max.Y : box.Min.Y,
+                (plane.Normal.Z >= 0.0f) ? box.Max.Z : box.Min.Z);
+            float plane_value = MATH::Vector3f::DotProduct(plane.Normal, farthest_inside_corner) + plane.Offset;
+            if (plane_value < 0.0f)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /// Adds a bounding plane to the frustum.
+    /// @param[in]  normal - The normal of the plane, pointing inside.
+    /// @param[in]  point_on_plane - Any point on the plane.
+    void ViewFrustum::AddPlane(const MATH::Vector3f& normal, const MATH::Vector3f& point_on_plane)
+    {
+        Plane& plane = Planes[PlaneCount];
+        plane.Normal = normal;
+        plane.Offset = -MATH::Vector3f::DotProduct(normal, point_on_plane);
+        ++PlaneCount;
+    }
+}
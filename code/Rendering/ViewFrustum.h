@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include "Math/Vector3.h"
+#include "Rendering/BoundingBox.h"
+
+namespace RENDERING
+{
+    /// Counts of geometry skipped by culling in the most recently rendered frame.
+    struct CullingStatistics
+    {
+        /// The number of objects in the scene.
+        std::size_t ObjectCount = 0;
+        /// The number of objects skipped for being entirely outside the view frustum.
+        std::size_t ObjectsOutsideFrustum = 0;
+        /// The number of clusters of triangles (parts of objects) considered in visible objects.
+        std::size_t ClusterCount = 0;
+        /// The number of clusters of triangles skipped for being entirely outside the view frustum.
+        std::size_t ClustersOutsideFrustum = 0;
+        /// The number of triangles skipped for being behind everything already drawn in screen tiles they overlap.
+        std::size_t OccludedTriangleCount = 0;
+    };
+
+    /// The region of world space visible through a camera, bounded by planes.
+    /// Used to skip geometry that can't appear on screen before doing any per-triangle work for it.
+    class ViewFrustum
+    {
+    public:
+        /// The maximum number of bounding planes: 4 for the sides of the screen, plus near and far planes.
+        static constexpr std::size_t MAX_PLANE_COUNT = 6;
+
+        // CREATION.
+        static ViewFrustum Create(
+            const MATH::Vector3f& origin,
+            const MATH::Vector3f& right,
+            const MATH::Vector3f& up,
+            const MATH::Vector3f& forward,
+            const bool perspective,
+            const float half_width,
+            const float half_height,
+            const float near_distance,
+            const float far_distance);
+
+        // CULLING.
+        bool Excludes(const BoundingBox& box) const;
+
+    private:
+        /// A plane bounding the frustum.  Points are inside where the plane's function is non-negative.
+        struct Plane
+        {
+            /// The normal of the plane, pointing inside.  Not necessarily normalized.
+            MATH::Vector3f Normal = MATH::Vector3f(0.0f, 0.0f, 1.0f);
+            /// The offset of the plane's function.
+            float Offset = 0.0f;
+        };
+
+        // HELPER METHODS.
+        void AddPlane(const MATH::Vector3f& normal, const MATH::Vector3f& point_on_plane);
+
+        // PRIVATE MEMBER VARIABLES.
+        /// The planes bounding the frustum.
+        Plane Planes[MAX_PLANE_COUNT] = {};
+        /// The number of planes in use.
+        std::size_t PlaneCount = 0;
+    };
+}
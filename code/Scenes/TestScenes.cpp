@@ -0,0 +1,175 @@
+#include <memory>
+#include <utility>
+#include "Assets/TextureCache.h"
+#include "Graphics/Geometry/Sphere.h"
+#include "Graphics/Images/Bitmap.h"
+#include "Graphics/Material.h"
+#include "Graphics/Mesh.h"
+#include "Scenes/TestScenes.h"
+
+namespace SCENES
+{
+    /// Creates the two-triangle textured quad used as the default model.
+    /// @param[in]  texture_filepath - The path to the texture to map onto the quad.
+    /// @return The textured quad object.
+    GRAPHICS::Object3D TestScenes::CreateTexturedQuad(const std::filesystem::path& texture_filepath)
+    {
+        // CREATE THE MATERIAL.
+        std::shared_ptr<GRAPHICS::Material> test_material = std::make_shared<GRAPHICS::Material>();
+        test_material->Shading = GRAPHICS::SHADING::ShadingType::MATERIAL;
+        test_material->DiffuseProperties.Color = GRAPHICS::Color::WHITE;
+        test_material->DiffuseProperties.Texture = ASSETS::TextureCache::LoadPng(texture_filepath);
+
+        // CREATE THE MESH.
+        GRAPHICS::Mesh test_mesh;
+        test_mesh.Name = "test_mesh";
+#if SINGLE_TRIANGLE
+        GRAPHICS::Triangle triangle;
+        triangle.Vertices =
+        {
+            GRAPHICS::VertexWithAttributes
+            {
+                .Position = MATH::Vector3f(0.0f, 1.0f, 0.0f),
+                .Color = GRAPHICS::Color::WHITE,
+                .TextureCoordinates = MATH::Vector2f(0.0f, 0.0f),
+            },
+            GRAPHICS::VertexWithAttributes
+            {
+                .Position = MATH::Vector3f(-1.0f, -1.0f, 0.0f) ,
+                .Color = GRAPHICS::Color::WHITE,
+                .TextureCoordinates = MATH::Vector2f(1.0f, 0.0f),
+            },
+            GRAPHICS::VertexWithAttributes
+            {
+                .Position = MATH::Vector3f(1.0f, -1.0f, 0.0f),
+                .Color = GRAPHICS::Color::WHITE,
+                .TextureCoordinates = MATH::Vector2f(0.0f, 1.0f),
+            },
+        };
+        triangle.Material = test_material;
+        test_mesh.Triangles.push_back(triangle);
+#else
+        GRAPHICS::GEOMETRY::Triangle triangle;
+#if 1
+        triangle.Vertices =
+        {
+            GRAPHICS::VertexWithAttributes
+            {
+                .Position = MATH::Vector3f(0.0f, 1.0f, 0.0f),
+                .Color = GRAPHICS::Color::WHITE,
+                //.Color = GRAPHICS::Color::RED,
+                .TextureCoordinates = MATH::Vector2f(0.0f, 0.0f), // red
+            },
+            GRAPHICS::VertexWithAttributes
+            {
+                .Position = MATH::Vector3f(0.0f, -1.0f, 0.0f),
+                .Color = GRAPHICS::Color::WHITE,
+                //.Color = GRAPHICS::Color(1.0f, 1.0f, 0.0f, 1.0f),
+                //.TextureCoordinates = MATH::Vector2f(1.0f, 1.0f), // this and one below are swapped; yellow
+                .TextureCoordinates = MATH::Vector2f(0.0f, 1.0f),
+            },
+            GRAPHICS::VertexWithAttributes
+            {
+                .Position = MATH::Vector3f(1.0f, -1.0f, 0.0f),
+                .Color = GRAPHICS::Color::WHITE,
+                //.Color = GRAPHICS::Color::BLUE,
+                //.TextureCoordinates = MATH::Vector2f(0.0f, 1.0f), // this and one above are swapped; blue
+                .TextureCoordinates = MATH::Vector2f(1.0f, 1.0f),
+            },
+        };
+        triangle.Material = test_material;
+        test_mesh.Triangles.push_back(triangle);
+#endif
+
+#if 1
+        triangle.Vertices =
+        {
+            GRAPHICS::VertexWithAttributes
+            {
+                .Position = MATH::Vector3f(1.0f, -1.0f, 0.0f),
+                .Color = GRAPHICS::Color::WHITE,
+                .TextureCoordinates = MATH::Vector2f(1.0f, 1.0f),
+            },
+            GRAPHICS::VertexWithAttributes
+            {
+                .Position = MATH::Vector3f(1.0f, 1.0f, 0.0f),
+                .Color = GRAPHICS::Color::WHITE,
+                .TextureCoordinates = MATH::Vector2f(1.0f, 0.0f),
+            },
+            GRAPHICS::VertexWithAttributes
+            {
+                .Position = MATH::Vector3f(0.0f, 1.0f, 0.0f),
+                .Color = GRAPHICS::Color::WHITE,
+                .TextureCoordinates = MATH::Vector2f(0.0f, 0.0f),
+            },
+        };
+        triangle.Material = test_material;
+        test_mesh.Triangles.push_back(triangle);
+#endif
+#endif
+
+        // CREATE THE OBJECT.
+        GRAPHICS::Object3D quad;
+        quad.Model.MeshesByName["test_mesh"] = test_mesh;
+        return quad;
+    }
+
+    /// Creates an object with a few colored spheres, primarily useful for ray tracing.
+    /// @return The object containing the spheres.
+    GRAPHICS::Object3D TestScenes::CreateSpheres()
+    {
+        GRAPHICS::Object3D spheres;
+
+        GRAPHICS::GEOMETRY::Sphere red_sphere;
+        red_sphere.CenterPosition = MATH::Vector3f(0.0f, -1.0f, -3.0f);
+        red_sphere.Radius = 1.0f;
+        red_sphere.Material = std::make_shared<GRAPHICS::Material>();
+        red_sphere.Material->DiffuseProperties.Color = GRAPHICS::Color::RED;
+        spheres.Spheres.emplace_back(std::move(red_sphere));
+
+        GRAPHICS::GEOMETRY::Sphere blue_sphere;
+        blue_sphere.CenterPosition = MATH::Vector3f(2.0f, 0.0f, -4.0f);
+        blue_sphere.Radius = 1.0f;
+        blue_sphere.Material = std::make_shared<GRAPHICS::Material>();
+        blue_sphere.Material->DiffuseProperties.Color = GRAPHICS::Color::BLUE;
+        spheres.Spheres.emplace_back(std::move(blue_sphere));
+
+        GRAPHICS::GEOMETRY::Sphere green_sphere;
+        green_sphere.CenterPosition = MATH::Vector3f(-2.0f, 0.0f, -4.0f);
+        green_sphere.Radius = 1.0f;
+        green_sphere.Material = std::make_shared<GRAPHICS::Material>();
+        green_sphere.Material->DiffuseProperties.Color = GRAPHICS::Color::GREEN;
+        spheres.Spheres.emplace_back(std::move(green_sphere));
+
+        return spheres;
+    }
+
+    /// Creates an empty scene with the basic lighting needed for most kinds of rendering.
+    /// @return The scene, without any objects.
+    GRAPHICS::Scene TestScenes::CreateLitScene()
+    {
+        GRAPHICS::Scene scene;
+        scene.BackgroundColor = GRAPHICS::Color::BLACK;
+        // Some lights are needed for most kinds of rendering.
+        scene.Lights = std::vector<GRAPHICS::SHADING::LIGHTING::Light>();
+        scene.Lights.emplace_back(
+            GRAPHICS::SHADING::LIGHTING::Light
+            {
+                .Type = GRAPHICS::SHADING::LIGHTING::LightType::POINT,
+                .Color = GRAPHICS::Color(1.0f, 1.0f, 1.0f, 1.0f),
+                .PointLightWorldPosition = MATH::Vector3f(0.0f, 0.0f, 5.0f)
+            });
+        return scene;
+    }
+
+    /// Creates the default camera for viewing the test scenes.
+    /// @return The default camera.
+    GRAPHICS::VIEWING::Camera TestScenes::CreateDefaultCamera()
+    {
+        GRAPHICS::VIEWING::Camera camera = GRAPHICS::VIEWING::Camera::LookAtFrom(MATH::Vector3f(0.0f, 0.0f, 0.0f), MATH::Vector3f(0.0f, 5.0f, 20.0f));
+        camera.Projection = GRAPHICS::VIEWING::ProjectionType::PERSPECTIVE;
+        camera.NearClipPlaneViewDistance = 1.0f;
+        camera.FarClipPlaneViewDistance = 1000.0f;
+        return camera;
+    }
+}
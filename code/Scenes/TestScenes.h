@@ -0,0 +1,21 @@
+#pragma once
+
+#include <filesystem>
+#include "Graphics/Object3D.h"
+#include "Graphics/Scene.h"
+#include "Graphics/Viewing/Camera.h"
+
+/// Holds code for building the canonical scenes used by the different programs in this project.
+namespace SCENES
+{
+    /// Builds the test scenes shared by the interactive viewer, the headless renderer, and benchmarks.
+    /// Keeping these in one place ensures that all of the programs render exactly the same content.
+    class TestScenes
+    {
+    public:
+        static GRAPHICS::Object3D CreateTexturedQuad(const std::filesystem::path& texture_filepath);
+        static GRAPHICS::Object3D CreateSpheres();
+        static GRAPHICS::Scene CreateLitScene();
+        static GRAPHICS::VIEWING::Camera CreateDefaultCamera();
+    };
+}
@@ -0,0 +1,260 @@
+#include <algorithm>
+#include "Threading/WorkStealingThreadPool.h"
+
+namespace THREADING
+{
+    /// Constructor.
+    /// @param[in]  thread_count - The total number of threads to use, including the calling thread.
+    ///     0 uses one thread per hardware core.
+    WorkStealingThreadPool::WorkStealingThreadPool(const unsigned int thread_count)
+    {
+        StartThreads(ResolveThreadCount(thread_count));
+    }
+
+    /// Destructor.  Waits for all background threads to exit.
+    WorkStealingThreadPool::~WorkStealingThreadPool()
+    {
+        StopThreads();
+    }
+
+    /// Determines the actual number of threads to use for a requested thread count.
+    /// @param[in]  requested_thread_count - The requested number of threads.  0 indicates one per hardware core.
+    /// @return The actual number of threads to use (always at least 1).
+    unsigned int WorkStealingThreadPool::ResolveThreadCount(const unsigned int requested_thread_count)
+    {
+        if (requested_thread_count > 0)
+        {
+            return requested_thread_count;
+        }
+
+        // The hardware concurrency may be unknown, in which case 0 is returned.
+        unsigned int hardware_thread_count = std::thread::hardware_concurrency();
+        return std::max(hardware_thread_count, 1u);
+    }
+
+    /// Gets the total number of threads tasks are run on, including the calling thread.
+    /// @return The number of threads.
+    unsigned int WorkStealingThreadPool::ThreadCount() const
+    {
+        return static_cast<unsigned int>(WorkerQueues.size());
+    }
+
+    /// Changes the number of threads in the pool, if different than the current number.
+    /// Must not be called while tasks are running.
+    /// @param[in]  thread_count - The total number of threads to use.  0 uses one thread per hardware core.
+    void WorkStealingThreadPool::Resize(const unsigned int thread_count)
+    {
+        unsigned int resolved_thread_count = ResolveThreadCount(thread_count);
+        if (resolved_thread_count == ThreadCount())
+        {
+            return;
+        }
+
+        StopThreads();
+        StartThreads(resolved_thread_count);
+    }
+
+    /// Gets the arena for transient memory of a worker.  Memory allocated from it remains valid until
+    /// the next call to ResetWorkerArenas(), which makes it suitable for data only needed for the current frame.
+    /// @param[in]  worker_index - The index of the worker, as passed to its tasks.
+    /// @return The worker's arena.  Only the worker's tasks may use it while tasks are running.
+    MEMORY::LinearArena& WorkStealingThreadPool::WorkerArena(const unsigned int worker_index)
+    {
+        return *WorkerArenas[worker_index];
+    }
+
+    /// Frees all memory allocated from the workers' arenas.  Should be called once per frame,
+    /// while no tasks are running and once nothing allocated from the arenas is in use anymore.
+    void WorkStealingThreadPool::ResetWorkerArenas()
+    {
+        for (std::unique_ptr<MEMORY::LinearArena>& arena : WorkerArenas)
+        {
+            arena->Reset();
+        }
+    }
+
+    /// Runs a batch of tasks across all threads, returning once all tasks have finished.
+    /// @param[in]  task_count - The number of tasks to run.
+    /// @param[in]  task - The function to run for each task index in [0, task_count).
+    void WorkStealingThreadPool::RunBatch(const std::size_t task_count, const TaskReference& task)
+    {
+        // HANDLE TRIVIAL CASES WITHOUT ANY SYNCHRONIZATION.
+        if (0 == task_count)
+        {
+            return;
+        }
+        bool run_serially = (1 == ThreadCount()) || (1 == task_count);
+        if (run_serially)
+        {
+            constexpr unsigned int CALLING_THREAD_WORKER_INDEX = 0;
+            for (std::size_t task_index = 0; task_index < task_count; ++task_index)
+            {
+                task.Run(task.Function, task_index, CALLING_THREAD_WORKER_INDEX);
+            }
+            return;
+        }
+
+        // DISTRIBUTE TASKS ACROSS WORKER QUEUES.
+        // Contiguous ranges are given to each worker since neighboring tasks (like neighboring tiles)
+        // tend to have similar costs and touch nearby memory.  Stealing balances out any differences.
+        std::size_t worker_count = WorkerQueues.size();
+        for (std::size_t worker_index = 0; worker_index < worker_count; ++worker_index)
+        {
+            WorkerQueue& worker_queue = *WorkerQueues[worker_index];
+            std::lock_guard<std::mutex> queue_lock(worker_queue.Mutex);
+            worker_queue.BeginTaskIndex = (task_count * worker_index) / worker_count;
+            worker_queue.EndTaskIndex = (task_count * (worker_index + 1)) / worker_count;
+        }
+        RemainingTaskCount = task_count;
+
+        // START THE BATCH ON BACKGROUND THREADS.
+        {
+            std::lock_guard<std::mutex> batch_lock(BatchMutex);
+            CurrentTask = &task;
+            ++BatchNumber;
+        }
+        BatchStarted.notify_all();
+
+        // HAVE THE CALLING THREAD HELP WITH TASKS.
+        constexpr unsigned int CALLING_THREAD_WORKER_INDEX = 0;
+        RunAvailableTasks(CALLING_THREAD_WORKER_INDEX, task);
+
+        // WAIT FOR ALL TASKS TO FINISH.
+        // Background workers must also no longer be looking for tasks before returning
+        // so that they can't accidentally pick up tasks from a later batch with this batch's function.
+        std::unique_lock<std::mutex> batch_lock(BatchMutex);
+        WorkerFinished.wait(batch_lock, [&]() { return (0 == RemainingTaskCount) && (0 == ActiveWorkerCount); });
+        CurrentTask = nullptr;
+    }
+
+    /// Starts the specified number of workers.
+    /// @param[in]  thread_count - The total number of threads, including the calling thread.
+    void WorkStealingThreadPool::StartThreads(const unsigned int thread_count)
+    {
+        Stopping = false;
+
+        WorkerQueues.clear();
+        WorkerArenas.clear();
+        for (unsigned int worker_index = 0; worker_index < thread_count; ++worker_index)
+        {
+            WorkerQueues.emplace_back(std::make_unique<WorkerQueue>());
+            WorkerArenas.emplace_back(std::make_unique<MEMORY::LinearArena>());
+        }
+
+        // Worker 0 is the calling thread, so background threads are only needed for the remaining workers.
+        for (unsigned int worker_index = 1; worker_index < thread_count; ++worker_index)
+        {
+            Threads.emplace_back(&WorkStealingThreadPool::RunWorkerThread, this, worker_index);
+        }
+    }
+
+    /// Stops all background threads, waiting for them to exit.
+    void WorkStealingThreadPool::StopThreads()
+    {
+        {
+            std::lock_guard<std::mutex> batch_lock(BatchMutex);
+            Stopping = true;
+        }
+        BatchStarted.notify_all();
+
+        for (std::thread& thread : Threads)
+        {
+            thread.join();
+        }
+        Threads.clear();
+    }
+
+    /// The main function for a background worker thread.
+    /// @param[in]  worker_index - The index of the worker the thread is for.
+    void WorkStealingThreadPool::RunWorkerThread(const unsigned int worker_index)
+    {
+        std::uint64_t last_batch_number = 0;
+        while (true)
+        {
+            // WAIT FOR A NEW BATCH OF TASKS.
+            const TaskReference* task = nullptr;
+            {
+                std::unique_lock<std::mutex> batch_lock(BatchMutex);
+                BatchStarted.wait(batch_lock, [&]() { return Stopping || (BatchNumber != last_batch_number); });
+                if (Stopping)
+                {
+                    return;
+                }
+
+                // The batch may have already finished before this thread woke up, in which case there's nothing to do.
+                last_batch_number = BatchNumber;
+                task = CurrentTask;
+                if (!task)
+                {
+                    continue;
+                }
+                ++ActiveWorkerCount;
+            }
+
+            // RUN TASKS UNTIL NONE ARE LEFT.
+            RunAvailableTasks(worker_index, *task);
+
+            // INDICATE THAT THIS WORKER IS DONE WITH THE BATCH.
+            {
+                std::lock_guard<std::mutex> batch_lock(BatchMutex);
+                --ActiveWorkerCount;
+            }
+            WorkerFinished.notify_all();
+        }
+    }
+
+    /// Runs tasks from the worker's own queue, then steals from other workers, until no tasks remain.
+    /// @param[in]  worker_index - The index of the worker running tasks.
+    /// @param[in]  task - The function to run for each task.
+    void WorkStealingThreadPool::RunAvailableTasks(const unsigned int worker_index, const TaskReference& task)
+    {
+        std::size_t task_index = 0;
+        while (TryPopOwnTask(worker_index, task_index) || TryStealTask(worker_index, task_index))
+        {
+            task.Run(task.Function, task_index, worker_index);
+            --RemainingTaskCount;
+        }
+    }
+
+    /// Attempts to pop a task from the back of a worker's own queue.
+    /// @param[in]  worker_index - The index of the worker.
+    /// @param[out] task_index - The index of the popped task, if successful.
+    /// @return True if a task was popped; false if the queue was empty.
+    bool WorkStealingThreadPool::TryPopOwnTask(const unsigned int worker_index, std::size_t& task_index)
+    {
+        WorkerQueue& worker_queue = *WorkerQueues[worker_index];
+        std::lock_guard<std::mutex> queue_lock(worker_queue.Mutex);
+        if (worker_queue.BeginTaskIndex >= worker_queue.EndTaskIndex)
+        {
+            return false;
+        }
+
+        --worker_queue.EndTaskIndex;
+        task_index = worker_queue.EndTaskIndex;
+        return true;
+    }
+
+    /// Attempts to steal a task from the front of another worker's queue.
+    /// @param[in]  thief_worker_index - The index of the worker trying to steal.
+    /// @param[out] task_index - The index of the stolen task, if successful.
+    /// @return True if a task was stolen; false if all other queues were empty.
+    bool WorkStealingThreadPool::TryStealTask(const unsigned int thief_worker_index, std::size_t& task_index)
+    {
+        // Victims are visited starting after the thief to spread out contention.
+        std::size_t worker_count = WorkerQueues.size();
+        for (std::size_t offset = 1; offset < worker_count; ++offset)
+        {
+            std::size_t victim_worker_index = (thief_worker_index + offset) % worker_count;
+            WorkerQueue& victim_queue = *WorkerQueues[victim_worker_index];
+            std::lock_guard<std::mutex> queue_lock(victim_queue.Mutex);
+            if (victim_queue.BeginTaskIndex < victim_queue.EndTaskIndex)
+            {
+                task_index = victim_queue.BeginTaskIndex;
+                ++victim_queue.BeginTaskIndex;
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
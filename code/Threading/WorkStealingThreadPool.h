@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Memory/LinearArena.h"
+
+/// Holds code for running work across multiple threads.
+namespace THREADING
+{
+    /// A pool of threads that splits batches of independent tasks across all cores.
+    ///
+    /// Each worker has its own queue of tasks that it pops from the back of for locality.
+    /// Workers that run out of tasks steal from the front of other workers' queues,
+    /// which keeps all cores busy even when tasks take very different amounts of time
+    /// (such as ray tracing tiles with and without reflective objects).
+    ///
+    /// The thread calling ParallelFor() participates as worker 0, so a pool with a thread count
+    /// of 1 simply runs all tasks serially on the calling thread.  ParallelFor() is not re-entrant.
+    ///
+    /// Each worker also has its own linear arena for transient memory, which is reset once per frame
+    /// by ResetWorkerArenas().  Running tasks doesn't allocate any heap memory itself.
+    class WorkStealingThreadPool
+    {
+    public:
+        // CONSTRUCTION/DESTRUCTION.
+        explicit WorkStealingThreadPool(const unsigned int thread_count = 0);
+        ~WorkStealingThreadPool();
+        WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+        WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+        // THREAD COUNT.
+        static unsigned int ResolveThreadCount(const unsigned int requested_thread_count);
+        unsigned int ThreadCount() const;
+        void Resize(const unsigned int thread_count);
+
+        // TASK EXECUTION.
+        /// Runs a batch of tasks across all threads, returning once all tasks have finished.
+        /// @param[in]  task_count - The number of tasks to run.
+        /// @param[in]  task - The function to run for each task index in [0, task_count).  It's called with the index
+        ///     of the task and the index of the worker running it (in the range [0, ThreadCount())), which allows
+        ///     tasks to use per-worker scratch data.
+        template <typename TaskFunction>
+        void ParallelFor(const std::size_t task_count, const TaskFunction& task)
+        {
+            // The task is referred to rather than copied into a std::function, which could allocate memory.
+            TaskReference task_reference;
+            task_reference.Function = &task;
+            task_reference.Run = [](const void* const function, const std::size_t task_index, const unsigned int worker_index)
+            {
+                (*static_cast<const TaskFunction*>(function))(task_index, worker_index);
+            };
+            RunBatch(task_count, task_reference);
+        }
+
+        // PER-FRAME MEMORY.
+        MEMORY::LinearArena& WorkerArena(const unsigned int worker_index);
+        void ResetWorkerArenas();
+
+    private:
+        /// A reference to the function for running each task in a batch, without knowing its type.
+        struct TaskReference
+        {
+            /// The task function.
+            const void* Function = nullptr;
+            /// Calls the task function for a single task.
+            void (*Run)(const void* const function, const std::size_t task_index, const unsigned int worker_index) = nullptr;
+        };
+
+        /// The queue of task indices for a single worker.
+        /// A worker's tasks are always a contiguous range, so the queue just tracks the range's ends.
+        struct WorkerQueue
+        {
+            /// Synchronizes access to the queue between the owner and thieves.
+            std::mutex Mutex = {};
+            /// The index of the first task remaining in the queue.  Thieves take tasks from here.
+            std::size_t BeginTaskIndex = 0;
+            /// One past the index of the last task remaining in the queue.  The owner takes tasks from here.
+            std::size_t EndTaskIndex = 0;
+        };
+
+        // HELPER METHODS.
+        void RunBatch(const std::size_t task_count, const TaskReference& task);
+        void StartThreads(const unsigned int thread_count);
+        void StopThreads();
+        void RunWorkerThread(const unsigned int worker_index);
+        void RunAvailableTasks(const unsigned int worker_index, const TaskReference& task);
+        bool TryPopOwnTask(const unsigned int worker_index, std::size_t& task_index);
+        bool TryStealTask(const unsigned int thief_worker_index, std::size_t& task_index);
+
+        // PRIVATE MEMBER VARIABLES.
+        /// The task queues, one per worker (including the calling thread as worker 0).
+        std::vector<std::unique_ptr<WorkerQueue>> WorkerQueues = {};
+        /// The arenas for transient memory, one per worker.
+        std::vector<std::unique_ptr<MEMORY::LinearArena>> WorkerArenas = {};
+        /// The background threads for workers 1 and up.
+        std::vector<std::thread> Threads = {};
+        /// Synchronizes the state for starting and finishing batches of tasks.
+        std::mutex BatchMutex = {};
+        /// Signaled when a new batch of tasks is available or when threads should stop.
+        std::condition_variable BatchStarted = {};
+        /// Signaled when a background worker has finished working on the current batch.
+        std::condition_variable WorkerFinished = {};
+        /// The task function for the current batch; null when no batch is running.
+        const TaskReference* CurrentTask = nullptr;
+        /// Incremented for each new batch so that workers can detect new batches.
+        std::uint64_t BatchNumber = 0;
+        /// The number of background workers currently working on the current batch.
+        unsigned int ActiveWorkerCount = 0;
+        /// The number of tasks in the current batch that have not yet finished.
+        std::atomic<std::size_t> RemainingTaskCount = 0;
+        /// True if background threads should exit.
+        bool Stopping = false;
+    };
+}